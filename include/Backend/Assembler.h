@@ -5,17 +5,31 @@
 #include "Backend/LIR/LIR.h"
 #include "Backend/InstructionSets/RISC-V/Opt/Peephole.h"
 #include "Backend/InstructionSets/RISC-V/Opt/Arithmetic.h"
+#include "Utils/OutputSink.h"
+#include "Utils/TimeReport.h"
 
 namespace Backend {
     class Assembler {
         public:
             std::shared_ptr<Backend::LIR::Module> lir_module;
-            [[nodiscard]] virtual std::string to_string() const = 0;
+            // Writes the whole output into `out` piece by piece.
+            virtual void print(::Utils::OutputSink &out) const = 0;
+
+            [[nodiscard]] std::string to_string() const {
+                return ::Utils::print_to_string([this](::Utils::OutputSink &out) { print(out); });
+            }
 
             Assembler(const std::shared_ptr<Mir::Module> &llvm_module) {
-                lir_module = std::make_shared<Backend::LIR::Module>(llvm_module);
-                auto arithmetic_opt = std::make_shared<RISCV::Opt::ConstOpt>(lir_module);
-                arithmetic_opt->optimize();
+                {
+                    const ::Utils::ScopedTimer timer("backend", "lir-build");
+                    lir_module = std::make_shared<Backend::LIR::Module>(llvm_module);
+                }
+                {
+                    const ::Utils::ScopedTimer timer("backend", "const-opt");
+                    auto arithmetic_opt = std::make_shared<RISCV::Opt::ConstOpt>(lir_module);
+                    arithmetic_opt->optimize();
+                }
+                const ::Utils::ScopedTimer timer("backend", "peephole-before-ra");
                 auto peephole_opt = std::make_shared<RISCV::Opt::PeepholeBeforeRA>(lir_module);
                 peephole_opt->optimize();
             }
@@ -0,0 +1,98 @@
+#ifndef BACKEND_BITSET_H
+#define BACKEND_BITSET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace Backend {
+    class BitSet;
+}
+
+/*
+ * Dense bit vector indexed by `Backend::Variable::index`.
+ * Used for per-block liveness so that set operations work on whole words instead of hashing names.
+ * The set grows on demand, bits beyond `size()` are treated as zero.
+ */
+class Backend::BitSet {
+    public:
+        BitSet() = default;
+        explicit BitSet(const size_t size) : words((size + 63) / 64, 0), bits(size) {}
+
+        [[nodiscard]] inline size_t size() const { return bits; }
+
+        void resize(const size_t size) {
+            words.resize((size + 63) / 64, 0);
+            if (size < bits && size % 64 != 0)
+                words.back() &= (uint64_t{1} << (size % 64)) - 1;
+            bits = size;
+        }
+
+        [[nodiscard]] inline bool test(const size_t index) const {
+            return index < bits && (words[index >> 6] >> (index & 63) & 1);
+        }
+
+        inline void set(const size_t index) {
+            if (index >= bits) resize(index + 1);
+            words[index >> 6] |= uint64_t{1} << (index & 63);
+        }
+
+        inline void reset(const size_t index) {
+            if (index < bits) words[index >> 6] &= ~(uint64_t{1} << (index & 63));
+        }
+
+        inline void clear() {
+            std::fill(words.begin(), words.end(), 0);
+        }
+
+        [[nodiscard]] size_t count() const {
+            size_t result = 0;
+            for (const uint64_t word : words)
+                result += __builtin_popcountll(word);
+            return result;
+        }
+
+        // this |= other, returns whether any bit changed
+        bool union_with(const BitSet &other) {
+            if (other.bits > bits) resize(other.bits);
+            uint64_t changed = 0;
+            for (size_t i = 0; i < other.words.size(); i++) {
+                const uint64_t merged = words[i] | other.words[i];
+                changed |= merged ^ words[i];
+                words[i] = merged;
+            }
+            return changed != 0;
+        }
+
+        // this &= ~other
+        void subtract(const BitSet &other) {
+            const size_t common = std::min(words.size(), other.words.size());
+            for (size_t i = 0; i < common; i++)
+                words[i] &= ~other.words[i];
+        }
+
+        bool operator==(const BitSet &other) const {
+            const size_t common = std::min(words.size(), other.words.size());
+            for (size_t i = 0; i < common; i++)
+                if (words[i] != other.words[i]) return false;
+            for (size_t i = common; i < words.size(); i++)
+                if (words[i]) return false;
+            for (size_t i = common; i < other.words.size(); i++)
+                if (other.words[i]) return false;
+            return true;
+        }
+        bool operator!=(const BitSet &other) const { return !(*this == other); }
+
+        // Call `func(index)` for every set bit in ascending order.
+        template<typename Func>
+        void for_each(Func &&func) const {
+            for (size_t i = 0; i < words.size(); i++)
+                for (uint64_t word = words[i]; word; word &= word - 1)
+                    func((i << 6) + __builtin_ctzll(word));
+        }
+    private:
+        std::vector<uint64_t> words;
+        size_t bits{0};
+};
+
+#endif
@@ -9,26 +9,35 @@
 #include "Backend/InstructionSets/RISC-V/RegisterAllocator/RegisterAllocator.h"
 #include "Backend/Assembler.h"
 #include "Backend/InstructionSets/RISC-V/Opt/Peephole.h"
+#include "Utils/TimeReport.h"
 
 namespace RISCV {
     class Assembler : public Backend::Assembler {
         public:
             RegisterAllocator::AllocationType allocation_type;
 
-            explicit Assembler(const std::shared_ptr<Mir::Module> &llvm_module, RegisterAllocator::AllocationType type = RegisterAllocator::AllocationType::GRAPH_COLORING) : Backend::Assembler(llvm_module), allocation_type(type) {
+            /*
+             * Register allocation, translation and the peephole pass after allocation run per function on `jobs` threads.
+             * Functions keep their order in the module, so the output is the same for any `jobs`.
+             */
+            explicit Assembler(const std::shared_ptr<Mir::Module> &llvm_module, RegisterAllocator::AllocationType type = RegisterAllocator::AllocationType::GRAPH_COLORING, const size_t jobs = 1) : Backend::Assembler(llvm_module), allocation_type(type) {
                 #ifndef RISCV_DEBUG_MODE
                     rv_module = std::make_shared<RISCV::Module>(lir_module, allocation_type);
-                    rv_module->to_assembly();
+                    {
+                        const ::Utils::ScopedTimer timer("backend", "to-assembly");
+                        rv_module->to_assembly(jobs);
+                    }
+                    const ::Utils::ScopedTimer timer("backend", "peephole-after-ra");
                     auto peephole_opt = std::make_shared<RISCV::Opt::PeepholeAfterRA>(rv_module);
-                    peephole_opt->optimize();
+                    peephole_opt->optimize(jobs);
                 #endif
             }
 
-            [[nodiscard]] std::string to_string() const override {
+            void print(::Utils::OutputSink &out) const override {
                 #ifndef RISCV_DEBUG_MODE
-                    return rv_module->to_string();
+                    rv_module->print(out);
                 #else
-                    return lir_module->to_string();
+                    lir_module->print(out);
                 #endif
             }
         private:
@@ -12,6 +12,8 @@
 #include "Backend/VariableTypes.h"
 #include "Backend/InstructionSets/RISC-V/memset.h"
 #include "Backend/Value.h"
+#include "Utils/OutputSink.h"
+#include "Utils/TimeReport.h"
 
 namespace RISCV {
     class Module;
@@ -67,6 +69,7 @@ class RISCV::Block {
 
         explicit Block(std::string name, std::shared_ptr<RISCV::Function> function) : name(name), function(function) {}
         [[nodiscard]] std::string to_string() const;
+        void print(::Utils::OutputSink &out) const;
         [[nodiscard]] std::string label_name() const;
 };
 
@@ -80,15 +83,27 @@ class RISCV::Function : public std::enable_shared_from_this<RISCV::Function> {
 
         explicit Function(const std::shared_ptr<Backend::LIR::Function>& lir_function, const RegisterAllocator::AllocationType& allocation_type = RegisterAllocator::AllocationType::LINEAR_SCAN);
 
+        /*
+         * Allocates registers, then translates the LIR function.
+         * Touches nothing outside this function, so functions can be handled concurrently.
+         */
         void to_assembly() {
+            const Backend::Utils::NameScope name_scope(name_counter);
+            {
+                const ::Utils::ScopedTimer timer("regalloc", name);
+                register_allocator->allocate();
+            }
             translate_blocks();
             generate_prologue();
         }
 
         [[nodiscard]] std::string to_string() const;
+        void print(::Utils::OutputSink &out) const;
 
     private:
         std::shared_ptr<Backend::LIR::Function> lir_function;
+        // temporaries created for this function are numbered from the module-wide count at construction
+        size_t name_counter{Backend::Utils::module_name_counter()};
         void generate_prologue();
         void translate_blocks();
         inline std::shared_ptr<RISCV::Block> find_block(std::string name) const {
@@ -112,13 +127,13 @@ class RISCV::Module {
 
         explicit Module(const std::shared_ptr<Backend::LIR::Module>& lir_module, const RegisterAllocator::AllocationType& allocation_type = RegisterAllocator::AllocationType::LINEAR_SCAN);
         [[nodiscard]] std::string to_string() const;
+        // Writes the data section, then each function instruction by instruction, into `out`.
+        void print(::Utils::OutputSink &out) const;
 
-        inline void to_assembly() {
-            for (std::shared_ptr<RISCV::Function>& function : functions)
-                function->to_assembly();
-        }
+        // Handles the functions on `jobs` threads, the result does not depend on `jobs`.
+        void to_assembly(size_t jobs = 1);
     private:
-        static std::string to_string(const std::shared_ptr<Backend::DataSection> &data_section);
+        static void print(::Utils::OutputSink &out, const std::shared_ptr<Backend::DataSection> &data_section);
         static inline const std::string TEXT_OPTION =
 "\
 .section .text\n\
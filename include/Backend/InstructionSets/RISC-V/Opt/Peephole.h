@@ -39,7 +39,9 @@ class RISCV::Opt::PeepholeAfterRA {
         PeepholeAfterRA(const std::shared_ptr<RISCV::Module> &module);
         ~PeepholeAfterRA();
         std::shared_ptr<RISCV::Module> module;
-        void optimize();
+        // Optimizes the functions on `jobs` threads, each function is rewritten on its own.
+        void optimize(size_t jobs = 1);
+        void optimize(const std::shared_ptr<RISCV::Function> &function);
         void addSubZeroRemove(const std::shared_ptr<RISCV::Block> &block);
         void removeUselessJumps(const std::shared_ptr<RISCV::Function> &function);
 };
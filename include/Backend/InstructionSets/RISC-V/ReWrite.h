@@ -16,6 +16,9 @@ namespace RISCV::ReWrite {
     void rewrite_large_offset(const std::shared_ptr<Backend::LIR::Function> &lir_function, const std::shared_ptr<RISCV::Stack> &stack);
     void rewrite_parameters_i(const std::shared_ptr<Backend::LIR::Function> &lir_function, const std::shared_ptr<RISCV::Stack> &stack);
     void rewrite_parameters_f(const std::shared_ptr<Backend::LIR::Function> &lir_function, const std::shared_ptr<RISCV::Stack> &stack);
+    // Create variables for physical registers, move parameters, return values and callee-saved registers through them.
+    void create_registers_i(const std::shared_ptr<Backend::LIR::Function> &lir_function, const std::shared_ptr<RISCV::Stack> &stack);
+    void create_registers_f(const std::shared_ptr<Backend::LIR::Function> &lir_function, const std::shared_ptr<RISCV::Stack> &stack);
 }
 
 #endif
\ No newline at end of file
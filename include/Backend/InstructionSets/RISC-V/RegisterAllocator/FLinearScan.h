@@ -0,0 +1,24 @@
+#ifndef RV_REGISTER_ALLOCATOR_FLINEAR_SCAN_H
+#define RV_REGISTER_ALLOCATOR_FLINEAR_SCAN_H
+
+#include "Backend/InstructionSets/RISC-V/RegisterAllocator/LinearScan.h"
+#include "Backend/LIR/Instructions.h"
+#include "Backend/InstructionSets/RISC-V/Registers.h"
+#include "Backend/LIR/LIR.h"
+#include "Backend/VariableTypes.h"
+#include "Backend/InstructionSets/RISC-V/ReWrite.h"
+#include "Utils/Log.h"
+
+class RISCV::RegisterAllocator::FLinearScan : public RISCV::RegisterAllocator::LinearScan {
+    public:
+        explicit FLinearScan(const std::shared_ptr<Backend::LIR::Function> &function, const std::shared_ptr<RISCV::Stack> &stack) : LinearScan(function, stack) {
+            is_consistent = Backend::Utils::is_float;
+        }
+        ~FLinearScan() override = default;
+        void allocate() final override;
+    private:
+        void create_registers() final override;
+        void build_intervals() final override;
+};
+
+#endif
\ No newline at end of file
@@ -2,8 +2,10 @@
 #define RV_REGISTER_ALLOCATOR_GRAPH_COLORING_H
 
 #include <algorithm>
-#include <set>
-#include <stack>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
 #include <map>
 #include <string>
 #include <ostream>
@@ -29,44 +31,45 @@ class RISCV::RegisterAllocator::GraphColoring : public RISCV::RegisterAllocator:
     protected:
         bool (*is_consistent)(const Backend::VariableType &type) = Backend::Utils::is_int;
 
-        class InterferenceNode : public std::enable_shared_from_this<InterferenceNode> {
+        /*
+         * Lower triangular bit matrix, answers "do `u` and `v` interfere" in O(1).
+         */
+        class InterferenceMatrix {
             public:
-                std::shared_ptr<Backend::Variable> variable;
-                std::set<std::shared_ptr<InterferenceNode>> move_related_neighbors;
-                std::set<std::shared_ptr<InterferenceNode>> non_move_related_neighbors;
-                std::set<std::shared_ptr<InterferenceNode>> coalesced;
-                bool is_spilled{false};
-                bool is_colored{false};
-                RISCV::Registers::ABI color{RISCV::Registers::ABI::ZERO};
-
-                explicit InterferenceNode(const std::shared_ptr<Backend::Variable> &var) : variable(var) {}
-                explicit InterferenceNode(RISCV::Registers::ABI reg) : variable(nullptr), is_colored(true), color(reg) {}
-                [[nodiscard]] inline size_t degree() const { return non_move_related_neighbors.size(); }
-
-                InterferenceNode& operator+=(const std::shared_ptr<InterferenceNode> &other) {
-                    coalesced.insert(other);
-                    coalesced.insert(other->coalesced.begin(), other->coalesced.end());
-                    move_related_neighbors.erase(other);
-                    for (std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> move_neighbor : other->move_related_neighbors) {
-                        if (move_neighbor != shared_from_this()) {
-                            move_neighbor->move_related_neighbors.erase(other);
-                            if (non_move_related_neighbors.find(move_neighbor) == non_move_related_neighbors.end()) {
-                                move_neighbor->move_related_neighbors.insert(shared_from_this());
-                                move_related_neighbors.insert(move_neighbor);
-                            }
-                        }
-                    }
-                    for (std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> non_move_neighbor : other->non_move_related_neighbors) {
-                        move_related_neighbors.erase(non_move_neighbor);
-                        non_move_related_neighbors.insert(non_move_neighbor);
-                        non_move_neighbor->move_related_neighbors.erase(shared_from_this());
-                        non_move_neighbor->non_move_related_neighbors.erase(other);
-                        non_move_neighbor->non_move_related_neighbors.insert(shared_from_this());
-                    }
-                    return *this;
+                void reset(const size_t n) {
+                    size = n;
+                    bits.assign((n * (n + 1) / 2 + 63) / 64, 0);
+                }
+                [[nodiscard]] inline bool test(const size_t u, const size_t v) const {
+                    const size_t pos = offset(u, v);
+                    return bits[pos >> 6] >> (pos & 63) & 1;
+                }
+                inline void set(const size_t u, const size_t v) {
+                    const size_t pos = offset(u, v);
+                    bits[pos >> 6] |= uint64_t{1} << (pos & 63);
+                }
+            private:
+                size_t size{0};
+                std::vector<uint64_t> bits;
+                [[nodiscard]] static inline size_t offset(const size_t u, const size_t v) {
+                    return u < v ? v * (v + 1) / 2 + u : u * (u + 1) / 2 + v;
                 }
         };
 
+        // Every node is in exactly one of these sets (George & Appel, "Iterated Register Coalescing").
+        enum class NodeState : uint8_t {
+            PRECOLORED, INITIAL, SIMPLIFY, FREEZE, SPILL, SPILLED, COALESCED, COLORED, SELECTED
+        };
+        enum class MoveState : uint8_t {
+            WORKLIST, ACTIVE, COALESCED, CONSTRAINED, FROZEN
+        };
+
+        struct Move {
+            size_t dst;
+            size_t src;
+            MoveState state{MoveState::WORKLIST};
+        };
+
         struct SpillCost {
             double cost{0.0};
             int use_count{0};
@@ -75,8 +78,29 @@ class RISCV::RegisterAllocator::GraphColoring : public RISCV::RegisterAllocator:
             int live_range{0};
         };
 
-        std::unordered_map<std::string, std::shared_ptr<InterferenceNode>> interference_graph;
-        std::unordered_map<std::string, SpillCost> spill_costs;
+        // Node ids are dense, physical registers come first.
+        std::vector<std::shared_ptr<Backend::Variable>> nodes;
+        // `Backend::Variable::index` -> node id, `Backend::Variable::no_index` if it takes no part in the allocation
+        std::vector<size_t> node_id;
+        size_t precolored_count{0};
+
+        InterferenceMatrix adj_set;
+        std::vector<std::vector<size_t>> adj_list;
+        std::vector<size_t> degree;
+        std::vector<std::vector<size_t>> move_list;
+        std::vector<size_t> alias;
+        std::vector<RISCV::Registers::ABI> color;
+        std::vector<NodeState> state;
+        std::vector<SpillCost> spill_costs;
+        std::vector<Move> moves;
+
+        // Worklists keep stale entries, an entry is valid only if the state of its node/move still matches.
+        std::vector<size_t> simplify_worklist;
+        std::vector<size_t> freeze_worklist;
+        std::vector<size_t> spill_worklist;
+        std::vector<size_t> worklist_moves;
+        std::vector<size_t> select_stack;
+
         std::vector<RISCV::Registers::ABI> available_colors;
 
         void __allocate__();
@@ -91,17 +115,39 @@ class RISCV::RegisterAllocator::GraphColoring : public RISCV::RegisterAllocator:
         void calculate_spill_costs();
         double calculate_spill_cost(const RISCV::RegisterAllocator::GraphColoring::SpillCost &cost_info);
 
-        bool can_coalesce_briggs(const std::string& node1, const std::string& node2, const size_t K);
-        void coalesce_nodes(const std::string& node1, const std::string& node2);
+        [[nodiscard]] inline size_t node_of(const Backend::Variable &variable) const {
+            const size_t index = lir_function->index_of(variable);
+            return index < node_id.size() ? node_id[index] : Backend::Variable::no_index;
+        }
+        [[nodiscard]] inline bool is_precolored(const size_t node) const { return node < precolored_count; }
+
+        void add_edge(size_t u, size_t v);
+        template<typename Func>
+        void for_each_adjacent(size_t node, Func &&func) const;
+        template<typename Func>
+        void for_each_node_move(size_t node, Func &&func) const;
+        [[nodiscard]] bool move_related(size_t node) const;
+        [[nodiscard]] size_t get_alias(size_t node) const;
+        void enable_moves(size_t node);
+        void decrement_degree(size_t node);
+        void add_worklist(size_t node);
+        [[nodiscard]] bool george_test(size_t u, size_t v) const;
+        [[nodiscard]] bool briggs_test(size_t u, size_t v) const;
+        void combine(size_t u, size_t v);
+        void freeze_moves(size_t node);
 
-        void simplify_phase(std::stack<std::string>& simplify_stack, const size_t K);
-        bool coalesce_phase(const size_t K);
-        bool freeze_phase(const size_t K);
-        bool spill_phase(std::stack<std::string>& simplify_stack, const size_t K);
-        std::string select_spill_candidate();
+        void make_worklists();
+        bool simplify_phase();
+        bool coalesce_phase();
+        bool freeze_phase();
+        bool spill_phase();
 
+        // Run simplify/coalesce/freeze/spill until every worklist is empty, then select colors.
+        // Actual spills are rewritten and the graph is rebuilt until no spill is needed.
+        template<typename StoreInst, typename LoadInst>
+        void color_graph();
         template<typename StoreInst, typename LoadInst>
-        bool assign_colors(std::stack<std::string> &stack);
+        bool assign_colors();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,107 @@
+#ifndef RV_REGISTER_ALLOCATOR_LINEAR_SCAN_H
+#define RV_REGISTER_ALLOCATOR_LINEAR_SCAN_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Backend/InstructionSets/RISC-V/RegisterAllocator/RegisterAllocator.h"
+#include "Backend/LIR/Instructions.h"
+#include "Backend/InstructionSets/RISC-V/Registers.h"
+#include "Backend/InstructionSets/RISC-V/ReWrite.h"
+#include "Backend/LIR/LIR.h"
+#include "Backend/VariableTypes.h"
+#include "Utils/Log.h"
+
+namespace RISCV::RegisterAllocator {
+    class FLinearScan;
+}
+
+/*
+ * Linear scan over live intervals with lifetime holes (Wimmer & Franz, "Linear Scan Register Allocation on SSA Form").
+ * Instructions are numbered in block order, an instruction `k` reads its operands at `2k` and writes its result at
+ * `2k + 1`. Physical registers are fixed intervals, calls add a short fixed range to every caller-saved register. An
+ * interval finding a register free only for its first part, and defined only within that part, keeps that register up
+ * to its first use behind the blocking position and is reloaded from a stack slot from there on. An interval that does
+ * not fit at all is split at every use by the spill rewrite. The scan is repeated on the rewritten function until
+ * everything fits.
+ */
+class RISCV::RegisterAllocator::LinearScan : public RISCV::RegisterAllocator::Allocator {
+    public:
+        explicit LinearScan(const std::shared_ptr<Backend::LIR::Function> &function, const std::shared_ptr<RISCV::Stack> &stack) : Allocator(function, stack) {};
+        ~LinearScan() override = default;
+        virtual void allocate() override;
+    private:
+        std::shared_ptr<RISCV::RegisterAllocator::FLinearScan> float_allocator;
+    protected:
+        bool (*is_consistent)(const Backend::VariableType &type) = Backend::Utils::is_int;
+
+        static constexpr size_t no_position = std::numeric_limits<size_t>::max();
+        // every round rewrites at least one use, a function needing more rounds is not making progress
+        static constexpr size_t max_rounds = 64;
+
+        struct Interval {
+            std::shared_ptr<Backend::Variable> variable;
+            // sorted, disjoint ranges `[from, to)`, the gaps are lifetime holes
+            std::vector<std::pair<size_t, size_t>> ranges;
+            // sorted positions of the uses and definitions, a split may reload the variable at any use listed here
+            std::vector<size_t> references;
+            size_t last_definition{0};
+            RISCV::Registers::ABI reg{RISCV::Registers::ABI::ZERO};
+            // the other side of a move, sharing its register makes the move redundant
+            size_t hint{Backend::Variable::no_index};
+            bool fixed{false};
+            int use_count{0};
+            int def_count{0};
+            double weight{0.0};
+
+            [[nodiscard]] inline size_t start() const { return ranges.front().first; }
+            [[nodiscard]] inline size_t end() const { return ranges.back().second; }
+            [[nodiscard]] bool covers(size_t position) const;
+            // first position covered by both intervals, `no_position` if they never overlap
+            [[nodiscard]] size_t next_intersection(const Interval &other) const;
+            // first use or definition at or after `position`, `no_position` if there is none
+            [[nodiscard]] size_t next_reference(size_t position) const;
+            void add_reference(size_t position);
+            // drop everything from `position` on
+            void truncate(size_t position);
+            // Ranges are added backwards while building, and reversed by `finish`.
+            void add_range(size_t from, size_t to);
+            void set_from(size_t from);
+            void finish();
+        };
+
+        // indexed by `Backend::Variable::index`, slots of variables taking no part in the allocation have no variable
+        std::vector<Interval> intervals;
+        // fixed interval (variable index) of every color
+        std::vector<size_t> fixed_intervals;
+        std::vector<RISCV::Registers::ABI> available_colors;
+
+        // `interval` keeps its register before the use at `position` and is reloaded from a stack slot from there on
+        struct Split {
+            size_t interval;
+            size_t position;
+        };
+
+        void __allocate__();
+        virtual void create_registers();
+        virtual void build_intervals();
+        template <size_t N>
+        void build_intervals(const std::vector<RISCV::Registers::ABI> &registers,
+                             const std::array<RISCV::Registers::ABI, N> &caller_saved);
+        [[nodiscard]] std::vector<size_t> scan(std::vector<Split> &splits);
+
+        [[nodiscard]] inline size_t interval_of(const Backend::Variable &variable) const {
+            const size_t index = lir_function->index_of(variable);
+            return index < intervals.size() && intervals[index].variable ? index : Backend::Variable::no_index;
+        }
+
+        // Scan until every interval fits, rewriting split and spilled ones into shorter intervals in between.
+        template<typename StoreInst, typename LoadInst>
+        void scan_intervals();
+};
+
+#endif
\ No newline at end of file
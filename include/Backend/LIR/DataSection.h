@@ -1,6 +1,7 @@
 #ifndef BACKEND_DATA_SECTION_H
 #define BACKEND_DATA_SECTION_H
 
+#include <cstring>
 #include <sstream>
 #include <vector>
 #include <memory>
@@ -24,7 +25,7 @@ class Backend::DataSection {
                 class InitValue {
                     public:
                         enum class Type : uint32_t {
-                            STRING, CONSTANTS
+                            STRING, CONSTANTS, SPARSE_ARRAY
                         };
                         Type value_type;
                         explicit InitValue(Type value_type) : value_type(value_type) {};
@@ -42,9 +43,89 @@ class Backend::DataSection {
                         std::vector<std::shared_ptr<Backend::Constant>> constants;
                 };
 
+                /*
+                 * A global array keeps the sparse `Mir::Init::Array` initializer as is,
+                 * so emission never expands it into one object per element.
+                 */
+                class SparseArray : public InitValue {
+                    public:
+                        explicit SparseArray(const std::shared_ptr<Mir::Init::Array> &array) : InitValue(Type::SPARSE_ARRAY), array(array) {}
+                        std::shared_ptr<Mir::Init::Array> array;
+                };
+
                 bool read_only{false};
                 std::shared_ptr<InitValue> init_value;
 
+                /*
+                 * Walk the initializer of an int/float variable as a sequence of data items:
+                 * `on_zero(bytes)` for a zero gap and `on_words(word, count)` for `count` consecutive copies of a non-zero word.
+                 * Adjacent zeros and repeated words are merged, so no two consecutive items are of the same kind and value.
+                 */
+                template<typename ZeroFn, typename WordsFn>
+                void for_each_data_item(ZeroFn &&on_zero, WordsFn &&on_words) const {
+                    const size_t element_size = Backend::Utils::type_to_size(workload_type);
+                    size_t zero_bytes = 0, repeat = 0;
+                    int32_t last_word = 0;
+                    auto zeros = [&](const size_t bytes) {
+                        if (repeat > 0) {
+                            on_words(last_word, repeat);
+                            repeat = 0;
+                        }
+                        zero_bytes += bytes;
+                    };
+                    auto word = [&](const int32_t w) {
+                        if (w == 0) {
+                            zeros(element_size);
+                            return;
+                        }
+                        if (zero_bytes > 0) {
+                            on_zero(zero_bytes);
+                            zero_bytes = 0;
+                        }
+                        if (repeat > 0 && w == last_word) {
+                            repeat++;
+                            return;
+                        }
+                        if (repeat > 0)
+                            on_words(last_word, repeat);
+                        last_word = w;
+                        repeat = 1;
+                    };
+
+                    if (init_value->value_type == InitValue::Type::SPARSE_ARRAY) {
+                        const std::shared_ptr<Mir::Init::Array> &array = std::static_pointer_cast<SparseArray>(init_value)->array;
+                        const bool is_float = array->get_atomic_type()->is_float();
+                        size_t next = 0;
+                        for (const Mir::Init::Array::Run &run : array->get_runs()) {
+                            zeros((run.offset - next) * element_size);
+                            for (const std::shared_ptr<Mir::Value> &element : run.values) {
+                                const eval_t value = std::static_pointer_cast<Mir::Const>(element)->get_constant_value();
+                                word(is_float ? float_to_word(static_cast<double>(value)) : static_cast<int32_t>(value));
+                            }
+                            next = run.end();
+                        }
+                        zeros((length - next) * element_size);
+                    } else {
+                        for (const std::shared_ptr<Backend::Constant> &constant : std::static_pointer_cast<Constants>(init_value)->constants) {
+                            if (const auto int_value = std::dynamic_pointer_cast<Backend::IntValue>(constant))
+                                word(int_value->int32_value);
+                            else if (const auto float_value = std::dynamic_pointer_cast<Backend::FloatValue>(constant))
+                                word(float_to_word(float_value->float_value));
+                            else if (const auto int_multi_zero = std::dynamic_pointer_cast<Backend::IntMultiZero>(constant))
+                                zeros(int_multi_zero->zero_count * element_size);
+                            else if (const auto float_multi_zero = std::dynamic_pointer_cast<Backend::FloatMultiZero>(constant))
+                                zeros(float_multi_zero->zero_count * element_size);
+                        }
+                    }
+                    if (repeat > 0)
+                        on_words(last_word, repeat);
+                    if (zero_bytes > 0)
+                        on_zero(zero_bytes);
+                }
+
+                // Whether every byte of the initializer is zero, i.e. the variable can live in `.bss`.
+                [[nodiscard]] bool zero_initialized() const;
+
                 void load_from_llvm(const std::shared_ptr<Mir::Init::Constant> &value);
                 void load_from_llvm(const std::shared_ptr<Mir::Init::Array> &value);
 
@@ -52,11 +133,18 @@ class Backend::DataSection {
 
                 explicit Variable(const std::string &name, const Backend::VariableType &type) : Backend::Variable(name, type, Backend::VariableWide::GLOBAL) {};
             private:
+                static int32_t float_to_word(const double value) {
+                    const float f = static_cast<float>(value);
+                    int32_t word;
+                    std::memcpy(&word, &f, sizeof(word));
+                    return word;
+                }
+
                 /*
-                 * Convert a `Mir::Init::Constant` value to `Backend::Constant`.
+                 * Convert a constant element of the given atomic type to `Backend::Constant`.
                  * Support only `ConstInt` and `ConstFloat`.
                  */
-                std::shared_ptr<Backend::Constant> load_from_llvm_(const std::shared_ptr<Mir::Init::Constant> &value);
+                std::shared_ptr<Backend::Constant> load_from_llvm_(const std::shared_ptr<Mir::Type::Type> &type, const std::shared_ptr<Mir::Value> &value);
         };
 
         std::unordered_map<std::string, std::shared_ptr<Variable>> global_variables;
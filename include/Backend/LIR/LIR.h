@@ -8,6 +8,7 @@
 #include <vector>
 #include <unordered_set>
 #include <sstream>
+#include "Backend/BitSet.h"
 #include "Backend/LIR/DataSection.h"
 #include "Backend/VariableTypes.h"
 #include "Backend/Value.h"
@@ -16,6 +17,7 @@
 #include "Pass/Analysis.h"
 #include "Pass/Analyses/ControlFlowGraph.h"
 #include "Utils/Log.h"
+#include "Utils/OutputSink.h"
 
 namespace Backend::LIR {
     class Module;
@@ -187,11 +189,37 @@ namespace Backend::Utils {
         }
     }
 
-    [[nodiscard]] inline std::string unique_name(const std::string &prefix = "") {
+    inline size_t &module_name_counter() {
         static size_t counter = 0;
+        return counter;
+    }
+
+    inline size_t *&scoped_name_counter() {
+        static thread_local size_t *counter = nullptr;
+        return counter;
+    }
+
+    [[nodiscard]] inline std::string unique_name(const std::string &prefix = "") {
+        size_t *const scoped = scoped_name_counter();
+        size_t &counter = scoped != nullptr ? *scoped : module_name_counter();
         return "%%" + prefix + std::to_string(counter++);
     }
 
+    /*
+     * Temporaries created after lowering only need names unique inside their function.
+     * While a scope is alive, `unique_name` on this thread counts on the function's own counter, so the names
+     * do not depend on which thread handles the function or in which order the functions are handled.
+     */
+    class NameScope {
+        public:
+            explicit NameScope(size_t &counter) : previous(scoped_name_counter()) { scoped_name_counter() = &counter; }
+            ~NameScope() { scoped_name_counter() = previous; }
+            NameScope(const NameScope &) = delete;
+            NameScope &operator=(const NameScope &) = delete;
+        private:
+            size_t *previous;
+    };
+
     [[nodiscard]] inline Backend::LIR::InstructionType cmp_to_lir(const Backend::Comparison::Type type) {
         switch (type) {
             case Backend::Comparison::Type::EQUAL: return Backend::LIR::InstructionType::EQUAL;
@@ -254,8 +282,9 @@ class Backend::LIR::Block {
         std::vector<std::shared_ptr<Backend::LIR::Block>> successors;
         std::weak_ptr<Backend::LIR::Function> parent_function;
 
-        std::unordered_set<std::string> live_in;
-        std::unordered_set<std::string> live_out;
+        // indexed by `Backend::Variable::index` of the parent function
+        Backend::BitSet live_in;
+        Backend::BitSet live_out;
 
         explicit Block(const std::string &block_name) : name(std::move(block_name)) {};
         explicit Block(const std::string &&block_name) : name(std::move(block_name)) {};
@@ -269,6 +298,8 @@ class Backend::LIR::Function {
         std::vector<std::shared_ptr<Backend::LIR::Block>> blocks;
         Backend::VariableType return_type{Backend::VariableType::INT32};
         std::map<std::string, std::shared_ptr<Backend::Variable>> variables;
+        // variables indexed by `Backend::Variable::index`, removed slots are left as `nullptr`
+        std::vector<std::shared_ptr<Backend::Variable>> variable_list;
         std::vector<std::shared_ptr<Backend::Variable>> parameters;
         FunctionType function_type{FunctionType::UNPRIVILEGED};
 
@@ -279,14 +310,38 @@ class Backend::LIR::Function {
         virtual ~Function() = default;
 
         void add_variable(const std::shared_ptr<Backend::Variable> &variable) {
-            if (variables.find(variable->name) == variables.end())
+            std::map<std::string, std::shared_ptr<Backend::Variable>>::const_iterator it = variables.find(variable->name);
+            if (it == variables.end()) {
+                variable->index = variable_list.size();
+                variable_list.push_back(variable);
                 variables[variable->name] = variable;
+            } else variable->index = it->second->index; // variables are identified by name
         }
 
         void remove_variable(const std::shared_ptr<Backend::Variable> &variable) {
-            variables.erase(variable->name);
+            std::map<std::string, std::shared_ptr<Backend::Variable>>::iterator it = variables.find(variable->name);
+            if (it != variables.end()) {
+                variable_list[it->second->index] = nullptr;
+                variables.erase(it);
+            }
         }
 
+        /*
+         * Dense index of `variable` in this function, `Backend::Variable::no_index` if it is not registered here.
+         * Falls back to a lookup by name for variables created without `add_variable`.
+         */
+        [[nodiscard]] size_t index_of(const Backend::Variable &variable) const {
+            if (variable.index < variable_list.size()) {
+                const std::shared_ptr<Backend::Variable> &slot = variable_list[variable.index];
+                if (slot.get() == &variable || (slot && slot->name == variable.name))
+                    return variable.index;
+            }
+            std::map<std::string, std::shared_ptr<Backend::Variable>>::const_iterator it = variables.find(variable.name);
+            return it != variables.end() ? it->second->index : Backend::Variable::no_index;
+        }
+
+        [[nodiscard]] inline size_t variable_count() const { return variable_list.size(); }
+
         [[nodiscard]] std::shared_ptr<Backend::Variable> find_variable(const std::string &name) const {
             std::map<std::string, std::shared_ptr<Backend::Variable>>::const_iterator it = variables.find(name);
             if (it != variables.end()) {
@@ -302,19 +357,34 @@ class Backend::LIR::Function {
 
         template <typename T_store, typename T_load>
         void spill(std::shared_ptr<Backend::Variable> &local_variable);
+        /*
+         * Split `local_variable` at `from`: every use from `from` on is reloaded from `slot`, earlier uses keep
+         * reading the register. Every definition stays in the register and is also written to `slot`, so both agree
+         * wherever control flow enters the reloaded part.
+         */
+        template <typename T_store, typename T_load>
+        void split(const std::shared_ptr<Backend::Variable> &local_variable, const std::shared_ptr<Backend::Variable> &slot, const Backend::LIR::Instruction *from);
+        /*
+         * Compute `live_in`/`live_out` of every block for variables accepted by `is_consistent`.
+         * Shared by the integer and float allocators, and by any pass that needs liveness.
+         */
         template<bool (*is_consistent)(const Backend::VariableType &type)>
         void analyze_live_variables();
+        // Blocks reachable from the entry block in reverse post order.
+        [[nodiscard]] std::vector<std::shared_ptr<Backend::LIR::Block>> reverse_post_order() const;
 
         [[nodiscard]] std::string to_string() const {
-            std::ostringstream oss;
-            oss << "Function: " << name << "\n";
+            return ::Utils::print_to_string([this](::Utils::OutputSink &out) { print(out); });
+        }
+
+        void print(::Utils::OutputSink &out) const {
+            out << "Function: " << name << "\n";
             for (const std::shared_ptr<Backend::LIR::Block> &block : blocks) {
-                oss << "  " << block->name << "\n";
+                out << "  " << block->name << "\n";
                 for (const auto &instr : block->instructions) {
-                    oss << "    " << instr->to_string() << "\n";
+                    out << "    " << instr->to_string() << "\n";
                 }
             }
-            return oss.str();
         }
 
         [[nodiscard]] std::string live_variables() {
@@ -323,21 +393,14 @@ class Backend::LIR::Function {
             for (const std::shared_ptr<Backend::LIR::Block> &block: blocks) {
                 oss << "\nBlock: " << block->name << "\n";
                 oss << "  Live In: ";
-                for (const std::string &var_name : block->live_in) {
-                    oss << var_name << " ";
-                }
+                block->live_in.for_each([&](const size_t index) { oss << variable_list[index]->name << " "; });
                 oss << "\n";
                 oss << "  Live Out: ";
-                for (const std::string &var_name : block->live_out) {
-                    oss << var_name << " ";
-                }
+                block->live_out.for_each([&](const size_t index) { oss << variable_list[index]->name << " "; });
             }
             oss << "\n";
             return oss.str();
         }
-    private:
-        template<bool (*is_consistent)(const Backend::VariableType &type)>
-        bool analyze_live_variables(std::shared_ptr<Backend::LIR::Block> &block, std::unordered_set<std::string> &visited);
 };
 
 class Backend::LIR::PrivilegedFunction : public Backend::LIR::Function {
@@ -390,10 +453,15 @@ class Backend::LIR::Module : public std::enable_shared_from_this<Backend::LIR::M
         }
 
         [[nodiscard]] std::string to_string() const {
-            std::ostringstream oss;
-            for (const std::shared_ptr<Backend::LIR::Function> &function : functions)
-                oss << function->to_string() << "\n";
-            return oss.str();
+            return ::Utils::print_to_string([this](::Utils::OutputSink &out) { print(out); });
+        }
+
+        // Writes function by function into `out` instead of building the whole module as one string.
+        void print(::Utils::OutputSink &out) const {
+            for (const std::shared_ptr<Backend::LIR::Function> &function : functions) {
+                function->print(out);
+                out << "\n";
+            }
         }
     private:
         const std::shared_ptr<Pass::ControlFlowGraph> cfg;
@@ -483,9 +551,10 @@ class Backend::LIR::Module : public std::enable_shared_from_this<Backend::LIR::M
          */
         void clear_variables(std::shared_ptr<Backend::LIR::Function> &lir_function) {
             for (std::map<std::string, std::shared_ptr<Backend::Variable>>::iterator it = lir_function->variables.begin(); it != lir_function->variables.end(); )
-                if (it->second->var_type == Backend::Variable::Type::PTR || it->second->var_type == Backend::Variable::Type::CMP)
+                if (it->second->var_type == Backend::Variable::Type::PTR || it->second->var_type == Backend::Variable::Type::CMP) {
+                    lir_function->variable_list[it->second->index] = nullptr;
                     it = lir_function->variables.erase(it);
-                else it++;
+                } else it++;
         }
 
         template<typename StoreInst, Backend::VariableType PTR>
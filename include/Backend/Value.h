@@ -87,10 +87,13 @@ class Backend::Variable : public Backend::Operand {
         enum class Type : uint32_t {
             OBJ, PTR, CMP
         };
+        static constexpr size_t no_index = static_cast<size_t>(-1);
         Type var_type{Type::OBJ};
         Backend::VariableType workload_type;
         VariableWide lifetime;
         size_t length{1};
+        // dense index inside the owning function, assigned by `LIR::Function::add_variable`
+        size_t index{no_index};
         explicit Variable(const std::string &name, const Backend::VariableType &type, VariableWide lifetime) : Backend::Operand(name, OperandType::VARIABLE), workload_type(type), lifetime(lifetime) {}
         explicit Variable(const std::string &name, const Backend::VariableType &type, VariableWide position, size_t length) : Backend::Operand(name, OperandType::VARIABLE), workload_type(type), lifetime(position), length(length) {}
         virtual ~Variable() = default;
@@ -4,17 +4,25 @@
 // ReSharper disable CppUnusedIncludeDirective
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "Frontend/Lexer.h"
 #include "Frontend/Parser.h"
+#include "Frontend/SourceBuffer.h"
 #include "Mir/Builder.h"
 #include "Mir/Value.h"
 #include "Pass/Analysis.h"
+#include "Pass/Pipeline.h"
 #include "Pass/Transform.h"
 #include "Pass/Util.h"
 #include "Utils/Log.h"
+#include "Utils/OutputSink.h"
+#include "Utils/ThreadPool.h"
+#include "Utils/TimeReport.h"
+#include "Utils/Trace.h"
 #include "Backend/InstructionSets/RISC-V/Assembler.h"
 
 enum class Optimize_level { O0, O1, O2 };
@@ -40,6 +48,28 @@ struct compiler_options {
     std::string input_file;
     emit_options _emit_options;
     Optimize_level opt_level = default_opt_level;
+    // 是否为IR节点启用模块级内存池
+    bool ir_arena = true;
+    // 编译结束后向stderr输出统计信息
+    bool print_stats = false;
+    // 编译结束后向stderr输出各变换与后端阶段的耗时，指定文件时同时写入JSON格式的记录
+    bool time_report = false;
+    std::string time_report_file;
+    // 非空时把各阶段、变换、函数与寄存器分配轮次的区间以 Chrome trace_event 格式写入该文件
+    std::string trace_file;
+    // 非空时代替优化等级决定的流水线，语法见 Pass::Pipeline
+    std::string passes;
+    // 寄存器分配算法，未指定时由优化等级决定
+    std::optional<RISCV::RegisterAllocator::AllocationType> register_allocator;
+    // 按函数在线程池上并行执行函数内的变换
+    bool parallel_passes = false;
+    // 并行使用的线程数；-fparallel-passes 在未指定时使用硬件线程数，后端只在指定时按函数并行
+    std::optional<size_t> jobs;
+
+    // -O0 使用线性扫描，其余使用图着色
+    [[nodiscard]] RISCV::RegisterAllocator::AllocationType allocation_type() const;
+
+    [[nodiscard]] size_t worker_threads() const;
 
     void print() const;
 };
@@ -47,31 +77,34 @@ struct compiler_options {
 // cmake设置为Debug时的编译选项
 extern const compiler_options debug_compile_options;
 
+// content 为字符串，或是形如 void(Utils::OutputSink &) 的打印函数，后者直接写入输出，不必先拼出整个字符串
+// filename 为空时输出到标准输出
 template<typename T>
 void emit_output(const std::string &filename, const T &content) {
-    std::ostream *out = &std::cout;
-    std::ofstream file_stream;
-    if (!filename.empty()) {
-        file_stream.open(filename);
-        if (!file_stream) {
-            log_error("Failed to open file: %s", filename.c_str());
-        }
-        out = &file_stream;
-    }
-    *out << content << std::endl;
-    if (file_stream.is_open()) {
-        file_stream.close();
+    Utils::OutputSink out{filename};
+    if constexpr (std::is_invocable_v<const T &, Utils::OutputSink &>) {
+        content(out);
+    } else {
+        out << content;
     }
+    out << '\n';
+    out.close();
 }
 
 void emit_tokens(const std::vector<Token::Token> &tokens, const emit_options &options);
 
-void emit_ast(const std::shared_ptr<AST::CompUnit> &ast, const emit_options &options);
+void emit_ast(const AST::CompUnit *ast, const emit_options &options);
 
 void emit_llvm(const std::shared_ptr<Mir::Module> &module, const emit_options &options);
 
 void emit_riscv(const RISCV::Assembler &assembler, const compiler_options &options);
 
+void emit_statistics(const std::shared_ptr<Mir::Module> &module, const compiler_options &options);
+
+void emit_time_report(const compiler_options &options);
+
+void emit_trace(const compiler_options &options);
+
 void usage(const char *prog_name);
 
 compiler_options parse_args(int argc, char *argv[]);
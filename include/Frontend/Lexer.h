@@ -1,40 +1,23 @@
 #ifndef LEXER_H
 #define LEXER_H
 
-#include <unordered_map>
-#include <unordered_set>
-#include <utility>
+#include <string_view>
 #include <vector>
 
 #include "Utils/Token.h"
 
 class Lexer {
-    // 以字符串形式保存到源程序
-    std::string input;
+    // 源程序，由调用者（通常是 SourceBuffer）持有，所有 Token 都指向其中
+    std::string_view input;
     // 当前指针位置
     size_t pos;
     // 当前行数
     int line;
-    // 解析得到的Token列表
+    // tokenize 得到的Token列表
     std::vector<Token::Token> tokens;
 
-    // 关键词集合
-    std::unordered_set<std::string> keywords = {"const", "int",   "float",    "void",   "if",  "else",
-                                                "while", "break", "continue", "return", "putf"};
-
-    // 运算符和分隔符映射
-    std::unordered_map<std::string, Token::Type> operators = {
-            {"+", Token::Type::ADD},      {"-", Token::Type::SUB},     {"!", Token::Type::NOT},
-            {"*", Token::Type::MUL},      {"/", Token::Type::DIV},     {"%", Token::Type::MOD},
-            {"<", Token::Type::LT},       {">", Token::Type::GT},      {"<=", Token::Type::LE},
-            {">=", Token::Type::GE},      {"==", Token::Type::EQ},     {"!=", Token::Type::NE},
-            {"&&", Token::Type::AND},     {"||", Token::Type::OR},     {";", Token::Type::SEMICOLON},
-            {",", Token::Type::COMMA},    {"=", Token::Type::ASSIGN},  {"(", Token::Type::LPAREN},
-            {")", Token::Type::RPAREN},   {"{", Token::Type::LBRACE},  {"}", Token::Type::RBRACE},
-            {"[", Token::Type::LBRACKET}, {"]", Token::Type::RBRACKET}};
-
-    // 查看当前位置的字符
-    char peek() const { return input[pos]; }
+    // 查看当前位置的字符，越界时返回 '\0'
+    char peek() const { return pos < input.length() ? input[pos] : '\0'; }
 
     // 查看下一个字符
     char peek_next() const {
@@ -52,12 +35,11 @@ class Lexer {
         return current;
     }
 
+    // 从 start 到当前位置的片段
+    std::string_view lexeme(const size_t start) const { return input.substr(start, pos - start); }
+
     // 跳过空白符
-    void consume_whitespace() {
-        while (pos < input.length() && isspace(peek())) {
-            advance();
-        }
-    }
+    void consume_whitespace();
 
     // 跳过单行注释
     void consume_line_comment();
@@ -68,7 +50,7 @@ class Lexer {
     // 识别标识符或关键词
     Token::Token consume_ident_or_keyword();
 
-    // 识别数字（整数或浮点数）
+    // 识别数字（整数或浮点数），只确定其范围，数值由 int_value 与 float_literal 在语法分析时转换
     Token::Token consume_number();
 
     // 识别字符串
@@ -77,36 +59,20 @@ class Lexer {
     // 识别运算符或未知字符
     Token::Token consume_operator();
 
-    // 将关键词字符串转换为TokenType
-    static Token::Type string_to_type(const std::string &str) {
-        if (str == "const")
-            return Token::Type::CONST;
-        if (str == "int")
-            return Token::Type::INT;
-        if (str == "float")
-            return Token::Type::FLOAT;
-        if (str == "void")
-            return Token::Type::VOID;
-        if (str == "if")
-            return Token::Type::IF;
-        if (str == "else")
-            return Token::Type::ELSE;
-        if (str == "while")
-            return Token::Type::WHILE;
-        if (str == "break")
-            return Token::Type::BREAK;
-        if (str == "continue")
-            return Token::Type::CONTINUE;
-        if (str == "return")
-            return Token::Type::RETURN;
-        return Token::Type::IDENTIFIER;
-    }
-
 public:
-    explicit Lexer(std::string src) : input(std::move(src)), pos(0), line(1) {}
+    explicit Lexer(const std::string_view src) : input(src), pos(0), line(1) {}
+
+    // 读取下一个Token，到达末尾后总是返回 END_OF_FILE
+    Token::Token next_token();
 
-    // 获取分割好的Token列表
+    // 一次读完并获取分割好的Token列表，仅在需要输出全部Token时使用
     const std::vector<Token::Token> &tokenize();
+
+    // 整数字面量（十进制、八进制或十六进制）的值，超出 int 范围时 log_fatal
+    static int int_value(std::string_view literal);
+
+    // 将浮点字面量规整为 AST::FloatNumber 接受的形式：十六进制保持原样，十进制保留 12 位有效数字
+    static std::string float_literal(std::string_view literal);
 };
 
 #endif
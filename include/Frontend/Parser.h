@@ -1,19 +1,46 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include "Frontend/TokenStream.h"
 #include "Utils/AST.h"
+#include "Utils/SmallVector.h"
 #include "Utils/Token.h"
 
 class Parser {
-    // lexer得到的
-    const std::vector<Token::Token> tokens;
+    // 边解析边从lexer读取Token
+    TokenStream tokens;
+    // 结点分配在调用者提供的arena上
+    AST::Arena &arena;
     // 当前指针位置
     size_t pos;
+    // 尚未结束的回溯起点，从最早的起点开始的Token都须保留
+    std::vector<size_t> marks;
+
     // 当前字符
-    [[nodiscard]] Token::Token peek() const { return tokens.at(pos); }
+    [[nodiscard]] Token::Token peek() { return tokens.at(pos); }
 
     // 向前(后)读n个字符
-    [[nodiscard]] Token::Token next(const int offset = 1) const { return tokens.at(pos + offset); }
+    [[nodiscard]] Token::Token next(const int offset = 1) { return tokens.at(pos + offset); }
+
+    // pos向前移动，此后只会访问前一个及之后的Token
+    void advance() {
+        ++pos;
+        const size_t keep = marks.empty() ? pos : std::min(pos, marks.front());
+        tokens.discard_before(keep > 0 ? keep - 1 : 0);
+    }
+
+    // 记录当前位置，之后以 rewind 回到此处或以 release 放弃回溯
+    size_t mark() {
+        marks.push_back(pos);
+        return pos;
+    }
+
+    void rewind(const size_t position) {
+        pos = position;
+        release();
+    }
+
+    void release() { marks.pop_back(); }
 
     // 如果该位置不是符合要求的Token，抛出异常；否则pos向前移动
     template<typename... Types>
@@ -23,68 +50,68 @@ class Parser {
     template<typename... Types>
     bool match(Types... expected_types);
 
-    std::shared_ptr<AST::CompUnit> parseCompUnit();
+    const AST::CompUnit *parseCompUnit();
 
-    std::shared_ptr<AST::Decl> parseDecl();
+    const AST::Decl *parseDecl();
 
-    std::shared_ptr<AST::ConstDecl> parseConstDecl();
+    const AST::ConstDecl *parseConstDecl();
 
-    std::shared_ptr<AST::ConstDef> parseConstDef();
+    const AST::ConstDef *parseConstDef();
 
-    std::shared_ptr<AST::ConstInitVal> parseConstInitVal();
+    const AST::ConstInitVal *parseConstInitVal();
 
-    std::shared_ptr<AST::VarDecl> parseVarDecl();
+    const AST::VarDecl *parseVarDecl();
 
-    std::shared_ptr<AST::VarDef> parseVarDef();
+    const AST::VarDef *parseVarDef();
 
-    std::shared_ptr<AST::InitVal> parseInitVal();
+    const AST::InitVal *parseInitVal();
 
-    std::shared_ptr<AST::FuncDef> parseFuncDef();
+    const AST::FuncDef *parseFuncDef();
 
-    std::shared_ptr<AST::FuncFParam> parseFuncFParam();
+    const AST::FuncFParam *parseFuncFParam();
 
-    std::shared_ptr<AST::Block> parseBlock();
+    const AST::Block *parseBlock();
 
-    std::shared_ptr<AST::Stmt> parseStmt();
+    const AST::Stmt *parseStmt();
 
-    std::shared_ptr<AST::ReturnStmt> parseReturnStmt();
+    const AST::ReturnStmt *parseReturnStmt();
 
-    std::shared_ptr<AST::IfStmt> parseIfStmt();
+    const AST::IfStmt *parseIfStmt();
 
-    std::shared_ptr<AST::WhileStmt> parseWhileStmt();
+    const AST::WhileStmt *parseWhileStmt();
 
-    std::shared_ptr<AST::Exp> parseExp();
+    const AST::Exp *parseExp();
 
-    std::shared_ptr<AST::Cond> parseCond();
+    const AST::Cond *parseCond();
 
-    std::shared_ptr<AST::LVal> parseLVal();
+    const AST::LVal *parseLVal();
 
-    std::shared_ptr<AST::PrimaryExp> parsePrimaryExp();
+    const AST::PrimaryExp *parsePrimaryExp();
 
-    [[nodiscard]] std::shared_ptr<AST::Number> parseNumber() const;
+    [[nodiscard]] const AST::Number *parseNumber();
 
-    std::shared_ptr<AST::UnaryExp> parseUnaryExp();
+    const AST::UnaryExp *parseUnaryExp();
 
-    std::shared_ptr<AST::MulExp> parseMulExp();
+    const AST::MulExp *parseMulExp();
 
-    std::shared_ptr<AST::AddExp> parseAddExp();
+    const AST::AddExp *parseAddExp();
 
-    std::shared_ptr<AST::RelExp> parseRelExp();
+    const AST::RelExp *parseRelExp();
 
-    std::shared_ptr<AST::EqExp> parseEqExp();
+    const AST::EqExp *parseEqExp();
 
-    std::shared_ptr<AST::LAndExp> parseLAndExp();
+    const AST::LAndExp *parseLAndExp();
 
-    std::shared_ptr<AST::LOrExp> parseLOrExp();
+    const AST::LOrExp *parseLOrExp();
 
-    std::shared_ptr<AST::ConstExp> parseConstExp();
+    const AST::ConstExp *parseConstExp();
 
 public:
-    explicit Parser(const std::vector<Token::Token> &tokens) : tokens{tokens}, pos{0} {}
+    Parser(Lexer &lexer, AST::Arena &arena) : tokens{lexer}, arena{arena}, pos{0} {}
 
-    std::shared_ptr<AST::CompUnit> parse() { return parseCompUnit(); }
+    const AST::CompUnit *parse() { return parseCompUnit(); }
 
-    [[nodiscard]] bool eof() const { return tokens[pos].type == Token::Type::END_OF_FILE; }
+    [[nodiscard]] bool eof() { return peek().type == Token::Type::END_OF_FILE; }
 };
 
 #endif // PARSER_H
@@ -0,0 +1,29 @@
+#ifndef SOURCEBUFFER_H
+#define SOURCEBUFFER_H
+
+#include <string>
+#include <string_view>
+
+// 只读的源程序缓冲区，Token 的内容均指向其中，因此它必须比 Token 与 AST 活得更久
+// 普通文件直接映射到内存，无法映射时（如管道、空文件）退化为整体读入
+class SourceBuffer {
+    const char *data_{nullptr};
+    size_t size_{0};
+    // 映射的起始地址，为空表示内容保存在 fallback_ 中
+    void *mapping_{nullptr};
+    std::string fallback_;
+
+public:
+    // 打开失败时 log_fatal
+    explicit SourceBuffer(const std::string &path);
+
+    ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer &) = delete;
+
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    [[nodiscard]] std::string_view view() const { return {data_, size_}; }
+};
+
+#endif // SOURCEBUFFER_H
@@ -0,0 +1,44 @@
+#ifndef TOKENSTREAM_H
+#define TOKENSTREAM_H
+
+#include <algorithm>
+#include <vector>
+
+#include "Frontend/Lexer.h"
+#include "Utils/Log.h"
+
+// 按需从 Lexer 读取 Token 的前瞻窗口，Token 按读出的顺序从 0 开始编号
+// 窗口是容量为 2 的幂的环形缓冲区，保存编号在 [first_, first_ + size_) 内的 Token
+// 调用者通过 discard_before 声明不再访问的 Token：窗口已满时优先丢弃它们，否则扩容
+class TokenStream {
+    Lexer &lexer_;
+    std::vector<Token::Token> ring_;
+    size_t first_{0};
+    size_t size_{0};
+    // 编号小于它的 Token 可以丢弃
+    size_t discardable_{0};
+
+    // 从 Lexer 再读入一个 Token
+    void fill();
+
+    void grow();
+
+public:
+    explicit TokenStream(Lexer &lexer, size_t capacity = 8);
+
+    // 编号为 index 的 Token，必要时继续从 Lexer 读取；读到文件末尾后总是返回 END_OF_FILE
+    // 返回的引用在下一次调用前有效
+    const Token::Token &at(const size_t index) {
+        if (index < first_) [[unlikely]] {
+            log_error("Token %zu has been discarded", index);
+        }
+        while (index >= first_ + size_) {
+            fill();
+        }
+        return ring_[index & (ring_.size() - 1)];
+    }
+
+    void discard_before(const size_t index) { discardable_ = std::max(discardable_, index); }
+};
+
+#endif // TOKENSTREAM_H
@@ -0,0 +1,117 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace Mir {
+// 以模块为生命周期的内存池，IR节点（连同 shared_ptr 的控制块）在大块内存上连续分配
+// 小对象按 16 字节划分尺寸档，释放后挂到对应档位的空闲链表上复用；所有内存在模块销毁后一次性归还
+class Arena {
+public:
+    struct Statistics {
+        size_t allocations{0};
+        size_t reused{0};
+        size_t deallocations{0};
+        size_t live{0};
+        size_t peak_live{0};
+        size_t bytes_allocated{0};
+        size_t bytes_reserved{0};
+        size_t chunks{0};
+    };
+
+    Arena() = default;
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+
+    void *allocate(size_t size, size_t align);
+
+    void deallocate(void *ptr, size_t size) noexcept;
+
+    // 由所属模块在析构时调用
+    // 若仍有节点存活（如被静态缓存或循环引用持有），则推迟到最后一个节点释放时再归还内存
+    void release() noexcept;
+
+    [[nodiscard]] const Statistics &statistics() const { return statistics_; }
+
+    [[nodiscard]] std::string statistics_string() const;
+
+    // 当前用于分配IR节点的arena，为nullptr时退回到普通的堆分配
+    [[nodiscard]] static Arena *active() { return active_; }
+
+    static void set_active(Arena *arena) { active_ = arena; }
+
+private:
+    static constexpr size_t chunk_size = 1 << 20;
+    static constexpr size_t granularity = 16;
+    static constexpr size_t max_small_size = 512;
+
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    static Arena *active_;
+
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    std::byte *cursor_{nullptr};
+    std::byte *limit_{nullptr};
+    std::array<FreeNode *, max_small_size / granularity + 1> free_lists_{};
+    bool orphaned_{false};
+    Statistics statistics_;
+    // 按函数并行执行变换时，多个线程同时创建与释放IR节点
+    std::mutex mutex_;
+
+    static size_t size_class(const size_t size) { return (size + granularity - 1) / granularity; }
+
+    void *bump(size_t size, size_t align);
+};
+
+// 供 std::allocate_shared 使用的分配器
+template<typename T>
+class ArenaAllocator {
+    template<typename>
+    friend class ArenaAllocator;
+
+    Arena *arena_;
+
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena *arena) : arena_{arena} {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena_{other.arena_} {} // NOLINT
+
+    T *allocate(const size_t n) { return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T))); }
+
+    void deallocate(T *ptr, const size_t n) noexcept { arena_->deallocate(ptr, n * sizeof(T)); }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+        return arena_ == other.arena_;
+    }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const {
+        return arena_ != other.arena_;
+    }
+};
+
+// 创建IR节点：存在活动的arena时在其上分配，否则退化为 std::make_shared
+template<typename T, typename... Args>
+std::shared_ptr<T> make_ir(Args &&...args) {
+    if (const auto arena{Arena::active()}) [[likely]] {
+        return std::allocate_shared<T>(ArenaAllocator<T>{arena}, std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+}
+} // namespace Mir
+
+#endif
@@ -11,92 +11,116 @@
 
 namespace Mir {
 class Builder {
-    static size_t variable_count, block_count;
+    // 不在任何函数的作用域内时（构建全局变量、串行执行的模块级变换）使用的计数器
+    static NameCounter module_count;
     bool is_global{false};
     std::shared_ptr<Module> module = std::make_shared<Module>();
     std::shared_ptr<Symbol::Table> table = std::make_shared<Symbol::Table>();
     std::shared_ptr<Function> cur_function;
     std::shared_ptr<Block> cur_block;
     std::vector<std::tuple<std::shared_ptr<Block>, std::shared_ptr<Block>, std::shared_ptr<Block>>> loop_stats{};
-    std::vector<std::shared_ptr<AST::Cond>> cond_stats{};
+    std::vector<const AST::Cond *> cond_stats{};
 
 public:
     explicit Builder() { table->push_scope(); }
 
-    static std::string gen_variable_name() { return "%" + std::to_string(variable_count++); }
-
-    static std::string gen_block_name() { return "block_" + std::to_string(block_count++); }
+    static NameCounter *&scoped_count() {
+        static thread_local NameCounter *counter = nullptr;
+        return counter;
+    }
 
-    static void reset_count() {
-        variable_count = 0;
-        block_count = 0;
+    static NameCounter &current_count() {
+        NameCounter *const scoped = scoped_count();
+        return scoped != nullptr ? *scoped : module_count;
     }
 
-    [[nodiscard]] std::shared_ptr<Module> &visit(const std::shared_ptr<AST::CompUnit> &ast);
+    static std::string gen_variable_name() { return "%" + std::to_string(current_count().variable++); }
+
+    static std::string gen_block_name() { return "block_" + std::to_string(current_count().block++); }
+
+    // 只清零当前作用域的计数器，不影响其它线程正在处理的函数
+    static void reset_count() { current_count() = {}; }
+
+    // 作用域内当前线程生成的名字都来自 func 自己的计数器，离开时（包括异常退出）恢复之前的计数器
+    class NameScope {
+    public:
+        explicit NameScope(const Function &func) : previous{scoped_count()} { scoped_count() = &func.name_counter(); }
+
+        ~NameScope() { scoped_count() = previous; }
+
+        NameScope(const NameScope &) = delete;
+
+        NameScope &operator=(const NameScope &) = delete;
+
+    private:
+        NameCounter *const previous;
+    };
+
+    [[nodiscard]] std::shared_ptr<Module> &visit(const AST::CompUnit *ast);
 
-    void visit_decl(const std::shared_ptr<AST::Decl> &decl) const;
+    void visit_decl(const AST::Decl *decl) const;
 
-    void visit_constDecl(const std::shared_ptr<AST::ConstDecl> &constDecl) const;
+    void visit_constDecl(const AST::ConstDecl *constDecl) const;
 
-    void visit_constDef(Token::Type type, const std::shared_ptr<AST::ConstDef> &constDef) const;
+    void visit_constDef(Token::Type type, const AST::ConstDef *constDef) const;
 
-    void visit_varDecl(const std::shared_ptr<AST::VarDecl> &varDecl) const;
+    void visit_varDecl(const AST::VarDecl *varDecl) const;
 
-    void visit_varDef(Token::Type type, const std::shared_ptr<AST::VarDef> &varDef) const;
+    void visit_varDef(Token::Type type, const AST::VarDef *varDef) const;
 
-    void visit_funcDef(const std::shared_ptr<AST::FuncDef> &funcDef);
+    void visit_funcDef(const AST::FuncDef *funcDef);
 
     [[nodiscard]] std::pair<std::string, std::shared_ptr<Type::Type>>
-    visit_funcFParam(const std::shared_ptr<AST::FuncFParam> &funcFParam) const;
+    visit_funcFParam(const AST::FuncFParam *funcFParam) const;
 
-    void visit_block(const std::shared_ptr<AST::Block> &block);
+    void visit_block(const AST::Block *block);
 
-    void visit_stmt(const std::shared_ptr<AST::Stmt> &stmt);
+    void visit_stmt(const AST::Stmt *stmt);
 
-    void visit_assignStmt(const std::shared_ptr<AST::AssignStmt> &assignStmt) const;
+    void visit_assignStmt(const AST::AssignStmt *assignStmt) const;
 
-    void visit_expStmt(const std::shared_ptr<AST::ExpStmt> &expStmt) const;
+    void visit_expStmt(const AST::ExpStmt *expStmt) const;
 
-    void visit_blockStmt(const std::shared_ptr<AST::BlockStmt> &blockStmt);
+    void visit_blockStmt(const AST::BlockStmt *blockStmt);
 
-    void visit_ifStmt(const std::shared_ptr<AST::IfStmt> &ifStmt);
+    void visit_ifStmt(const AST::IfStmt *ifStmt);
 
-    void visit_whileStmt(const std::shared_ptr<AST::WhileStmt> &whileStmt);
+    void visit_whileStmt(const AST::WhileStmt *whileStmt);
 
     void visit_breakStmt();
 
     void visit_continueStmt();
 
-    void visit_returnStmt(const std::shared_ptr<AST::ReturnStmt> &returnStmt) const;
+    void visit_returnStmt(const AST::ReturnStmt *returnStmt) const;
 
-    std::shared_ptr<Value> visit_exp(const std::shared_ptr<AST::Exp> &exp) const; // NOLINT(*-use-nodiscard)
+    std::shared_ptr<Value> visit_exp(const AST::Exp *exp) const; // NOLINT(*-use-nodiscard)
 
-    void visit_cond(const std::shared_ptr<AST::Cond> &cond, const std::shared_ptr<Block> &_then,
+    void visit_cond(const AST::Cond *cond, const std::shared_ptr<Block> &_then,
                     const std::shared_ptr<Block> &_else);
 
-    [[nodiscard]] std::shared_ptr<Value> visit_lVal(const std::shared_ptr<AST::LVal> &lVal,
+    [[nodiscard]] std::shared_ptr<Value> visit_lVal(const AST::LVal *lVal,
                                                     bool get_address = false) const;
 
-    [[nodiscard]] static std::shared_ptr<Value> visit_number(const std::shared_ptr<AST::Number> &number);
+    [[nodiscard]] static std::shared_ptr<Value> visit_number(const AST::Number *number);
 
-    [[nodiscard]] std::shared_ptr<Value> visit_primaryExp(const std::shared_ptr<AST::PrimaryExp> &primaryExp) const;
+    [[nodiscard]] std::shared_ptr<Value> visit_primaryExp(const AST::PrimaryExp *primaryExp) const;
 
     [[nodiscard]] std::shared_ptr<Value> visit_functionCall(const AST::UnaryExp::call &call) const;
 
-    [[nodiscard]] std::shared_ptr<Value> visit_unaryExp(const std::shared_ptr<AST::UnaryExp> &unaryExp) const;
+    [[nodiscard]] std::shared_ptr<Value> visit_unaryExp(const AST::UnaryExp *unaryExp) const;
 
-    [[nodiscard]] std::shared_ptr<Value> visit_mulExp(const std::shared_ptr<AST::MulExp> &mulExp) const;
+    [[nodiscard]] std::shared_ptr<Value> visit_mulExp(const AST::MulExp *mulExp) const;
 
-    [[nodiscard]] std::shared_ptr<Value> visit_addExp(const std::shared_ptr<AST::AddExp> &addExp) const;
+    [[nodiscard]] std::shared_ptr<Value> visit_addExp(const AST::AddExp *addExp) const;
 
-    [[nodiscard]] std::shared_ptr<Value> visit_relExp(const std::shared_ptr<AST::RelExp> &relExp) const;
+    [[nodiscard]] std::shared_ptr<Value> visit_relExp(const AST::RelExp *relExp) const;
 
-    [[nodiscard]] std::shared_ptr<Value> visit_eqExp(const std::shared_ptr<AST::EqExp> &eqExp) const;
+    [[nodiscard]] std::shared_ptr<Value> visit_eqExp(const AST::EqExp *eqExp) const;
 
-    void visit_lAndExp(const std::shared_ptr<AST::LAndExp> &lAndExp, const std::shared_ptr<Block> &_then,
+    void visit_lAndExp(const AST::LAndExp *lAndExp, const std::shared_ptr<Block> &_then,
                        const std::shared_ptr<Block> &_else);
 
-    void visit_lOrExp(const std::shared_ptr<AST::LOrExp> &lOrExp, const std::shared_ptr<Block> &_then,
+    void visit_lOrExp(const AST::LOrExp *lOrExp, const std::shared_ptr<Block> &_then,
                       const std::shared_ptr<Block> &_else);
 };
 
@@ -106,6 +130,6 @@ std::shared_ptr<Value> type_cast(const std::shared_ptr<Value> &v, const std::sha
 } // namespace Mir
 
 // 用于在编译期内计算常数
-eval_t eval_exp(const std::shared_ptr<AST::AddExp> &exp, const std::shared_ptr<Mir::Symbol::Table> &table);
+eval_t eval_exp(const AST::AddExp *exp, const std::shared_ptr<Mir::Symbol::Table> &table);
 
 #endif
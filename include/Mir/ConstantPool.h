@@ -0,0 +1,88 @@
+#ifndef CONSTANT_POOL_H
+#define CONSTANT_POOL_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Type.h"
+#include "Utils/Parallel.h"
+
+namespace Mir {
+class Const;
+
+// 模块持有的常量池：按(种类, 类型, 位模式)对常量进行唯一化并持有强引用
+// 相同的常量在模块内只有一个实例，可直接按指针比较；模块销毁时随之释放
+class ConstantPool {
+public:
+    enum class Tag : uint8_t { Bool, Int, Float, Undef };
+
+    struct Statistics {
+        size_t hits{0};
+        size_t misses{0};
+    };
+
+    ConstantPool() = default;
+
+    ConstantPool(const ConstantPool &) = delete;
+
+    ConstantPool &operator=(const ConstantPool &) = delete;
+
+    // 返回键对应的常量；尚不存在时调用 make 新建并放入池中
+    // 查找与填充在同一把锁内完成，按函数并行执行变换时同一个常量也只会创建一次
+    template<typename Make>
+    std::shared_ptr<Const> intern(const Tag tag, const std::shared_ptr<Type::Type> &type, const uint64_t bits,
+                                  Make &&make) {
+        const Utils::ParallelLock lock{mutex_};
+        auto &slot = lookup(tag, type, bits);
+        if (slot == nullptr) {
+            slot = make();
+        }
+        return slot;
+    }
+
+    [[nodiscard]] size_t size() const { return constants_.size(); }
+
+    [[nodiscard]] const Statistics &statistics() const { return statistics_; }
+
+    [[nodiscard]] std::string statistics_string() const;
+
+    // 当前模块的常量池；尚未创建模块时退回到全局常量池
+    [[nodiscard]] static ConstantPool &active();
+
+    static void set_active(ConstantPool *pool) { active_ = pool; }
+
+private:
+    struct Key {
+        Tag tag;
+        const Type::Type *type;
+        uint64_t bits;
+
+        bool operator==(const Key &other) const {
+            return tag == other.tag && type == other.type && bits == other.bits;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const {
+            size_t seed = std::hash<uint64_t>{}(key.bits);
+            seed ^= std::hash<const Type::Type *>{}(key.type) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= static_cast<size_t>(key.tag) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
+    static ConstantPool *active_;
+
+    // 返回键对应的槽位，并统计命中情况
+    std::shared_ptr<Const> &lookup(Tag tag, const std::shared_ptr<Type::Type> &type, uint64_t bits);
+
+    std::unordered_map<Key, std::shared_ptr<Const>, KeyHash> constants_;
+    Statistics statistics_;
+    std::mutex mutex_;
+};
+} // namespace Mir
+
+#endif
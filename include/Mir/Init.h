@@ -2,12 +2,14 @@
 #define INIT_H
 
 #include <string>
+#include <vector>
 
 #include "Builder.h"
 #include "Const.h"
 #include "Type.h"
 #include "Utils/AST.h"
 #include "Utils/Log.h"
+#include "Utils/OutputSink.h"
 
 namespace Mir {
 class Builder;
@@ -32,17 +34,16 @@ template<>
 struct InitValTrait<AST::ConstInitVal> {
     using ExpType = AST::ConstExp;
 
-    static bool is_array_vals(const std::shared_ptr<AST::ConstInitVal> &node) { return node->is_constInitVals(); }
+    static bool is_array_vals(const AST::ConstInitVal *node) { return node->is_constInitVals(); }
 
-    static std::vector<std::shared_ptr<AST::ConstInitVal>>
-    get_array_vals(const std::shared_ptr<AST::ConstInitVal> &node) {
-        return std::get<std::vector<std::shared_ptr<AST::ConstInitVal>>>(node->get_value());
+    static AST::List<const AST::ConstInitVal *> get_array_vals(const AST::ConstInitVal *node) {
+        return std::get<AST::List<const AST::ConstInitVal *>>(node->get_value());
     }
 
-    static bool is_exp(const std::shared_ptr<AST::ConstInitVal> &node) { return node->is_constExp(); }
+    static bool is_exp(const AST::ConstInitVal *node) { return node->is_constExp(); }
 
-    static std::shared_ptr<AST::AddExp> get_addExp(const std::shared_ptr<AST::ConstInitVal> &node) {
-        return std::get<std::shared_ptr<AST::ConstExp>>(node->get_value())->addExp();
+    static const AST::AddExp *get_addExp(const AST::ConstInitVal *node) {
+        return std::get<const AST::ConstExp *>(node->get_value())->addExp();
     }
 };
 
@@ -51,16 +52,16 @@ template<>
 struct InitValTrait<AST::InitVal> {
     using ExpType = AST::Exp;
 
-    static bool is_array_vals(const std::shared_ptr<AST::InitVal> &node) { return node->is_initVals(); }
+    static bool is_array_vals(const AST::InitVal *node) { return node->is_initVals(); }
 
-    static std::vector<std::shared_ptr<AST::InitVal>> get_array_vals(const std::shared_ptr<AST::InitVal> &node) {
-        return std::get<std::vector<std::shared_ptr<AST::InitVal>>>(node->get_value());
+    static AST::List<const AST::InitVal *> get_array_vals(const AST::InitVal *node) {
+        return std::get<AST::List<const AST::InitVal *>>(node->get_value());
     }
 
-    static bool is_exp(const std::shared_ptr<AST::InitVal> &node) { return node->is_exp(); }
+    static bool is_exp(const AST::InitVal *node) { return node->is_exp(); }
 
-    static std::shared_ptr<AST::AddExp> get_addExp(const std::shared_ptr<AST::InitVal> &node) {
-        return std::get<std::shared_ptr<AST::Exp>>(node->get_value())->addExp();
+    static const AST::AddExp *get_addExp(const AST::InitVal *node) {
+        return std::get<const AST::Exp *>(node->get_value())->addExp();
     }
 };
 
@@ -84,11 +85,20 @@ public:
 
     [[nodiscard]] virtual std::string to_string() const = 0;
 
+    // 大数组的初值直接写入 out，不先拼成字符串
+    virtual void print(Utils::OutputSink &out) const { out << to_string(); }
+
     template<typename T>
     std::shared_ptr<T> as() {
         return std::static_pointer_cast<T>(shared_from_this());
     }
 
+    // 不增加引用计数的裸指针视图，仅在调用者持有该初值期间有效
+    template<typename T>
+    T *as_ptr() {
+        return static_cast<T *>(this);
+    }
+
     [[nodiscard]] std::shared_ptr<Type::Type> get_type() const { return type; }
 };
 
@@ -107,8 +117,12 @@ public:
 
     [[nodiscard]] std::string to_string() const override;
 
+    // 对常量表达式求值，并转换为 type 类型的常量
+    static std::shared_ptr<Const> eval_const_value(const std::shared_ptr<Type::Type> &type, const AST::AddExp *addExp,
+                                                   const std::shared_ptr<Symbol::Table> &table);
+
     static std::shared_ptr<Constant> create_constant_init_value(const std::shared_ptr<Type::Type> &type,
-                                                                const std::shared_ptr<AST::AddExp> &addExp,
+                                                                const AST::AddExp *addExp,
                                                                 const std::shared_ptr<Symbol::Table> &table);
 
     static std::shared_ptr<Constant> create_zero_constant_init_value(const std::shared_ptr<Type::Type> &type);
@@ -133,49 +147,60 @@ public:
                                                        const std::shared_ptr<Value> &exp_value);
 };
 
+// 数组初值的扁平稀疏表示：按展平后的下标记录若干段连续的非零元素，段外的元素均为零
 class Array final : public Init {
-    const bool is_zero_initialized;
-    const std::vector<std::shared_ptr<Init>> init_values;
-    int last_non_zero_{-1};
-
 public:
-    // 计算最后一个非零元素的索引
-    void calculate_last_non_zero() {
-        last_non_zero_ = -1;
-        if (std::any_of(init_values.begin(), init_values.end(), [](const auto &init) {
-            return !init->is_constant_init();
-        })) {
-            return;
-        }
-        for (int i = static_cast<int>(init_values.size()) - 1; i >= 0; --i) {
-            if (const auto &init = init_values[i]; init->is_constant_init()) {
-                if (const auto constant_init = std::static_pointer_cast<Constant>(init); !constant_init->is_zero()) {
-                    last_non_zero_ = i;
-                    break;
-                }
-            } else {
-                // 如果有非Constant类型的元素，则last_non_zero_无意义
-                last_non_zero_ = -1;
-                return;
-            }
-        }
-    }
+    // 一段连续的非零元素，首元素的展平下标为 offset
+    struct Run {
+        size_t offset;
+        std::vector<std::shared_ptr<Value>> values;
 
-    explicit Array(const std::shared_ptr<Type::Type> &type, const std::vector<std::shared_ptr<Init>> &init_values,
-                   const bool is_zero_initialized = false) :
-        Init{type}, is_zero_initialized{is_zero_initialized}, init_values{init_values} {
-        calculate_last_non_zero();
-    }
+        [[nodiscard]] size_t end() const { return offset + values.size(); }
+    };
+
+private:
+    // 按 offset 升序排列且互不相邻
+    std::vector<Run> runs;
+
+    // 第一个满足 end() > offset 的段
+    [[nodiscard]] std::vector<Run>::const_iterator find_run(size_t offset) const;
 
-    [[nodiscard]] const auto &get_init_values() const { return init_values; }
+    // 展平下标在 [begin, end) 内是否有非零元素
+    [[nodiscard]] bool has_value_in(size_t begin, size_t end) const;
+
+    // 依次追加下一个元素，零常量只推进下标
+    static void append(std::vector<Run> &runs, size_t offset, const std::shared_ptr<Value> &value);
+
+    // 将 initVal 描述的子数组写入展平下标从 offset 开始的区域
+    template<typename TVal>
+    static void fill(const std::shared_ptr<Type::Type> &type, const TVal *initVal, size_t offset,
+                     std::vector<Run> &runs, const std::shared_ptr<Symbol::Table> &table, bool is_constant,
+                     const Builder *builder);
+
+    void gen_store_inst(const std::shared_ptr<Value> &addr, const std::shared_ptr<Block> &block,
+                        const std::shared_ptr<Type::Type> &sub_type, size_t offset) const;
+
+    void print(Utils::OutputSink &out, const std::shared_ptr<Type::Type> &sub_type, size_t offset) const;
+
+public:
+    explicit Array(const std::shared_ptr<Type::Type> &type, std::vector<Run> runs = {}) :
+        Init{type}, runs{std::move(runs)} {}
 
     [[nodiscard]] bool is_array_init() const override { return true; }
 
-    [[nodiscard]] bool zero_initialized() const { return is_zero_initialized; }
+    [[nodiscard]] bool zero_initialized() const { return runs.empty(); }
 
-    [[nodiscard]] size_t get_size() const { return init_values.size(); }
+    [[nodiscard]] const std::vector<Run> &get_runs() const { return runs; }
 
-    [[nodiscard]] int last_non_zero() const { return last_non_zero_; }
+    [[nodiscard]] std::shared_ptr<Type::Type> get_atomic_type() const {
+        return std::static_pointer_cast<Type::Array>(type)->get_atomic_type();
+    }
+
+    // 各维下标对应的展平下标，下标个数必须与维数相同
+    [[nodiscard]] size_t flat_index(const std::vector<int> &indexes) const;
+
+    // 展平下标为 offset 的元素，零元素返回对应类型的零常量
+    [[nodiscard]] std::shared_ptr<Value> get_value(size_t offset) const;
 
     std::shared_ptr<Init> get_init_value(const std::vector<int> &indexes);
 
@@ -183,7 +208,7 @@ public:
 
     template<typename TVal>
     static std::shared_ptr<Array> create_array_init_value(const std::shared_ptr<Type::Type> &type,
-                                                          const std::shared_ptr<TVal> &initVal,
+                                                          const TVal *initVal,
                                                           const std::shared_ptr<Symbol::Table> &table, bool is_constant,
                                                           const Builder *builder = nullptr);
 
@@ -191,61 +216,14 @@ public:
                         const std::vector<int> &dimensions) const;
 
     [[nodiscard]] std::string to_string() const override;
-};
 
-template<typename TVal>
-bool is_zero_array(const std::shared_ptr<Type::Type> &type, const std::shared_ptr<TVal> &initVal,
-                   const std::shared_ptr<Symbol::Table> &table, bool is_constant, const Builder *const builder) {
-    using Trait = InitValTrait<TVal>;
-    if (!type->is_array()) {
-        return false;
-    }
-    if (!Trait::is_array_vals(initVal)) {
-        return false;
-    }
-    if (Trait::get_array_vals(initVal).empty()) {
-        return true;
-    }
-    const auto &array_type = std::static_pointer_cast<Type::Array>(type);
-    const auto element_type = array_type->get_element_type(), atomic_type = array_type->get_atomic_type();
-    for (const auto &val: Trait::get_array_vals(initVal)) {
-        if (Trait::is_exp(val)) {
-            if (is_constant) {
-                auto res = eval_exp(Trait::get_addExp(val), table);
-                if (atomic_type->is_int32()) {
-                    if (const int value = std::visit([](auto &&arg) { return static_cast<int>(arg); }, res); value != 0)
-                        return false;
-                }
-                if (atomic_type->is_float()) {
-                    const double value = std::visit([](auto &&arg) { return static_cast<double>(arg); }, res);
-                    if (constexpr double tolerance = 1e-6f; std::abs(value - 0.0f) >= tolerance) {
-                        return false;
-                    }
-                }
-            } else {
-                const auto &exp_value = builder->visit_addExp(Trait::get_addExp(val));
-                if (!exp_value->is_constant()) {
-                    return false;
-                }
-                const auto const_exp_value = std::dynamic_pointer_cast<Const>(exp_value);
-                if (const_exp_value == nullptr || !const_exp_value->is_zero()) {
-                    return false;
-                }
-            }
-        } else if (Trait::is_array_vals(val)) {
-            if (!is_zero_array<TVal>(element_type, val, table, is_constant, builder)) {
-                return false;
-            }
-        }
-    }
-    return true;
-}
+    void print(Utils::OutputSink &out) const override;
+};
 
 template<typename TVal>
-std::shared_ptr<Array> Array::create_array_init_value(const std::shared_ptr<Type::Type> &type,
-                                                      const std::shared_ptr<TVal> &initVal,
-                                                      const std::shared_ptr<Symbol::Table> &table,
-                                                      const bool is_constant, const Builder *const builder) {
+void Array::fill(const std::shared_ptr<Type::Type> &type, const TVal *initVal, const size_t offset,
+                 std::vector<Run> &runs, const std::shared_ptr<Symbol::Table> &table, const bool is_constant,
+                 const Builder *const builder) {
     using Trait = InitValTrait<TVal>;
     if (!type->is_array()) {
         log_error("%s is not an array type", type->to_string().c_str());
@@ -253,65 +231,52 @@ std::shared_ptr<Array> Array::create_array_init_value(const std::shared_ptr<Type
     if (!Trait::is_array_vals(initVal)) {
         log_error("Not an array");
     }
-    if (is_zero_array<TVal>(type, initVal, table, is_constant, builder)) {
-        return create_zero_array_init_value(type);
-    }
     const auto &array_type = std::static_pointer_cast<Type::Array>(type);
     const auto &element_type = array_type->get_element_type();
-    std::vector<std::shared_ptr<Init>> init_values;
+    const size_t element_size =
+            element_type->is_array() ? std::static_pointer_cast<Type::Array>(element_type)->get_flattened_size() : 1;
     const auto &vals = Trait::get_array_vals(initVal);
-    for (size_t i = 0; i < vals.size(); ++i) {
+    // count 为已填入的元素个数，未填入的元素保持为零
+    for (size_t i = 0, count = 0; i < vals.size() && count < array_type->get_size(); ++i, ++count) {
         const auto &val = vals[i];
-        if (init_values.size() >= array_type->get_size())
-            break;
+        const size_t element_offset = offset + count * element_size;
         if (Trait::is_array_vals(val)) {
             if (!element_type->is_array()) {
                 log_error("Element not an array");
             }
-            init_values.emplace_back(
-                    Array::create_array_init_value<TVal>(element_type, val, table, is_constant, builder));
-        } else if (Trait::is_exp(val)) {
-            if (element_type->is_array()) {
-                auto basic_type = array_type->get_atomic_type();
-                const auto element_array_type = std::static_pointer_cast<Type::Array>(element_type);
-                const size_t flatten_size = element_array_type->get_flattened_size();
-                std::vector<std::shared_ptr<TVal>> sub_vals;
-                size_t cnt = 0;
-                for (size_t j = 0; j < flatten_size;) {
-                    if (i + cnt >= vals.size())
-                        break;
-                    sub_vals.emplace_back(vals[i + cnt]);
-                    if (!Trait::is_array_vals(vals[i + cnt])) {
-                        ++j;
-                    } else {
-                        j += element_array_type->get_flattened_size();
-                    }
-                    ++cnt;
-                }
-                TVal ast_val{sub_vals};
-                std::shared_ptr<TVal> wrapped_val = std::make_shared<TVal>(ast_val);
-                init_values.emplace_back(
-                        Array::create_array_init_value<TVal>(element_type, wrapped_val, table, is_constant, builder));
-                i += cnt - 1;
-            } else {
-                if (is_constant) {
-                    init_values.emplace_back(
-                            Constant::create_constant_init_value(element_type, Trait::get_addExp(val), table));
+            fill<TVal>(element_type, val, element_offset, runs, table, is_constant, builder);
+        } else if (element_type->is_array()) {
+            // 省略了花括号的元素在 vals 中是连续的，直接以其中一段作为子数组的初值
+            size_t cnt = 0;
+            for (size_t j = 0; j < element_size;) {
+                if (i + cnt >= vals.size())
+                    break;
+                if (!Trait::is_array_vals(vals[i + cnt])) {
+                    ++j;
                 } else {
-                    const auto &exp_value = builder->visit_addExp(Trait::get_addExp(val));
-                    init_values.emplace_back(Exp::create_exp_init_value(element_type, exp_value));
+                    j += element_size;
                 }
+                ++cnt;
             }
-        }
-    }
-    while (init_values.size() < array_type->get_size()) {
-        if (element_type->is_array()) {
-            init_values.emplace_back(create_zero_array_init_value(element_type));
+            const TVal wrapped_val{AST::List<const TVal *>{&vals[i], cnt}};
+            fill<TVal>(element_type, &wrapped_val, element_offset, runs, table, is_constant, builder);
+            i += cnt - 1;
+        } else if (is_constant) {
+            append(runs, element_offset, Constant::eval_const_value(element_type, Trait::get_addExp(val), table));
         } else {
-            init_values.emplace_back(Constant::create_zero_constant_init_value(element_type));
+            append(runs, element_offset, builder->visit_addExp(Trait::get_addExp(val)));
         }
     }
-    return std::make_shared<Array>(type, init_values);
+}
+
+template<typename TVal>
+std::shared_ptr<Array> Array::create_array_init_value(const std::shared_ptr<Type::Type> &type,
+                                                      const TVal *initVal,
+                                                      const std::shared_ptr<Symbol::Table> &table,
+                                                      const bool is_constant, const Builder *const builder) {
+    std::vector<Run> runs;
+    fill<TVal>(type, initVal, 0, runs, table, is_constant, builder);
+    return std::make_shared<Array>(type, std::move(runs));
 }
 } // namespace Mir::Init
 
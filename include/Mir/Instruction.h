@@ -67,6 +67,9 @@ public:
 
     [[nodiscard]] std::string to_string() const override = 0;
 
+    // 直接写入 out，不先拼成字符串；常用指令各自实现，其余指令输出 to_string 的结果
+    virtual void print(Utils::OutputSink &out) const { out << to_string(); }
+
     virtual std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) {
         log_error("Not implemented");
     }
@@ -94,6 +97,7 @@ public:
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -103,7 +107,7 @@ public:
 class Load final : public Instruction {
 public:
     Load(const std::string &name, const std::shared_ptr<Value> &addr) :
-        Instruction{name, addr->get_type()->as<Type::Pointer>()->get_contain_type(), Operator::LOAD} {
+        Instruction{name, addr->get_type()->as_ptr<Type::Pointer>()->get_contain_type(), Operator::LOAD} {
         if (!addr->get_type()->is_pointer()) {
             log_error("Address must be a pointer");
         }
@@ -116,9 +120,10 @@ public:
         return create(name_, get_addr(), block);
     }
 
-    [[nodiscard]] std::shared_ptr<Value> get_addr() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_addr() const { return get_operand(0); }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -146,11 +151,12 @@ public:
         return create(get_addr(), get_value(), block);
     }
 
-    [[nodiscard]] std::shared_ptr<Value> get_addr() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_addr() const { return get_operand(0); }
 
-    [[nodiscard]] std::shared_ptr<Value> get_value() const { return operands_[1]; }
+    [[nodiscard]] std::shared_ptr<Value> get_value() const { return get_operand(1); }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -171,19 +177,20 @@ public:
                                                  const std::vector<std::shared_ptr<Value>> &indexes,
                                                  const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_addr() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_addr() const { return get_operand(0); }
 
-    [[nodiscard]] std::shared_ptr<Value> get_index() const { return operands_.back(); }
+    [[nodiscard]] std::shared_ptr<Value> get_index() const { return operands_.back().get(); }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
         std::vector<std::shared_ptr<Value>> indexes;
         for (size_t i = 1; i < operands_.size(); ++i) {
-            indexes.push_back(operands_[i]);
+            indexes.push_back(get_operand(i));
         }
         return create(name_, get_addr(), indexes, block);
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -208,13 +215,14 @@ public:
                                            const std::shared_ptr<Type::Type> &target_type,
                                            const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_value() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_value() const { return get_operand(0); }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
         return create(name_, get_value(), get_type(), block);
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 };
@@ -231,13 +239,14 @@ public:
     static std::shared_ptr<Fptosi> create(const std::string &name, const std::shared_ptr<Value> &value,
                                           const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_value() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_value() const { return get_operand(0); }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
         return create(name_, get_value(), block);
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -256,13 +265,14 @@ public:
     static std::shared_ptr<Sitofp> create(const std::string &name, const std::shared_ptr<Value> &value,
                                           const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_value() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_value() const { return get_operand(0); }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
         return create(name_, get_value(), block);
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -299,14 +309,14 @@ public:
 
     void reverse_op() {
         this->op = swap_op(this->op);
-        std::swap(operands_[0], operands_[1]);
+        exchange_operands(0, 1);
     }
 
     static std::shared_ptr<Fcmp> create(const std::string &name, Op op, std::shared_ptr<Value> lhs,
                                         std::shared_ptr<Value> rhs, const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_lhs() const { return operands_[0]; }
-    [[nodiscard]] std::shared_ptr<Value> get_rhs() const { return operands_[1]; }
+    [[nodiscard]] std::shared_ptr<Value> get_lhs() const { return get_operand(0); }
+    [[nodiscard]] std::shared_ptr<Value> get_rhs() const { return get_operand(1); }
 
     [[nodiscard]] Op fcmp_op() const { return op; }
 
@@ -315,6 +325,7 @@ public:
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -369,14 +380,14 @@ public:
 
     void reverse_op() {
         this->op = swap_op(this->op);
-        std::swap(operands_[0], operands_[1]);
+        exchange_operands(0, 1);
     }
 
     static std::shared_ptr<Icmp> create(const std::string &name, Op op, std::shared_ptr<Value> lhs,
                                         std::shared_ptr<Value> rhs, const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_lhs() const { return operands_[0]; }
-    [[nodiscard]] std::shared_ptr<Value> get_rhs() const { return operands_[1]; }
+    [[nodiscard]] std::shared_ptr<Value> get_lhs() const { return get_operand(0); }
+    [[nodiscard]] std::shared_ptr<Value> get_rhs() const { return get_operand(1); }
 
     [[nodiscard]] Op icmp_op() const { return op; }
 
@@ -385,6 +396,7 @@ public:
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -403,13 +415,14 @@ public:
     static std::shared_ptr<Zext> create(const std::string &name, const std::shared_ptr<Value> &value,
                                         const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_value() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_value() const { return get_operand(0); }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
         return create(name_, get_value(), block);
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -431,7 +444,7 @@ public:
                                         const std::shared_ptr<Block> &block);
 
     [[nodiscard]] std::shared_ptr<Block> get_target_block() const {
-        return std::static_pointer_cast<Block>(operands_[0]);
+        return std::static_pointer_cast<Block>(get_operand(0));
     }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
@@ -439,6 +452,7 @@ public:
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -458,16 +472,16 @@ public:
                                           const std::shared_ptr<Block> &false_block,
                                           const std::shared_ptr<Block> &block);
 
-    void swap() { std::swap(operands_[0], operands_[1]); }
+    void swap() { exchange_operands(0, 1); }
 
-    [[nodiscard]] std::shared_ptr<Value> get_cond() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_cond() const { return get_operand(0); }
 
     [[nodiscard]] std::shared_ptr<Block> get_true_block() const {
-        return std::static_pointer_cast<Block>(operands_[1]);
+        return std::static_pointer_cast<Block>(get_operand(1));
     }
 
     [[nodiscard]] std::shared_ptr<Block> get_false_block() const {
-        return std::static_pointer_cast<Block>(operands_[2]);
+        return std::static_pointer_cast<Block>(get_operand(2));
     }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
@@ -475,6 +489,7 @@ public:
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -501,7 +516,7 @@ public:
         if (operands_.empty()) [[unlikely]] {
             return nullptr;
         }
-        return operands_[0];
+        return get_operand(0);
     }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
@@ -509,6 +524,7 @@ public:
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -528,9 +544,9 @@ public:
                                           const std::shared_ptr<Block> &default_block,
                                           const std::shared_ptr<Block> &block);
 
-    std::shared_ptr<Value> get_base() const { return operands_[0]; }
+    std::shared_ptr<Value> get_base() const { return get_operand(0); }
 
-    std::shared_ptr<Block> get_default_block() const { return operands_[1]->as<Block>(); }
+    std::shared_ptr<Block> get_default_block() const { return get_operand(1)->as<Block>(); }
 
     [[nodiscard]] std::string to_string() const override;
 
@@ -553,7 +569,6 @@ public:
 
     void remove_case(const std::shared_ptr<Const> &value);
 
-    void modify_operand(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value) override;
 
     void clear_operands() override;
 
@@ -566,6 +581,9 @@ public:
         return sw;
     }
 
+protected:
+    void on_operand_modified(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value) override;
+
 private:
     // 跳转表
     std::unordered_map<std::shared_ptr<Value>, std::shared_ptr<Block>> cases_table;
@@ -604,7 +622,7 @@ public:
                                         const std::vector<std::shared_ptr<Value>> &params,
                                         const std::shared_ptr<Block> &block, int const_string_index = -1);
 
-    [[nodiscard]] std::shared_ptr<Value> get_function() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_function() const { return get_operand(0); }
 
     [[nodiscard]] std::vector<std::shared_ptr<Value>> get_params() const {
         if (operands_.size() <= 1) {
@@ -613,7 +631,7 @@ public:
         std::vector<std::shared_ptr<Value>> params;
         params.reserve(operands_.size() - 1);
         for (size_t i = 1; i < operands_.size(); ++i) {
-            params.push_back(operands_[i]);
+            params.push_back(get_operand(i));
         }
         return params;
     }
@@ -628,6 +646,7 @@ public:
     }
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
@@ -649,11 +668,11 @@ protected:
     }
 
 public:
-    [[nodiscard]] std::shared_ptr<Value> get_lhs() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_lhs() const { return get_operand(0); }
 
-    [[nodiscard]] std::shared_ptr<Value> get_rhs() const { return operands_[1]; }
+    [[nodiscard]] std::shared_ptr<Value> get_rhs() const { return get_operand(1); }
 
-    void swap_operands() { std::swap(operands_[0], operands_[1]); }
+    void swap_operands() { exchange_operands(0, 1); }
 
     [[nodiscard]] std::string to_string() const override = 0;
 
@@ -790,11 +809,11 @@ public:
         }
     }
 
-    [[nodiscard]] std::shared_ptr<Value> get_x() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_x() const { return get_operand(0); }
 
-    [[nodiscard]] std::shared_ptr<Value> get_y() const { return operands_[1]; }
+    [[nodiscard]] std::shared_ptr<Value> get_y() const { return get_operand(1); }
 
-    [[nodiscard]] std::shared_ptr<Value> get_z() const { return operands_[2]; }
+    [[nodiscard]] std::shared_ptr<Value> get_z() const { return get_operand(2); }
 
     [[nodiscard]] Op floatternary_op() const { return op; }
 
@@ -815,6 +834,7 @@ public:
             return create(get_name(), get_lhs(), get_rhs(), block);                                                    \
         }                                                                                                              \
         [[nodiscard]] std::string to_string() const override;                                                          \
+        void print(Utils::OutputSink &out) const override;                                                             \
         void do_interpret(Interpreter *interpreter) override;                                                          \
         [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;                        \
     };
@@ -833,6 +853,7 @@ public:
             return create(get_name(), get_lhs(), get_rhs(), block);                                                    \
         }                                                                                                              \
         [[nodiscard]] std::string to_string() const override;                                                          \
+        void print(Utils::OutputSink &out) const override;                                                             \
         void do_interpret(Interpreter *interpreter) override;                                                          \
         [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;                        \
     };
@@ -846,10 +867,10 @@ public:
                                              const std::shared_ptr<Value> &y, const std::shared_ptr<Value> &z,         \
                                              const std::shared_ptr<Block> &block);                                     \
         std::shared_ptr<Instruction> clone_exact() {                                                                   \
-            return create(get_name(), operands_[0], operands_[1], operands_[2], get_block());                          \
+            return create(get_name(), get_operand(0), get_operand(1), get_operand(2), get_block());                    \
         }                                                                                                              \
         std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {                    \
-            return create(get_name(), operands_[0], operands_[1], operands_[2], block);                                \
+            return create(get_name(), get_operand(0), get_operand(1), get_operand(2), block);                          \
         }                                                                                                              \
         [[nodiscard]] std::string to_string() const override;                                                          \
         void do_interpret(Interpreter *interpreter) override;                                                          \
@@ -914,7 +935,7 @@ public:
     static std::shared_ptr<FNeg> create(const std::string &name, const std::shared_ptr<Value> &value,
                                         const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_value() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_value() const { return get_operand(0); }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
         return create(name_, get_value(), block);
@@ -938,6 +959,7 @@ public:
                                        const std::shared_ptr<Block> &block, const Optional_Values &optional_values);
 
     [[nodiscard]] std::string to_string() const override;
+    void print(Utils::OutputSink &out) const override;
 
     [[nodiscard]] const Optional_Values &get_optional_values() { return optional_values; }
 
@@ -947,7 +969,6 @@ public:
 
     void remove_optional_value(const std::shared_ptr<Block> &block);
 
-    void modify_operand(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value) override;
 
     void clear_operands() override;
 
@@ -963,6 +984,9 @@ public:
 
     [[nodiscard]] std::shared_ptr<Instruction> clone(FunctionCloneHelper &helper) override;
 
+protected:
+    void on_operand_modified(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value) override;
+
 private:
     Optional_Values optional_values;
 };
@@ -985,11 +1009,11 @@ public:
                                           const std::shared_ptr<Value> &false_value,
                                           const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_cond() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_cond() const { return get_operand(0); }
 
-    [[nodiscard]] std::shared_ptr<Value> get_true_value() const { return operands_[1]; }
+    [[nodiscard]] std::shared_ptr<Value> get_true_value() const { return get_operand(1); }
 
-    [[nodiscard]] std::shared_ptr<Value> get_false_value() const { return operands_[2]; }
+    [[nodiscard]] std::shared_ptr<Value> get_false_value() const { return get_operand(2); }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
         return create(name_, get_cond(), get_true_value(), get_false_value(), block);
@@ -1015,9 +1039,9 @@ public:
                                         const std::shared_ptr<Value> &from_value,
                                         const std::shared_ptr<Block> &block);
 
-    [[nodiscard]] std::shared_ptr<Value> get_to_value() const { return operands_[0]; }
+    [[nodiscard]] std::shared_ptr<Value> get_to_value() const { return get_operand(0); }
 
-    [[nodiscard]] std::shared_ptr<Value> get_from_value() const { return operands_[1]; }
+    [[nodiscard]] std::shared_ptr<Value> get_from_value() const { return get_operand(1); }
 
     std::shared_ptr<Instruction> clone_to_block(const std::shared_ptr<Block> &block) override {
         log_error("Not implemented");
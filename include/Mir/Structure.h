@@ -5,7 +5,10 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Arena.h"
+#include "ConstantPool.h"
 #include "Value.h"
+#include "Utils/OutputSink.h"
 
 namespace Pass {
 class LoopNodeClone;
@@ -17,6 +20,12 @@ class Init;
 
 namespace Mir {
 class GlobalVariable;
+
+// 生成变量名与基本块名的计数器，每个函数各有一份，名字只需在函数内唯一
+struct NameCounter {
+    size_t variable{0};
+    size_t block{0};
+};
 class Function;
 class Instruction;
 
@@ -26,11 +35,42 @@ class Module {
     std::vector<std::string> const_strings;
     std::vector<std::shared_ptr<Function>> functions;
     std::shared_ptr<Function> main_function;
+    // 模块内IR节点所使用的内存池，为nullptr时使用普通的堆分配
+    Arena *arena_{nullptr};
+    // 模块内唯一化的常量
+    ConstantPool constant_pool_;
 
+    // 只在编译流程开始时设置一次，按函数并行执行变换期间各线程只读取
     static std::shared_ptr<Module> instance_;
+    static bool arena_enabled_;
 
 public:
-    explicit Module() = default;
+    explicit Module() {
+        if (arena_enabled_) [[likely]] {
+            arena_ = new Arena;
+            Arena::set_active(arena_);
+        }
+        ConstantPool::set_active(&constant_pool_);
+    }
+
+    Module(const Module &) = delete;
+
+    Module &operator=(const Module &) = delete;
+
+    ~Module() {
+        if (&ConstantPool::active() == &constant_pool_) {
+            ConstantPool::set_active(nullptr);
+        }
+        if (arena_ != nullptr) {
+            arena_->release();
+        }
+    }
+
+    static void set_arena_enabled(const bool enabled) { arena_enabled_ = enabled; }
+
+    [[nodiscard]] const Arena *get_arena() const { return arena_; }
+
+    [[nodiscard]] const ConstantPool &get_constant_pool() const { return constant_pool_; }
 
     static void set_instance(const std::shared_ptr<Module> &module) { instance_ = module; }
 
@@ -81,6 +121,9 @@ public:
 
     [[nodiscard]] std::string to_string() const;
 
+    // 逐个函数、逐条指令写入 out，不在内存中拼出整个模块
+    void print(Utils::OutputSink &out) const;
+
     auto begin() { return functions.begin(); }
     auto end() { return functions.end(); }
     [[nodiscard]] auto begin() const { return functions.begin(); }
@@ -101,6 +144,8 @@ public:
     [[nodiscard]] std::shared_ptr<Init::Init> get_init_value() const { return init_value; }
 
     [[nodiscard]] std::string to_string() const override;
+
+    void print(Utils::OutputSink &out) const;
 };
 
 class Argument final : public Value {
@@ -124,6 +169,8 @@ class Function final : public User {
     std::vector<std::shared_ptr<Block>> blocks;
     std::vector<std::shared_ptr<Value>> phicopy_values_;
     const bool is_runtime_function;
+    // 按函数并行执行的变换只在本函数的计数器上取名，名字不依赖线程的执行顺序
+    mutable NameCounter name_counter_;
 
 public:
     Function(const std::string &name, const std::shared_ptr<Type::Type> &return_type,
@@ -133,10 +180,10 @@ public:
     template<typename... Types>
     static std::shared_ptr<Function> create(const std::string &name, const std::shared_ptr<Type::Type> &return_type,
                                             Types... argument_types) {
-        const auto &func = std::make_shared<Function>(name, return_type, true);
+        const auto &func = make_ir<Function>(name, return_type, true);
         std::vector<std::shared_ptr<Type::Type>> arguments_types{argument_types...};
         for (size_t i = 0; i < arguments_types.size(); ++i) {
-            const auto &arg = std::make_shared<Argument>("%" + std::to_string(i), arguments_types[i], i);
+            const auto &arg = make_ir<Argument>("%" + std::to_string(i), arguments_types[i], i);
             func->add_argument(arg);
         }
         return func;
@@ -165,10 +212,14 @@ public:
 
     [[nodiscard]] auto &phicopy_values() { return phicopy_values_; }
 
+    [[nodiscard]] NameCounter &name_counter() const { return name_counter_; }
+
     // 清除流图后需要更新基本块和指令的id
     void update_id() const;
 
     [[nodiscard]] std::string to_string() const override;
+
+    void print(Utils::OutputSink &out) const;
 };
 
 
@@ -177,13 +228,15 @@ class Block final : public User {
     std::vector<std::shared_ptr<Instruction>> instructions;
     // 标记基本块是否被删除
     bool deleted{false};
+    // 在所属函数的控制流图中的稠密编号，由 ControlFlowGraph 分配
+    size_t index{0};
 
 public:
     explicit Block(const std::string &name) :
         User(name, Type::Label::label) {}
 
     static std::shared_ptr<Block> create(const std::string &name, const std::shared_ptr<Function> &function = nullptr) {
-        const auto block = std::make_shared<Block>(name);
+        const auto block = make_ir<Block>(name);
         if (function != nullptr) [[likely]] {
             block->set_function(function);
         }
@@ -201,6 +254,10 @@ public:
 
     void set_deleted(const bool flag = true) { deleted = flag; }
 
+    [[nodiscard]] size_t get_index() const { return index; }
+
+    void set_index(const size_t index) { this->index = index; }
+
     [[nodiscard]] std::shared_ptr<Function> get_function() const { return parent.lock(); }
 
     [[nodiscard]] std::vector<std::shared_ptr<Instruction>> &get_instructions() { return instructions; }
@@ -209,6 +266,8 @@ public:
 
     [[nodiscard]] std::string to_string() const override;
 
+    void print(Utils::OutputSink &out) const;
+
     void modify_successor(const std::shared_ptr<Block> &old_successor,
                           const std::shared_ptr<Block> &new_successor) const;
 
@@ -2,23 +2,90 @@
 #define VALUE_H
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "Type.h"
+#include "Utils/Parallel.h"
 
 namespace Mir {
 class User;
+class Value;
+
+// 常量、全局变量与函数被多个函数共享，按函数并行执行变换时其use链表会被并发修改
+// 以Value地址分段加锁，仅在并行执行期间生效
+inline std::mutex &use_list_mutex(const Value *value) {
+    static std::array<std::mutex, 64> mutexes;
+    return mutexes[(reinterpret_cast<uintptr_t>(value) >> 4) % mutexes.size()];
+}
+
+// 一条def-use边，由User的操作数槽位持有，并以侵入式双向链表的形式挂在被使用的Value上
+// 插入、删除与替换均为O(1)，不需要额外分配
+class Use {
+    friend class Value;
+    friend class User;
+
+    std::shared_ptr<Value> value_;
+    User *user_;
+    Use *prev_{nullptr};
+    Use *next_{nullptr};
+
+    inline void link();
+
+    inline void unlink();
+
+    // 将other在链表中的位置转移给this
+    inline void take_over(Use &other);
+
+public:
+    Use(User *user, const std::shared_ptr<Value> &value) : value_{value}, user_{user} { link(); }
+
+    Use(const Use &other) = delete;
+
+    Use &operator=(const Use &other) = delete;
+
+    // std::vector扩容或删除元素时会移动Use，此时需要修正链表中相邻节点的指针
+    Use(Use &&other) noexcept : user_{other.user_} { take_over(other); }
+
+    Use &operator=(Use &&other) noexcept {
+        if (this != &other) {
+            unlink();
+            user_ = other.user_;
+            take_over(other);
+        }
+        return *this;
+    }
+
+    ~Use() { unlink(); }
+
+    [[nodiscard]] const std::shared_ptr<Value> &get() const { return value_; }
+
+    [[nodiscard]] User *get_user() const { return user_; }
+
+    [[nodiscard]] Use *get_next() const { return next_; }
+
+    inline void set(const std::shared_ptr<Value> &value);
+};
 
 class Value : public std::enable_shared_from_this<Value> {
+    friend class Use;
     friend class User;
 
 protected:
     std::string name_;
     std::shared_ptr<Type::Type> type_;
-    std::vector<std::weak_ptr<User>> users_{};
+
+private:
+    // 所有使用该Value的操作数槽位，按插入顺序排列
+    Use *use_head_{nullptr};
+    Use *use_tail_{nullptr};
+    size_t use_count_{0};
 
 public:
     Value(std::string name, const std::shared_ptr<Type::Type> &type) : name_{std::move(name)}, type_(type) {}
@@ -41,10 +108,6 @@ public:
 
     [[nodiscard]] std::shared_ptr<Type::Type> get_type() const { return type_; }
 
-    // Value对应的User被销毁后，在users_中可能依然存有对该user的指针
-    // 因此需要在增删user时清理users_，防止出现访存异常
-    void cleanup_users();
-
     // 双向维护关系
     void add_user(const std::shared_ptr<User> &user);
 
@@ -64,13 +127,6 @@ public:
         (remove_user(std::forward<Args>(args)), ...);
     }
 
-protected:
-    // 单向维护关系
-    void _remove_user(const std::shared_ptr<User> &user);
-
-    void _add_user(const std::shared_ptr<User> &user);
-
-public:
     void replace_by_new_value(const std::shared_ptr<Value> &new_value);
 
     [[nodiscard]] virtual bool is_constant() const { return false; }
@@ -79,48 +135,47 @@ public:
         return get_type()->to_string() + std::string{" "} + get_name();
     }
 
+    // 遍历use链表，不产生额外的分配
+    // 同一个User多次使用该Value时（如 add %1, %1），会在遍历中出现多次
     class UserRange {
-        using UserPtr = std::weak_ptr<User>;
-        std::vector<UserPtr> &users_;
+        Use *head_;
+        size_t size_;
 
     public:
-        explicit UserRange(std::vector<UserPtr> &users) : users_{users} {}
+        explicit UserRange(Use *head, const size_t size) : head_{head}, size_{size} {}
 
         struct Iterator {
-            std::vector<UserPtr>::iterator current;
+            Use *current;
 
-            explicit Iterator(const std::vector<UserPtr>::iterator current) : current(current) {}
+            explicit Iterator(Use *current) : current(current) {}
 
-            std::shared_ptr<User> operator*() const { return current->lock(); }
+            inline std::shared_ptr<User> operator*() const;
+
+            bool operator==(const Iterator &other) const { return current == other.current; }
 
             bool operator!=(const Iterator &other) const { return current != other.current; }
 
             Iterator &operator++() {
-                ++current;
+                current = current->get_next();
                 return *this;
             }
         };
 
-        [[nodiscard]] std::vector<std::shared_ptr<User>> lock() const {
-            std::vector<std::shared_ptr<User>> result;
-            result.reserve(users_.size());
-            for (const auto &user_weak: users_) {
-                if (auto user_shared{user_weak.lock()}) {
-                    result.push_back(user_shared);
-                }
-            }
-            return result;
-        }
+        // 获取当前users的快照，每个User只出现一次
+        // 在遍历过程中需要修改use关系时使用
+        [[nodiscard]] std::vector<std::shared_ptr<User>> lock() const;
 
-        [[nodiscard]] size_t size() const { return users_.size(); }
-        [[nodiscard]] Iterator begin() const { return Iterator{users_.begin()}; }
-        [[nodiscard]] Iterator end() const { return Iterator{users_.end()}; }
+        [[nodiscard]] Iterator begin() const { return Iterator{head_}; }
+        [[nodiscard]] Iterator end() const { return Iterator{nullptr}; }
     };
 
-    [[nodiscard]] UserRange users() {
-        cleanup_users();
-        return UserRange{users_};
-    }
+    [[nodiscard]] UserRange users() const { return UserRange{use_head_, use_count_}; }
+
+    // use的数量，O(1)；同一个User多次使用时计多次，只适合判断是否有use
+    [[nodiscard]] size_t num_uses() const { return use_count_; }
+
+    // 所有use都来自同一个User时返回该User，否则返回nullptr
+    [[nodiscard]] std::shared_ptr<User> single_user() const;
 
     template<typename T>
     std::shared_ptr<T> as() {
@@ -133,18 +188,34 @@ public:
         static_assert(std::is_base_of_v<Value, T>, "T must be a derived class of Value or Value itself");
         return std::dynamic_pointer_cast<T>(shared_from_this());
     }
+
+    // 不增加引用计数的裸指针视图，仅在调用者持有该值期间有效，用于链式访问和类型判断
+    template<typename T>
+    T *as_ptr() {
+        static_assert(std::is_base_of_v<Value, T>, "T must be a derived class of Value or Value itself");
+        return static_cast<T *>(this);
+    }
+
+    template<typename T>
+    T *is_ptr() {
+        static_assert(std::is_base_of_v<Value, T>, "T must be a derived class of Value or Value itself");
+        return dynamic_cast<T *>(this);
+    }
 };
 
 class User : public Value {
     friend class Value;
 
 protected:
-    std::vector<std::shared_ptr<Value>> operands_;
+    // 每个操作数槽位持有一个Use
+    std::vector<Use> operands_;
 
-    // 单向维护关系
-    void _add_operand(const std::shared_ptr<Value> &value);
+    // 交换两个操作数槽位中的Value
+    void exchange_operands(size_t i, size_t j);
 
-    void _remove_operand(const std::shared_ptr<Value> &value);
+    // 操作数槽位中的 old_value 被替换为 new_value 后调用，用于维护子类中与操作数相关的额外信息
+    virtual void on_operand_modified(const std::shared_ptr<Value> &old_value,
+                                     const std::shared_ptr<Value> &new_value) {}
 
 public:
     User(const std::string &name, const std::shared_ptr<Type::Type> &type) : Value{name, type} {}
@@ -157,14 +228,80 @@ public:
 
     User &operator=(User &&other) = delete;
 
-    ~User() override {
-        for (const auto &operand: operands_) {
-            operand->_remove_user(std::shared_ptr<User>(this, [](User *) {}));
-        }
-        operands_.clear();
-    }
+    ~User() override = default;
+
+    // 以 std::shared_ptr<Value> 的形式只读访问操作数
+    class OperandRange {
+        const std::vector<Use> &uses_;
+
+    public:
+        explicit OperandRange(const std::vector<Use> &uses) : uses_{uses} {}
+
+        struct Iterator {
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::shared_ptr<Value>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::shared_ptr<Value> *;
+            using reference = const std::shared_ptr<Value> &;
+
+            std::vector<Use>::const_iterator current;
+
+            explicit Iterator(const std::vector<Use>::const_iterator current) : current(current) {}
+
+            reference operator*() const { return current->get(); }
 
-    const std::vector<std::shared_ptr<Value>> &get_operands() const { return operands_; }
+            pointer operator->() const { return &current->get(); }
+
+            reference operator[](const difference_type n) const { return current[n].get(); }
+
+            Iterator &operator++() {
+                ++current;
+                return *this;
+            }
+
+            Iterator operator++(int) { return Iterator{current++}; }
+
+            Iterator &operator--() {
+                --current;
+                return *this;
+            }
+
+            Iterator operator--(int) { return Iterator{current--}; }
+
+            Iterator &operator+=(const difference_type n) {
+                current += n;
+                return *this;
+            }
+
+            Iterator &operator-=(const difference_type n) {
+                current -= n;
+                return *this;
+            }
+
+            Iterator operator+(const difference_type n) const { return Iterator{current + n}; }
+
+            Iterator operator-(const difference_type n) const { return Iterator{current - n}; }
+
+            difference_type operator-(const Iterator &other) const { return current - other.current; }
+
+            bool operator==(const Iterator &other) const { return current == other.current; }
+            bool operator!=(const Iterator &other) const { return current != other.current; }
+            bool operator<(const Iterator &other) const { return current < other.current; }
+            bool operator>(const Iterator &other) const { return current > other.current; }
+            bool operator<=(const Iterator &other) const { return current <= other.current; }
+            bool operator>=(const Iterator &other) const { return current >= other.current; }
+        };
+
+        [[nodiscard]] size_t size() const { return uses_.size(); }
+        [[nodiscard]] bool empty() const { return uses_.empty(); }
+        [[nodiscard]] const std::shared_ptr<Value> &operator[](const size_t index) const { return uses_[index].get(); }
+        [[nodiscard]] Iterator begin() const { return Iterator{uses_.begin()}; }
+        [[nodiscard]] Iterator end() const { return Iterator{uses_.end()}; }
+    };
+
+    [[nodiscard]] OperandRange get_operands() const { return OperandRange{operands_}; }
+
+    [[nodiscard]] const std::shared_ptr<Value> &get_operand(const size_t index) const { return operands_[index].get(); }
 
     // 双向维护关系
     void add_operand(const std::shared_ptr<Value> &value);
@@ -187,13 +324,82 @@ public:
 
     virtual void clear_operands();
 
-    virtual void modify_operand(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value);
+    void modify_operand(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value);
 
-    auto begin() { return operands_.begin(); }
-    auto end() { return operands_.end(); }
-    auto begin() const { return operands_.begin(); }
-    auto end() const { return operands_.end(); }
+    [[nodiscard]] auto begin() const { return get_operands().begin(); }
+    [[nodiscard]] auto end() const { return get_operands().end(); }
 };
+
+inline void Use::link() {
+    if (value_ == nullptr) [[unlikely]] {
+        return;
+    }
+    const Utils::ParallelLock lock{use_list_mutex(value_.get())};
+    prev_ = value_->use_tail_;
+    next_ = nullptr;
+    if (prev_ != nullptr) {
+        prev_->next_ = this;
+    } else {
+        value_->use_head_ = this;
+    }
+    value_->use_tail_ = this;
+    ++value_->use_count_;
+}
+
+inline void Use::unlink() {
+    if (value_ == nullptr) [[unlikely]] {
+        return;
+    }
+    const Utils::ParallelLock lock{use_list_mutex(value_.get())};
+    if (prev_ != nullptr) {
+        prev_->next_ = next_;
+    } else {
+        value_->use_head_ = next_;
+    }
+    if (next_ != nullptr) {
+        next_->prev_ = prev_;
+    } else {
+        value_->use_tail_ = prev_;
+    }
+    prev_ = next_ = nullptr;
+    --value_->use_count_;
+}
+
+inline void Use::take_over(Use &other) {
+    if (other.value_ == nullptr) [[unlikely]] {
+        value_ = nullptr;
+        prev_ = next_ = nullptr;
+        return;
+    }
+    const Utils::ParallelLock lock{use_list_mutex(other.value_.get())};
+    value_ = std::move(other.value_);
+    prev_ = other.prev_;
+    next_ = other.next_;
+    other.prev_ = other.next_ = nullptr;
+    if (prev_ != nullptr) {
+        prev_->next_ = this;
+    } else {
+        value_->use_head_ = this;
+    }
+    if (next_ != nullptr) {
+        next_->prev_ = this;
+    } else {
+        value_->use_tail_ = this;
+    }
+}
+
+inline void Use::set(const std::shared_ptr<Value> &value) {
+    if (value_ == value) {
+        return;
+    }
+    unlink();
+    value_ = value;
+    link();
+}
+
+inline std::shared_ptr<User> Value::UserRange::Iterator::operator*() const {
+    return std::static_pointer_cast<User>(current->get_user()->shared_from_this());
+}
 } // namespace Mir
 
 #endif
@@ -1,23 +1,71 @@
 #ifndef CONTROLFLOWGRAPH_H
 #define CONTROLFLOWGRAPH_H
 
-#include <unordered_set>
+#include <optional>
 
 #include "Pass/Analysis.h"
+#include "Utils/SmallVector.h"
 
 namespace Pass {
+class DominanceGraph;
+
 // ControlFlowGraph 构建控制流图
+// 构建时为函数中的每个基本块分配稠密编号，边表按编号存放，边按终结指令中出现的顺序排列
 class ControlFlowGraph final : public Analysis {
 public:
     using FunctionPtr = std::shared_ptr<Mir::Function>;
     using BlockPtr = std::shared_ptr<Mir::Block>;
-    using BlockPtrMap = std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>>;
+    using BlockList = ::Utils::SmallVector<BlockPtr, 2>;
+
+    // { block -> 边表 }，以 block 的编号为下标
+    class BlockListMap {
+    public:
+        [[nodiscard]] const BlockList &at(const BlockPtr &block) const {
+            if (!count(block)) [[unlikely]] {
+                log_error("Block not in control flow graph: %s", block->get_name().c_str());
+            }
+            return slots_[block->get_index()].second;
+        }
+
+        [[nodiscard]] bool count(const BlockPtr &block) const {
+            return block->get_index() < slots_.size() && slots_[block->get_index()].first == block;
+        }
+
+        // 与 at 相同，但对构建后新建、尚未加入控制流图的块返回空表
+        [[nodiscard]] const BlockList &lookup(const BlockPtr &block) const {
+            static const BlockList empty{};
+            return count(block) ? slots_[block->get_index()].second : empty;
+        }
+
+        // 已分配的编号数（含已删除的块），可用作以编号为下标的数组的大小
+        [[nodiscard]] size_t size() const { return slots_.size(); }
+
+    private:
+        friend class ControlFlowGraph;
+
+        BlockList &edges(const BlockPtr &block) { return const_cast<BlockList &>(at(block)); }
+
+        // 已删除的块对应的槽位为空
+        std::vector<std::pair<BlockPtr, BlockList>> slots_;
+    };
 
     struct Graph {
-        // 前驱块关系：{ block -> {所有前驱块} }
-        BlockPtrMap predecessors{};
-        // 后继块关系：{ block -> {所有后继块} }
-        BlockPtrMap successors{};
+        // 前驱块关系：{ block -> [所有前驱块] }
+        BlockListMap predecessors{};
+        // 后继块关系：{ block -> [所有后继块] }
+        BlockListMap successors{};
+
+        // 从入口块出发的后序与逆后序遍历，不含不可达的块，首次查询时计算，控制流图被修改时丢弃
+        [[nodiscard]] const std::vector<BlockPtr> &post_order() const;
+
+        [[nodiscard]] const std::vector<BlockPtr> &reverse_post_order() const;
+
+    private:
+        friend class ControlFlowGraph;
+
+        BlockPtr entry_{nullptr};
+        mutable std::optional<std::vector<BlockPtr>> post_order_{};
+        mutable std::optional<std::vector<BlockPtr>> reverse_post_order_{};
     };
 
     [[nodiscard]]
@@ -37,14 +85,56 @@ public:
 
     void set_dirty(const FunctionPtr &func);
 
+    void invalidate(const std::shared_ptr<Mir::Function> &function) override { set_dirty(function); }
+
+    void prepare(const std::shared_ptr<const Mir::Module> &module) override;
+
     void remove(const FunctionPtr &func) { graphs_.erase(func); }
 
-    [[nodiscard]] std::vector<BlockPtr> reverse_post_order(const FunctionPtr &func) const;
+    // 逆后序遍历，要求所有块都可达
+    [[nodiscard]] const std::vector<BlockPtr> &reverse_post_order(const FunctionPtr &func) const;
+
+    // 增量更新：变换修改控制流的同时调用，就地修补控制流图与支配树，使两者在变换后依然有效
+    // 循环信息总是失效；func 的控制流图已经失效时不做任何事，下次请求时会重新计算
+
+    // 新增边 from -> to
+    void insert_edge(const FunctionPtr &func, const BlockPtr &from, const BlockPtr &to);
+
+    // 删除边 from -> to
+    void delete_edge(const FunctionPtr &func, const BlockPtr &from, const BlockPtr &to);
+
+    // block 的所有出边转移给新块 new_block，并新增边 block -> new_block
+    void split_block(const FunctionPtr &func, const BlockPtr &block, const BlockPtr &new_block);
+
+    // child 是 block 的唯一后继且 block 是 child 的唯一前驱：child 并入 block，其出边转移给 block
+    void merge_blocks(const FunctionPtr &func, const BlockPtr &block, const BlockPtr &child);
+
+    // block 只有唯一的后继：删除 block，其前驱改为直接跳转到该后继
+    void bypass_block(const FunctionPtr &func, const BlockPtr &block);
+
+    // 删除不可达的 block 及其所有边
+    void remove_block(const FunctionPtr &func, const BlockPtr &block);
+
+    // 新建的 block：按其终结指令新增出边，出边指向的新块也需要各自加入
+    void insert_block(const FunctionPtr &func, const BlockPtr &block);
 
 protected:
     void analyze(std::shared_ptr<const Mir::Module> module) override;
 
 private:
+    // 为新出现的 block 分配编号并建立空的边表
+    static void add_block(Graph &graph, const BlockPtr &block);
+
+    static void erase_block(Graph &graph, const BlockPtr &block);
+
+    // 边已存在时不重复添加
+    static void add_edge(Graph &graph, const BlockPtr &from, const BlockPtr &to);
+
+    static void remove_edge(Graph &graph, const BlockPtr &from, const BlockPtr &to);
+
+    // 修补完成后调用：丢弃缓存的遍历顺序并修补支配树，update 返回 false 时由更新后的控制流图重新计算
+    void update_dominance(const FunctionPtr &func, const std::function<bool(DominanceGraph &)> &update);
+
     std::unordered_map<FunctionPtr, Graph> graphs_;
 
     std::unordered_map<FunctionPtr, bool> dirty_funcs_;
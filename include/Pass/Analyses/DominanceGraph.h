@@ -1,12 +1,14 @@
 #ifndef DOMINANCEGRAPH_H
 #define DOMINANCEGRAPH_H
 
+#include <optional>
 #include <unordered_set>
 
-#include "Pass/Analysis.h"
+#include "Pass/Analyses/ControlFlowGraph.h"
 
 namespace Pass {
 // DominanceGraph 构建基本块的支配图
+// 只保存支配树及其先序遍历区间，支配关系的查询为 O(1)，支配边界在首次查询时计算
 class DominanceGraph final : public Analysis {
 public:
     using FunctionPtr = std::shared_ptr<Mir::Function>;
@@ -16,16 +18,40 @@ public:
     explicit DominanceGraph() : Analysis("DominanceGraph") {}
 
     struct Graph {
-        // 被支配块集合：{ block -> {被该块支配的所有块集合（含自身）} }
-        BlockPtrMap dominated_blocks{};
-        // 支配块集合：{ block -> {支配该块的所有块集合（含自身）} }
-        BlockPtrMap dominator_blocks{};
-        // 直接支配者：{ block -> 该块的唯一直接支配者（支配树中的父节点） }
+        // 直接支配者：{ block -> 该块的唯一直接支配者（支配树中的父节点） }，不含入口块与不可达的块
         std::unordered_map<BlockPtr, BlockPtr> immediate_dominator{};
         // 支配树子节点：{ block -> {该块在支配树中的直接子节点} }
         BlockPtrMap dominance_children{};
-        // 支配边界集合：function -> { block -> {该块的支配边界} }
-        BlockPtrMap dominance_frontier{};
+
+        // a 是否支配 b（a == b 时为真），不可达的块被任意块支配
+        [[nodiscard]] bool dominates(const BlockPtr &a, const BlockPtr &b) const;
+
+        [[nodiscard]] bool strictly_dominates(const BlockPtr &a, const BlockPtr &b) const {
+            return a != b && dominates(a, b);
+        }
+
+        // 被 block 支配的块数（含自身），即支配树中以 block 为根的子树大小，不可达的块为 0
+        [[nodiscard]] size_t dominated_count(const BlockPtr &block) const;
+
+        // 在支配树中的深度，入口块与不可达的块为 0
+        [[nodiscard]] size_t depth(const BlockPtr &block) const;
+
+    private:
+        friend class DominanceGraph;
+
+        // 支配树先序遍历的编号：b 被 a 支配当且仅当 a.pre <= b.pre <= a.last
+        struct Interval {
+            size_t pre;
+            size_t last;
+            size_t depth;
+        };
+
+        std::unordered_map<BlockPtr, Interval> intervals_{};
+        // 支配树的先序与后序遍历，与 intervals_ 一同生成
+        std::vector<BlockPtr> pre_order_{};
+        std::vector<BlockPtr> post_order_{};
+        // 支配边界，由 DominanceGraph::dominance_frontier 在首次查询时填充
+        std::optional<BlockPtrMap> dominance_frontier_{};
     };
 
     const Graph &graph(const FunctionPtr &func) const {
@@ -36,11 +62,15 @@ public:
         return it->second;
     }
 
+    // block 的支配边界，首次查询时由控制流图为整个函数计算
+    // 并行执行时每个函数的结果只由处理该函数的线程读写
+    const std::unordered_set<BlockPtr> &dominance_frontier(const FunctionPtr &func, const BlockPtr &block);
+
     std::vector<BlockPtr> dom_tree_layer(const FunctionPtr &func);
 
-    std::vector<BlockPtr> pre_order_blocks(const FunctionPtr &func);
+    [[nodiscard]] const std::vector<BlockPtr> &pre_order_blocks(const FunctionPtr &func) const;
 
-    std::vector<BlockPtr> post_order_blocks(const FunctionPtr &func);
+    [[nodiscard]] const std::vector<BlockPtr> &post_order_blocks(const FunctionPtr &func) const;
 
     bool is_dirty() const override;
 
@@ -48,12 +78,37 @@ public:
 
     void set_dirty(const FunctionPtr &func);
 
+    void invalidate(const std::shared_ptr<Mir::Function> &function) override { set_dirty(function); }
+
+    void prepare(const std::shared_ptr<const Mir::Module> &module) override;
+
     void remove(const FunctionPtr &func) { graphs_.erase(func); }
 
 protected:
     void analyze(std::shared_ptr<const Mir::Module> module) override;
 
 private:
+    // 以下由 ControlFlowGraph 的增量更新在控制流图修补完成后调用
+    friend class ControlFlowGraph;
+
+    // 由 func 的控制流图重新计算其支配树
+    void compute(const FunctionPtr &func, const ControlFlowGraph::Graph &cfg);
+
+    // 在支配树上先序遍历，为每个块记录编号区间与深度，同时记录先序与后序遍历
+    static void number_tree(const FunctionPtr &func, Graph &graph);
+
+    // 返回 false 表示无法确定支配树不变，需要重新计算
+    bool insert_edge(const FunctionPtr &func, const BlockPtr &from, const BlockPtr &to);
+
+    bool delete_edge(const FunctionPtr &func, const BlockPtr &from, const BlockPtr &to);
+
+    void split_block(const FunctionPtr &func, const BlockPtr &block, const BlockPtr &new_block);
+
+    // block 只有唯一前驱或唯一后继，控制流沿它收缩后被删除：其子节点改挂到它的直接支配者下
+    bool contract_block(const FunctionPtr &func, const BlockPtr &block);
+
+    bool remove_block(const FunctionPtr &func, const BlockPtr &block);
+
     std::unordered_map<FunctionPtr, Graph> graphs_;
 
     std::unordered_map<FunctionPtr, bool> dirty_funcs_;
@@ -879,7 +879,7 @@ public:
                 return intervals.at(value);
             }
             if (value->is_constant()) {
-                const auto constant{value->as<Mir::Const>()->get_constant_value()};
+                const auto constant{value->as_ptr<Mir::Const>()->get_constant_value()};
                 if (constant.holds<int>()) {
                     return AnyIntervalSet{IntervalSet(constant.get<int>())};
                 }
@@ -165,6 +165,10 @@ public:
 
     void set_dirty(const FunctionPtr &func);
 
+    void invalidate(const std::shared_ptr<Mir::Function> &function) override { set_dirty(function); }
+
+    void prepare(const std::shared_ptr<const Mir::Module> &module) override;
+
 private:
     using FunctLoopsMap = std::unordered_map<std::shared_ptr<Mir::Function>, std::vector<std::shared_ptr<Loop>>>;
     FunctLoopsMap loops_;
@@ -1,13 +1,31 @@
 #ifndef ANALYSIS_H
 #define ANALYSIS_H
 
+#include <algorithm>
+#include <map>
+#include <mutex>
 #include <type_traits>
 #include <typeindex>
+#include <unordered_set>
 #include <utility>
 
 #include "Pass.h"
+#include "Utils/Parallel.h"
 
 namespace Pass {
+// 按函数并行执行变换时，当前线程正在处理的函数；串行执行时为空
+inline std::shared_ptr<Mir::Function> &_current_function() {
+    static thread_local std::shared_ptr<Mir::Function> function;
+    return function;
+}
+
+// 保护分析结果缓存与统计信息，仅在并行执行期间加锁
+// 按函数失效的分析在持锁时会级联地使其它分析失效，因此使用递归锁
+inline std::recursive_mutex &_analysis_mutex() {
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
 // 计算相关IR单元的高层信息，但不对其进行修改
 // 提供其它pass需要查询的信息并提供查询接口
 class Analysis : public Pass {
@@ -23,26 +41,126 @@ public:
 
     void run_on(const std::shared_ptr<const Mir::Module> &module) { analyze(module); }
 
+    // 不支持按函数失效的分析只维护一个整体的标记，由 get_analysis_result 在计算后清除
     [[nodiscard]]
     virtual bool is_dirty() const {
-        return true;
+        return dirty_;
     }
 
     [[nodiscard]]
     virtual bool is_dirty(const std::shared_ptr<Mir::Function> &function) const {
-        return true;
+        return dirty_;
+    }
+
+    void set_clean() { dirty_ = false; }
+
+    // 变换未保留该分析时调用：支持按函数失效的分析只失效 function，其余分析整体失效
+    // 并行执行期间其它线程仍在读取整体结果，由并行驱动在所有函数处理完毕后统一失效
+    virtual void invalidate(const std::shared_ptr<Mir::Function> &function) {
+        if (_current_function() == nullptr) {
+            dirty_ = true;
+        }
     }
 
+    // 按函数并行执行前调用：支持按函数失效的分析为模块中的每个函数预留结果槽位
+    // 此后各线程只读写自己所处理函数的槽位，不再改变容器的结构
+    virtual void prepare(const std::shared_ptr<const Mir::Module> &module) {}
+
 protected:
     // 子类必须实现的纯虚函数（只读版本）
     virtual void analyze(std::shared_ptr<const Mir::Module> module) = 0;
+
+    // 记录一次按函数的计算或复用，供 -stats 统计
+    void record_function(bool recomputed) const;
+
+    // 本次 analyze 需要处理的函数：并行执行时只处理当前线程的函数
+    [[nodiscard]] static std::vector<std::shared_ptr<Mir::Function>>
+    functions_to_analyze(const std::shared_ptr<const Mir::Module> &module);
+
+private:
+    bool dirty_{true};
+};
+
+// 变换声明的、在其运行后依然有效的分析集合
+// 变换结束后，管理器会使所有未被保留的分析失效
+class PreservedAnalyses {
+public:
+    static PreservedAnalyses all() {
+        PreservedAnalyses preserved;
+        preserved.all_ = true;
+        return preserved;
+    }
+
+    static PreservedAnalyses none() { return PreservedAnalyses{}; }
+
+    // ControlFlowGraph, DominanceGraph 与 LoopAnalysis
+    // 修改了控制流的变换需要自行对修改过的函数调用 set_analysis_result_dirty
+    static PreservedAnalyses control_flow();
+
+    template<typename T>
+    PreservedAnalyses &preserve() {
+        static_assert(std::is_base_of_v<Analysis, T>, "T must be a subclass of Analysis");
+        preserved_.insert(std::type_index(typeid(T)));
+        return *this;
+    }
+
+    [[nodiscard]] bool preserved(const std::type_index &idx) const { return all_ || preserved_.count(idx); }
+
+private:
+    bool all_{false};
+    std::unordered_set<std::type_index> preserved_;
+};
+
+// 每种分析的请求与计算次数
+struct AnalysisStatistics {
+    size_t requests{0};
+    size_t computations{0};
+    size_t functions_computed{0};
+    size_t functions_reused{0};
 };
 
+inline std::map<std::string, AnalysisStatistics> &_analysis_statistics() {
+    static std::map<std::string, AnalysisStatistics> statistics;
+    return statistics;
+}
+
+std::string analysis_statistics_string();
+
+// 正在运行的变换（可能嵌套）各自声明保留的分析，每个线程各有一份
+inline std::vector<PreservedAnalyses> &_running_transforms() {
+    static thread_local std::vector<PreservedAnalyses> running_transforms;
+    return running_transforms;
+}
+
+// 所有正在运行的变换都保留了该分析时，其缓存的结果才可能是有效的
+inline bool _preserved_by_running_transforms(const std::type_index &idx) {
+    const auto &running = _running_transforms();
+    return std::all_of(running.begin(), running.end(),
+                       [&](const PreservedAnalyses &preserved) { return preserved.preserved(idx); });
+}
+
+// 在变换结束后使其未保留的分析失效，function 为空时作用于整个模块
+void invalidate_analyses(const PreservedAnalyses &preserved, const std::shared_ptr<Mir::Module> &module,
+                         const std::shared_ptr<Mir::Function> &function = nullptr);
+
 inline std::unordered_map<std::type_index, std::shared_ptr<Analysis>> &_analysis_results() {
     static std::unordered_map<std::type_index, std::shared_ptr<Analysis>> analysis_results;
     return analysis_results;
 }
 
+// 丢弃模块中已不存在的函数对应的结果，其余函数的结果保持不变
+template<typename... FunctionMaps>
+void prune_removed_functions(const std::shared_ptr<const Mir::Module> &module, FunctionMaps &...maps) {
+    const std::unordered_set<std::shared_ptr<Mir::Function>> alive(module->get_functions().begin(),
+                                                                   module->get_functions().end());
+    const auto prune = [&](auto &map) {
+        for (auto it = map.begin(); it != map.end();) {
+            it = alive.count(it->first) ? std::next(it) : map.erase(it);
+        }
+    };
+    (prune(maps), ...);
+}
+
 template<typename, typename = void>
 struct has_set_dirty : std::false_type {};
 
@@ -59,6 +177,7 @@ void set_analysis_result_dirty(const std::shared_ptr<Mir::Function> &function) {
     static_assert(std::is_base_of_v<Analysis, T>, "T must be a subclass of Analysis");
     static_assert(has_set_dirty_v<T>, "Analysis type T cannot set dirty");
     const std::type_index idx(typeid(T));
+    const ::Utils::ParallelLock lock{_analysis_mutex()};
     if (const auto it = _analysis_results().find(idx);
         it != _analysis_results().end() && !it->second->is_dirty(function)) [[likely]] {
         std::static_pointer_cast<T>(it->second)->set_dirty(function);
@@ -70,6 +189,7 @@ void set_analysis_result_dirty(const std::shared_ptr<Mir::Module> &module) {
     static_assert(std::is_base_of_v<Analysis, T>, "T must be a subclass of Analysis");
     static_assert(has_set_dirty_v<T>, "Analysis type T cannot set dirty");
     const std::type_index idx(typeid(T));
+    const ::Utils::ParallelLock lock{_analysis_mutex()};
     if (const auto it = _analysis_results().find(idx); it != _analysis_results().end()) {
         for (const auto &func: module->get_functions()) {
             std::static_pointer_cast<T>(it->second)->set_dirty(func);
@@ -77,23 +197,74 @@ void set_analysis_result_dirty(const std::shared_ptr<Mir::Module> &module) {
     }
 }
 
+// 已经计算过且对 function 仍然有效的分析结果，不存在或已失效时返回空，不会触发计算
+// 供增量更新使用：失效的结果在下次请求时会整体重新计算，无需修补
+template<typename T>
+std::shared_ptr<T> valid_analysis_result(const std::shared_ptr<Mir::Function> &function) {
+    static_assert(std::is_base_of_v<Analysis, T>, "T must be a subclass of Analysis");
+    static_assert(has_set_dirty_v<T>, "Analysis type T cannot be updated per function");
+    const std::type_index idx(typeid(T));
+    const ::Utils::ParallelLock lock{_analysis_mutex()};
+    if (const auto it = _analysis_results().find(idx);
+        it != _analysis_results().end() && !it->second->is_dirty(function)) {
+        return std::static_pointer_cast<T>(it->second);
+    }
+    return nullptr;
+}
+
 template<typename T, typename... Args>
 std::shared_ptr<T> get_analysis_result(const std::shared_ptr<Mir::Module> module, Args &&... args) {
     static_assert(std::is_base_of_v<Analysis, T>, "T must be a subclass of Analysis");
     // 检查 PassType 是否是非抽象类
     static_assert(!std::is_abstract_v<T>, "PassType must not be an abstract class");
     const std::type_index idx(typeid(T));
-    if (const auto it = _analysis_results().find(idx); it != _analysis_results().end()) {
-        const auto existing_analysis = it->second;
-        if (existing_analysis->is_dirty()) {
-            existing_analysis->run_on(module);
+    const auto &function = _current_function();
+    std::shared_ptr<Analysis> analysis;
+    bool recompute = true;
+    {
+        const ::Utils::ParallelLock lock{_analysis_mutex()};
+        auto &statistics = _analysis_statistics();
+        if (const auto it = _analysis_results().find(idx); it != _analysis_results().end()) {
+            analysis = it->second;
+            if (function == nullptr) {
+                // 按函数失效的分析由变换通过 set_dirty 报告修改，其余分析在未被保留的变换运行期间每次请求都重新计算
+                recompute = analysis->is_dirty() || (!has_set_dirty_v<T> && !_preserved_by_running_transforms(idx));
+            } else if constexpr (has_set_dirty_v<T>) {
+                // 并行执行时只重新计算当前函数
+                recompute = analysis->is_dirty(function);
+            } else {
+                // 整体分析是并行执行前准备好的快照，执行期间不重新计算
+                if (analysis->is_dirty()) [[unlikely]] {
+                    log_error("Analysis %s is not prepared before running in parallel", analysis->name().c_str());
+                }
+                recompute = false;
+            }
+        } else {
+            if constexpr (!has_set_dirty_v<T>) {
+                if (function != nullptr) [[unlikely]] {
+                    log_error("Analysis %s is not prepared before running in parallel", typeid(T).name());
+                }
+            }
+            analysis = std::make_shared<T>(std::forward<Args>(args)...);
+            if (function != nullptr) {
+                analysis->prepare(module);
+            }
+            _analysis_results()[idx] = analysis;
+        }
+        auto &stat = statistics[analysis->name()];
+        ++stat.requests;
+        if (recompute) {
+            ++stat.computations;
+        }
+    }
+    if (recompute) {
+        const ::Utils::TraceSpan span{"analysis", analysis->name()};
+        analysis->run_on(module);
+        if (function == nullptr) {
+            analysis->set_clean();
         }
-        return std::static_pointer_cast<T>(existing_analysis);
     }
-    const auto analysis = std::make_shared<T>(std::forward<Args>(args)...);
-    analysis->run_on(module);
-    _analysis_results()[idx] = analysis;
-    return analysis;
+    return std::static_pointer_cast<T>(analysis);
 }
 
 template<typename T, typename... Args>
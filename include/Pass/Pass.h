@@ -1,15 +1,21 @@
 #ifndef PASS_H
 #define PASS_H
 
+#include <functional>
 #include <memory>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "Mir/Structure.h"
 #include "Utils/Log.h"
+#include "Utils/TimeReport.h"
 
 namespace Pass {
 class Analysis;
 
+class Transform;
+
 class Pass {
 public:
     enum class PassType { ANALYSIS, TRANSFORM, UTIL };
@@ -49,11 +55,56 @@ private:
     std::string name_;
 };
 
+// 模块中（未删除的）函数、基本块与指令的数量
+[[nodiscard]] ::Utils::IRSize ir_size(const std::shared_ptr<Mir::Module> &module);
+
+// 执行一次变换，开启 -ftime-report 时记录其耗时、前后的 IR 规模与期间重新计算的分析次数，开启 -ftrace 时记录为一段区间
+void run_timed(const std::shared_ptr<Mir::Module> &module, const std::string &name, const std::function<void()> &run);
+
 inline std::shared_ptr<Mir::Module> operator|(std::shared_ptr<Mir::Module> module, const std::shared_ptr<Pass> &pass) {
     log_info("Running pass: %s", pass->name().c_str());
-    pass->run_on(module);
+    run_timed(module, pass->name(), [&] { pass->run_on(module); });
     return module;
 }
+
+// 按函数并行执行变换使用的线程数，为 1 时所有变换都串行执行
+void set_function_parallelism(size_t threads);
+
+[[nodiscard]] size_t function_parallelism();
+
+// 每个函数由一个新建的变换实例处理，全部完成后返回是否有函数被修改
+bool run_on_functions_in_parallel(const std::shared_ptr<Mir::Module> &module,
+                                  const std::function<std::shared_ptr<Transform>()> &create_transform);
+
+// 只读写单个函数的变换（FunctionTransform）
+template<typename, typename = void>
+struct is_function_transform : std::false_type {};
+
+template<typename T>
+struct is_function_transform<T, std::void_t<decltype(T::prepare(std::declval<std::shared_ptr<Mir::Module>>()))>>
+        : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_function_transform_v = is_function_transform<T>::value;
+
+// 不动点迭代的轮数上限
+inline constexpr size_t max_fixpoint_iterations = 8;
+
+// 按函数的变换在不动点驱动中的类型擦除形式
+struct FunctionPassEntry {
+    void (*prepare)(const std::shared_ptr<Mir::Module> &);
+    std::shared_ptr<Transform> (*create)();
+};
+
+template<typename PassType>
+FunctionPassEntry function_pass_entry() {
+    static_assert(is_function_transform_v<PassType>, "PassType must be a FunctionTransform");
+    return {&PassType::prepare, []() -> std::shared_ptr<Transform> { return Pass::create<PassType>(); }};
+}
+
+// 对每个函数依次执行 group 中的变换，直到一轮中没有变换报告修改了该函数，至多 max_fixpoint_iterations 轮
+// 已到达不动点的函数在之后的轮次中跳过，开启并行时每一轮的函数分发到线程池上执行，返回是否有函数被修改
+bool run_until_fixpoint(const std::shared_ptr<Mir::Module> &module, const std::vector<FunctionPassEntry> &group);
 } // namespace Pass
 
 // 对每个 Passes 类型进行检查
@@ -64,14 +115,46 @@ struct PassChecker {
     static_assert(!std::is_base_of_v<Pass::Analysis, PassType>, "Use get_analysis_result instead");
 };
 
+// 按函数的变换逐函数执行（每个函数在 -ftrace 中各有一段区间），开启并行时分发到线程池
+// 其余变换作为屏障在所有函数处理完毕后串行执行
+template<typename PassType>
+void apply_one(std::shared_ptr<Mir::Module> &module) {
+    if constexpr (Pass::is_function_transform_v<PassType>) {
+        const auto pass = Pass::Pass::create<PassType>();
+        if (Pass::function_parallelism() > 1) {
+            log_info("Running pass in parallel: %s", pass->name().c_str());
+        } else {
+            log_info("Running pass: %s", pass->name().c_str());
+        }
+        Pass::run_timed(module, pass->name(), [&] {
+            PassType::prepare(module);
+            Pass::run_on_functions_in_parallel(module, [] { return Pass::Pass::create<PassType>(); });
+        });
+        return;
+    }
+    module = module | Pass::Pass::create<PassType>();
+}
+
 template<typename... Passes>
 void apply(std::shared_ptr<Mir::Module> &module) {
     (void) std::initializer_list<int>{(PassChecker<Passes>(), 0)...};
-    (..., (module = module | Pass::Pass::create<Passes>()));
+    (..., apply_one<Passes>(module));
+}
+
+// 按函数反复执行 Passes 直到不动点，只能包含 FunctionTransform
+template<typename... Passes>
+void apply_until_fixpoint(std::shared_ptr<Mir::Module> &module) {
+    (void) std::initializer_list<int>{(PassChecker<Passes>(), 0)...};
+    Pass::run_until_fixpoint(module, {Pass::function_pass_entry<Passes>()...});
 }
 
 void execute_O0_passes(std::shared_ptr<Mir::Module> &module);
 
 void execute_O1_passes(std::shared_ptr<Mir::Module> &module);
 
+void execute_O2_passes(std::shared_ptr<Mir::Module> &module);
+
+// 执行 -passes= 指定的流水线，其后补上后端所需的 RemovePhi
+void execute_pipeline(std::shared_ptr<Mir::Module> &module, const std::string &pipeline);
+
 #endif // PASS_H
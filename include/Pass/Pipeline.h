@@ -0,0 +1,71 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Mir/Structure.h"
+
+namespace Pass {
+// 文本形式的变换流水线，例如 "gep-folding,fixpoint(lvn,simplify-cfg),dce"
+// 以逗号分隔的变换按顺序执行，变换名见 registered_passes()
+// fixpoint(...) 中的变换反复执行，直到某一轮执行后 IR 不再变化，至多执行 max_fixpoint_iterations 轮，可以嵌套
+// 组内全部是按函数的变换时由 run_until_fixpoint 逐函数迭代，否则依据每个变换报告的修改判断一轮中 IR 是否变化
+class Pipeline {
+public:
+    // 语法错误或变换名未注册时 log_error
+    [[nodiscard]] static Pipeline parse(const std::string &text);
+
+    void run(std::shared_ptr<Mir::Module> &module) const;
+
+    // 规范化的文本形式，可以再次解析
+    [[nodiscard]] std::string to_string() const;
+
+    // 流水线中（包括 fixpoint 组内）是否有名为 pass 的变换
+    [[nodiscard]] bool contains(const std::string &pass) const;
+
+    // 后端要求没有 phi、常量比较已经折叠、控制流图已经化简的 IR，与各个 -O 级别的结尾相同
+    // 在每个 remove-phi 之前补上 algebraic-simplify 与 simplify-cfg，没有 remove-phi 时在最后追加这三个变换
+    [[nodiscard]] Pipeline lowered_for_backend() const;
+
+private:
+    // pass 为空时是 fixpoint 组
+    struct Node {
+        std::string pass;
+        std::vector<Node> group;
+    };
+
+    std::vector<Node> nodes_;
+
+    static void run(const std::vector<Node> &nodes, std::shared_ptr<Mir::Module> &module);
+
+    // 以下返回是否修改了模块
+    static bool run_tracked(const std::vector<Node> &nodes, std::shared_ptr<Mir::Module> &module);
+
+    static bool run_group(const std::vector<Node> &group, std::shared_ptr<Mir::Module> &module);
+
+    static std::string to_string(const std::vector<Node> &nodes);
+
+    static bool contains(const std::vector<Node> &nodes, const std::string &pass);
+
+    static std::vector<Node> lowered_for_backend(const std::vector<Node> &nodes);
+};
+
+// 已知会在部分输入上崩溃或生成错误代码的变换，注册名带有此前缀，使用时给出警告
+inline const std::string unsafe_pass_prefix = "unsafe-";
+
+// 可以在流水线中使用的全部变换名，按字典序排列
+[[nodiscard]] std::vector<std::string> registered_passes();
+
+// -O2 在 Mem2Reg 之后执行的流水线
+// 在 -O1 的基础上增加了 GVN、LICM、GCM、重新关联、树高平衡、无用参数与返回值删除以及指令调度，与 -O1 相同不执行尾调用优化
+inline const std::string O2_pipeline = "lvn,gep-folding,dce,fixpoint(lvn,simplify-cfg),inline,dead-func-eliminate,"
+                                       "global-variable-localize,global-array-localize,load-eliminate,store-eliminate,"
+                                       "algebraic-simplify,fixpoint(gvn,simplify-cfg),reassociate,tree-height-balance,"
+                                       "gvn,licm,gcm,dce,fixpoint(lvn,simplify-cfg),constexpr-func-eval,"
+                                       "dead-func-arg-eliminate,dead-return-eliminate,dead-func-eliminate,"
+                                       "constrain-reduce,inst-schedule,remove-phi,block-positioning";
+} // namespace Pass
+
+#endif // PIPELINE_H
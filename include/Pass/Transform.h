@@ -1,6 +1,8 @@
 #ifndef TRANSFORM_H
 #define TRANSFORM_H
 
+#include "Analysis.h"
+#include "Mir/Builder.h"
 #include "Mir/Instruction.h"
 #include "Pass.h"
 
@@ -8,16 +10,77 @@ namespace Pass {
 // 以某种方式改变和优化IR，并保证改变后的IR仍然合法有效
 class Transform : public Pass {
 public:
-    explicit Transform(const std::string &name) : Pass(PassType::TRANSFORM, name) {}
+    // preserved 为变换运行后依然有效的分析，默认不保留任何分析
+    // 不改变控制流或对修改过的函数自行报告的变换应传入 PreservedAnalyses::control_flow()
+    explicit Transform(const std::string &name, PreservedAnalyses preserved = PreservedAnalyses::none()) :
+        Pass(PassType::TRANSFORM, name), preserved_{std::move(preserved)} {}
 
-    void run_on(const std::shared_ptr<Mir::Module> module) override { transform(module); }
+    void run_on(const std::shared_ptr<Mir::Module> module) override { run_on_module(module); }
 
-    void run_on(const std::shared_ptr<Mir::Function> &function) { transform(function); }
+    // 与 run_on 相同，返回模块是否被修改
+    bool run_on_module(const std::shared_ptr<Mir::Module> &module) {
+        const Scope scope{preserved_analyses(), module, nullptr};
+        return transform(module);
+    }
+
+    // 按函数运行时，支持按函数失效的分析只失效该函数，返回该函数是否被修改
+    bool run_on(const std::shared_ptr<Mir::Function> &function) {
+        const ::Utils::TraceSpan span{"function", function->get_name()};
+        const Scope scope{preserved_analyses(), Mir::Module::instance(), function};
+        const Mir::Builder::NameScope name_scope{*function};
+        return transform(function);
+    }
+
+    [[nodiscard]] const PreservedAnalyses &preserved_analyses() const { return preserved_; }
 
 protected:
-    virtual void transform(std::shared_ptr<Mir::Module> module) = 0;
+    // 返回是否修改了模块，无法确定时返回 true
+    virtual bool transform(std::shared_ptr<Mir::Module> module) = 0;
+
+    // 返回是否修改了该函数，无法确定时返回 true
+    virtual bool transform(const std::shared_ptr<Mir::Function> &) { return transform(Mir::Module::instance()); }
+
+private:
+    const PreservedAnalyses preserved_;
+
+    // 变换运行期间登记其保留的分析，结束时（包括异常退出）使其余分析失效
+    struct Scope {
+        const PreservedAnalyses preserved;
+        const std::shared_ptr<Mir::Module> module;
+        const std::shared_ptr<Mir::Function> function;
+
+        Scope(PreservedAnalyses preserved, std::shared_ptr<Mir::Module> module,
+              std::shared_ptr<Mir::Function> function) :
+            preserved{std::move(preserved)}, module{std::move(module)}, function{std::move(function)} {
+            _running_transforms().push_back(this->preserved);
+        }
+
+        ~Scope() {
+            _running_transforms().pop_back();
+            invalidate_analyses(preserved, module, function);
+        }
 
-    virtual void transform(const std::shared_ptr<Mir::Function> &) { transform(Mir::Module::instance()); }
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+    };
+};
+
+// 只读写单个函数的变换，开启 -fparallel-passes 后按函数在线程池上并行执行
+// ModuleAnalyses 为执行期间需要查询的整体分析，在并行执行前计算好，执行期间作为只读快照
+// 按函数失效的分析（控制流图、支配树、循环）无需列出，各线程按需只重新计算自己的函数
+template<typename... ModuleAnalyses>
+class FunctionTransform : public Transform {
+public:
+    explicit FunctionTransform(const std::string &name, PreservedAnalyses preserved = PreservedAnalyses::none()) :
+        Transform(name, std::move(preserved)) {}
+
+    static void prepare(const std::shared_ptr<Mir::Module> &module) {
+        (get_analysis_result<ModuleAnalyses>(module), ...);
+    }
+
+protected:
+    bool transform(const std::shared_ptr<Mir::Function> &) override = 0;
 };
 } // namespace Pass
 
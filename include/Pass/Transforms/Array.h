@@ -8,30 +8,32 @@
 
 namespace Pass {
 // getelementptr 折叠：将嵌套的 getelementptr 指令链折叠为单一 getelementptr 指令
-class GepFolding final : public Transform {
+class GepFolding final : public FunctionTransform<> {
 public:
-    explicit GepFolding() : Transform("GepFolding") {}
+    // 只合并 gep，不改变控制流
+    explicit GepFolding() : FunctionTransform("GepFolding", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
     std::shared_ptr<DominanceGraph> dom_graph{nullptr};
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func) const;
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func) const;
 };
 
 // 冗余加载消除：跟踪内存的 store 和 load 操作，通过替换重复的 load 来减少不必要的内存访问
 class LoadEliminate final : public Transform {
 public:
-    explicit LoadEliminate() : Transform("LoadEliminate") {}
+    // 只删除冗余的 load，不改变控制流
+    explicit LoadEliminate() : Transform("LoadEliminate", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
     using ValuePtr = std::shared_ptr<Mir::Value>;
@@ -71,12 +73,13 @@ private:
 // 冗余存储消除：删除同一地址的连续 store 操作与未使用的 store 操作
 class StoreEliminate final : public Transform {
 public:
-    explicit StoreEliminate() : Transform("StoreEliminate") {}
+    // 只删除冗余的 store，不改变控制流
+    explicit StoreEliminate() : Transform("StoreEliminate", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
     using ValuePtr = std::shared_ptr<Mir::Value>;
@@ -89,7 +92,7 @@ private:
 
     std::unordered_set<std::shared_ptr<Mir::Instruction>> deleted_instructions;
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func);
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 
     void handle_load(const std::shared_ptr<Mir::Load> &load);
 
@@ -106,12 +109,13 @@ private:
 // 聚集对象的标量替换: scalar replacement of aggregate
 class SROA final : public Transform {
 public:
-    explicit SROA() : Transform("SROA") {}
+    // 只拆分局部数组，不改变控制流
+    explicit SROA() : Transform("SROA", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
     using IndexMap = std::unordered_map<int, std::vector<std::shared_ptr<Mir::GetElementPtr>>>;
@@ -122,7 +126,8 @@ private:
 
     std::unordered_set<std::shared_ptr<Mir::Instruction>> deleted_instructions;
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func);
+    // 返回是否拆分了数组
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 
     bool can_be_split(const std::shared_ptr<Mir::Alloc> &alloc);
 
@@ -135,10 +140,11 @@ private:
 // 将全局变量中数组的常量索引访问替换为对应的初始化值
 class ConstIndexToValue final : public Transform {
 public:
-    explicit ConstIndexToValue() : Transform("ConstIndexToValue") {}
+    // 只以常量替换 load，不改变控制流
+    explicit ConstIndexToValue() : Transform("ConstIndexToValue", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 };
 } // namespace Pass
 
@@ -6,25 +6,29 @@
 
 namespace Pass {
 // 对指令进行代数优化恒等式变形
-class AlgebraicSimplify final : public Transform {
+class AlgebraicSimplify final : public FunctionTransform<FunctionAnalysis> {
 public:
-    explicit AlgebraicSimplify() : Transform("AlgebraicSimplify") {}
+    // 只改写同一基本块内的算术指令，不改变控制流、访存与调用
+    explicit AlgebraicSimplify() :
+        FunctionTransform("AlgebraicSimplify", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 };
 
 // 标准化计算指令 "Binary"，为之后的代数变形/GVN做准备
-class StandardizeBinary final : public Transform {
+class StandardizeBinary final : public FunctionTransform<> {
 public:
-    explicit StandardizeBinary() : Transform("StandardizeBinary") {}
+    // 只交换操作数或替换同一基本块内的二元运算，不改变控制流、访存与调用
+    explicit StandardizeBinary() :
+        FunctionTransform("StandardizeBinary", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 };
 
 // 执行在编译期内能识别出来的constexpr函数
@@ -34,7 +38,7 @@ public:
     explicit ConstexprFuncEval() : Transform("ConstexprFuncEval") {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
 private:
     std::shared_ptr<FunctionAnalysis> func_analysis;
@@ -20,14 +20,15 @@ namespace Pass {
  * 4. 消除只包含单个非条件跳转的基本块
  * 5. 消除只包含单个条件跳转的基本块
  */
-class SimplifyControlFlow final : public Transform {
+class SimplifyControlFlow final : public FunctionTransform<FunctionAnalysis> {
 public:
-    explicit SimplifyControlFlow() : Transform("SimplifyControlFlow") {}
+    // 通过 ControlFlowGraph 的增量接口修改控制流
+    explicit SimplifyControlFlow() : FunctionTransform("SimplifyControlFlow", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 public:
     static bool remove_unreachable_blocks(const std::shared_ptr<Mir::Function> &func);
@@ -44,35 +45,37 @@ private:
 template<int level>
 class BlockPositioning final : public Transform {
 public:
-    explicit BlockPositioning() : Transform("BlockPositioning") {}
+    // 只调整基本块的顺序，并自行报告控制流图的变化
+    explicit BlockPositioning() :
+        Transform("BlockPositioning", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(const std::shared_ptr<Mir::Module> module) override {
+    bool transform(const std::shared_ptr<Mir::Module> module) override {
         static_assert(level == 0 || level == 1);
         if constexpr (level == 0) {
-            do_reverse_postorder_placement(module);
+            return do_reverse_postorder_placement(module);
         } else {
-            do_static_probability_placement(module);
+            return do_static_probability_placement(module);
         }
     }
 
 private:
-    static void do_reverse_postorder_placement(const std::shared_ptr<Mir::Module> &module);
+    static bool do_reverse_postorder_placement(const std::shared_ptr<Mir::Module> &module);
 
-    static void do_static_probability_placement(const std::shared_ptr<Mir::Module> &module);
+    static bool do_static_probability_placement(const std::shared_ptr<Mir::Module> &module);
 };
 
 // 合并嵌套的分支，减少控制流复杂度
 class BranchMerging final : public Transform {
 public:
-    explicit BranchMerging() : Transform("BranchMerging") {}
+    explicit BranchMerging() : Transform("BranchMerging", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func);
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 
 private:
     std::shared_ptr<ControlFlowGraph> cfg_info{nullptr};
@@ -85,11 +88,11 @@ public:
     explicit IfChainToSwitch() : Transform("IfChainToSwitch") {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func) const;
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func) const;
 
 private:
     std::shared_ptr<ControlFlowGraph> cfg_info{nullptr};
@@ -99,18 +102,20 @@ private:
 // 尾调用优化：将部分 call 指令标记为tail call，消除了函数返回/入栈开销
 class TailCallOptimize final : public Transform {
 public:
-    explicit TailCallOptimize() : Transform("TailCallOptimize") {}
+    explicit TailCallOptimize() : Transform("TailCallOptimize", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func) const;
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func) const;
 
-    void tail_call_detect(const std::shared_ptr<Mir::Function> &func) const;
+    // 返回是否标记了新的尾调用
+    bool tail_call_detect(const std::shared_ptr<Mir::Function> &func) const;
 
-    void tail_call_eliminate(const std::shared_ptr<Mir::Function> &func) const;
+    // 返回是否消除了尾递归
+    bool tail_call_eliminate(const std::shared_ptr<Mir::Function> &func) const;
 
     static bool handle_tail_call(const std::shared_ptr<Mir::Call> &call);
 
@@ -122,24 +127,25 @@ private:
 // 将函数中所有的ret语句汇聚到一个block中，简化cfg
 class SingleReturnTransform final : public Transform {
 public:
-    explicit SingleReturnTransform() : Transform("SingleReturnTransform") {}
+    explicit SingleReturnTransform() : Transform("SingleReturnTransform", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
-    static void run_on_func(const std::shared_ptr<Mir::Function> &func);
+    static bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 };
 
 // 函数内联
 class Inlining final : public Transform {
 public:
-    explicit Inlining() : Transform("Inlining") {}
+    // 就地修补调用者的控制流图，调用者的支配树自行报告失效
+    explicit Inlining() : Transform("Inlining", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
 private:
     std::shared_ptr<ControlFlowGraph> cfg_info{nullptr};
@@ -148,7 +154,8 @@ private:
 
     [[nodiscard]] bool can_inline(const std::shared_ptr<Mir::Function> &func) const;
 
-    void do_inline(const std::shared_ptr<Mir::Function> &func);
+    // 返回是否内联了至少一处调用
+    bool do_inline(const std::shared_ptr<Mir::Function> &func);
 
     void replace_call(const std::shared_ptr<Mir::Call> &call, const std::shared_ptr<Mir::Function> &caller,
                       const std::shared_ptr<Mir::Function> &callee) const;
@@ -6,14 +6,14 @@
 
 namespace Pass {
 // 删除未被使用的指令
-class DeadInstEliminate final : public Transform {
+class DeadInstEliminate final : public FunctionTransform<FunctionAnalysis> {
 public:
-    explicit DeadInstEliminate() : Transform("DeadInstEliminate") {}
+    explicit DeadInstEliminate() : FunctionTransform("DeadInstEliminate", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
     [[nodiscard]] bool remove_unused_instructions(const std::shared_ptr<Mir::Module> &module) const;
 
@@ -26,28 +26,29 @@ private:
 // 删除未被调用的函数
 class DeadFuncEliminate final : public Transform {
 public:
-    explicit DeadFuncEliminate() : Transform("DeadFuncEliminate") {}
+    // 删除函数时一并移除其控制流图
+    explicit DeadFuncEliminate() : Transform("DeadFuncEliminate", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 };
 
 // 激进的死代码删除
 class DeadCodeEliminate final : public Transform {
 public:
-    explicit DeadCodeEliminate() : Transform("DeadCodeEliminate") {}
+    explicit DeadCodeEliminate() : Transform("DeadCodeEliminate", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
     std::unordered_set<std::shared_ptr<Mir::Instruction>> useful_instructions_;
 
     std::shared_ptr<FunctionAnalysis> function_analysis_{nullptr};
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func,
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func,
                      const std::unordered_set<std::shared_ptr<Mir::Instruction>> &initial);
 
     // 删除指令
@@ -63,31 +64,33 @@ private:
 // 函数无用形参删除
 class DeadFuncArgEliminate final : public Transform {
 public:
-    explicit DeadFuncArgEliminate() : Transform("DeadFuncArgEliminate") {}
+    // 只删除参数与实参，不改变控制流
+    explicit DeadFuncArgEliminate() : Transform("DeadFuncArgEliminate", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
 private:
     std::shared_ptr<FunctionAnalysis> function_analysis_{nullptr};
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func) const;
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func) const;
 };
 
 // 如果该函数的返回值并未被使用，则删除该函数的返回值
 class DeadReturnEliminate final : public Transform {
 public:
-    explicit DeadReturnEliminate() : Transform("DeadReturnEliminate") {}
+    // 只删除返回值，不改变控制流
+    explicit DeadReturnEliminate() : Transform("DeadReturnEliminate", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
     std::shared_ptr<FunctionAnalysis> function_analysis_{nullptr};
 
-    static void run_on_func(const std::shared_ptr<Mir::Function> &func);
+    static bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 };
 } // namespace Pass
 
@@ -6,17 +6,19 @@
 #include "Pass/Analyses/FunctionAnalysis.h"
 #include "Pass/Analyses/LoopAnalysis.h"
 #include "Pass/Transform.h"
+#include "Pass/Transforms/ValueNumbering.h"
 
 namespace Pass {
 // 自动地将 alloca 变量提升为寄存器变量，将IR转化为SSA形式
 class Mem2Reg final : public Transform {
 public:
-    explicit Mem2Reg() : Transform("Mem2Reg") {}
+    // 只插入 phi 并删除 alloca、load 与 store，不改变控制流
+    explicit Mem2Reg() : Transform("Mem2Reg", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
     // 控制流图信息，用于后续基本块支配关系和变量使用/定义分析
@@ -35,7 +37,8 @@ private:
     // 变量重命名时使用的定义栈，栈顶为当前作用域内有效的定义版本
     std::vector<std::shared_ptr<Mir::Value>> def_stack;
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func);
+    // 返回是否提升了至少一个 alloc
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 
     void init_mem2reg();
 
@@ -48,17 +51,20 @@ private:
 // 根据Value之间的依赖关系，将代码的位置重新安排，从而使得一些不必要（不会影响结果）的代码尽可能少执行
 class GlobalCodeMotion final : public Transform {
 public:
-    explicit GlobalCodeMotion() : Transform("GlobalCodeMotion") {}
+    // 只在基本块之间移动指令，不改变控制流、访存与调用
+    explicit GlobalCodeMotion() :
+        Transform("GlobalCodeMotion", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
     bool is_pinned(const std::shared_ptr<Mir::Instruction> &instruction) const;
 
-    void run_on_func(const std::shared_ptr<Mir::Function> &func);
+    // 返回是否把指令移动到了其他基本块
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 
     void schedule_early(const std::shared_ptr<Mir::Instruction> &instruction);
 
@@ -83,38 +89,44 @@ private:
 // 实现全局的消除公共表达式
 class GlobalValueNumbering final : public Transform {
 public:
-    explicit GlobalValueNumbering() : Transform("GlobalValueNumbering") {}
+    // 只以等价的值替换指令，被替换的调用总有一条相同的调用保留下来
+    explicit GlobalValueNumbering() :
+        Transform("GlobalValueNumbering", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
     static bool fold_instruction(const std::shared_ptr<Mir::Instruction> &instruction);
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
 private:
     bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 
     bool run_on_block(const std::shared_ptr<Mir::Function> &func, const std::shared_ptr<Mir::Block> &block,
-                      std::unordered_map<std::string, std::shared_ptr<Mir::Instruction>> &value_hashmap);
+                      ValueTable &value_table);
 
     std::shared_ptr<DominanceGraph> dom_info{nullptr};
 
     std::shared_ptr<FunctionAnalysis> func_analysis{nullptr};
 };
 
-class LocalValueNumbering final : public Transform {
+class LocalValueNumbering final : public FunctionTransform<FunctionAnalysis> {
 public:
-    explicit LocalValueNumbering() : Transform("LocalValueNumbering") {}
+    // 只以等价的值替换指令，被替换的调用总有一条相同的调用保留下来
+    explicit LocalValueNumbering() :
+        FunctionTransform("LocalValueNumbering", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
     static bool fold_instruction(const std::shared_ptr<Mir::Instruction> &instruction);
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
+
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
     bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 
     bool run_on_block(const std::shared_ptr<Mir::Function> &func, const std::shared_ptr<Mir::Block> &block,
-                      std::unordered_map<std::string, std::shared_ptr<Mir::Instruction>> &value_hashmap);
+                      ValueTable &value_table);
 
     std::shared_ptr<DominanceGraph> dom_info{nullptr};
 
@@ -124,62 +136,66 @@ private:
 // 全局变量局部化
 class GlobalVariableLocalize final : public Transform {
 public:
-    explicit GlobalVariableLocalize() : Transform("GlobalVariableLocalize") {}
+    explicit GlobalVariableLocalize() : Transform("GlobalVariableLocalize", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 };
 
 // 全局数组局部化
 class GlobalArrayLocalize final : public Transform {
 public:
-    explicit GlobalArrayLocalize() : Transform("GlobalArrayLocalize") {}
+    explicit GlobalArrayLocalize() : Transform("GlobalArrayLocalize", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 };
 
 // 树高平衡，实现指令级并行性
 class TreeHeightBalance final : public Transform {
 public:
-    explicit TreeHeightBalance() : Transform("TreeHeightBalance") {}
+    // 只重排算术指令，不改变控制流、访存与调用
+    explicit TreeHeightBalance() :
+        Transform("TreeHeightBalance", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
 private:
-    static void run_on_func(const std::shared_ptr<Mir::Function> &func);
+    static bool run_on_func(const std::shared_ptr<Mir::Function> &func);
 };
 
 // 重新关联
 // 如果满足结合律的二元操作（如加法、乘法、位运算的 AND/OR/XOR），则尝试对操作数进行重新关联和排序
 class Reassociate final : public Transform {
 public:
-    explicit Reassociate() : Transform("Reassociate") {}
+    // 只重排算术指令，不改变控制流、访存与调用
+    explicit Reassociate() : Transform("Reassociate", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 };
 
 // 强度削弱
 // 根据区间分析的结果削弱部分的icmp等运算
 class ConstrainReduce final : public Transform {
 public:
-    explicit ConstrainReduce() : Transform("ConstrainReduce") {}
+    explicit ConstrainReduce() : Transform("ConstrainReduce", PreservedAnalyses::control_flow()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 };
 
 // 移除phi，是后端的必备操作
 class RemovePhi final : public Transform {
 public:
-    explicit RemovePhi() : Transform("RemovePhi") {}
+    // 拆分关键边时自行报告控制流图的变化，只新增 move
+    explicit RemovePhi() : Transform("RemovePhi", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
 private:
     void run_on_func(const std::shared_ptr<Mir::Function> &func);
@@ -192,15 +208,17 @@ private:
 // 指令调度
 class InstSchedule final : public Transform {
 public:
-    explicit InstSchedule() : Transform("InstSchedule") {}
+    // 只在基本块内重排指令
+    explicit InstSchedule() :
+        Transform("InstSchedule", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
 private:
-    void run_on_func(const std::shared_ptr<Mir::Function> &func) const;
+    bool run_on_func(const std::shared_ptr<Mir::Function> &func) const;
 
-    void in_block_schedule(const std::shared_ptr<Mir::Function> &func) const;
+    bool in_block_schedule(const std::shared_ptr<Mir::Function> &func) const;
 
     std::shared_ptr<DominanceGraph> dom_graph{nullptr};
 
@@ -3,23 +3,28 @@
 
 #include "Pass/Analyses/ControlFlowGraph.h"
 #include "Pass/Analyses/DominanceGraph.h"
+#include "Pass/Analyses/FunctionAnalysis.h"
 #include "Pass/Analyses/LoopAnalysis.h"
 #include "Pass/Transform.h"
 
 namespace Pass {
 class LoopSimplyForm final : public Transform {
 public:
-    explicit LoopSimplyForm() : Transform("LoopSimplyform") {}
+    // 新建基本块时自行报告控制流图的变化并更新循环，只新增 phi 与跳转
+    explicit LoopSimplyForm() :
+        Transform("LoopSimplyform", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 };
 
 class LCSSA final : public Transform {
 public:
-    explicit LCSSA() : Transform("LCSSA") {}
+    // 只在循环出口插入 phi
+    explicit LCSSA() : Transform("LCSSA", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
+
     void set_cfg(const std::shared_ptr<ControlFlowGraph> &cfg) { cfg_info_ = cfg; }
 
     void set_dom(const std::shared_ptr<DominanceGraph> &dom) { dom_info_ = dom; }
@@ -33,11 +38,12 @@ public:
     std::shared_ptr<LoopAnalysis> loop_info() { return loop_info_; }
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
-    void runOnNode(const std::shared_ptr<LoopNodeTreeNode> &loop_node);
+    // 返回是否插入了 phi
+    bool runOnNode(const std::shared_ptr<LoopNodeTreeNode> &loop_node);
 
     bool usedOutLoop(const std::shared_ptr<Mir::Instruction> &inst, const std::shared_ptr<Loop> &loop);
 
@@ -52,12 +58,12 @@ private:
 
 class LoopUnSwitch final : public Transform {
 public:
-    explicit LoopUnSwitch() : Transform("LoopUnSwitch") {}
+    explicit LoopUnSwitch() : Transform("LoopUnSwitch", PreservedAnalyses::control_flow()) {}
 
 protected:
     std::vector<std::shared_ptr<Loop>> un_switched_loops_;
 
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
     bool un_switching(std::shared_ptr<LoopNodeTreeNode> &loop);
 
@@ -72,15 +78,15 @@ class SCEVAnalysis;
 class SCEVExpr;
 class InductionVariables final : public Transform {
 public:
-    explicit InductionVariables() : Transform("InductionVariables") {}
+    explicit InductionVariables() : Transform("InductionVariables", PreservedAnalyses::control_flow()) {}
 
 protected:
 
     std::shared_ptr<SCEVAnalysis> scev_info_;
     std::shared_ptr<LoopAnalysis> loop_info_;
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
     void run(std::shared_ptr<LoopNodeTreeNode> &loop_node);
     bool get_trip_count(std::shared_ptr<Loop> loop);
     int get_tick_num(std::shared_ptr<SCEVExpr> scev_expr, Mir::Icmp::Op op, int n);
@@ -88,8 +94,9 @@ protected:
 
 class LoopInterchange final : public Transform {
 public:
-    explicit LoopInterchange() : Transform("LoopInterchange") {}
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    explicit LoopInterchange() : Transform("LoopInterchange", PreservedAnalyses::control_flow()) {}
+
+    bool transform(std::shared_ptr<Mir::Module> module) override;
     void run_on(const std::shared_ptr<Mir::Function> &function);
     bool check_on_nest(const std::shared_ptr<LoopNodeTreeNode>& loop_nest);
     void transform_on_nest(std::shared_ptr<LoopNodeTreeNode> loop_nest);
@@ -108,10 +115,10 @@ protected:
 
 class ConstLoopUnroll final : public Transform {
 public:
-    explicit ConstLoopUnroll() : Transform("ConstLoopUnroll") {}
+    explicit ConstLoopUnroll() : Transform("ConstLoopUnroll", PreservedAnalyses::control_flow()) {}
 
-    void transform(std::shared_ptr<Mir::Module> module) override;
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
     bool try_unroll(std::shared_ptr<LoopNodeTreeNode> loop_node, std::shared_ptr<Mir::Function> func);
 protected:
@@ -123,9 +130,10 @@ protected:
 
 class LoopUnroll final : public Transform {
 public:
-    explicit LoopUnroll() : Transform("ConstLoopUnroll") {}
-    void transform(std::shared_ptr<Mir::Module> module) override;
-    void transform(const std::shared_ptr<Mir::Function> &) override;
+    explicit LoopUnroll() : Transform("ConstLoopUnroll", PreservedAnalyses::control_flow()) {}
+
+    bool transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(const std::shared_ptr<Mir::Function> &) override;
 
     bool try_unroll(std::shared_ptr<LoopNodeTreeNode> loop_node, std::shared_ptr<Mir::Function> func);
     bool can_unroll(std::shared_ptr<LoopNodeTreeNode> loop_node, std::shared_ptr<Mir::Function> func);
@@ -141,10 +149,12 @@ protected:
 };
 class LoopInvariantCodeMotion final : public Transform {
 public:
-    explicit LoopInvariantCodeMotion() : Transform("LoopInvariantCodeMotion") {}
+    // 只把指令移入循环的 preheader
+    explicit LoopInvariantCodeMotion() :
+        Transform("LoopInvariantCodeMotion", PreservedAnalyses::control_flow().preserve<FunctionAnalysis>()) {}
 
 protected:
-    void transform(std::shared_ptr<Mir::Module> module) override;
+    bool transform(std::shared_ptr<Mir::Module> module) override;
 };
 } // namespace Pass
 
@@ -0,0 +1,89 @@
+#ifndef VALUE_NUMBERING_H
+#define VALUE_NUMBERING_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Mir/Instruction.h"
+#include "Pass/Analyses/FunctionAnalysis.h"
+
+namespace Pass {
+// 值编号使用的指令结构键：操作码、子操作码、附加信息（如结果类型）以及操作数的身份
+// 满足交换律的二元运算会按地址对操作数排序，使 a+b 与 b+a 得到相同的键
+// 类型与常量均已唯一化，因此直接比较地址即可判断是否相同
+class InstructionKey {
+public:
+    // 为指令构造键；不参与值编号的指令返回 std::nullopt
+    static std::optional<InstructionKey> create(const std::shared_ptr<Mir::Instruction> &instruction,
+                                                const std::shared_ptr<FunctionAnalysis> &func_analysis);
+
+    [[nodiscard]] size_t hash() const { return hash_; }
+
+    bool operator==(const InstructionKey &other) const;
+
+    bool operator!=(const InstructionKey &other) const { return !(*this == other); }
+
+private:
+    static constexpr size_t inline_capacity = 4;
+
+    Mir::Operator op_;
+    int sub_op_;
+    const void *extra_;
+    size_t size_{0};
+    // 操作数不超过 inline_capacity 个时不产生堆分配
+    std::array<const Mir::Value *, inline_capacity> inline_operands_{};
+    std::vector<const Mir::Value *> spilled_operands_;
+    size_t hash_{0};
+
+    InstructionKey(Mir::Operator op, int sub_op, const void *extra) : op_{op}, sub_op_{sub_op}, extra_{extra} {}
+
+    void push_operand(const Mir::Value *operand);
+
+    [[nodiscard]] const Mir::Value *operand(size_t i) const {
+        return size_ <= inline_capacity ? inline_operands_[i] : spilled_operands_[i];
+    }
+
+    void finalize();
+};
+
+// 以 InstructionKey 为键的开放寻址（线性探测）哈希表，供 GVN 与 LVN 共用
+// 删除使用墓碑标记，LVN 回溯作用域时按插入的逆序删除
+class ValueTable {
+public:
+    ValueTable() : slots_(initial_capacity) {}
+
+    [[nodiscard]] std::shared_ptr<Mir::Instruction> find(const InstructionKey &key) const;
+
+    // 插入新的键；调用者需保证键不存在
+    void insert(InstructionKey key, const std::shared_ptr<Mir::Instruction> &instruction);
+
+    void erase(const InstructionKey &key);
+
+    [[nodiscard]] size_t size() const { return size_; }
+
+private:
+    static constexpr size_t initial_capacity = 64;
+
+    enum class State : uint8_t { Empty, Occupied, Deleted };
+
+    struct Slot {
+        State state{State::Empty};
+        std::optional<InstructionKey> key;
+        std::shared_ptr<Mir::Instruction> instruction;
+    };
+
+    std::vector<Slot> slots_;
+    size_t size_{0};
+    size_t deleted_{0};
+
+    // 返回键所在的槽位下标，不存在时返回 slots_.size()
+    [[nodiscard]] size_t locate(const InstructionKey &key) const;
+
+    void rehash(size_t capacity);
+};
+} // namespace Pass
+
+#endif
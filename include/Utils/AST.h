@@ -1,7 +1,12 @@
 #ifndef AST_H
 #define AST_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -11,12 +16,92 @@
 #include "Utils/Token.h"
 
 namespace AST {
+// Arena 上的定长数组，只保存首地址与长度，可以按值传递
+template<typename T>
+class List {
+    const T *data_{nullptr};
+    size_t size_{0};
+
+public:
+    List() = default;
+
+    List(const T *data, const size_t size) : data_{data}, size_{size} {}
+
+    [[nodiscard]] size_t size() const { return size_; }
+
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    [[nodiscard]] const T *begin() const { return data_; }
+
+    [[nodiscard]] const T *end() const { return data_ + size_; }
+
+    const T &operator[](const size_t index) const { return data_[index]; }
+
+    [[nodiscard]] const T &front() const { return data_[0]; }
+
+    [[nodiscard]] const T &back() const { return data_[size_ - 1]; }
+};
+
+// 一次编译的 AST 所使用的内存池，结点与 List 在大块内存上顺序分配，Arena 销毁时一并释放
+// 只接受平凡析构的类型：结点中的标识符与字符串常量都指向源程序缓冲区，子结点以指针或 List 引用
+class Arena {
+public:
+    Arena() = default;
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+
+    template<typename T, typename... Args>
+    T *create(Args &&...args) {
+        static_assert(std::is_trivially_destructible_v<T>, "AST nodes are released without being destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // 将语法分析时收集的元素复制到 Arena 上
+    template<typename Container, typename T = typename Container::value_type>
+    List<T> list(const Container &items) {
+        static_assert(std::is_trivially_copyable_v<T>, "List elements must be trivially copyable");
+        if (items.empty()) {
+            return {};
+        }
+        const auto data = static_cast<T *>(allocate(sizeof(T) * items.size(), alignof(T)));
+        std::uninitialized_copy(items.begin(), items.end(), data);
+        return {data, items.size()};
+    }
+
+    // 已向系统申请的字节数
+    [[nodiscard]] size_t bytes_reserved() const { return bytes_reserved_; }
+
+private:
+    static constexpr size_t chunk_size = 1 << 16;
+
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    std::byte *cursor_{nullptr};
+    std::byte *limit_{nullptr};
+    size_t bytes_reserved_{0};
+
+    void *allocate(const size_t size, const size_t align) {
+        auto aligned = reinterpret_cast<std::byte *>((reinterpret_cast<uintptr_t>(cursor_) + align - 1) & ~(align - 1));
+        if (cursor_ == nullptr || aligned + size > limit_) [[unlikely]] {
+            aligned = new_chunk(size + align, align);
+        }
+        cursor_ = aligned + size;
+        return aligned;
+    }
+
+    // 申请至少 size 字节的新块，返回其中按 align 对齐的首地址
+    std::byte *new_chunk(size_t size, size_t align);
+};
+
 // AST 结点基类
+// 结点都分配在 Arena 上，随 Arena 一次性释放而不会逐个析构，因此析构函数不是虚函数
 class Node {
 public:
-    virtual ~Node() = default;
-
     [[nodiscard]] virtual std::string to_string() const = 0;
+
+protected:
+    ~Node() = default;
 };
 
 class Exp;
@@ -26,10 +111,9 @@ class Number : public Node {};
 
 class IntNumber final : public Number {
     const int value_;
-    const std::string value_string_;
 
 public:
-    explicit IntNumber(const int &value) : value_{value}, value_string_{std::to_string(value)} {}
+    explicit IntNumber(const int &value) : value_{value} {}
 
     [[nodiscard]] int get_value() const { return value_; }
 
@@ -38,58 +122,53 @@ public:
 
 class FloatNumber final : public Number {
     const double value_;
-    const std::string value_string_;
 
 public:
-    explicit FloatNumber(const double &value) :
-        value_{value}, value_string_{std::to_string(value)} {}
+    explicit FloatNumber(const double &value) : value_{value} {}
 
-    explicit FloatNumber(const std::string &value) :
-        value_{IEEE754_Single::SimpleFloat{value}.to_float()}, value_string_{value} {}
+    explicit FloatNumber(const std::string &value) : value_{IEEE754_Single::SimpleFloat{value}.to_float()} {}
 
     [[nodiscard]] double get_value() const { return value_; }
 
-    [[nodiscard]] std::string get_value_string() const { return value_string_; }
-
     [[nodiscard]] std::string to_string() const override;
 };
 
 // PrimaryExp -> '(' Exp ')' | LVal | Number
 class PrimaryExp final : public Node {
-    const std::variant<std::shared_ptr<Exp>, std::shared_ptr<LVal>, std::shared_ptr<Number>> value_;
+    const std::variant<const Exp *, const LVal *, const Number *> value_;
 
 public:
-    explicit PrimaryExp(const std::shared_ptr<Exp> &exp) : value_{exp} {}
+    explicit PrimaryExp(const Exp *exp) : value_{exp} {}
 
-    explicit PrimaryExp(const std::shared_ptr<LVal> &lVal) : value_{lVal} {}
+    explicit PrimaryExp(const LVal *lVal) : value_{lVal} {}
 
-    explicit PrimaryExp(const std::shared_ptr<Number> &number) : value_{number} {}
+    explicit PrimaryExp(const Number *number) : value_{number} {}
 
-    [[nodiscard]] std::variant<std::shared_ptr<Exp>, std::shared_ptr<LVal>, std::shared_ptr<Number>> get_value() const {
+    [[nodiscard]] std::variant<const Exp *, const LVal *, const Number *> get_value() const {
         return value_;
     }
 
-    [[nodiscard]] bool is_exp() const { return std::holds_alternative<std::shared_ptr<Exp>>(value_); }
+    [[nodiscard]] bool is_exp() const { return std::holds_alternative<const Exp *>(value_); }
 
-    [[nodiscard]] bool is_lVal() const { return std::holds_alternative<std::shared_ptr<LVal>>(value_); }
+    [[nodiscard]] bool is_lVal() const { return std::holds_alternative<const LVal *>(value_); }
 
-    [[nodiscard]] bool is_number() const { return std::holds_alternative<std::shared_ptr<Number>>(value_); }
+    [[nodiscard]] bool is_number() const { return std::holds_alternative<const Number *>(value_); }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 // LVal -> Ident {'[' Exp ']'}
 class LVal final : public Node {
-    const std::string ident_;
-    const std::vector<std::shared_ptr<Exp>> exps_;
+    const std::string_view ident_;
+    const List<const Exp *> exps_;
 
 public:
-    explicit LVal(std::string ident, const std::vector<std::shared_ptr<Exp>> &exps) :
-        ident_{std::move(ident)}, exps_{exps} {}
+    explicit LVal(const std::string_view ident, const List<const Exp *> exps) :
+        ident_{ident}, exps_{exps} {}
 
-    [[nodiscard]] std::string ident() const { return ident_; }
+    [[nodiscard]] std::string_view ident() const { return ident_; }
 
-    [[nodiscard]] const std::vector<std::shared_ptr<Exp>> &exps() const { return exps_; }
+    [[nodiscard]] List<const Exp *> exps() const { return exps_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
@@ -97,18 +176,18 @@ public:
 // UnaryExp -> PrimaryExp | Ident '(' [Exp { ',' Exp }] ')'  | unaryOp UnaryExp
 class UnaryExp final : public Node {
 public:
-    using call = std::pair<Token::Token, std::vector<std::shared_ptr<Exp>>>;
-    using opExp = std::pair<Token::Type, std::shared_ptr<UnaryExp>>;
-    const std::variant<call, opExp, std::shared_ptr<PrimaryExp>> value_;
-    explicit UnaryExp(const std::shared_ptr<PrimaryExp> &exp) : value_{exp} {}
+    using call = std::pair<Token::Token, List<const Exp *>>;
+    using opExp = std::pair<Token::Type, const UnaryExp *>;
+    const std::variant<call, opExp, const PrimaryExp *> value_;
+    explicit UnaryExp(const PrimaryExp *exp) : value_{exp} {}
 
-    UnaryExp(const Token::Type &type, const std::shared_ptr<UnaryExp> &exp) : value_{opExp{type, exp}} {}
+    UnaryExp(const Token::Type &type, const UnaryExp *exp) : value_{opExp{type, exp}} {}
 
-    UnaryExp(const Token::Token &ident, const std::vector<std::shared_ptr<Exp>> &exp) : value_{call{ident, exp}} {}
+    UnaryExp(const Token::Token &ident, const List<const Exp *> exp) : value_{call{ident, exp}} {}
 
-    [[nodiscard]] std::variant<call, opExp, std::shared_ptr<PrimaryExp>> get_value() const { return value_; }
+    [[nodiscard]] std::variant<call, opExp, const PrimaryExp *> get_value() const { return value_; }
 
-    [[nodiscard]] bool is_primaryExp() const { return std::holds_alternative<std::shared_ptr<PrimaryExp>>(value_); }
+    [[nodiscard]] bool is_primaryExp() const { return std::holds_alternative<const PrimaryExp *>(value_); }
 
     [[nodiscard]] bool is_call() const { return std::holds_alternative<call>(value_); }
 
@@ -119,124 +198,124 @@ public:
 
 // MulExp -> UnaryExp { (* | / | %) UnaryExp}
 class MulExp final : public Node {
-    const std::vector<std::shared_ptr<UnaryExp>> unaryExps_;
-    const std::vector<Token::Type> operators_;
+    const List<const UnaryExp *> unaryExps_;
+    const List<Token::Type> operators_;
 
 public:
-    MulExp(const std::vector<std::shared_ptr<UnaryExp>> &unaryExps, const std::vector<Token::Type> &operators) :
+    MulExp(const List<const UnaryExp *> unaryExps, const List<Token::Type> operators) :
         unaryExps_{unaryExps}, operators_{operators} {
         if (operators_.size() != unaryExps_.size() - 1) {
             throw std::invalid_argument("MulExp: Unexpected number of operators");
         }
     }
 
-    [[nodiscard]] const std::vector<std::shared_ptr<UnaryExp>> &unaryExps() const { return unaryExps_; }
+    [[nodiscard]] List<const UnaryExp *> unaryExps() const { return unaryExps_; }
 
-    [[nodiscard]] const std::vector<Token::Type> &operators() const { return operators_; }
+    [[nodiscard]] List<Token::Type> operators() const { return operators_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 // AddExp -> MulExp { (+ | -) MulExp }
 class AddExp final : public Node {
-    const std::vector<std::shared_ptr<MulExp>> mulExps_;
-    const std::vector<Token::Type> operators_;
+    const List<const MulExp *> mulExps_;
+    const List<Token::Type> operators_;
 
 public:
-    AddExp(const std::vector<std::shared_ptr<MulExp>> &mulExps, const std::vector<Token::Type> &operators) :
+    AddExp(const List<const MulExp *> mulExps, const List<Token::Type> operators) :
         mulExps_{mulExps}, operators_{operators} {
         if (operators_.size() != mulExps_.size() - 1) {
             throw std::invalid_argument("AddExp: Unexpected number of operators");
         }
     }
 
-    [[nodiscard]] const std::vector<std::shared_ptr<MulExp>> &mulExps() const { return mulExps_; }
+    [[nodiscard]] List<const MulExp *> mulExps() const { return mulExps_; }
 
-    [[nodiscard]] const std::vector<Token::Type> &operators() const { return operators_; }
+    [[nodiscard]] List<Token::Type> operators() const { return operators_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 // RelExp -> AddExp { (> | < | >= | <=) AddExp }
 class RelExp final : public Node {
-    const std::vector<std::shared_ptr<AddExp>> addExps_;
-    const std::vector<Token::Type> operators_;
+    const List<const AddExp *> addExps_;
+    const List<Token::Type> operators_;
 
 public:
-    RelExp(const std::vector<std::shared_ptr<AddExp>> &addExps, const std::vector<Token::Type> &operators) :
+    RelExp(const List<const AddExp *> addExps, const List<Token::Type> operators) :
         addExps_{addExps}, operators_{operators} {
         if (operators_.size() != addExps_.size() - 1) {
             throw std::invalid_argument("RelExp: Unexpected number of operators");
         }
     }
 
-    [[nodiscard]] const std::vector<std::shared_ptr<AddExp>> &addExps() const { return addExps_; }
+    [[nodiscard]] List<const AddExp *> addExps() const { return addExps_; }
 
-    [[nodiscard]] const std::vector<Token::Type> &operators() const { return operators_; }
+    [[nodiscard]] List<Token::Type> operators() const { return operators_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 // EqExp -> RelExp { (== | !=) RelExp }
 class EqExp final : public Node {
-    const std::vector<std::shared_ptr<RelExp>> relExps_;
-    const std::vector<Token::Type> operators_;
+    const List<const RelExp *> relExps_;
+    const List<Token::Type> operators_;
 
 public:
-    EqExp(const std::vector<std::shared_ptr<RelExp>> &relExps, const std::vector<Token::Type> &operators) :
+    EqExp(const List<const RelExp *> relExps, const List<Token::Type> operators) :
         relExps_{relExps}, operators_{operators} {
         if (operators_.size() != relExps_.size() - 1) {
             throw std::invalid_argument("EqExp: Unexpected number of operators");
         }
     }
 
-    [[nodiscard]] const std::vector<std::shared_ptr<RelExp>> &relExps() const { return relExps_; }
+    [[nodiscard]] List<const RelExp *> relExps() const { return relExps_; }
 
-    [[nodiscard]] const std::vector<Token::Type> &operators() const { return operators_; }
+    [[nodiscard]] List<Token::Type> operators() const { return operators_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 // LAndExp -> EqExp { && EqExp }
 class LAndExp final : public Node {
-    const std::vector<std::shared_ptr<EqExp>> eqExps_;
+    const List<const EqExp *> eqExps_;
 
 public:
-    explicit LAndExp(const std::vector<std::shared_ptr<EqExp>> &eqExps) : eqExps_{eqExps} {}
+    explicit LAndExp(const List<const EqExp *> eqExps) : eqExps_{eqExps} {}
 
-    [[nodiscard]] const std::vector<std::shared_ptr<EqExp>> &eqExps() const { return eqExps_; }
+    [[nodiscard]] List<const EqExp *> eqExps() const { return eqExps_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 // LOrExp -> LAndExp { || LAndExp }
 class LOrExp final : public Node {
-    const std::vector<std::shared_ptr<LAndExp>> lAndExps_;
+    const List<const LAndExp *> lAndExps_;
 
 public:
-    explicit LOrExp(const std::vector<std::shared_ptr<LAndExp>> &lAndExps) : lAndExps_{lAndExps} {}
+    explicit LOrExp(const List<const LAndExp *> lAndExps) : lAndExps_{lAndExps} {}
 
-    [[nodiscard]] const std::vector<std::shared_ptr<LAndExp>> &lAndExps() const { return lAndExps_; }
+    [[nodiscard]] List<const LAndExp *> lAndExps() const { return lAndExps_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 // Exp -> AddExp | ConstString
 class Exp final : public Node {
-    const std::variant<std::shared_ptr<AddExp>, std::string> addExp_;
+    const std::variant<const AddExp *, std::string_view> addExp_;
 
 public:
-    explicit Exp(const std::shared_ptr<AddExp> &addExp) : addExp_{addExp} {}
+    explicit Exp(const AddExp *addExp) : addExp_{addExp} {}
 
-    explicit Exp(const std::string &const_string) : addExp_{const_string} {}
+    explicit Exp(const std::string_view const_string) : addExp_{const_string} {}
 
-    [[nodiscard]] bool is_const_string() const { return std::holds_alternative<std::string>(addExp_); }
+    [[nodiscard]] bool is_const_string() const { return std::holds_alternative<std::string_view>(addExp_); }
 
-    [[nodiscard]] std::string get_const_string() const { return std::get<std::string>(addExp_); }
+    [[nodiscard]] std::string_view get_const_string() const { return std::get<std::string_view>(addExp_); }
 
-    [[nodiscard]] std::shared_ptr<AddExp> addExp() const {
-        if (std::holds_alternative<std::shared_ptr<AddExp>>(addExp_)) {
-            return std::get<std::shared_ptr<AddExp>>(addExp_);
+    [[nodiscard]] const AddExp *addExp() const {
+        if (std::holds_alternative<const AddExp *>(addExp_)) {
+            return std::get<const AddExp *>(addExp_);
         }
         log_fatal("Cannot change an string to exp");
     }
@@ -246,24 +325,24 @@ public:
 
 // ConstExp -> AddExp
 class ConstExp final : public Node {
-    const std::shared_ptr<AddExp> addExp_;
+    const AddExp *const addExp_;
 
 public:
-    explicit ConstExp(const std::shared_ptr<AddExp> &addExp) : addExp_{addExp} {}
+    explicit ConstExp(const AddExp *addExp) : addExp_{addExp} {}
 
-    [[nodiscard]] std::shared_ptr<AddExp> addExp() const { return addExp_; }
+    [[nodiscard]] const AddExp *addExp() const { return addExp_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 // Cond -> LOrExp
 class Cond final : public Node {
-    const std::shared_ptr<LOrExp> lOrExp_;
+    const LOrExp *const lOrExp_;
 
 public:
-    explicit Cond(const std::shared_ptr<LOrExp> &lOrExp) : lOrExp_{lOrExp} {}
+    explicit Cond(const LOrExp *lOrExp) : lOrExp_{lOrExp} {}
 
-    [[nodiscard]] std::shared_ptr<LOrExp> lOrExp() const { return lOrExp_; }
+    [[nodiscard]] const LOrExp *lOrExp() const { return lOrExp_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
@@ -272,9 +351,6 @@ public:
 class Decl : public Node {
 protected:
     Decl() {}
-
-public:
-    ~Decl() override = default;
 };
 
 // Stmt -> LVal '=' Exp ';' | [Exp] ';'  | Block
@@ -290,83 +366,80 @@ protected:
 
 // Block -> '{' { (Decl | Stmt) } '}'
 class Block final : public Node {
-    const std::vector<std::variant<std::shared_ptr<Decl>, std::shared_ptr<Stmt>>> items_;
+    const List<std::variant<const Decl *, const Stmt *>> items_;
 
 public:
-    explicit Block(const std::vector<std::variant<std::shared_ptr<Decl>, std::shared_ptr<Stmt>>> &items) :
-        items_{items} {}
+    explicit Block(const List<std::variant<const Decl *, const Stmt *>> items) : items_{items} {}
 
-    [[nodiscard]] const std::vector<std::variant<std::shared_ptr<Decl>, std::shared_ptr<Stmt>>> &items() const {
-        return items_;
-    }
+    [[nodiscard]] List<std::variant<const Decl *, const Stmt *>> items() const { return items_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 class AssignStmt final : public Stmt {
-    const std::shared_ptr<LVal> lVal_;
-    const std::shared_ptr<Exp> exp_;
+    const LVal *const lVal_;
+    const Exp *const exp_;
 
 public:
-    AssignStmt(const std::shared_ptr<LVal> &lVal, const std::shared_ptr<Exp> &exp) : lVal_{lVal}, exp_{exp} {}
+    AssignStmt(const LVal *lVal, const Exp *exp) : lVal_{lVal}, exp_{exp} {}
 
-    [[nodiscard]] std::shared_ptr<LVal> lVal() const { return lVal_; }
+    [[nodiscard]] const LVal *lVal() const { return lVal_; }
 
-    [[nodiscard]] std::shared_ptr<Exp> exp() const { return exp_; }
+    [[nodiscard]] const Exp *exp() const { return exp_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 class ExpStmt final : public Stmt {
-    const std::shared_ptr<Exp> exp_;
+    const Exp *const exp_;
 
 public:
-    explicit ExpStmt(const std::shared_ptr<Exp> &exp) : exp_{exp} {}
+    explicit ExpStmt(const Exp *exp) : exp_{exp} {}
 
-    [[nodiscard]] std::shared_ptr<Exp> exp() const { return exp_; }
+    [[nodiscard]] const Exp *exp() const { return exp_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 class BlockStmt final : public Stmt {
-    const std::shared_ptr<Block> block_;
+    const Block *const block_;
 
 public:
-    explicit BlockStmt(const std::shared_ptr<Block> &block) : block_{block} {}
+    explicit BlockStmt(const Block *block) : block_{block} {}
 
-    [[nodiscard]] std::shared_ptr<Block> block() const { return block_; }
+    [[nodiscard]] const Block *block() const { return block_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 class IfStmt final : public Stmt {
-    const std::shared_ptr<Cond> cond_;
-    const std::shared_ptr<Stmt> then_;
-    const std::shared_ptr<Stmt> else_;
+    const Cond *const cond_;
+    const Stmt *const then_;
+    const Stmt *const else_;
 
 public:
-    IfStmt(const std::shared_ptr<Cond> &cond, const std::shared_ptr<Stmt> &then, const std::shared_ptr<Stmt> &else_) :
+    IfStmt(const Cond *cond, const Stmt *then, const Stmt *else_) :
         cond_{cond}, then_{then}, else_{else_} {}
 
-    [[nodiscard]] std::shared_ptr<Cond> cond() const { return cond_; }
+    [[nodiscard]] const Cond *cond() const { return cond_; }
 
-    [[nodiscard]] std::shared_ptr<Stmt> then() const { return then_; }
+    [[nodiscard]] const Stmt *then() const { return then_; }
 
-    [[nodiscard]] std::shared_ptr<Stmt> _else() const { return else_; }
+    [[nodiscard]] const Stmt *_else() const { return else_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 class WhileStmt final : public Stmt {
-    const std::shared_ptr<Cond> cond_;
-    const std::shared_ptr<Stmt> body_;
+    const Cond *const cond_;
+    const Stmt *const body_;
 
 public:
-    WhileStmt(const std::shared_ptr<Cond> &cond, const std::shared_ptr<Stmt> &body) : cond_{cond}, body_{body} {}
+    WhileStmt(const Cond *cond, const Stmt *body) : cond_{cond}, body_{body} {}
 
-    [[nodiscard]] std::shared_ptr<Cond> cond() const { return cond_; }
+    [[nodiscard]] const Cond *cond() const { return cond_; }
 
-    [[nodiscard]] std::shared_ptr<Stmt> body() const { return body_; }
+    [[nodiscard]] const Stmt *body() const { return body_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
@@ -382,34 +455,34 @@ public:
 };
 
 class ReturnStmt final : public Stmt {
-    const std::shared_ptr<Exp> exp_;
+    const Exp *const exp_;
 
 public:
-    explicit ReturnStmt(const std::shared_ptr<Exp> &exp) : exp_{exp} {}
+    explicit ReturnStmt(const Exp *exp) : exp_{exp} {}
 
-    [[nodiscard]] std::shared_ptr<Exp> exp() const { return exp_; }
+    [[nodiscard]] const Exp *exp() const { return exp_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
 
 // ConstInitVal -> ConstExp | '{' [ ConstInitVal { ',' ConstInitVal } ] '}'
 class ConstInitVal final : public Node {
-    const std::variant<std::shared_ptr<ConstExp>, std::vector<std::shared_ptr<ConstInitVal>>> value_;
+    const std::variant<const ConstExp *, List<const ConstInitVal *>> value_;
 
 public:
-    explicit ConstInitVal(const std::shared_ptr<ConstExp> &constExp) : value_{constExp} {}
+    explicit ConstInitVal(const ConstExp *constExp) : value_{constExp} {}
 
-    explicit ConstInitVal(const std::vector<std::shared_ptr<ConstInitVal>> &constInitVals) : value_{constInitVals} {}
+    explicit ConstInitVal(const List<const ConstInitVal *> constInitVals) : value_{constInitVals} {}
 
-    [[nodiscard]] std::variant<std::shared_ptr<ConstExp>, std::vector<std::shared_ptr<ConstInitVal>>>
+    [[nodiscard]] std::variant<const ConstExp *, List<const ConstInitVal *>>
     get_value() const {
         return value_;
     }
 
-    [[nodiscard]] bool is_constExp() const { return std::holds_alternative<std::shared_ptr<ConstExp>>(value_); }
+    [[nodiscard]] bool is_constExp() const { return std::holds_alternative<const ConstExp *>(value_); }
 
     [[nodiscard]] bool is_constInitVals() const {
-        return std::holds_alternative<std::vector<std::shared_ptr<ConstInitVal>>>(value_);
+        return std::holds_alternative<List<const ConstInitVal *>>(value_);
     }
 
     [[nodiscard]] std::string to_string() const override;
@@ -417,21 +490,21 @@ public:
 
 // ConstDef -> Ident { '[' ConstExp ']' } '=' ConstInitVal
 class ConstDef final : public Node {
-    const std::string ident_;
-    const std::vector<std::shared_ptr<ConstExp>> constExps_;
-    const std::shared_ptr<ConstInitVal> constInitVal_;
+    const std::string_view ident_;
+    const List<const ConstExp *> constExps_;
+    const ConstInitVal *const constInitVal_;
     const int lineno_;
 
 public:
-    ConstDef(std::string ident, const std::vector<std::shared_ptr<ConstExp>> &constExps,
-             const std::shared_ptr<ConstInitVal> &constInitVal, int lineno) :
-        ident_{std::move(ident)}, constExps_{constExps}, constInitVal_{constInitVal}, lineno_{lineno} {}
+    ConstDef(const std::string_view ident, const List<const ConstExp *> constExps,
+             const ConstInitVal *constInitVal, int lineno) :
+        ident_{ident}, constExps_{constExps}, constInitVal_{constInitVal}, lineno_{lineno} {}
 
     [[nodiscard]] std::string to_string() const override;
 
-    [[nodiscard]] std::string ident() const { return ident_; }
-    [[nodiscard]] const std::vector<std::shared_ptr<ConstExp>> &constExps() const { return constExps_; }
-    [[nodiscard]] std::shared_ptr<ConstInitVal> constInitVal() const { return constInitVal_; }
+    [[nodiscard]] std::string_view ident() const { return ident_; }
+    [[nodiscard]] List<const ConstExp *> constExps() const { return constExps_; }
+    [[nodiscard]] const ConstInitVal *constInitVal() const { return constInitVal_; }
     [[nodiscard]] bool is_exp() const { return constInitVal_->is_constExp(); }
     [[nodiscard]] int lineno() const { return lineno_; }
 };
@@ -439,36 +512,36 @@ public:
 // ConstDecl ->  'const' BType ConstDef { ',' ConstDef } ';'
 class ConstDecl final : public Decl {
     const Token::Type bType_;
-    const std::vector<std::shared_ptr<ConstDef>> constDefs_;
+    const List<const ConstDef *> constDefs_;
 
 public:
-    ConstDecl(const Token::Type &bType, const std::vector<std::shared_ptr<ConstDef>> &constDefs) :
+    ConstDecl(const Token::Type &bType, const List<const ConstDef *> constDefs) :
         bType_{bType}, constDefs_{constDefs} {}
 
     [[nodiscard]] std::string to_string() const override;
 
     [[nodiscard]] Token::Type bType() const { return bType_; }
 
-    [[nodiscard]] const std::vector<std::shared_ptr<ConstDef>> &constDefs() const { return constDefs_; }
+    [[nodiscard]] List<const ConstDef *> constDefs() const { return constDefs_; }
 };
 
 // InitVal : Exp | '{' [ InitVal { ',' InitVal } ] '}'
 class InitVal final : public Node {
-    const std::variant<std::shared_ptr<Exp>, std::vector<std::shared_ptr<InitVal>>> value_;
+    const std::variant<const Exp *, List<const InitVal *>> value_;
 
 public:
-    explicit InitVal(const std::shared_ptr<Exp> &exp) : value_{exp} {}
+    explicit InitVal(const Exp *exp) : value_{exp} {}
 
-    explicit InitVal(const std::vector<std::shared_ptr<InitVal>> &initVals) : value_{initVals} {}
+    explicit InitVal(const List<const InitVal *> initVals) : value_{initVals} {}
 
-    [[nodiscard]] std::variant<std::shared_ptr<Exp>, std::vector<std::shared_ptr<InitVal>>> get_value() const {
+    [[nodiscard]] std::variant<const Exp *, List<const InitVal *>> get_value() const {
         return value_;
     }
 
-    [[nodiscard]] bool is_exp() const { return std::holds_alternative<std::shared_ptr<Exp>>(value_); }
+    [[nodiscard]] bool is_exp() const { return std::holds_alternative<const Exp *>(value_); }
 
     [[nodiscard]] bool is_initVals() const {
-        return std::holds_alternative<std::vector<std::shared_ptr<InitVal>>>(value_);
+        return std::holds_alternative<List<const InitVal *>>(value_);
     }
 
     [[nodiscard]] std::string to_string() const override;
@@ -476,21 +549,21 @@ public:
 
 // VarDef -> Ident { '[' ConstExp ']' } ('=' InitVal)
 class VarDef final : public Node {
-    const std::string ident_;
-    const std::vector<std::shared_ptr<ConstExp>> constExps_;
-    const std::shared_ptr<InitVal> initVal_;
+    const std::string_view ident_;
+    const List<const ConstExp *> constExps_;
+    const InitVal *const initVal_;
     const int lineno_;
 
 public:
-    VarDef(std::string ident, const std::vector<std::shared_ptr<ConstExp>> &constExps,
-           const std::shared_ptr<InitVal> &initVal, int lineno) :
-        ident_{std::move(ident)}, constExps_{constExps}, initVal_{initVal}, lineno_{lineno} {}
+    VarDef(const std::string_view ident, const List<const ConstExp *> constExps,
+           const InitVal *initVal, int lineno) :
+        ident_{ident}, constExps_{constExps}, initVal_{initVal}, lineno_{lineno} {}
 
-    [[nodiscard]] std::string ident() const { return ident_; }
+    [[nodiscard]] std::string_view ident() const { return ident_; }
 
-    [[nodiscard]] std::vector<std::shared_ptr<ConstExp>> constExps() const { return constExps_; }
+    [[nodiscard]] List<const ConstExp *> constExps() const { return constExps_; }
 
-    [[nodiscard]] std::shared_ptr<InitVal> initVal() const { return initVal_; }
+    [[nodiscard]] const InitVal *initVal() const { return initVal_; }
 
     [[nodiscard]] std::string to_string() const override;
 
@@ -502,32 +575,32 @@ public:
 // VarDecl -> BType VarDef { ',' VarDef } ';'
 class VarDecl final : public Decl {
     const Token::Type bType_;
-    const std::vector<std::shared_ptr<VarDef>> varDefs_;
+    const List<const VarDef *> varDefs_;
 
 public:
-    VarDecl(const Token::Type &bType, const std::vector<std::shared_ptr<VarDef>> &varDefs) :
+    VarDecl(const Token::Type &bType, const List<const VarDef *> varDefs) :
         bType_{bType}, varDefs_{varDefs} {}
 
     [[nodiscard]] std::string to_string() const override;
 
     [[nodiscard]] Token::Type bType() const { return bType_; }
 
-    [[nodiscard]] const std::vector<std::shared_ptr<VarDef>> &varDefs() const { return varDefs_; }
+    [[nodiscard]] List<const VarDef *> varDefs() const { return varDefs_; }
 };
 
 // FuncFParam -> BType Ident ['[' ']' { '[' Exp ']' }]
 class FuncFParam final : public Node {
     const Token::Type bType_;
-    const std::string ident_;
-    const std::vector<std::shared_ptr<Exp>> exps_;
+    const std::string_view ident_;
+    const List<const Exp *> exps_;
 
 public:
-    FuncFParam(const Token::Type &bType, std::string ident, const std::vector<std::shared_ptr<Exp>> &exps) :
-        bType_{bType}, ident_{std::move(ident)}, exps_{exps} {}
+    FuncFParam(const Token::Type &bType, const std::string_view ident, const List<const Exp *> exps) :
+        bType_{bType}, ident_{ident}, exps_{exps} {}
 
     [[nodiscard]] Token::Type bType() const { return bType_; }
-    [[nodiscard]] std::string ident() const { return ident_; }
-    [[nodiscard]] const std::vector<std::shared_ptr<Exp>> &exps() const { return exps_; }
+    [[nodiscard]] std::string_view ident() const { return ident_; }
+    [[nodiscard]] List<const Exp *> exps() const { return exps_; }
 
     [[nodiscard]] std::string to_string() const override;
 };
@@ -535,36 +608,33 @@ public:
 // FuncDef -> FuncType Ident '(' [FuncFParam { ',' FuncFParam }] ')' Block
 class FuncDef final : public Node {
     const Token::Type funcType_;
-    const std::string ident_;
-    const std::vector<std::shared_ptr<FuncFParam>> funcParams_;
-    const std::shared_ptr<Block> block_;
+    const std::string_view ident_;
+    const List<const FuncFParam *> funcParams_;
+    const Block *const block_;
 
 public:
-    FuncDef(const Token::Type &funcType, std::string ident, const std::vector<std::shared_ptr<FuncFParam>> &funcParams,
-            const std::shared_ptr<Block> &block) :
-        funcType_{funcType}, ident_{std::move(ident)}, funcParams_{funcParams}, block_{block} {}
+    FuncDef(const Token::Type &funcType, const std::string_view ident, const List<const FuncFParam *> funcParams,
+            const Block *block) :
+        funcType_{funcType}, ident_{ident}, funcParams_{funcParams}, block_{block} {}
 
     [[nodiscard]] std::string to_string() const override;
 
-    [[nodiscard]] std::string ident() const { return ident_; }
+    [[nodiscard]] std::string_view ident() const { return ident_; }
     [[nodiscard]] Token::Type funcType() const { return funcType_; }
-    [[nodiscard]] const std::vector<std::shared_ptr<FuncFParam>> &funcParams() const { return funcParams_; }
-    [[nodiscard]] std::shared_ptr<Block> block() const { return block_; }
+    [[nodiscard]] List<const FuncFParam *> funcParams() const { return funcParams_; }
+    [[nodiscard]] const Block *block() const { return block_; }
 };
 
 // CompUnit -> {Decl | FuncDef}
 class CompUnit final : public Node {
-    const std::vector<std::variant<std::shared_ptr<Decl>, std::shared_ptr<FuncDef>>> compunits_;
+    const List<std::variant<const Decl *, const FuncDef *>> compunits_;
 
 public:
-    explicit CompUnit(const std::vector<std::variant<std::shared_ptr<Decl>, std::shared_ptr<FuncDef>>> &compunits) :
-        compunits_{compunits} {}
+    explicit CompUnit(const List<std::variant<const Decl *, const FuncDef *>> compunits) : compunits_{compunits} {}
 
     [[nodiscard]] std::string to_string() const override;
 
-    [[nodiscard]] const std::vector<std::variant<std::shared_ptr<Decl>, std::shared_ptr<FuncDef>>> &compunits() const {
-        return compunits_;
-    }
+    [[nodiscard]] List<std::variant<const Decl *, const FuncDef *>> compunits() const { return compunits_; }
 };
 } // namespace AST
 #endif
@@ -0,0 +1,97 @@
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Utils {
+// 带固定 1MB 缓冲区的输出，打印函数逐条写入，缓冲区满时整块写入文件描述符
+// 也可以直接追加到一个字符串，以便用同一个打印函数实现 to_string
+class OutputSink {
+    static constexpr size_t buffer_size = 1 << 20;
+
+    int fd_{-1};
+    bool owns_fd_{false};
+    std::string *target_{nullptr};
+    std::unique_ptr<char[]> buffer_;
+    size_t used_{0};
+
+    // 将缓冲区写入文件描述符，返回是否全部写入
+    bool drain() noexcept;
+
+public:
+    // 写入文件 path，path 为空时写入标准输出
+    explicit OutputSink(const std::string &path);
+
+    // 追加到 target
+    explicit OutputSink(std::string &target) : target_{&target} {}
+
+    OutputSink(const OutputSink &) = delete;
+
+    OutputSink &operator=(const OutputSink &) = delete;
+
+    // 析构时尽力写出剩余内容，需要报告写入错误时应先调用 close
+    ~OutputSink();
+
+    void write(const char *data, const size_t size) {
+        if (target_ != nullptr) {
+            target_->append(data, size);
+            return;
+        }
+        if (used_ + size > buffer_size) {
+            flush();
+            if (size > buffer_size) {
+                write_through(data, size);
+                return;
+            }
+        }
+        std::memcpy(buffer_.get() + used_, data, size);
+        used_ += size;
+    }
+
+    void flush();
+
+    // 写出剩余内容并关闭文件，失败时 log_error
+    void close();
+
+    OutputSink &operator<<(const std::string_view text) {
+        write(text.data(), text.size());
+        return *this;
+    }
+
+    OutputSink &operator<<(const char *text) { return *this << std::string_view{text}; }
+
+    OutputSink &operator<<(const char c) {
+        write(&c, 1);
+        return *this;
+    }
+
+    template<typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>,
+                                          int>  = 0>
+    OutputSink &operator<<(const T value) {
+        char digits[24];
+        const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        write(digits, end - digits);
+        return *this;
+    }
+
+private:
+    // 超过缓冲区大小的内容直接写入
+    void write_through(const char *data, size_t size);
+};
+
+// 用 print(OutputSink &) 形式的打印函数得到字符串
+template<typename Printer>
+std::string print_to_string(const Printer &printer) {
+    std::string result;
+    OutputSink out{result};
+    printer(out);
+    return result;
+}
+} // namespace Utils
+
+#endif // OUTPUT_SINK_H
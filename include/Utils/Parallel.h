@@ -0,0 +1,40 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+
+namespace Utils {
+// 线程池正在执行一批任务时为 true
+// 模块内共享的结构（arena、常量池、类型表、共享Value的use链表等）只在此期间加锁，串行执行时没有额外开销
+inline std::atomic<bool> &parallel_running() {
+    static std::atomic<bool> running{false};
+    return running;
+}
+
+// 仅在并行执行期间加锁的互斥锁守卫
+// 标记只在没有任务执行时切换（ThreadPool::run 在任务入队前置位、全部完成后复位），因此同一个守卫的加锁与解锁总是成对的
+template<typename Mutex>
+class ParallelLock {
+    Mutex *mutex_;
+
+public:
+    explicit ParallelLock(Mutex &mutex) :
+        mutex_{parallel_running().load(std::memory_order_relaxed) ? &mutex : nullptr} {
+        if (mutex_ != nullptr) {
+            mutex_->lock();
+        }
+    }
+
+    ~ParallelLock() {
+        if (mutex_ != nullptr) {
+            mutex_->unlock();
+        }
+    }
+
+    ParallelLock(const ParallelLock &) = delete;
+
+    ParallelLock &operator=(const ParallelLock &) = delete;
+};
+} // namespace Utils
+
+#endif // PARALLEL_H
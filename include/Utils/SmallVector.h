@@ -0,0 +1,97 @@
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace Utils {
+// 不超过 N 个元素时存放在对象内部的顺序容器，超出后整体转存到堆上
+// 元素保持插入顺序，find 与 count 按值线性查找，适合控制流图的边表这类通常只有一两个元素的场景
+template<typename T, size_t N>
+class SmallVector {
+    std::array<T, N> inline_{};
+    size_t inline_size_{0};
+    // 非空时所有元素都在堆上
+    std::vector<T> heap_;
+
+    [[nodiscard]] bool on_heap() const { return !heap_.empty(); }
+
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> values) {
+        for (const auto &value: values) {
+            push_back(value);
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return on_heap() ? heap_.size() : inline_size_; }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    [[nodiscard]] T *data() { return on_heap() ? heap_.data() : inline_.data(); }
+
+    [[nodiscard]] const T *data() const { return on_heap() ? heap_.data() : inline_.data(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    [[nodiscard]] const_iterator begin() const { return data(); }
+    [[nodiscard]] const_iterator end() const { return data() + size(); }
+
+    T &operator[](const size_t index) { return data()[index]; }
+
+    const T &operator[](const size_t index) const { return data()[index]; }
+
+    [[nodiscard]] const T &front() const { return data()[0]; }
+
+    [[nodiscard]] const T &back() const { return data()[size() - 1]; }
+
+    void push_back(const T &value) {
+        if (on_heap()) {
+            heap_.push_back(value);
+            return;
+        }
+        if (inline_size_ < N) {
+            inline_[inline_size_++] = value;
+            return;
+        }
+        heap_.reserve(2 * N + 1);
+        for (size_t i = 0; i < inline_size_; ++i) {
+            heap_.push_back(std::move(inline_[i]));
+            inline_[i] = T{};
+        }
+        inline_size_ = 0;
+        heap_.push_back(value);
+    }
+
+    iterator erase(const_iterator position) {
+        const auto index = static_cast<size_t>(position - data());
+        if (on_heap()) {
+            heap_.erase(heap_.begin() + static_cast<std::ptrdiff_t>(index));
+            return data() + index;
+        }
+        std::move(inline_.begin() + index + 1, inline_.begin() + inline_size_, inline_.begin() + index);
+        inline_[--inline_size_] = T{};
+        return data() + index;
+    }
+
+    void clear() {
+        heap_.clear();
+        std::fill(inline_.begin(), inline_.begin() + inline_size_, T{});
+        inline_size_ = 0;
+    }
+
+    [[nodiscard]] const_iterator find(const T &value) const { return std::find(begin(), end(), value); }
+
+    [[nodiscard]] size_t count(const T &value) const { return std::count(begin(), end(), value); }
+};
+} // namespace Utils
+
+#endif // SMALLVECTOR_H
@@ -0,0 +1,86 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils {
+// 工作窃取线程池
+// 每个线程持有一个任务队列，从自己的队尾取任务，自己的队列为空时从其它线程的队首窃取
+// 调用 run 的线程作为 0 号线程同样参与执行，直到这一批任务全部完成
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t threads);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    [[nodiscard]] size_t size() const { return queues_.size(); }
+
+    // 执行一批任务并等待其全部完成，期间 parallel_running() 为 true
+    // 某个任务抛出异常后，尚未开始的任务被跳过，第一个异常在调用线程上重新抛出
+    void run(std::vector<Task> tasks);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    // 新的一批任务到来或线程池析构
+    std::condition_variable wake_;
+    // 当前批次的任务全部完成
+    std::condition_variable done_;
+    size_t generation_{0};
+    bool stopping_{false};
+    std::atomic<size_t> pending_{0};
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+
+    bool pop(size_t self, Task &task);
+
+    void execute(Task &task);
+
+    void work(size_t self);
+};
+
+// 编译器共享的线程池，线程数由 -j 决定，首次使用时创建
+void set_worker_threads(size_t threads);
+
+ThreadPool &worker_pool();
+
+// 对 items 中的每个元素调用 func，jobs 大于 1 时分发到共享线程池上执行，返回前全部完成
+template<typename Container, typename Func>
+void for_each_in_parallel(Container &items, const size_t jobs, const Func &func) {
+    if (jobs <= 1 || items.size() <= 1) {
+        for (auto &item: items) {
+            func(item);
+        }
+        return;
+    }
+    std::vector<ThreadPool::Task> tasks;
+    tasks.reserve(items.size());
+    for (auto &item: items) {
+        tasks.emplace_back([&func, &item] { func(item); });
+    }
+    worker_pool().run(std::move(tasks));
+}
+} // namespace Utils
+
+#endif // THREAD_POOL_H
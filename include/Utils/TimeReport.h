@@ -0,0 +1,82 @@
+#ifndef TIME_REPORT_H
+#define TIME_REPORT_H
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+#include "Utils/Trace.h"
+
+namespace Utils {
+// IR 的规模
+struct IRSize {
+    size_t functions{0};
+    size_t blocks{0};
+    size_t instructions{0};
+};
+
+// -ftime-report 记录的一次计时，如一次变换或一个后端阶段
+struct TimeRecord {
+    // frontend、pass 或 backend
+    std::string group;
+    std::string name;
+    double wall_ms{0};
+    double cpu_ms{0};
+    // 变换前后的 IR 规模，后端阶段没有
+    std::optional<IRSize> before;
+    std::optional<IRSize> after;
+    // 执行期间重新计算的分析次数
+    size_t analyses{0};
+};
+
+// 开启后才记录，开启的时刻作为整个编译的起点
+void set_time_report_enabled(bool enabled);
+
+[[nodiscard]] bool time_report_enabled();
+
+// 可在线程池的任务中调用
+void record_time(TimeRecord record);
+
+// 按名称汇总、按墙钟时间降序排列的表格
+[[nodiscard]] std::string time_report_table();
+
+// 按执行顺序列出每一次记录
+[[nodiscard]] std::string time_report_json();
+
+// 同时测量墙钟时间与 CPU 时间
+// 在线程池的任务中只统计当前线程的 CPU 时间，否则统计整个进程的 CPU 时间（包括并行执行的工作线程）
+class Stopwatch {
+public:
+    Stopwatch();
+
+    [[nodiscard]] double wall_ms() const;
+
+    [[nodiscard]] double cpu_ms() const;
+
+private:
+    std::chrono::steady_clock::time_point wall_start_;
+    bool thread_clock_;
+    double cpu_start_;
+};
+
+// 析构时把所在作用域的耗时记录为 group/name，开启 -ftrace 时同时记录为一段区间
+// 两者都未开启时不做任何事
+class ScopedTimer {
+public:
+    ScopedTimer(std::string group, std::string name);
+
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer &) = delete;
+
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    TraceSpan span_;
+    std::optional<Stopwatch> stopwatch_;
+    std::string group_;
+    std::string name_;
+};
+} // namespace Utils
+
+#endif // TIME_REPORT_H
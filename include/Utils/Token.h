@@ -4,7 +4,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
-#include <utility>
+#include <string_view>
 
 namespace Token {
 enum class Type {
@@ -58,13 +58,14 @@ enum class Type {
 
 std::string type_to_string(Type type);
 
+// Token 不持有文本，content 指向 SourceBuffer 中的原始片段（字符串字面量不含两侧的引号）
 class Token {
 public:
-    const std::string content;
-    const Type type;
-    const int line;
+    std::string_view content;
+    Type type;
+    int line;
 
-    Token(std::string c, const Type t, const int l) : content(std::move(c)), type(t), line(l) {}
+    Token(const std::string_view c, const Type t, const int l) : content(c), type(t), line(l) {}
 
     [[nodiscard]] std::string to_string() const;
 };
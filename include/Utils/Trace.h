@@ -0,0 +1,45 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Utils {
+// -ftrace 开启后记录编译过程中的区间，结束时写出 Chrome trace_event 格式的 JSON
+// 可用 chrome://tracing 或 Perfetto 打开，同一线程上的区间按时间自动嵌套
+void set_trace_enabled(bool enabled);
+
+[[nodiscard]] bool trace_enabled();
+
+void write_trace(const std::string &filename);
+
+// 转义 JSON 字符串中的引号、反斜杠与控制字符
+[[nodiscard]] std::string escape_json(const std::string &str);
+
+// 作用域内的一段区间，未开启 -ftrace 时不做任何事
+// 可在线程池的任务中使用，每个线程在输出中各占一行
+class TraceSpan {
+public:
+    TraceSpan(const char *category, std::string name);
+
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan &) = delete;
+
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    // 附加到事件的 args 中，在查看器中选中区间时显示
+    void add_arg(const char *key, long long value);
+
+private:
+    bool active_;
+    std::string category_;
+    std::string name_;
+    std::chrono::steady_clock::time_point start_;
+    std::vector<std::pair<const char *, long long>> args_;
+};
+} // namespace Utils
+
+#endif // TRACE_H
@@ -1,6 +1,7 @@
 #include "Backend/InstructionSets/RISC-V/Modules.h"
 #include "Backend/LIR/Instructions.h"
 #include "Utils/Log.h"
+#include "Utils/ThreadPool.h"
 
 RISCV::Module::Module(const std::shared_ptr<Backend::LIR::Module>& lir_module, const RegisterAllocator::AllocationType& allocation_type) {
     data_section = std::move(lir_module->global_data);
@@ -12,74 +13,57 @@ RISCV::Module::Module(const std::shared_ptr<Backend::LIR::Module>& lir_module, c
     }
 }
 
-std::string RISCV::Module::to_string(const std::shared_ptr<Backend::DataSection> &data_section) {
-    std::ostringstream oss;
-
-    auto float_value_to_string = [&oss](const std::shared_ptr<Backend::FloatValue> &float_value) {
-        oss << "  .word  ";
-        const float val = static_cast<float>(float_value->float_value);
-        union {
-            float f;
-            uint32_t i;
-        } x;
-        x.f = val;
-        oss << x.i << "\n";
+void RISCV::Module::print(::Utils::OutputSink &out, const std::shared_ptr<Backend::DataSection> &data_section) {
+    // Zero gaps become `.zero`, and runs of the same word collapse into a single `.fill`.
+    // Each label is realigned because strings of odd length may precede it in `.rodata`.
+    auto print_variable = [&out](const Backend::DataSection::Variable &var) {
+        out << ".p2align 2\n"
+            << var.label() << ":\n";
+        var.for_each_data_item(
+            [&out](const size_t bytes) { out << "  .zero " << bytes << "\n"; },
+            [&out](const int32_t word, const size_t count) {
+                if (count == 1)
+                    out << "  .word " << word << "\n";
+                else
+                    out << "  .fill " << count << ", 4, " << word << "\n";
+            });
     };
 
-    oss << ".section .rodata\n"
+    out << ".section .rodata\n"
+        << ".align 2\n";
+    // Strings go first so that the word data after them only has to be padded once per label.
+    for (const auto &[name, var] : data_section->global_variables)
+        if (var->read_only && var->init_value->value_type == Backend::DataSection::Variable::InitValue::Type::STRING)
+            out << "str." << var->name << ":\n"
+                << "  .string \"" << std::static_pointer_cast<Backend::DataSection::Variable::ConstString>(var->init_value)->str << "\""
+                << "\n";
+    for (const auto &[name, var] : data_section->global_variables)
+        if (var->read_only && var->init_value->value_type != Backend::DataSection::Variable::InitValue::Type::STRING)
+            print_variable(*var);
+    out << ".section .data\n"
         << ".align 2\n";
-    for (const std::pair<std::string, std::shared_ptr<Backend::DataSection::Variable>> var : data_section->global_variables)
-        if (var.second->read_only) {
-            if (var.second->init_value->value_type == Backend::DataSection::Variable::InitValue::Type::STRING) {
-                // only str can trigger this
-                oss << "str." << var.second->name << ":\n"
-                    << "  .string \"" << std::static_pointer_cast<Backend::DataSection::Variable::ConstString>(var.second->init_value)->str << "\""
-                    << "\n";
-            } else {
-                oss << var.second->label() << ":\n";
-                const std::vector<std::shared_ptr<Backend::Constant>> &constants = std::static_pointer_cast<Backend::DataSection::Variable::Constants>(var.second->init_value)->constants;
-                for (const std::shared_ptr<Backend::Constant> &value: constants) {
-                    if (std::dynamic_pointer_cast<Backend::IntValue>(value) != nullptr) {
-                        oss << "  " << Backend::Utils::to_riscv_indicator(value->constant_type) << " " << value->name << "\n";
-                    } else if (const auto f = std::dynamic_pointer_cast<Backend::FloatValue>(value)) {
-                        float_value_to_string(f);
-                    } else if (const auto int_multi_zero = std::dynamic_pointer_cast<Backend::IntMultiZero>(value)) {
-                        oss << "  .zero " << int_multi_zero->zero_count * Backend::Utils::type_to_size(var.second->workload_type) << "\n";
-                    } else if (const auto float_multi_zero = std::dynamic_pointer_cast<Backend::FloatMultiZero>(value)) {
-                        oss << "  .zero " << float_multi_zero->zero_count * Backend::Utils::type_to_size(var.second->workload_type) << "\n";
-                    }
-                }
-            }
-        }
-    oss << ".section .data\n"
+    for (const auto &[name, var] : data_section->global_variables)
+        if (!var->read_only && !var->zero_initialized())
+            print_variable(*var);
+    // All-zero variables take no space in the object file.
+    out << ".section .bss\n"
         << ".align 2\n";
-    for (const std::pair<std::string, std::shared_ptr<Backend::DataSection::Variable>> var : data_section->global_variables)
-        if (!var.second->read_only) {
-            // only int & float can trigger this
-            oss << var.second->label() << ":\n";
-            const std::vector<std::shared_ptr<Backend::Constant>> &constants = std::static_pointer_cast<Backend::DataSection::Variable::Constants>(var.second->init_value)->constants;
-            for (const std::shared_ptr<Backend::Constant> &value: constants) {
-                if (std::dynamic_pointer_cast<Backend::IntValue>(value) != nullptr) {
-                    oss << "  " << Backend::Utils::to_riscv_indicator(value->constant_type) << " " << value->name << "\n";
-                } else if (const auto f = std::dynamic_pointer_cast<Backend::FloatValue>(value)) {
-                    float_value_to_string(f);
-                } else if (const auto int_multi_zero = std::dynamic_pointer_cast<Backend::IntMultiZero>(value);
-                    int_multi_zero && int_multi_zero->zero_count > 0) {
-                    oss << "  .zero " << int_multi_zero->zero_count * Backend::Utils::type_to_size(var.second->workload_type) << "\n";
-                } else if (const auto float_multi_zero = std::dynamic_pointer_cast<Backend::FloatMultiZero>(value);
-                    float_multi_zero && float_multi_zero->zero_count > 0) {
-                    oss << "  .zero " << float_multi_zero->zero_count * Backend::Utils::type_to_size(var.second->workload_type) << "\n";
-                }
-            }
-        }
-    oss << "# END OF DATA FIELD\n";
-    return oss.str();
+    for (const auto &[name, var] : data_section->global_variables)
+        if (!var->read_only && var->zero_initialized())
+            out << var->label() << ":\n"
+                << "  .zero " << var->size() << "\n";
+    out << "# END OF DATA FIELD\n";
+}
+
+void RISCV::Module::to_assembly(const size_t jobs) {
+    ::Utils::for_each_in_parallel(functions, jobs, [](const std::shared_ptr<RISCV::Function> &function) {
+        function->to_assembly();
+    });
 }
 
 RISCV::Function::Function(const std::shared_ptr<Backend::LIR::Function> &lir_function, const RegisterAllocator::AllocationType& allocation_type) : name(lir_function->name), lir_function(lir_function) {
     stack = std::make_shared<RISCV::Stack>();
     register_allocator = RISCV::RegisterAllocator::create(allocation_type, lir_function, stack);
-    register_allocator->allocate();
 }
 
 void RISCV::Function::generate_prologue() {
@@ -125,31 +109,39 @@ std::string RISCV::Block::label_name() const {
 }
 
 std::string RISCV::Block::to_string() const {
-    std::ostringstream oss;
-    oss << " " << label_name() << ":\n";
+    return ::Utils::print_to_string([this](::Utils::OutputSink &out) { print(out); });
+}
+
+void RISCV::Block::print(::Utils::OutputSink &out) const {
+    out << " " << label_name() << ":\n";
     for (const std::shared_ptr<Instructions::Instruction>& instr : instructions) {
-        oss << "  " << instr->to_string() << "\n";
+        out << "  " << instr->to_string() << "\n";
     }
-    return oss.str();
 }
 
 std::string RISCV::Function::to_string() const {
-    std::ostringstream oss;
-    oss << name << ":\n";
+    return ::Utils::print_to_string([this](::Utils::OutputSink &out) { print(out); });
+}
+
+void RISCV::Function::print(::Utils::OutputSink &out) const {
+    out << name << ":\n";
     for (const std::shared_ptr<RISCV::Block> &block: blocks)
-        oss << block->to_string();
-    return oss.str();
+        block->print(out);
 }
 
 std::string RISCV::Module::to_string() const {
-    std::ostringstream oss;
-    oss << to_string(data_section) << "\n";
-    oss << TEXT_OPTION << "\n";
+    return ::Utils::print_to_string([this](::Utils::OutputSink &out) { print(out); });
+}
+
+void RISCV::Module::print(::Utils::OutputSink &out) const {
+    print(out, data_section);
+    out << "\n";
+    out << TEXT_OPTION << "\n";
     for (const std::shared_ptr<RISCV::Function> &function : functions) {
-        oss << function->to_string() << "\n";
+        function->print(out);
+        out << "\n";
     }
-    oss << RISCV::ASM::memset_s;
-    return oss.str();
+    out << RISCV::ASM::memset_s;
 }
 
 void RISCV::Function::translate_blocks() {
@@ -1,4 +1,5 @@
 #include "Backend/InstructionSets/RISC-V/Opt/Peephole.h"
+#include "Utils/ThreadPool.h"
 
 RISCV::Opt::PeepholeBeforeRA::PeepholeBeforeRA(const std::shared_ptr<Backend::LIR::Module> &module) {
     this->module = module;
@@ -232,13 +233,17 @@ RISCV::Opt::PeepholeAfterRA::PeepholeAfterRA(const std::shared_ptr<RISCV::Module
 
 RISCV::Opt::PeepholeAfterRA::~PeepholeAfterRA() { this->module = nullptr; }
 
-void RISCV::Opt::PeepholeAfterRA::optimize() {
-    for (auto &function: module->functions) {
-        for (auto &block: function->blocks) {
-            addSubZeroRemove(block);
-        }
-        removeUselessJumps(function);
+void RISCV::Opt::PeepholeAfterRA::optimize(const size_t jobs) {
+    ::Utils::for_each_in_parallel(module->functions, jobs, [this](const std::shared_ptr<RISCV::Function> &function) {
+        optimize(function);
+    });
+}
+
+void RISCV::Opt::PeepholeAfterRA::optimize(const std::shared_ptr<RISCV::Function> &function) {
+    for (auto &block: function->blocks) {
+        addSubZeroRemove(block);
     }
+    removeUselessJumps(function);
 }
 
 void RISCV::Opt::PeepholeAfterRA::removeUselessJumps(const std::shared_ptr<RISCV::Function> &function) {
@@ -152,4 +152,67 @@ void RISCV::ReWrite::rewrite_parameters_f(const std::shared_ptr<Backend::LIR::Fu
             }
         }
     }
+}
+
+/*
+ * Create virtual registers for all integer registers, shared by all register allocators.
+ * First, we create a block entry which will not be included in any loops.
+ * Second, we create variables for reigsters.
+ * Third, we insert `load` & `store` instructions for function calls & parameters.
+ * Last, we save all caller-saved registers.
+ */
+void RISCV::ReWrite::create_registers_i(const std::shared_ptr<Backend::LIR::Function> &lir_function, const std::shared_ptr<RISCV::Stack> &stack) {
+    create_entry_block(lir_function);
+    std::shared_ptr<Backend::LIR::Block> block_entry = lir_function->blocks.front();
+    for (const RISCV::Registers::ABI reg : RISCV::Registers::Integers::registers)
+        lir_function->add_variable(std::make_shared<Backend::Variable>(RISCV::Registers::to_string(reg), Backend::VariableType::INT64, Backend::VariableWide::LOCAL));
+    rewrite_parameters_i(lir_function, stack);
+    // at the very beginning of the function, copy callee-saved registers
+    for (const RISCV::Registers::ABI reg : RISCV::Registers::Integers::callee_saved) {
+        std::shared_ptr<Backend::Variable> var = std::make_shared<Backend::Variable>(RISCV::Registers::to_string(reg) + "_mem", Backend::VariableType::INT64, Backend::VariableWide::LOCAL);
+        lir_function->add_variable(var);
+        block_entry->instructions.insert(block_entry->instructions.begin(), std::make_shared<Backend::LIR::Move>(lir_function->variables[RISCV::Registers::to_string(reg)], var));
+    }
+    for (const std::shared_ptr<Backend::LIR::Block> &block : lir_function->blocks) {
+        for (size_t i = 0; i < block->instructions.size(); i++) {
+            std::shared_ptr<Backend::LIR::Instruction> instruction = block->instructions[i];
+            if (instruction->type == Backend::LIR::InstructionType::RETURN) {
+                // move return value to a0
+                std::shared_ptr<Backend::LIR::Return> ret = std::static_pointer_cast<Backend::LIR::Return>(instruction);
+                if (ret->return_value && Backend::Utils::is_int(ret->return_value->workload_type))
+                    block->instructions.insert(block->instructions.begin() + i++, std::make_shared<Backend::LIR::Move>(ret->return_value, lir_function->variables[RISCV::Registers::to_string(RISCV::Registers::ABI::A0)])),
+                    ret->return_value = lir_function->variables[RISCV::Registers::to_string(RISCV::Registers::ABI::A0)];
+                for (const RISCV::Registers::ABI reg : RISCV::Registers::Integers::callee_saved)
+                    block->instructions.insert(block->instructions.begin() + i++, std::make_shared<Backend::LIR::Move>(lir_function->variables[RISCV::Registers::to_string(reg) + "_mem"], lir_function->variables[RISCV::Registers::to_string(reg)]));
+            }
+        }
+    }
+}
+
+void RISCV::ReWrite::create_registers_f(const std::shared_ptr<Backend::LIR::Function> &lir_function, const std::shared_ptr<RISCV::Stack> &stack) {
+    create_entry_block(lir_function);
+    std::shared_ptr<Backend::LIR::Block> block_entry = lir_function->blocks.front();
+    for (const RISCV::Registers::ABI reg : RISCV::Registers::Floats::registers)
+        lir_function->add_variable(std::make_shared<Backend::Variable>(RISCV::Registers::to_string(reg), Backend::VariableType::DOUBLE, Backend::VariableWide::LOCAL));
+    rewrite_parameters_f(lir_function, stack);
+    // at the very beginning of the function, copy callee-saved registers
+    for (const RISCV::Registers::ABI reg : RISCV::Registers::Floats::callee_saved) {
+        std::shared_ptr<Backend::Variable> var = std::make_shared<Backend::Variable>(RISCV::Registers::to_string(reg) + "_mem", Backend::VariableType::DOUBLE, Backend::VariableWide::LOCAL);
+        lir_function->add_variable(var);
+        block_entry->instructions.insert(block_entry->instructions.begin(), std::make_shared<Backend::LIR::Move>(lir_function->variables[RISCV::Registers::to_string(reg)], var));
+    }
+    for (const std::shared_ptr<Backend::LIR::Block> &block : lir_function->blocks) {
+        for (size_t i = 0; i < block->instructions.size(); i++) {
+            std::shared_ptr<Backend::LIR::Instruction> instruction = block->instructions[i];
+            if (instruction->type == Backend::LIR::InstructionType::RETURN) {
+                // move return value to fa0
+                std::shared_ptr<Backend::LIR::Return> ret = std::static_pointer_cast<Backend::LIR::Return>(instruction);
+                if (ret->return_value && Backend::Utils::is_float(ret->return_value->workload_type))
+                    block->instructions.insert(block->instructions.begin() + i++, std::make_shared<Backend::LIR::Move>(ret->return_value, lir_function->variables[RISCV::Registers::to_string(RISCV::Registers::ABI::FA0)])),
+                    ret->return_value = lir_function->variables[RISCV::Registers::to_string(RISCV::Registers::ABI::FA0)];
+                for (const RISCV::Registers::ABI reg : RISCV::Registers::Floats::callee_saved)
+                    block->instructions.insert(block->instructions.begin() + i++, std::make_shared<Backend::LIR::Move>(lir_function->variables[RISCV::Registers::to_string(reg) + "_mem"], lir_function->variables[RISCV::Registers::to_string(reg)]));
+            }
+        }
+    }
 }
\ No newline at end of file
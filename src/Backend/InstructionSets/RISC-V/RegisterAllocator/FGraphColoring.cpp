@@ -4,46 +4,13 @@
 void RISCV::RegisterAllocator::FGraphColoring::allocate() {
     available_colors.insert(available_colors.end(), RISCV::Registers::Floats::registers.begin(), RISCV::Registers::Floats::registers.end());
     create_registers();
-    build_interference_graph();
-    const size_t K = available_colors.size();
-    std::stack<std::string> simplify_stack;
-    while (true) {
-        simplify_phase(simplify_stack, K);
-        if (coalesce_phase(K)) continue;
-        else if (freeze_phase(K)) continue;
-        else if (spill_phase(simplify_stack, K)) continue;
-        else if (assign_colors<Backend::LIR::StoreFloat, Backend::LIR::LoadFloat>(simplify_stack)) break;
-    }
+    color_graph<Backend::LIR::StoreFloat, Backend::LIR::LoadFloat>();
     __allocate__();
     log_info("Allocated float registers for %s", lir_function->name.c_str());
 }
 
 void RISCV::RegisterAllocator::FGraphColoring::create_registers() {
-    RISCV::ReWrite::create_entry_block(lir_function);
-    std::shared_ptr<Backend::LIR::Block> block_entry = lir_function->blocks.front();
-    for (const RISCV::Registers::ABI reg : RISCV::Registers::Floats::registers)
-        lir_function->add_variable(std::make_shared<Backend::Variable>(RISCV::Registers::to_string(reg), Backend::VariableType::DOUBLE, Backend::VariableWide::LOCAL));
-    RISCV::ReWrite::rewrite_parameters_f(lir_function, stack);
-    // at the very beginning of the function, copy callee-saved registers
-    for (const RISCV::Registers::ABI reg : RISCV::Registers::Floats::callee_saved) {
-        std::shared_ptr<Backend::Variable> var = std::make_shared<Backend::Variable>(RISCV::Registers::to_string(reg) + "_mem", Backend::VariableType::DOUBLE, Backend::VariableWide::LOCAL);
-        lir_function->add_variable(var);
-        block_entry->instructions.insert(block_entry->instructions.begin(), std::make_shared<Backend::LIR::Move>(lir_function->variables[RISCV::Registers::to_string(reg)], var));
-    }
-    for (const std::shared_ptr<Backend::LIR::Block> &block : lir_function->blocks) {
-        for (size_t i = 0; i < block->instructions.size(); i++) {
-            std::shared_ptr<Backend::LIR::Instruction> instruction = block->instructions[i];
-            if (instruction->type == Backend::LIR::InstructionType::RETURN) {
-                // move return value to fa0
-                std::shared_ptr<Backend::LIR::Return> ret = std::static_pointer_cast<Backend::LIR::Return>(instruction);
-                if (ret->return_value && Backend::Utils::is_float(ret->return_value->workload_type))
-                    block->instructions.insert(block->instructions.begin() + i++, std::make_shared<Backend::LIR::Move>(ret->return_value, lir_function->variables[RISCV::Registers::to_string(RISCV::Registers::ABI::FA0)])),
-                    ret->return_value = lir_function->variables[RISCV::Registers::to_string(RISCV::Registers::ABI::FA0)];
-                for (const RISCV::Registers::ABI reg : RISCV::Registers::Floats::callee_saved)
-                    block->instructions.insert(block->instructions.begin() + i++, std::make_shared<Backend::LIR::Move>(lir_function->variables[RISCV::Registers::to_string(reg) + "_mem"], lir_function->variables[RISCV::Registers::to_string(reg)]));
-            }
-        }
-    }
+    RISCV::ReWrite::create_registers_f(lir_function, stack);
 }
 
 void RISCV::RegisterAllocator::FGraphColoring::build_interference_graph() {
@@ -0,0 +1,19 @@
+#include "Backend/InstructionSets/RISC-V/RegisterAllocator/FLinearScan.h"
+#include "Backend/InstructionSets/RISC-V/Modules.h"
+
+void RISCV::RegisterAllocator::FLinearScan::allocate() {
+    available_colors.insert(available_colors.end(), RISCV::Registers::Floats::registers.begin(), RISCV::Registers::Floats::registers.end());
+    create_registers();
+    scan_intervals<Backend::LIR::StoreFloat, Backend::LIR::LoadFloat>();
+    __allocate__();
+    log_info("Allocated float registers for %s", lir_function->name.c_str());
+}
+
+void RISCV::RegisterAllocator::FLinearScan::create_registers() {
+    RISCV::ReWrite::create_registers_f(lir_function, stack);
+}
+
+void RISCV::RegisterAllocator::FLinearScan::build_intervals() {
+    lir_function->analyze_live_variables<Backend::Utils::is_float>();
+    LinearScan::build_intervals<>(RISCV::Registers::Floats::registers, RISCV::Registers::Floats::caller_saved);
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Backend/InstructionSets/RISC-V/RegisterAllocator/GraphColoring.h"
 #include "Backend/InstructionSets/RISC-V/RegisterAllocator/FGraphColoring.h"
 #include "Backend/InstructionSets/RISC-V/Modules.h"
+#include "Utils/Trace.h"
 
 void RISCV::RegisterAllocator::GraphColoring::allocate() {
     float_allocator = std::make_shared<RISCV::RegisterAllocator::FGraphColoring>(lir_function, stack);
@@ -8,16 +9,7 @@ void RISCV::RegisterAllocator::GraphColoring::allocate() {
     var_to_reg.insert(float_allocator->var_to_reg.begin(), float_allocator->var_to_reg.end());
     available_colors.insert(available_colors.end(), RISCV::Registers::Integers::registers.begin(), RISCV::Registers::Integers::registers.end());
     create_registers();
-    build_interference_graph();
-    const size_t K = available_colors.size();
-    std::stack<std::string> simplify_stack;
-    while (true) {
-        simplify_phase(simplify_stack, K);
-        if (coalesce_phase(K)) continue;
-        else if (freeze_phase(K)) continue;
-        else if (spill_phase(simplify_stack, K)) continue;
-        else if (assign_colors<Backend::LIR::StoreInt, Backend::LIR::LoadInt>(simplify_stack)) break;
-    }
+    color_graph<Backend::LIR::StoreInt, Backend::LIR::LoadInt>();
     __allocate__();
     log_info("Allocated integer registers for %s", lir_function->name.c_str());
     stack->stack_size = stack->align(16);
@@ -25,64 +17,60 @@ void RISCV::RegisterAllocator::GraphColoring::allocate() {
 }
 
 void RISCV::RegisterAllocator::GraphColoring::__allocate__() {
-    for (const std::pair<std::string, std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode>> pair : interference_graph)
-        if (pair.second->is_colored && pair.second->color != RISCV::Registers::ABI::ZERO) {
-            var_to_reg[pair.first] = pair.second->color;
-            for (const std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> &coalesced: pair.second->coalesced)
-                var_to_reg[coalesced->variable->name] = pair.second->color;
-        }
-    interference_graph.clear();
+    for (size_t node = 0; node < nodes.size(); node++) {
+        const RISCV::Registers::ABI reg = color[get_alias(node)];
+        if (reg != RISCV::Registers::ABI::ZERO)
+            var_to_reg[nodes[node]->name] = reg;
+    }
+    nodes.clear();
+    node_id.clear();
+    adj_set.reset(0);
+    adj_list.clear();
+    degree.clear();
+    move_list.clear();
+    alias.clear();
+    color.clear();
+    state.clear();
     spill_costs.clear();
+    moves.clear();
 }
 
-/*
- * Create virtual registers for all integer registers.
- * First, we create a block entry which will not be included in any loops.
- * Second, we create variables for reigsters.
- * Third, we insert `load` & `store` instructions for function calls & parameters.
- * Last, we save all caller-saved registers.
- */
 void RISCV::RegisterAllocator::GraphColoring::create_registers() {
-    RISCV::ReWrite::create_entry_block(lir_function);
-    std::shared_ptr<Backend::LIR::Block> block_entry = lir_function->blocks.front();
-    for (const RISCV::Registers::ABI reg : RISCV::Registers::Integers::registers)
-        lir_function->add_variable(std::make_shared<Backend::Variable>(RISCV::Registers::to_string(reg), Backend::VariableType::INT64, Backend::VariableWide::LOCAL));
-    RISCV::ReWrite::rewrite_parameters_i(lir_function, stack);
-    // at the very beginning of the function, copy callee-saved registers
-    for (const RISCV::Registers::ABI reg : RISCV::Registers::Integers::callee_saved) {
-        std::shared_ptr<Backend::Variable> var = std::make_shared<Backend::Variable>(RISCV::Registers::to_string(reg) + "_mem", Backend::VariableType::INT64, Backend::VariableWide::LOCAL);
-        lir_function->add_variable(var);
-        block_entry->instructions.insert(block_entry->instructions.begin(), std::make_shared<Backend::LIR::Move>(lir_function->variables[RISCV::Registers::to_string(reg)], var));
-    }
-    for (const std::shared_ptr<Backend::LIR::Block> &block : lir_function->blocks) {
-        for (size_t i = 0; i < block->instructions.size(); i++) {
-            std::shared_ptr<Backend::LIR::Instruction> instruction = block->instructions[i];
-            if (instruction->type == Backend::LIR::InstructionType::RETURN) {
-                // move return value to a0
-                std::shared_ptr<Backend::LIR::Return> ret = std::static_pointer_cast<Backend::LIR::Return>(instruction);
-                if (ret->return_value && Backend::Utils::is_int(ret->return_value->workload_type))
-                    block->instructions.insert(block->instructions.begin() + i++, std::make_shared<Backend::LIR::Move>(ret->return_value, lir_function->variables[RISCV::Registers::to_string(RISCV::Registers::ABI::A0)])),
-                    ret->return_value = lir_function->variables[RISCV::Registers::to_string(RISCV::Registers::ABI::A0)];
-                for (const RISCV::Registers::ABI reg : RISCV::Registers::Integers::callee_saved)
-                    block->instructions.insert(block->instructions.begin() + i++, std::make_shared<Backend::LIR::Move>(lir_function->variables[RISCV::Registers::to_string(reg) + "_mem"], lir_function->variables[RISCV::Registers::to_string(reg)]));
-            }
-        }
-    }
+    RISCV::ReWrite::create_registers_i(lir_function, stack);
 }
 
+/*
+ * Physical registers get node ids `[0, precolored_count)` in the order of `registers`,
+ * the other variables stored in registers follow in the order of `Backend::LIR::Function::variable_list`.
+ */
 void RISCV::RegisterAllocator::GraphColoring::create_interference_nodes(const std::vector<RISCV::Registers::ABI> &registers) {
-    interference_graph.clear();
-    for (const auto& [var_name, var] : lir_function->variables)
-        if (var->lifetime == Backend::VariableWide::LOCAL && is_consistent(var->workload_type))
-            interference_graph[var_name] = std::make_shared<InterferenceNode>(var);
+    nodes.clear();
+    node_id.assign(lir_function->variable_count(), Backend::Variable::no_index);
     for (const RISCV::Registers::ABI reg : registers) {
-        interference_graph[RISCV::Registers::to_string(reg)]->is_colored = true;
-        interference_graph[RISCV::Registers::to_string(reg)]->color = reg;
+        const std::shared_ptr<Backend::Variable> var = lir_function->find_variable(RISCV::Registers::to_string(reg));
+        node_id[var->index] = nodes.size();
+        nodes.push_back(var);
     }
-    for (const RISCV::Registers::ABI reg1 : registers)
-        for (const RISCV::Registers::ABI reg2 : registers)
-            if (reg1 != reg2)
-                interference_graph[RISCV::Registers::to_string(reg1)]->non_move_related_neighbors.insert(interference_graph[RISCV::Registers::to_string(reg2)]);
+    precolored_count = nodes.size();
+    for (const std::shared_ptr<Backend::Variable> &var : lir_function->variable_list)
+        if (var && var->lifetime == Backend::VariableWide::LOCAL && is_consistent(var->workload_type) && node_id[var->index] == Backend::Variable::no_index) {
+            node_id[var->index] = nodes.size();
+            nodes.push_back(var);
+        }
+    const size_t n = nodes.size();
+    adj_set.reset(n);
+    adj_list.assign(n, {});
+    // physical registers can never be simplified or spilled
+    degree.assign(n, 0);
+    std::fill(degree.begin(), degree.begin() + precolored_count, std::numeric_limits<size_t>::max() / 2);
+    move_list.assign(n, {});
+    alias.resize(n);
+    std::iota(alias.begin(), alias.end(), 0);
+    color.assign(n, RISCV::Registers::ABI::ZERO);
+    std::copy(registers.begin(), registers.end(), color.begin());
+    state.assign(n, NodeState::INITIAL);
+    std::fill(state.begin(), state.begin() + precolored_count, NodeState::PRECOLORED);
+    moves.clear();
 }
 
 void RISCV::RegisterAllocator::GraphColoring::build_interference_graph() {
@@ -94,41 +82,50 @@ void RISCV::RegisterAllocator::GraphColoring::build_interference_graph() {
 
 template <size_t N>
 void RISCV::RegisterAllocator::GraphColoring::build_interference_graph(const std::array<RISCV::Registers::ABI, N> &caller_saved) {
+    std::vector<size_t> caller_saved_nodes;
+    for (const RISCV::Registers::ABI reg : caller_saved)
+        caller_saved_nodes.push_back(node_of(*lir_function->find_variable(RISCV::Registers::to_string(reg))));
+    // Variables spilled to the stack are still live, but have no node.
+    const auto for_each_live_node = [this](const Backend::BitSet &live, auto &&func) {
+        live.for_each([&](const size_t index) {
+            if (index < node_id.size() && node_id[index] != Backend::Variable::no_index)
+                func(node_id[index]);
+        });
+    };
     for (const std::shared_ptr<Backend::LIR::Block> &block : lir_function->blocks) {
-        std::unordered_set<std::string> live = block->live_out;
+        Backend::BitSet live = block->live_out;
         // Reverse traversal!!!
         for (std::vector<std::shared_ptr<Backend::LIR::Instruction>>::reverse_iterator instr_iter = block->instructions.rbegin(); instr_iter != block->instructions.rend(); ++instr_iter) {
             const std::shared_ptr<Backend::LIR::Instruction> &instr = *instr_iter;
             std::shared_ptr<Backend::Variable> def_var = instr->get_defined_variable(is_consistent);
             std::vector<std::shared_ptr<Backend::Variable>> used_vars = instr->get_used_variables(is_consistent);
-            bool is_move_instruction = (instr->type == Backend::LIR::InstructionType::MOVE || instr->type == Backend::LIR::InstructionType::FMOVE);
-            if (def_var) {
-                live.erase(def_var->name);
-                for (const std::string &live_var : live) {
-                    interference_graph[def_var->name]->non_move_related_neighbors.insert(interference_graph[live_var]);
-                    interference_graph[live_var]->non_move_related_neighbors.insert(interference_graph[def_var->name]);
-                }
-                if (is_move_instruction) {
-                    for (const std::shared_ptr<Backend::Variable> &used_var : used_vars) {
-                        interference_graph[def_var->name]->move_related_neighbors.insert(interference_graph[used_var->name]);
-                        interference_graph[used_var->name]->move_related_neighbors.insert(interference_graph[def_var->name]);
+            const size_t def_node = def_var ? node_of(*def_var) : Backend::Variable::no_index;
+            if ((instr->type == Backend::LIR::InstructionType::MOVE || instr->type == Backend::LIR::InstructionType::FMOVE) && def_node != Backend::Variable::no_index) {
+                for (const std::shared_ptr<Backend::Variable> &used_var : used_vars)
+                    if (const size_t used_node = node_of(*used_var); used_node != Backend::Variable::no_index) {
+                        // source and destination hold the same value, they do not interfere because of this move
+                        live.reset(lir_function->index_of(*used_var));
+                        move_list[def_node].push_back(moves.size());
+                        move_list[used_node].push_back(moves.size());
+                        moves.push_back({def_node, used_node});
                     }
-                }
+            }
+            if (def_var) {
+                live.reset(lir_function->index_of(*def_var));
+                if (def_node != Backend::Variable::no_index)
+                    for_each_live_node(live, [&](const size_t live_node) { add_edge(def_node, live_node); });
             }
             // if the instruction is a function call, all live variables conflict with caller-saved registers
             if (instr->type == Backend::LIR::InstructionType::CALL)
-                for (const RISCV::Registers::ABI reg : caller_saved)
-                    for (const std::string &live_var : live) {
-                        interference_graph[RISCV::Registers::to_string(reg)]->non_move_related_neighbors.insert(interference_graph[live_var]);
-                        interference_graph[live_var]->non_move_related_neighbors.insert(interference_graph[RISCV::Registers::to_string(reg)]);
-                    }
+                for_each_live_node(live, [&](const size_t live_node) {
+                    for (const size_t reg_node : caller_saved_nodes)
+                        add_edge(reg_node, live_node);
+                });
             for (const std::shared_ptr<Backend::Variable> &used_var : used_vars)
-                live.insert(used_var->name);
+                if (const size_t index = lir_function->index_of(*used_var); index != Backend::Variable::no_index)
+                    live.set(index);
         }
     }
-    for (const auto& [var_name, node] : interference_graph)
-        for (const std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> &neighbor : node->non_move_related_neighbors)
-            node->move_related_neighbors.erase(neighbor);
     calculate_spill_costs();
     // print_interference_graph();
 }
@@ -138,51 +135,52 @@ template void RISCV::RegisterAllocator::GraphColoring::build_interference_graph<
 void RISCV::RegisterAllocator::GraphColoring::print_interference_graph() {
     std::ostringstream oss;
     oss << "\n";
-    for (const auto& [var_name, node] : interference_graph) {
-        oss << "Node: " << var_name << "\n";
+    for (size_t node = precolored_count; node < nodes.size(); node++) {
+        oss << "Node: " << nodes[node]->name << "\n";
         oss << "  Move-related neighbors:";
-        for (const std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> &neighbor : node->move_related_neighbors)
-            oss << " " << neighbor->variable->name;
+        for (const size_t move : move_list[node])
+            oss << " " << nodes[moves[move].dst == node ? moves[move].src : moves[move].dst]->name;
         oss << "\n";
         oss << "  Non-move-related neighbors:";
-        for (const std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> &neighbor : node->non_move_related_neighbors)
-            oss << " " << neighbor->variable->name;
+        for (const size_t neighbor : adj_list[node])
+            oss << " " << nodes[neighbor]->name;
         oss << "\n";
     }
     std::cout << oss.str();
 }
 
 void RISCV::RegisterAllocator::GraphColoring::calculate_spill_costs() {
-    spill_costs.clear();
-    for (const auto& [var_name, var] : lir_function->variables)
-        if (var->lifetime == Backend::VariableWide::LOCAL && is_consistent(var->workload_type))
-            spill_costs[var_name] = SpillCost{};
+    spill_costs.assign(nodes.size(), SpillCost{});
+    constexpr size_t unused = std::numeric_limits<size_t>::max();
+    std::vector<size_t> first_use(nodes.size(), unused);
+    std::vector<size_t> last_use(nodes.size(), unused);
+    const auto touch = [&](const size_t node, const size_t instr_idx) {
+        if (first_use[node] == unused)
+            first_use[node] = instr_idx;
+        last_use[node] = instr_idx;
+    };
     size_t instr_idx = 0;
-    std::unordered_map<std::string, size_t> first_use;
-    std::unordered_map<std::string, size_t> last_use;
     for (const std::shared_ptr<Backend::LIR::Block> &block : lir_function->blocks) {
         for (const std::shared_ptr<Backend::LIR::Instruction> &instr : block->instructions) {
             std::shared_ptr<Backend::Variable> def_var = instr->get_defined_variable(is_consistent);
-            if (def_var && spill_costs.find(def_var->name) != spill_costs.end()) {
-                spill_costs[def_var->name].def_count++;
-                if (first_use.find(def_var->name) == first_use.end())
-                    first_use[def_var->name] = instr_idx;
-                last_use[def_var->name] = instr_idx;
-            }
+            if (def_var)
+                if (const size_t node = node_of(*def_var); node != Backend::Variable::no_index) {
+                    spill_costs[node].def_count++;
+                    touch(node, instr_idx);
+                }
             std::vector<std::shared_ptr<Backend::Variable>> used_vars = instr->get_used_variables(is_consistent);
             for (const std::shared_ptr<Backend::Variable> &used_var : used_vars)
-                if (spill_costs.find(used_var->name) != spill_costs.end()) {
-                    spill_costs[used_var->name].use_count++;
-                    if (first_use.find(used_var->name) == first_use.end())
-                        first_use[used_var->name] = instr_idx;
-                    last_use[used_var->name] = instr_idx;
+                if (const size_t node = node_of(*used_var); node != Backend::Variable::no_index) {
+                    spill_costs[node].use_count++;
+                    touch(node, instr_idx);
                 }
             instr_idx++;
         }
     }
-    for (auto& [var_name, cost] : spill_costs) {
-        if (first_use.find(var_name) != first_use.end() && last_use.find(var_name) != last_use.end())
-            cost.live_range = last_use[var_name] - first_use[var_name] + 1;
+    for (size_t node = 0; node < spill_costs.size(); node++) {
+        SpillCost &cost = spill_costs[node];
+        if (first_use[node] != unused)
+            cost.live_range = last_use[node] - first_use[node] + 1;
         cost.loop_depth = 1; // TODO: Implement loop depth analysis
         cost.cost = calculate_spill_cost(cost);
     }
@@ -196,154 +194,294 @@ double RISCV::RegisterAllocator::GraphColoring::calculate_spill_cost(const RISCV
     return (access_count * loop_factor) / range_factor;
 }
 
-void RISCV::RegisterAllocator::GraphColoring::simplify_phase(std::stack<std::string>& simplify_stack, const size_t K) {
-    std::set<std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode>> workload;
-    for (const std::pair<std::string, std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode>> pair : interference_graph)
-        if (!pair.second->is_spilled && !pair.second->is_colored)
-            workload.insert(pair.second);
-    bool changed = true;
-    while (changed) {
-        changed = false;
-        for (std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> node : workload) {
-            if (node->degree() < K && node->move_related_neighbors.empty()) {
-                // log_debug("Simplify variable %s", node->variable->name.c_str());
-                simplify_stack.push(node->variable->name);
-                for (std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> neighbor : node->non_move_related_neighbors)
-                    neighbor->non_move_related_neighbors.erase(node);
-                node->is_spilled = true;
-                workload.erase(node);
-                changed = true;
-                break;
-            }
+void RISCV::RegisterAllocator::GraphColoring::add_edge(const size_t u, const size_t v) {
+    if (u == v || adj_set.test(u, v)) return;
+    adj_set.set(u, v);
+    // physical registers do not keep adjacency lists, their degree is infinite anyway
+    if (!is_precolored(u)) {
+        adj_list[u].push_back(v);
+        degree[u]++;
+    }
+    if (!is_precolored(v)) {
+        adj_list[v].push_back(u);
+        degree[v]++;
+    }
+}
+
+// Neighbours still in the graph, i.e. neither on the select stack nor coalesced.
+template<typename Func>
+void RISCV::RegisterAllocator::GraphColoring::for_each_adjacent(const size_t node, Func &&func) const {
+    for (const size_t neighbor : adj_list[node])
+        if (state[neighbor] != NodeState::SELECTED && state[neighbor] != NodeState::COALESCED)
+            func(neighbor);
+}
+
+// Moves of the node that may still be coalesced.
+template<typename Func>
+void RISCV::RegisterAllocator::GraphColoring::for_each_node_move(const size_t node, Func &&func) const {
+    for (const size_t move : move_list[node])
+        if (moves[move].state == MoveState::ACTIVE || moves[move].state == MoveState::WORKLIST)
+            func(move);
+}
+
+bool RISCV::RegisterAllocator::GraphColoring::move_related(const size_t node) const {
+    return std::any_of(move_list[node].begin(), move_list[node].end(), [this](const size_t move) {
+        return moves[move].state == MoveState::ACTIVE || moves[move].state == MoveState::WORKLIST;
+    });
+}
+
+size_t RISCV::RegisterAllocator::GraphColoring::get_alias(size_t node) const {
+    while (state[node] == NodeState::COALESCED)
+        node = alias[node];
+    return node;
+}
+
+void RISCV::RegisterAllocator::GraphColoring::enable_moves(const size_t node) {
+    for_each_node_move(node, [this](const size_t move) {
+        if (moves[move].state == MoveState::ACTIVE) {
+            moves[move].state = MoveState::WORKLIST;
+            worklist_moves.push_back(move);
         }
+    });
+}
+
+void RISCV::RegisterAllocator::GraphColoring::decrement_degree(const size_t node) {
+    const size_t K = available_colors.size();
+    if (degree[node]-- != K || is_precolored(node)) return;
+    enable_moves(node);
+    for_each_adjacent(node, [this](const size_t neighbor) { enable_moves(neighbor); });
+    if (move_related(node)) {
+        state[node] = NodeState::FREEZE;
+        freeze_worklist.push_back(node);
+    } else {
+        state[node] = NodeState::SIMPLIFY;
+        simplify_worklist.push_back(node);
     }
 }
 
-bool RISCV::RegisterAllocator::GraphColoring::coalesce_phase(const size_t K) {
-    for (const auto& [var_name, node] : interference_graph) {
-        if (!node->is_spilled) {
-            for (const auto& move_neighbor : node->move_related_neighbors) {
-                std::string neighbor_name = move_neighbor->variable->name;
-                if (can_coalesce_briggs(var_name, neighbor_name, K)) {
-                    coalesce_nodes(var_name, neighbor_name);
-                    return true;
-                }
-            }
+void RISCV::RegisterAllocator::GraphColoring::add_worklist(const size_t node) {
+    if (state[node] == NodeState::FREEZE && !move_related(node) && degree[node] < available_colors.size()) {
+        state[node] = NodeState::SIMPLIFY;
+        simplify_worklist.push_back(node);
+    }
+}
+
+// George: merging `v` into the physical register `u` is safe if every neighbour of `v`
+// is insignificant or already interferes with `u`.
+bool RISCV::RegisterAllocator::GraphColoring::george_test(const size_t u, const size_t v) const {
+    const size_t K = available_colors.size();
+    return std::all_of(adj_list[v].begin(), adj_list[v].end(), [&](const size_t t) {
+        return state[t] == NodeState::SELECTED || state[t] == NodeState::COALESCED ||
+               degree[t] < K || is_precolored(t) || adj_set.test(t, u);
+    });
+}
+
+// Briggs: the merged node has fewer than K significant neighbours.
+bool RISCV::RegisterAllocator::GraphColoring::briggs_test(const size_t u, const size_t v) const {
+    const size_t K = available_colors.size();
+    size_t significant = 0;
+    for_each_adjacent(u, [&](const size_t t) {
+        if (degree[t] >= K) significant++;
+    });
+    for_each_adjacent(v, [&](const size_t t) {
+        if (degree[t] >= K && !adj_set.test(t, u)) significant++;
+    });
+    return significant < K;
+}
+
+void RISCV::RegisterAllocator::GraphColoring::combine(const size_t u, const size_t v) {
+    state[v] = NodeState::COALESCED;
+    alias[v] = u;
+    move_list[u].insert(move_list[u].end(), move_list[v].begin(), move_list[v].end());
+    enable_moves(v);
+    for_each_adjacent(v, [this, u](const size_t t) {
+        add_edge(t, u);
+        decrement_degree(t);
+    });
+    if (degree[u] >= available_colors.size() && state[u] == NodeState::FREEZE) {
+        state[u] = NodeState::SPILL;
+        spill_worklist.push_back(u);
+    }
+}
+
+void RISCV::RegisterAllocator::GraphColoring::freeze_moves(const size_t node) {
+    for_each_node_move(node, [this, node](const size_t move) {
+        const size_t x = get_alias(moves[move].dst), y = get_alias(moves[move].src);
+        const size_t other = y == get_alias(node) ? x : y;
+        moves[move].state = MoveState::FROZEN;
+        if (state[other] == NodeState::FREEZE && !move_related(other) && degree[other] < available_colors.size()) {
+            state[other] = NodeState::SIMPLIFY;
+            simplify_worklist.push_back(other);
+        }
+    });
+}
+
+void RISCV::RegisterAllocator::GraphColoring::make_worklists() {
+    const size_t K = available_colors.size();
+    simplify_worklist.clear();
+    freeze_worklist.clear();
+    spill_worklist.clear();
+    worklist_moves.clear();
+    select_stack.clear();
+    for (size_t move = 0; move < moves.size(); move++)
+        worklist_moves.push_back(move);
+    for (size_t node = precolored_count; node < nodes.size(); node++) {
+        if (degree[node] >= K) {
+            state[node] = NodeState::SPILL;
+            spill_worklist.push_back(node);
+        } else if (move_related(node)) {
+            state[node] = NodeState::FREEZE;
+            freeze_worklist.push_back(node);
+        } else {
+            state[node] = NodeState::SIMPLIFY;
+            simplify_worklist.push_back(node);
         }
     }
+}
+
+bool RISCV::RegisterAllocator::GraphColoring::simplify_phase() {
+    while (!simplify_worklist.empty()) {
+        const size_t node = simplify_worklist.back();
+        simplify_worklist.pop_back();
+        if (state[node] != NodeState::SIMPLIFY) continue;
+        state[node] = NodeState::SELECTED;
+        select_stack.push_back(node);
+        for_each_adjacent(node, [this](const size_t neighbor) { decrement_degree(neighbor); });
+        return true;
+    }
     return false;
 }
 
-bool RISCV::RegisterAllocator::GraphColoring::freeze_phase(const size_t K) {
-    for (const auto& [var_name, node] : interference_graph)
-        if (!node->is_spilled && !node->is_colored && node->degree() < K && !node->move_related_neighbors.empty()) {
-            for (std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> neighbor: node->move_related_neighbors)
-                neighbor->move_related_neighbors.erase(node);
-            node->move_related_neighbors.clear();
-            // log_debug("Freeze %s", node->variable->name.c_str());
-            return true;
+bool RISCV::RegisterAllocator::GraphColoring::coalesce_phase() {
+    while (!worklist_moves.empty()) {
+        const size_t move = worklist_moves.back();
+        worklist_moves.pop_back();
+        if (moves[move].state != MoveState::WORKLIST) continue;
+        size_t u = get_alias(moves[move].dst), v = get_alias(moves[move].src);
+        if (is_precolored(v)) std::swap(u, v);
+        if (u == v) {
+            moves[move].state = MoveState::COALESCED;
+            add_worklist(u);
+        } else if (is_precolored(v) || adj_set.test(u, v)) {
+            moves[move].state = MoveState::CONSTRAINED;
+            add_worklist(u);
+            add_worklist(v);
+        } else if (is_precolored(u) ? george_test(u, v) : briggs_test(u, v)) {
+            moves[move].state = MoveState::COALESCED;
+            combine(u, v);
+            add_worklist(u);
+            // log_debug("Coalesced %s and %s", nodes[u]->name.c_str(), nodes[v]->name.c_str());
+        } else {
+            moves[move].state = MoveState::ACTIVE;
         }
+        return true;
+    }
     return false;
 }
 
-bool RISCV::RegisterAllocator::GraphColoring::spill_phase(std::stack<std::string>& simplify_stack, const size_t K) {
-    std::string best_candidate = select_spill_candidate();
-    if (!best_candidate.empty()) {
-        simplify_stack.push(best_candidate);
-        std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode>  node = interference_graph[best_candidate];
-        node->is_spilled = true;
-        for (std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> neighbor: node->move_related_neighbors)
-            neighbor->move_related_neighbors.erase(node);
-        for (std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> neighbor: node->non_move_related_neighbors)
-            neighbor->non_move_related_neighbors.erase(node);
-        // log_debug("Select %s as spill candidate.", best_candidate.c_str());
+bool RISCV::RegisterAllocator::GraphColoring::freeze_phase() {
+    while (!freeze_worklist.empty()) {
+        const size_t node = freeze_worklist.back();
+        freeze_worklist.pop_back();
+        if (state[node] != NodeState::FREEZE) continue;
+        state[node] = NodeState::SIMPLIFY;
+        simplify_worklist.push_back(node);
+        freeze_moves(node);
+        // log_debug("Freeze %s", nodes[node]->name.c_str());
         return true;
     }
     return false;
 }
 
-std::string RISCV::RegisterAllocator::GraphColoring::select_spill_candidate() {
-    std::string best_candidate;
+bool RISCV::RegisterAllocator::GraphColoring::spill_phase() {
+    // drop stale entries while looking for the cheapest candidate
+    size_t best = 0, kept = 0;
     double min_cost = std::numeric_limits<double>::max();
-    for (const auto& [var_name, node] : interference_graph) {
-        if (!node->is_spilled && !node->is_colored) {
-            double cost = spill_costs[var_name].cost;
-            if (cost < min_cost) {
-                min_cost = cost;
-                best_candidate = var_name;
-            }
+    for (const size_t node : spill_worklist) {
+        if (state[node] != NodeState::SPILL) continue;
+        if (spill_costs[node].cost < min_cost) {
+            min_cost = spill_costs[node].cost;
+            best = kept;
         }
+        spill_worklist[kept++] = node;
     }
-    return best_candidate;
+    spill_worklist.resize(kept);
+    if (spill_worklist.empty()) return false;
+    const size_t node = spill_worklist[best];
+    spill_worklist[best] = spill_worklist.back();
+    spill_worklist.pop_back();
+    state[node] = NodeState::SIMPLIFY;
+    simplify_worklist.push_back(node);
+    freeze_moves(node);
+    // log_debug("Select %s as spill candidate.", nodes[node]->name.c_str());
+    return true;
 }
 
+/*
+ * Every round builds the graph, runs the worklists and assigns colors, spilled nodes are rewritten before the next round.
+ * Each round is a trace span, the simplify/coalesce/freeze/spill steps interleave node by node,
+ * so they share one span that counts the steps of each kind.
+ */
 template<typename StoreInst, typename LoadInst>
-bool RISCV::RegisterAllocator::GraphColoring::assign_colors(std::stack<std::string> &stack) {
-    for (const RISCV::Registers::ABI reg: available_colors) {
-        std::set<std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode>> &colored_ = interference_graph[RISCV::Registers::to_string(reg)]->coalesced;
-        for (std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> node : colored_) {
-            node->is_colored = true;
-            node->color = reg;
+void RISCV::RegisterAllocator::GraphColoring::color_graph() {
+    const std::string kind = is_consistent == Backend::Utils::is_float ? "float" : "int";
+    for (size_t round = 1;; round++) {
+        const ::Utils::TraceSpan round_span("regalloc", kind + " round " + std::to_string(round));
+        {
+            const ::Utils::TraceSpan span("regalloc", "build");
+            build_interference_graph();
         }
-    }
-    while (!stack.empty()) {
-        std::string var_name = stack.top();
-        stack.pop();
-        std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> &node = interference_graph[var_name];
-        std::unordered_set<RISCV::Registers::ABI> used_colors;
-        std::for_each(node->non_move_related_neighbors.begin(), node->non_move_related_neighbors.end(),
-            [&](const std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> &neighbor) {
-                if (neighbor->is_colored)
-                    used_colors.insert(neighbor->color);
+        {
+            ::Utils::TraceSpan span("regalloc", "simplify/coalesce/freeze/spill");
+            long long simplified = 0, coalesced = 0, frozen = 0, spill_candidates = 0;
+            make_worklists();
+            while (true) {
+                if (simplify_phase()) simplified++;
+                else if (coalesce_phase()) coalesced++;
+                else if (freeze_phase()) frozen++;
+                else if (spill_phase()) spill_candidates++;
+                else break;
             }
-        );
+            span.add_arg("simplify", simplified);
+            span.add_arg("coalesce", coalesced);
+            span.add_arg("freeze", frozen);
+            span.add_arg("spill", spill_candidates);
+        }
+        const ::Utils::TraceSpan span("regalloc", "select");
+        if (assign_colors<StoreInst, LoadInst>()) break;
+    }
+}
+
+template void RISCV::RegisterAllocator::GraphColoring::color_graph<Backend::LIR::StoreFloat, Backend::LIR::LoadFloat>();
+
+template<typename StoreInst, typename LoadInst>
+bool RISCV::RegisterAllocator::GraphColoring::assign_colors() {
+    std::vector<size_t> spilled_nodes;
+    while (!select_stack.empty()) {
+        const size_t node = select_stack.back();
+        select_stack.pop_back();
+        uint64_t used_colors = 0;
+        for (const size_t neighbor : adj_list[node])
+            if (const size_t target = get_alias(neighbor); state[target] == NodeState::COLORED || state[target] == NodeState::PRECOLORED)
+                used_colors |= uint64_t{1} << static_cast<uint32_t>(color[target]);
         std::vector<RISCV::Registers::ABI>::iterator color_iter = std::find_if(available_colors.begin(), available_colors.end(),
-            [&used_colors](RISCV::Registers::ABI reg) {
-                return used_colors.find(reg) == used_colors.end();
+            [used_colors](RISCV::Registers::ABI reg) {
+                return !(used_colors >> static_cast<uint32_t>(reg) & 1);
             }
         );
         if (color_iter != available_colors.end()) {
-            node->color = *color_iter;
-            node->is_colored = true;
-            for (std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> coalesced : node->coalesced) {
-                coalesced->is_colored = true;
-                coalesced->color = *color_iter;
-            }
+            state[node] = NodeState::COLORED;
+            color[node] = *color_iter;
         } else {
-            log_debug("Marked %s for actual spilling", var_name.c_str());
-            lir_function->spill<StoreInst, LoadInst>(node->variable);
-            this->stack->add_variable(node->variable);
-            build_interference_graph();
-            while (!stack.empty()) stack.pop();
-            return false;
+            state[node] = NodeState::SPILLED;
+            spilled_nodes.push_back(node);
         }
     }
-    return true;
-}
-
-template bool RISCV::RegisterAllocator::GraphColoring::assign_colors<Backend::LIR::StoreFloat, Backend::LIR::LoadFloat>(std::stack<std::string> &stack);
-
-bool RISCV::RegisterAllocator::GraphColoring::can_coalesce_briggs(const std::string& node1, const std::string& node2, const size_t K) {
-    std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> n1 = interference_graph[node1];
-    std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> n2 = interference_graph[node2];
-    std::set<std::shared_ptr<InterferenceNode>> combined_neighbors;
-    combined_neighbors.insert(n1->non_move_related_neighbors.begin(), n1->non_move_related_neighbors.end());
-    combined_neighbors.insert(n2->non_move_related_neighbors.begin(), n2->non_move_related_neighbors.end());
-    size_t high_degree_neighbors = 0;
-    for (const std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> &neighbor : combined_neighbors)
-        if (neighbor->non_move_related_neighbors.find(n1) != neighbor->non_move_related_neighbors.end() && neighbor->non_move_related_neighbors.find(n2) != neighbor->non_move_related_neighbors.end()) {
-            if (neighbor->degree() >= K + 1)
-                high_degree_neighbors++;
-        } else if (neighbor->degree() >= K)
-            high_degree_neighbors++;
-    return high_degree_neighbors < K;
-}
-
-void RISCV::RegisterAllocator::GraphColoring::coalesce_nodes(const std::string& node1, const std::string& node2) {
-    std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> n1 = interference_graph[node1];
-    std::shared_ptr<RISCV::RegisterAllocator::GraphColoring::InterferenceNode> n2 = interference_graph[node2];
-    if (n2->is_colored) std::swap(n1, n2);
-    *n1 += n2;
-    // log_debug("Coalesced %s and %s", n1->variable->name.c_str(), n2->variable->name.c_str());
-    interference_graph.erase(n2->variable->name);
-}
+    if (spilled_nodes.empty()) return true;
+    for (const size_t node : spilled_nodes) {
+        log_debug("Marked %s for actual spilling", nodes[node]->name.c_str());
+        lir_function->spill<StoreInst, LoadInst>(nodes[node]);
+        this->stack->add_variable(nodes[node]);
+    }
+    return false;
+}
\ No newline at end of file
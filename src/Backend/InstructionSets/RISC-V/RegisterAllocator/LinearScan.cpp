@@ -0,0 +1,333 @@
+#include "Backend/InstructionSets/RISC-V/RegisterAllocator/LinearScan.h"
+#include "Backend/InstructionSets/RISC-V/RegisterAllocator/FLinearScan.h"
+#include "Backend/InstructionSets/RISC-V/Modules.h"
+#include "Utils/Trace.h"
+
+void RISCV::RegisterAllocator::LinearScan::allocate() {
+    float_allocator = std::make_shared<RISCV::RegisterAllocator::FLinearScan>(lir_function, stack);
+    float_allocator->allocate();
+    var_to_reg.insert(float_allocator->var_to_reg.begin(), float_allocator->var_to_reg.end());
+    available_colors.insert(available_colors.end(), RISCV::Registers::Integers::registers.begin(), RISCV::Registers::Integers::registers.end());
+    create_registers();
+    scan_intervals<Backend::LIR::StoreInt, Backend::LIR::LoadInt>();
+    __allocate__();
+    log_info("Allocated integer registers for %s", lir_function->name.c_str());
+    stack->stack_size = stack->align(16);
+}
+
+void RISCV::RegisterAllocator::LinearScan::__allocate__() {
+    for (const Interval &interval : intervals)
+        if (interval.variable && interval.reg != RISCV::Registers::ABI::ZERO)
+            var_to_reg[interval.variable->name] = interval.reg;
+    intervals.clear();
+    fixed_intervals.clear();
+}
+
+void RISCV::RegisterAllocator::LinearScan::create_registers() {
+    RISCV::ReWrite::create_registers_i(lir_function, stack);
+}
+
+bool RISCV::RegisterAllocator::LinearScan::Interval::covers(const size_t position) const {
+    const std::vector<std::pair<size_t, size_t>>::const_iterator range = std::partition_point(ranges.begin(), ranges.end(),
+        [position](const std::pair<size_t, size_t> &r) { return r.second <= position; });
+    return range != ranges.end() && range->first <= position;
+}
+
+size_t RISCV::RegisterAllocator::LinearScan::Interval::next_intersection(const Interval &other) const {
+    if (ranges.empty() || other.ranges.empty())
+        return no_position;
+    // nothing before the start of either interval can intersect, skip those ranges
+    const size_t from = std::max(start(), other.start());
+    const auto after = [from](const std::pair<size_t, size_t> &r) { return r.second <= from; };
+    std::vector<std::pair<size_t, size_t>>::const_iterator i = std::partition_point(ranges.begin(), ranges.end(), after);
+    std::vector<std::pair<size_t, size_t>>::const_iterator j = std::partition_point(other.ranges.begin(), other.ranges.end(), after);
+    while (i != ranges.end() && j != other.ranges.end()) {
+        const size_t low = std::max(i->first, j->first);
+        if (low < std::min(i->second, j->second))
+            return low;
+        if (i->second <= j->second) ++i;
+        else ++j;
+    }
+    return no_position;
+}
+
+size_t RISCV::RegisterAllocator::LinearScan::Interval::next_reference(const size_t position) const {
+    const std::vector<size_t>::const_iterator reference = std::lower_bound(references.begin(), references.end(), position);
+    return reference != references.end() ? *reference : no_position;
+}
+
+void RISCV::RegisterAllocator::LinearScan::Interval::add_reference(const size_t position) {
+    // added backwards like the ranges, an instruction may read the same variable twice
+    if (references.empty() || references.back() != position)
+        references.push_back(position);
+}
+
+void RISCV::RegisterAllocator::LinearScan::Interval::truncate(const size_t position) {
+    while (!ranges.empty() && ranges.back().first >= position)
+        ranges.pop_back();
+    if (!ranges.empty())
+        ranges.back().second = std::min(ranges.back().second, position);
+    references.erase(std::lower_bound(references.begin(), references.end(), position), references.end());
+}
+
+void RISCV::RegisterAllocator::LinearScan::Interval::add_range(const size_t from, const size_t to) {
+    if (from >= to) return;
+    if (!ranges.empty() && ranges.back().first <= to) {
+        ranges.back().first = std::min(ranges.back().first, from);
+        ranges.back().second = std::max(ranges.back().second, to);
+    } else ranges.emplace_back(from, to);
+}
+
+void RISCV::RegisterAllocator::LinearScan::Interval::set_from(const size_t from) {
+    if (!ranges.empty() && ranges.back().first <= from)
+        ranges.back().first = from;
+    else // the definition is never used
+        ranges.emplace_back(from, from + 1);
+}
+
+void RISCV::RegisterAllocator::LinearScan::Interval::finish() {
+    std::reverse(ranges.begin(), ranges.end());
+    std::reverse(references.begin(), references.end());
+    if (fixed || ranges.empty()) {
+        weight = std::numeric_limits<double>::infinity();
+        return;
+    }
+    // an interval spanning only its definition and the next instruction cannot get any shorter by spilling
+    const size_t live_range = (end() - start()) / 2 + 1;
+    if (live_range <= 2) {
+        weight = std::numeric_limits<double>::infinity();
+        return;
+    }
+    // same estimation as the graph coloring allocator, without loop depth
+    weight = (use_count + def_count * 2.0) * 10.0 / static_cast<double>(live_range);
+}
+
+void RISCV::RegisterAllocator::LinearScan::build_intervals() {
+    RISCV::ReWrite::rewrite_large_offset(lir_function, stack);
+    lir_function->analyze_live_variables<Backend::Utils::is_int>();
+    build_intervals<>(RISCV::Registers::Integers::registers, RISCV::Registers::Integers::caller_saved);
+}
+
+template <size_t N>
+void RISCV::RegisterAllocator::LinearScan::build_intervals(const std::vector<RISCV::Registers::ABI> &registers, const std::array<RISCV::Registers::ABI, N> &caller_saved) {
+    intervals.assign(lir_function->variable_count(), Interval{});
+    fixed_intervals.clear();
+    for (const RISCV::Registers::ABI reg : registers) {
+        const std::shared_ptr<Backend::Variable> var = lir_function->find_variable(RISCV::Registers::to_string(reg));
+        Interval &interval = intervals[var->index];
+        interval.variable = var;
+        interval.reg = reg;
+        interval.fixed = true;
+        fixed_intervals.push_back(var->index);
+    }
+    for (const std::shared_ptr<Backend::Variable> &var : lir_function->variable_list)
+        if (var && var->lifetime == Backend::VariableWide::LOCAL && is_consistent(var->workload_type) && !intervals[var->index].variable)
+            intervals[var->index].variable = var;
+    std::vector<size_t> caller_saved_intervals;
+    for (const RISCV::Registers::ABI reg : caller_saved)
+        caller_saved_intervals.push_back(lir_function->find_variable(RISCV::Registers::to_string(reg))->index);
+    std::vector<size_t> block_from;
+    size_t position = 0;
+    for (const std::shared_ptr<Backend::LIR::Block> &block : lir_function->blocks) {
+        block_from.push_back(position);
+        position += 2 * block->instructions.size();
+    }
+    // Blocks and instructions are visited backwards, so every range is added in front of the previous ones.
+    for (size_t b = lir_function->blocks.size(); b-- > 0;) {
+        const std::shared_ptr<Backend::LIR::Block> &block = lir_function->blocks[b];
+        const size_t from = block_from[b], to = from + 2 * block->instructions.size();
+        block->live_out.for_each([&](const size_t index) {
+            if (index < intervals.size() && intervals[index].variable)
+                intervals[index].add_range(from, to);
+        });
+        for (size_t k = block->instructions.size(); k-- > 0;) {
+            const std::shared_ptr<Backend::LIR::Instruction> &instr = block->instructions[k];
+            const size_t use_position = from + 2 * k, def_position = use_position + 1;
+            std::shared_ptr<Backend::Variable> def_var = instr->get_defined_variable(is_consistent);
+            std::vector<std::shared_ptr<Backend::Variable>> used_vars = instr->get_used_variables(is_consistent);
+            const size_t def_interval = def_var ? interval_of(*def_var) : Backend::Variable::no_index;
+            if (def_interval != Backend::Variable::no_index) {
+                intervals[def_interval].set_from(def_position);
+                intervals[def_interval].def_count++;
+                intervals[def_interval].add_reference(def_position);
+                intervals[def_interval].last_definition = std::max(intervals[def_interval].last_definition, def_position);
+            }
+            // caller-saved registers are clobbered by the call, nothing living across it may use them
+            if (instr->type == Backend::LIR::InstructionType::CALL)
+                for (const size_t reg_interval : caller_saved_intervals)
+                    intervals[reg_interval].add_range(def_position, def_position + 1);
+            // a value written to a stack slot has to be in the register, reloading it there gains nothing
+            const bool to_stack = (instr->type == Backend::LIR::InstructionType::STORE || instr->type == Backend::LIR::InstructionType::FSTORE) && std::static_pointer_cast<Backend::LIR::StoreInt>(instr)->var_in_mem->lifetime == Backend::VariableWide::FUNCTIONAL;
+            for (const std::shared_ptr<Backend::Variable> &used_var : used_vars) {
+                const size_t used_interval = interval_of(*used_var);
+                if (used_interval == Backend::Variable::no_index) continue;
+                intervals[used_interval].add_range(from, def_position);
+                intervals[used_interval].use_count++;
+                if (!to_stack)
+                    intervals[used_interval].add_reference(use_position);
+                if ((instr->type == Backend::LIR::InstructionType::MOVE || instr->type == Backend::LIR::InstructionType::FMOVE) && def_interval != Backend::Variable::no_index) {
+                    if (intervals[def_interval].hint == Backend::Variable::no_index)
+                        intervals[def_interval].hint = used_interval;
+                    if (intervals[used_interval].hint == Backend::Variable::no_index)
+                        intervals[used_interval].hint = def_interval;
+                }
+            }
+        }
+    }
+    for (Interval &interval : intervals)
+        if (interval.variable)
+            interval.finish();
+}
+
+template void RISCV::RegisterAllocator::LinearScan::build_intervals<RISCV::Registers::Floats::caller_saved.size()>(const std::vector<RISCV::Registers::ABI> &, const std::array<RISCV::Registers::ABI, RISCV::Registers::Floats::caller_saved.size()> &);
+
+/*
+ * Walk the intervals by increasing start position.
+ * `active` intervals cover the current position, `inactive` ones are in a lifetime hole and may still be
+ * reused by an interval fitting into that hole.
+ * When no register is free for the whole interval, the one staying free the longest is taken up to the first use
+ * behind its blocking position, and the rest of the interval is split off.
+ * If the interval cannot be split there, the cheapest intervals blocking one register are evicted, or the current
+ * interval itself if it is cheaper. Intervals of infinite weight cannot get any shorter and are never spilled.
+ * Returns the intervals to spill, and adds the intervals to split to `splits`.
+ */
+std::vector<size_t> RISCV::RegisterAllocator::LinearScan::scan(std::vector<Split> &splits) {
+    const size_t K = available_colors.size();
+    std::array<size_t, 64> color_of{};
+    for (size_t c = 0; c < K; c++)
+        color_of[static_cast<uint32_t>(available_colors[c])] = c;
+    std::vector<size_t> unhandled;
+    for (size_t index = 0; index < intervals.size(); index++)
+        if (intervals[index].variable && !intervals[index].fixed && !intervals[index].ranges.empty())
+            unhandled.push_back(index);
+    std::stable_sort(unhandled.begin(), unhandled.end(), [this](const size_t a, const size_t b) {
+        return intervals[a].start() < intervals[b].start();
+    });
+    std::vector<size_t> active, inactive, spilled;
+    std::vector<size_t> free_until(K);
+    std::vector<double> block_cost(K);
+    for (const size_t current_index : unhandled) {
+        Interval &current = intervals[current_index];
+        const size_t position = current.start();
+        std::vector<size_t> still_active, still_inactive;
+        for (const size_t index : active)
+            if (intervals[index].end() > position)
+                (intervals[index].covers(position) ? still_active : still_inactive).push_back(index);
+        for (const size_t index : inactive)
+            if (intervals[index].end() > position)
+                (intervals[index].covers(position) ? still_active : still_inactive).push_back(index);
+        active = std::move(still_active);
+        inactive = std::move(still_inactive);
+
+        for (size_t c = 0; c < K; c++)
+            free_until[c] = intervals[fixed_intervals[c]].next_intersection(current);
+        for (const size_t index : active)
+            free_until[color_of[static_cast<uint32_t>(intervals[index].reg)]] = 0;
+        for (const size_t index : inactive) {
+            size_t &until = free_until[color_of[static_cast<uint32_t>(intervals[index].reg)]];
+            until = std::min(until, intervals[index].next_intersection(current));
+        }
+        size_t chosen = K;
+        if (current.hint != Backend::Variable::no_index && intervals[current.hint].reg != RISCV::Registers::ABI::ZERO) {
+            const size_t c = color_of[static_cast<uint32_t>(intervals[current.hint].reg)];
+            if (free_until[c] == no_position)
+                chosen = c;
+        }
+        for (size_t c = 0; c < K && chosen == K; c++)
+            if (free_until[c] == no_position)
+                chosen = c;
+        if (chosen == K && std::isfinite(current.weight)) {
+            const size_t longest = std::max_element(free_until.begin(), free_until.end()) - free_until.begin();
+            const size_t split = current.next_reference(free_until[longest]);
+            if (split != no_position && current.references.front() < free_until[longest] && current.last_definition < free_until[longest]) {
+                splits.push_back({current_index, split});
+                current.truncate(free_until[longest]);
+                chosen = longest;
+            }
+        }
+        if (chosen == K) {
+            // every register is blocked somewhere inside the interval
+            std::fill(block_cost.begin(), block_cost.end(), 0.0);
+            for (size_t c = 0; c < K; c++)
+                if (intervals[fixed_intervals[c]].next_intersection(current) != no_position)
+                    block_cost[c] = std::numeric_limits<double>::infinity();
+            for (const size_t index : active)
+                block_cost[color_of[static_cast<uint32_t>(intervals[index].reg)]] += intervals[index].weight;
+            for (const size_t index : inactive)
+                if (intervals[index].next_intersection(current) != no_position)
+                    block_cost[color_of[static_cast<uint32_t>(intervals[index].reg)]] += intervals[index].weight;
+            size_t cheapest = K;
+            for (size_t c = 0; c < K; c++)
+                if (std::isfinite(block_cost[c]) && (cheapest == K || block_cost[c] < block_cost[cheapest]))
+                    cheapest = c;
+            if (std::isfinite(current.weight) && (cheapest == K || block_cost[cheapest] >= current.weight)) {
+                spilled.push_back(current_index);
+                continue;
+            }
+            if (cheapest == K)
+                log_error("No register can be freed for %s", current.variable->name.c_str());
+            const RISCV::Registers::ABI reg = available_colors[cheapest];
+            const auto evict = [&](std::vector<size_t> &list) {
+                list.erase(std::remove_if(list.begin(), list.end(), [&](const size_t index) {
+                    if (intervals[index].reg != reg || intervals[index].next_intersection(current) == no_position)
+                        return false;
+                    intervals[index].reg = RISCV::Registers::ABI::ZERO;
+                    spilled.push_back(index);
+                    return true;
+                }), list.end());
+            };
+            evict(active);
+            evict(inactive);
+            chosen = cheapest;
+        }
+        current.reg = available_colors[chosen];
+        active.push_back(current_index);
+    }
+    return spilled;
+}
+
+template<typename StoreInst, typename LoadInst>
+void RISCV::RegisterAllocator::LinearScan::scan_intervals() {
+    const std::string kind = is_consistent == Backend::Utils::is_float ? "float" : "int";
+    for (size_t round = 1;; round++) {
+        if (round > max_rounds)
+            log_error("Register allocation of %s did not converge in %zu rounds", lir_function->name.c_str(), max_rounds);
+        const ::Utils::TraceSpan round_span("regalloc", kind + " round " + std::to_string(round));
+        {
+            const ::Utils::TraceSpan span("regalloc", "build");
+            build_intervals();
+        }
+        ::Utils::TraceSpan span("regalloc", "scan");
+        std::vector<Split> splits;
+        const std::vector<size_t> spilled = scan(splits);
+        span.add_arg("spilled", static_cast<long long>(spilled.size()));
+        span.add_arg("split", static_cast<long long>(splits.size()));
+        if (spilled.empty() && splits.empty()) break;
+        // split positions number the instructions as they are before this round's rewrites
+        std::vector<const Backend::LIR::Instruction *> instructions;
+        for (const std::shared_ptr<Backend::LIR::Block> &block : lir_function->blocks)
+            for (const std::shared_ptr<Backend::LIR::Instruction> &instr : block->instructions)
+                instructions.push_back(instr.get());
+        std::vector<bool> is_spilled(intervals.size(), false);
+        for (const size_t index : spilled)
+            is_spilled[index] = true;
+        for (const Split &split : splits) {
+            // evicted after it was split, the spill below covers it
+            if (is_spilled[split.interval]) continue;
+            const std::shared_ptr<Backend::Variable> &variable = intervals[split.interval].variable;
+            std::shared_ptr<Backend::Variable> slot = std::make_shared<Backend::Variable>(Backend::Utils::unique_name("slot_"), variable->workload_type, Backend::VariableWide::FUNCTIONAL);
+            log_debug("Split %s at %zu", variable->name.c_str(), split.position);
+            lir_function->add_variable(slot);
+            lir_function->split<StoreInst, LoadInst>(variable, slot, instructions[split.position / 2]);
+            this->stack->add_variable(slot);
+        }
+        for (const size_t index : spilled) {
+            std::shared_ptr<Backend::Variable> variable = intervals[index].variable;
+            log_debug("Marked %s for actual spilling", variable->name.c_str());
+            lir_function->spill<StoreInst, LoadInst>(variable);
+            this->stack->add_variable(variable);
+        }
+    }
+}
+
+template void RISCV::RegisterAllocator::LinearScan::scan_intervals<Backend::LIR::StoreFloat, Backend::LIR::LoadFloat>();
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Backend/InstructionSets/RISC-V/RegisterAllocator/RegisterAllocator.h"
 #include "Backend/InstructionSets/RISC-V/RegisterAllocator/GraphColoring.h"
+#include "Backend/InstructionSets/RISC-V/RegisterAllocator/LinearScan.h"
 #include "Backend/InstructionSets/RISC-V/Modules.h"
 
 RISCV::RegisterAllocator::Allocator::Allocator(const std::shared_ptr<Backend::LIR::Function> &function, const std::shared_ptr<RISCV::Stack> &stack) : stack(stack), lir_function(function) {
@@ -15,6 +16,8 @@ RISCV::RegisterAllocator::Allocator::Allocator(const std::shared_ptr<Backend::LI
 
 std::shared_ptr<RISCV::RegisterAllocator::Allocator> RISCV::RegisterAllocator::create(AllocationType type, const std::shared_ptr<Backend::LIR::Function> &function, std::shared_ptr<RISCV::Stack> &stack) {
     switch (type) {
+        case AllocationType::LINEAR_SCAN:
+            return std::make_shared<RISCV::RegisterAllocator::LinearScan>(function, stack);
         case AllocationType::GRAPH_COLORING:
             return std::make_shared<RISCV::RegisterAllocator::GraphColoring>(function, stack);
         default:
@@ -41,8 +41,8 @@ void Backend::LIR::Module::load_functional_variables(const std::shared_ptr<Mir::
                 std::shared_ptr<Mir::Alloc> alloc = std::static_pointer_cast<Mir::Alloc>(llvm_instruction);
                 std::shared_ptr<Mir::Type::Type> mir_type = alloc->get_type();
                 std::shared_ptr<Backend::Variable> var = std::make_shared<Backend::Variable>(alloc->get_name(), Backend::Utils::to_reference(Backend::Utils::llvm_to_riscv(*mir_type)), VariableWide::FUNCTIONAL);
-                if (mir_type->as<Mir::Type::Pointer>()->get_contain_type()->is_array())
-                    var->length = mir_type->as<Mir::Type::Pointer>()->get_contain_type()->as<Mir::Type::Array>()->get_flattened_size();
+                if (mir_type->as_ptr<Mir::Type::Pointer>()->get_contain_type()->is_array())
+                    var->length = mir_type->as_ptr<Mir::Type::Pointer>()->get_contain_type()->as_ptr<Mir::Type::Array>()->get_flattened_size();
                 lir_function->add_variable(var);
             }
     }
@@ -422,49 +422,121 @@ void Backend::LIR::Function::spill(std::shared_ptr<Backend::Variable> &local_var
 template void Backend::LIR::Function::spill<Backend::LIR::StoreInt, Backend::LIR::LoadInt>(std::shared_ptr<Backend::Variable> &local_variable);
 template void Backend::LIR::Function::spill<Backend::LIR::StoreFloat, Backend::LIR::LoadFloat>(std::shared_ptr<Backend::Variable> &local_variable);
 
-template<bool (*is_consistent)(const Backend::VariableType &type)>
-void Backend::LIR::Function::analyze_live_variables() {
-    bool changed = true;
+template <typename T_store, typename T_load>
+void Backend::LIR::Function::split(const std::shared_ptr<Backend::Variable> &local_variable, const std::shared_ptr<Backend::Variable> &slot, const Backend::LIR::Instruction *from) {
+    if (local_variable->lifetime != VariableWide::LOCAL || slot->lifetime != VariableWide::FUNCTIONAL)
+        log_error("Only variable in register can be split into a stack slot.");
+    // whether the current instruction lies behind the split
+    bool reload = false;
     for (std::shared_ptr<Backend::LIR::Block> &block : blocks) {
-        block->live_in.clear();
-        block->live_out.clear();
-    }
-    while(changed) {
-        std::unordered_set<std::string> visited;
-        std::shared_ptr<Backend::LIR::Block> first_block = blocks.front();
-        changed = analyze_live_variables<is_consistent>(first_block, visited);
+        for (size_t i = 0; i < block->instructions.size(); i++) {
+            const std::shared_ptr<Backend::LIR::Instruction> instr = block->instructions[i];
+            if (instr.get() == from)
+                reload = true;
+            std::vector<std::shared_ptr<Backend::Variable>> used = instr->get_used_variables();
+            if (reload && std::find(used.begin(), used.end(), local_variable) != used.end()) {
+                // insert `load` before the instruction
+                std::shared_ptr<Backend::Variable> new_var = std::make_shared<Backend::Variable>(Backend::Utils::unique_name("spill_"), local_variable->workload_type, VariableWide::LOCAL);
+                add_variable(new_var);
+                log_debug("Reloading split `%s` to `%s` in `%s`", local_variable->name.c_str(), new_var->name.c_str(), instr->to_string().c_str());
+                instr->update_used_variable(local_variable, new_var);
+                block->instructions.insert(block->instructions.begin() + i, std::make_shared<T_load>(slot, new_var));
+                i++;
+            }
+            if (instr->get_defined_variable() && *instr->get_defined_variable() == *local_variable) {
+                // insert `store` after the instruction
+                block->instructions.insert(block->instructions.begin() + i + 1, std::make_shared<T_store>(slot, local_variable));
+                i++;
+            }
+        }
     }
-    // std::cout << live_variables();
 }
 
-template void Backend::LIR::Function::analyze_live_variables<Backend::Utils::is_int>();
-template void Backend::LIR::Function::analyze_live_variables<Backend::Utils::is_float>();
+template void Backend::LIR::Function::split<Backend::LIR::StoreInt, Backend::LIR::LoadInt>(const std::shared_ptr<Backend::Variable> &, const std::shared_ptr<Backend::Variable> &, const Backend::LIR::Instruction *);
+template void Backend::LIR::Function::split<Backend::LIR::StoreFloat, Backend::LIR::LoadFloat>(const std::shared_ptr<Backend::Variable> &, const std::shared_ptr<Backend::Variable> &, const Backend::LIR::Instruction *);
+
+std::vector<std::shared_ptr<Backend::LIR::Block>> Backend::LIR::Function::reverse_post_order() const {
+    std::vector<std::shared_ptr<Backend::LIR::Block>> order;
+    if (blocks.empty())
+        return order;
+    // iterative DFS, each frame keeps the index of the next successor to visit
+    std::unordered_set<const Backend::LIR::Block *> visited{blocks.front().get()};
+    std::vector<std::pair<std::shared_ptr<Backend::LIR::Block>, size_t>> frames{{blocks.front(), 0}};
+    while (!frames.empty()) {
+        std::pair<std::shared_ptr<Backend::LIR::Block>, size_t> &frame = frames.back();
+        if (frame.second < frame.first->successors.size()) {
+            std::shared_ptr<Backend::LIR::Block> succ = frame.first->successors[frame.second++];
+            if (visited.insert(succ.get()).second)
+                frames.emplace_back(succ, 0);
+        } else {
+            order.push_back(frame.first);
+            frames.pop_back();
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
 
+/*
+ * Backward data flow solved with a worklist:
+ *   live_out(B) = U live_in(S) for S in succ(B)
+ *   live_in(B)  = gen(B) U (live_out(B) - kill(B))
+ * gen/kill of each block are summarized once, instructions are not revisited while iterating.
+ * Blocks are seeded in post order so that most of them are final after the first pass.
+ */
 template<bool (*is_consistent)(const Backend::VariableType &type)>
-bool Backend::LIR::Function::analyze_live_variables(std::shared_ptr<Backend::LIR::Block> &block, std::unordered_set<std::string> &visited) {
-    bool changed = false;
-    size_t old_in_size = block->live_in.size();
-    size_t old_out_size = block->live_out.size();
-    visited.insert(block->name);
-    // live_out = sum(live_in)
-    for (std::shared_ptr<Backend::LIR::Block> &succ : block->successors) {
-        if (visited.find(succ->name) == visited.end())
-            changed = analyze_live_variables<is_consistent>(succ, visited) | changed;
-        block->live_out.insert(succ->live_in.begin(), succ->live_in.end());
+void Backend::LIR::Function::analyze_live_variables() {
+    for (std::shared_ptr<Backend::LIR::Block> &block : blocks) {
+        block->live_in = Backend::BitSet(variable_count());
+        block->live_out = Backend::BitSet(variable_count());
+    }
+    const std::vector<std::shared_ptr<Backend::LIR::Block>> order = reverse_post_order();
+    const size_t n = order.size();
+    std::unordered_map<const Backend::LIR::Block *, size_t> position;
+    for (size_t i = 0; i < n; i++)
+        position[order[i].get()] = i;
+    std::vector<Backend::BitSet> gen(n, Backend::BitSet(variable_count()));
+    std::vector<Backend::BitSet> kill(n, Backend::BitSet(variable_count()));
+    for (size_t i = 0; i < n; i++) {
+        for (std::vector<std::shared_ptr<Backend::LIR::Instruction>>::const_reverse_iterator it = order[i]->instructions.rbegin(); it != order[i]->instructions.rend(); it++) {
+            const std::shared_ptr<Backend::LIR::Instruction> &instruction = *it;
+            if (std::shared_ptr<Backend::Variable> def_var = instruction->get_defined_variable(is_consistent))
+                if (const size_t index = index_of(*def_var); index != Backend::Variable::no_index) {
+                    kill[i].set(index);
+                    gen[i].reset(index);
+                }
+            for (const std::shared_ptr<Backend::Variable> &used_var : instruction->get_used_variables(is_consistent))
+                if (const size_t index = index_of(*used_var); index != Backend::Variable::no_index)
+                    gen[i].set(index);
+        }
     }
-    // live_in = (live_out - def) + use
-    block->live_in.insert(block->live_out.begin(), block->live_out.end());
-    for (std::vector<std::shared_ptr<Backend::LIR::Instruction>>::reverse_iterator it = block->instructions.rbegin(); it != block->instructions.rend(); it++) {
-        std::shared_ptr<Backend::LIR::Instruction> &instruction = *it;
-        std::shared_ptr<Backend::Variable> def_var = instruction->get_defined_variable(is_consistent);
-        if (def_var)
-            block->live_in.erase(def_var->name);
-        for (const std::shared_ptr<Backend::Variable> &used_var : instruction->get_used_variables(is_consistent))
-            if (is_consistent(used_var->workload_type))
-                block->live_in.insert(used_var->name);
+    // the worklist is used as a stack, pushing in RPO pops in post order
+    std::vector<size_t> worklist(n);
+    std::vector<bool> in_worklist(n, true);
+    for (size_t i = 0; i < n; i++)
+        worklist[i] = i;
+    while (!worklist.empty()) {
+        const size_t i = worklist.back();
+        worklist.pop_back();
+        in_worklist[i] = false;
+        const std::shared_ptr<Backend::LIR::Block> &block = order[i];
+        for (const std::shared_ptr<Backend::LIR::Block> &succ : block->successors)
+            block->live_out.union_with(succ->live_in);
+        Backend::BitSet live = block->live_out;
+        live.subtract(kill[i]);
+        live.union_with(gen[i]);
+        if (!block->live_in.union_with(live))
+            continue;
+        for (const std::shared_ptr<Backend::LIR::Block> &pred : block->predecessors) {
+            std::unordered_map<const Backend::LIR::Block *, size_t>::const_iterator pos = position.find(pred.get());
+            if (pos != position.end() && !in_worklist[pos->second]) {
+                in_worklist[pos->second] = true;
+                worklist.push_back(pos->second);
+            }
+        }
     }
-    return changed || block->live_in.size() != old_in_size || block->live_out.size() != old_out_size;
+    // std::cout << live_variables();
 }
 
-template bool Backend::LIR::Function::analyze_live_variables<Backend::Utils::is_int>(std::shared_ptr<Backend::LIR::Block> &block, std::unordered_set<std::string> &visited);
-template bool Backend::LIR::Function::analyze_live_variables<Backend::Utils::is_float>(std::shared_ptr<Backend::LIR::Block> &block, std::unordered_set<std::string> &visited);
\ No newline at end of file
+template void Backend::LIR::Function::analyze_live_variables<Backend::Utils::is_int>();
+template void Backend::LIR::Function::analyze_live_variables<Backend::Utils::is_float>();
\ No newline at end of file
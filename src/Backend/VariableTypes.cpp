@@ -3,11 +3,11 @@
 [[nodiscard]] Backend::VariableType Backend::Utils::llvm_to_riscv(const Mir::Type::Type& type) {
     if (type.is_int32()) return Backend::VariableType::INT32;
     if (type.is_int1()) return Backend::VariableType::INT1;
-    if (type.is_array()) return Backend::Utils::to_pointer(Backend::Utils::llvm_to_riscv(*dynamic_cast<const Mir::Type::Array *>(&type)->get_element_type()));
+    if (type.is_array()) return Backend::Utils::to_pointer(Backend::Utils::llvm_to_riscv(*static_cast<const Mir::Type::Array *>(&type)->get_element_type()));
     if (type.is_float()) return Backend::VariableType::FLOAT;
     if (type.is_void()) return Backend::VariableType::VOID;
     if (type.is_label()) return Backend::VariableType::LABEL;
-    if (type.is_pointer()) return Backend::Utils::to_pointer(Backend::Utils::llvm_to_riscv(*dynamic_cast<const Mir::Type::Pointer *>(&type)->get_contain_type()));
+    if (type.is_pointer()) return Backend::Utils::to_pointer(Backend::Utils::llvm_to_riscv(*static_cast<const Mir::Type::Pointer *>(&type)->get_contain_type()));
     log_error("Type cannot be converted!");
 }
 
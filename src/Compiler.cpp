@@ -9,41 +9,67 @@ int main(int argc, char *argv[]) {
     compiler_options options = parse_args(argc, argv);
 #endif
     options.print();
-    std::ifstream file(options.input_file);
-    if (!file) {
-        log_fatal("Could not open file %s: %s", options.input_file.c_str(), strerror(errno));
-    }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string src_code = buffer.str();
-    file.close();
+    Utils::set_time_report_enabled(options.time_report);
+    Utils::set_trace_enabled(!options.trace_file.empty());
+    // Token 与 AST 中的标识符直接指向源程序，须保持到 IR 构建完成
+    const SourceBuffer source(options.input_file);
 
-    Lexer lexer(src_code);
-    const std::vector<Token::Token> &tokens = lexer.tokenize();
-    emit_tokens(tokens, options._emit_options);
+    std::optional<Utils::TraceSpan> phase{std::in_place, "phase", "frontend"};
+    if (options._emit_options.emit_tokens) {
+        // 只有输出Token时才需要完整的Token列表，语法分析另行从源程序开头按需读取
+        Lexer lexer(source.view());
+        std::optional<Utils::ScopedTimer> timer{std::in_place, "frontend", "lex"};
+        const std::vector<Token::Token> &tokens = lexer.tokenize();
+        timer.reset();
+        emit_tokens(tokens, options._emit_options);
+    }
 
-    Parser parser(tokens);
-    std::shared_ptr<AST::CompUnit> ast = parser.parse();
+    // AST 只在构建 IR 前后使用，结点全部分配在 ast_arena 上，构建完成后一次性释放
+    std::optional<AST::Arena> ast_arena{std::in_place};
+    Lexer lexer(source.view());
+    Parser parser(lexer, *ast_arena);
+    // 词法分析穿插在语法分析中，计入 parse
+    std::optional<Utils::ScopedTimer> timer{std::in_place, "frontend", "parse"};
+    const AST::CompUnit *ast = parser.parse();
+    timer.reset();
     emit_ast(ast, options._emit_options);
 
+    Mir::Module::set_arena_enabled(options.ir_arena);
     Mir::Builder builder;
+    timer.emplace("frontend", "build-ir");
     std::shared_ptr<Mir::Module> module = builder.visit(ast);
+    timer.reset();
+    ast_arena.reset();
+    phase.reset();
     Mir::Module::set_instance(module);
     emit_llvm(module, options._emit_options);
     module->update_id();
 
-    if (options.opt_level >= Optimize_level::O1) {
+    Utils::set_worker_threads(options.worker_threads());
+    if (options.parallel_passes) {
+        Pass::set_function_parallelism(options.worker_threads());
+    }
+    phase.emplace("phase", "optimize");
+    if (!options.passes.empty()) {
+        execute_pipeline(module, options.passes);
+    } else if (options.opt_level == Optimize_level::O2) {
+        execute_O2_passes(module);
+    } else if (options.opt_level == Optimize_level::O1) {
         execute_O1_passes(module);
     } else {
         execute_O0_passes(module);
     }
+    phase.reset();
     emit_llvm(module, options._emit_options);
 
     if (options._emit_options.emit_riscv) {
-        RISCV::Assembler assembler(module);
+        const Utils::TraceSpan backend_phase{"phase", "backend"};
+        RISCV::Assembler assembler(module, options.allocation_type(), options.jobs.value_or(1));
         emit_riscv(assembler, options);
     }
+    emit_statistics(module, options);
+    emit_time_report(options);
+    emit_trace(options);
 
     return 0;
 }
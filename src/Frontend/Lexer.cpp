@@ -1,8 +1,154 @@
+#include <array>
+#include <charconv>
+#include <cstdint>
 #include <iomanip>
 
 #include "Frontend/Lexer.h"
 #include "Utils/Log.h"
 
+namespace {
+// 字符类别表，扫描时每个字符只查一次表
+enum CharClass : uint8_t {
+    SPACE = 1 << 0,
+    // 标识符的首字符：字母与下划线
+    IDENT_START = 1 << 1,
+    DIGIT = 1 << 2,
+    HEX_DIGIT = 1 << 3,
+    OCT_DIGIT = 1 << 4,
+};
+
+constexpr std::array<uint8_t, 256> char_classes = [] {
+    std::array<uint8_t, 256> classes{};
+    for (const unsigned char c: {' ', '\t', '\n', '\v', '\f', '\r'}) {
+        classes[c] |= SPACE;
+    }
+    for (unsigned char c = 'a'; c <= 'z'; ++c) {
+        classes[c] |= IDENT_START;
+        classes[c - 'a' + 'A'] |= IDENT_START;
+    }
+    classes['_'] |= IDENT_START;
+    for (unsigned char c = '0'; c <= '9'; ++c) {
+        classes[c] |= DIGIT | HEX_DIGIT;
+    }
+    for (unsigned char c = '0'; c <= '7'; ++c) {
+        classes[c] |= OCT_DIGIT;
+    }
+    for (unsigned char c = 'a'; c <= 'f'; ++c) {
+        classes[c] |= HEX_DIGIT;
+        classes[c - 'a' + 'A'] |= HEX_DIGIT;
+    }
+    return classes;
+}();
+
+bool is(const char c, const uint8_t char_class) { return char_classes[static_cast<unsigned char>(c)] & char_class; }
+
+bool is_ident(const char c) { return is(c, IDENT_START | DIGIT); }
+
+struct Keyword {
+    std::string_view text;
+    Token::Type type;
+};
+
+constexpr Keyword keywords[] = {
+        {"const", Token::Type::CONST}, {"int", Token::Type::INT},     {"float", Token::Type::FLOAT},
+        {"void", Token::Type::VOID},   {"if", Token::Type::IF},       {"else", Token::Type::ELSE},
+        {"while", Token::Type::WHILE}, {"break", Token::Type::BREAK}, {"continue", Token::Type::CONTINUE},
+        {"return", Token::Type::RETURN}};
+
+// 关键词的完美哈希：由长度与首字符决定槽位，每个槽位至多一个关键词，查找时只需比较一次
+constexpr size_t keyword_slot(const std::string_view text) {
+    return (text.size() * 7 + static_cast<unsigned char>(text[0])) & 15;
+}
+
+constexpr std::array<Keyword, 16> keyword_table = [] {
+    std::array<Keyword, 16> table{};
+    for (auto &slot: table) {
+        slot = {"", Token::Type::IDENTIFIER};
+    }
+    for (const auto &keyword: keywords) {
+        table[keyword_slot(keyword.text)] = keyword;
+    }
+    return table;
+}();
+
+constexpr bool keyword_table_is_perfect() {
+    for (const auto &keyword: keywords) {
+        if (keyword_table[keyword_slot(keyword.text)].text != keyword.text) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(keyword_table_is_perfect(), "Keyword hash has collisions");
+
+Token::Type keyword_or_identifier(const std::string_view text) {
+    const auto &[keyword, type] = keyword_table[keyword_slot(text)];
+    return keyword == text ? type : Token::Type::IDENTIFIER;
+}
+
+// 单字符运算符与分隔符，其余字符为 UNKNOWN
+constexpr std::array<Token::Type, 256> single_char_operators = [] {
+    std::array<Token::Type, 256> table{};
+    for (auto &type: table) {
+        type = Token::Type::UNKNOWN;
+    }
+    table['+'] = Token::Type::ADD;
+    table['-'] = Token::Type::SUB;
+    table['!'] = Token::Type::NOT;
+    table['*'] = Token::Type::MUL;
+    table['/'] = Token::Type::DIV;
+    table['%'] = Token::Type::MOD;
+    table['<'] = Token::Type::LT;
+    table['>'] = Token::Type::GT;
+    table[';'] = Token::Type::SEMICOLON;
+    table[','] = Token::Type::COMMA;
+    table['='] = Token::Type::ASSIGN;
+    table['('] = Token::Type::LPAREN;
+    table[')'] = Token::Type::RPAREN;
+    table['{'] = Token::Type::LBRACE;
+    table['}'] = Token::Type::RBRACE;
+    table['['] = Token::Type::LBRACKET;
+    table[']'] = Token::Type::RBRACKET;
+    return table;
+}();
+
+// 双字符运算符，不匹配时返回 UNKNOWN
+Token::Type two_char_operator(const char first, const char second) {
+    if (second == '=') {
+        switch (first) {
+            case '<':
+                return Token::Type::LE;
+            case '>':
+                return Token::Type::GE;
+            case '=':
+                return Token::Type::EQ;
+            case '!':
+                return Token::Type::NE;
+            default:
+                return Token::Type::UNKNOWN;
+        }
+    }
+    if (first == '&' && second == '&') {
+        return Token::Type::AND;
+    }
+    if (first == '|' && second == '|') {
+        return Token::Type::OR;
+    }
+    return Token::Type::UNKNOWN;
+}
+
+bool is_hex_prefix(const std::string_view literal) {
+    return literal.size() >= 2 && literal[0] == '0' && (literal[1] == 'x' || literal[1] == 'X');
+}
+} // namespace
+
+void Lexer::consume_whitespace() {
+    while (pos < input.length() && is(peek(), SPACE)) {
+        advance();
+    }
+}
+
 void Lexer::consume_line_comment() {
     advance(); // '/'
     advance(); // '/'
@@ -26,167 +172,154 @@ void Lexer::consume_block_comment() {
 
 Token::Token Lexer::consume_ident_or_keyword() {
     const int start_line = line;
-    std::string lexeme;
-    while (pos < input.length() && (isalnum(peek()) || peek() == '_')) {
-        lexeme += advance();
+    const size_t start = pos;
+    // 标识符中不会出现换行，无需经过 advance
+    while (pos < input.length() && is_ident(input[pos])) {
+        ++pos;
     }
-
-    if (keywords.find(lexeme) != keywords.end()) {
-        return Token::Token{lexeme, string_to_type(lexeme), start_line};
-    }
-    return Token::Token{lexeme, Token::Type::IDENTIFIER, start_line};
+    const auto text = lexeme(start);
+    return Token::Token{text, keyword_or_identifier(text), start_line};
 }
 
 Token::Token Lexer::consume_number() {
     const int start_line = line;
-    std::string number;
+    const size_t start = pos;
     bool is_float = false;
-    std::size_t idx;
 
     // 十六进制数处理 (0x...)
     if (peek() == '0' && (peek_next() == 'x' || peek_next() == 'X')) {
-        number += advance(); // '0'
-        number += advance(); // 'x'/'X'
-        while (pos < input.length() && std::isxdigit(peek())) {
-            number += advance();
+        advance(); // '0'
+        advance(); // 'x'/'X'
+        while (is(peek(), HEX_DIGIT)) {
+            advance();
         }
 
         // 处理十六进制浮点数
         if (peek() == '.' || peek() == 'p' || peek() == 'P') {
             if (peek() == '.') {
-                number += advance(); // '.'
-                while (pos < input.length() && std::isxdigit(peek())) {
-                    number += advance();
+                advance(); // '.'
+                while (is(peek(), HEX_DIGIT)) {
+                    advance();
                 }
             }
             if (peek() == 'p' || peek() == 'P') {
-                number += advance(); // 'p'/'P'
+                advance(); // 'p'/'P'
                 if (peek() == '+' || peek() == '-')
-                    number += advance();
-                while (pos < input.length() && std::isdigit(peek())) {
-                    number += advance();
+                    advance();
+                while (is(peek(), DIGIT)) {
+                    advance();
                 }
             }
-            return Token::Token{std::move(number), Token::Type::FLOAT_CONST, start_line};
+            return Token::Token{lexeme(start), Token::Type::FLOAT_CONST, start_line};
         }
-        return Token::Token{std::to_string(std::stoi(number, &idx, 16)), Token::Type::INT_CONST, start_line};
+        return Token::Token{lexeme(start), Token::Type::INT_CONST, start_line};
     }
 
     // 八进制数处理 (0后面紧跟0-7)
-    if (peek() == '0' && (peek_next() >= '0' && peek_next() <= '7')) {
-        number += advance(); // '0'
-        while (pos < input.length() && peek() >= '0' && peek() <= '7') {
-            number += advance();
+    if (peek() == '0' && is(peek_next(), OCT_DIGIT)) {
+        advance(); // '0'
+        while (is(peek(), OCT_DIGIT)) {
+            advance();
         }
 
-        // 检查八进制后是否接浮点或指数（转换为十进制处理）
+        // 检查八进制后是否接浮点或指数（整数部分由 float_literal 按八进制转换）
         if (peek() == '.' || peek() == 'e' || peek() == 'E') {
-            int oct_part = std::stoi(number, nullptr, 8);
-            number = std::to_string(oct_part);
             is_float = true;
         } else {
-            return Token::Token{std::to_string(std::stoi(number, &idx, 8)), Token::Type::INT_CONST, start_line};
+            return Token::Token{lexeme(start), Token::Type::INT_CONST, start_line};
         }
     }
 
     // 十进制数字处理
-    if (number.empty()) {
-        while (pos < input.length() && std::isdigit(peek())) {
-            number += advance();
+    if (!is_float) {
+        while (is(peek(), DIGIT)) {
+            advance();
         }
     }
 
     // 前导零错误检查（仅限十进制整数）
-    if (!is_float && number.size() > 1 && number[0] == '0') {
+    if (!is_float && pos - start > 1 && input[start] == '0') {
         log_fatal("Invalid leading zero in integer at line %d", start_line);
     }
 
     // 浮点数处理
     if (peek() == '.') {
         is_float = true;
-        number += advance();
-        while (pos < input.length() && std::isdigit(peek())) {
-            number += advance();
+        advance();
+        while (is(peek(), DIGIT)) {
+            advance();
         }
     }
 
     if (peek() == 'e' || peek() == 'E') {
         is_float = true;
-        number += advance();
+        advance();
         if (peek() == '+' || peek() == '-')
-            number += advance();
-        while (pos < input.length() && std::isdigit(peek())) {
-            number += advance();
+            advance();
+        while (is(peek(), DIGIT)) {
+            advance();
         }
     }
 
     // 浮点后缀
     if (peek() == 'f' || peek() == 'F' || peek() == 'l' || peek() == 'L') {
         is_float = true;
-        number += advance();
-    }
-
-    if (is_float) {
-        std::ostringstream oss;
-        double val = std::stod(number, &idx);
-        oss << std::setprecision(12) << val;
-        return Token::Token{oss.str(), Token::Type::FLOAT_CONST, start_line};
+        advance();
     }
 
-    return Token::Token{std::to_string(std::stoi(number, &idx, 10)), Token::Type::INT_CONST, start_line};
+    return Token::Token{lexeme(start), is_float ? Token::Type::FLOAT_CONST : Token::Type::INT_CONST, start_line};
 }
 
 Token::Token Lexer::consume_string() {
     const int start_line = line;
-    std::string str;
     advance(); // 消费第一个双引号
+    const size_t start = pos;
+    size_t end = input.length();
     while (pos < input.length()) {
         if (const char current = peek(); current == '\\') {
-            // 转义字符
-            str += advance(); // '\\'
+            // 转义字符，保持原样
+            advance(); // '\\'
             if (pos < input.length()) {
-                str += advance(); // 转义后的字符
+                advance(); // 转义后的字符
             }
         } else if (current == '"') {
             // 结束双引号
+            end = pos;
             advance();
             break;
         } else {
-            str += advance();
+            advance();
         }
     }
-    return Token::Token{str, Token::Type::STRING_CONST, start_line};
+    return Token::Token{input.substr(start, end - start), Token::Type::STRING_CONST, start_line};
 }
 
 // 识别运算符或未知字符
 Token::Token Lexer::consume_operator() {
     const int start_line = line;
-    std::string op;
-    op += advance();
+    const size_t start = pos;
+    const char first = advance();
 
     // 尝试匹配两个字符的运算符
-    if (pos < input.length()) {
-        if (const std::string two_char_op = op + std::string(1, peek());
-            operators.find(two_char_op) != operators.end()) {
-            advance();
-            return Token::Token{two_char_op, operators[two_char_op], start_line};
-        }
+    if (const auto type = two_char_operator(first, peek()); type != Token::Type::UNKNOWN) {
+        advance();
+        return Token::Token{lexeme(start), type, start_line};
     }
 
     // 尝试匹配单字符运算符
-    if (operators.find(op) != operators.end()) {
-        return Token::Token{op, operators[op], start_line};
+    if (const auto type = single_char_operators[static_cast<unsigned char>(first)]; type != Token::Type::UNKNOWN) {
+        return Token::Token{lexeme(start), type, start_line};
     }
 
     // 未知字符
-    log_fatal("Unrecognized operator %s at line %d", op.c_str(), start_line);
+    log_fatal("Unrecognized operator %c at line %d", first, start_line);
 }
 
-const std::vector<Token::Token> &Lexer::tokenize() {
+Token::Token Lexer::next_token() {
     while (pos < input.length()) {
         const char current = peek();
         // 跳过空白符和注释
-        if (isspace(current)) {
+        if (is(current, SPACE)) {
             consume_whitespace();
             continue;
         }
@@ -201,16 +334,63 @@ const std::vector<Token::Token> &Lexer::tokenize() {
             }
         }
         // 识别Token
-        if (isalpha(current) || current == '_') {
-            tokens.push_back(consume_ident_or_keyword());
-        } else if (isdigit(current) || current == '.') {
-            tokens.push_back(consume_number());
-        } else if (current == '"') {
-            tokens.push_back(consume_string());
-        } else {
-            tokens.push_back(consume_operator());
+        if (is(current, IDENT_START)) {
+            return consume_ident_or_keyword();
+        }
+        if (is(current, DIGIT) || current == '.') {
+            return consume_number();
         }
+        if (current == '"') {
+            return consume_string();
+        }
+        return consume_operator();
     }
-    tokens.emplace_back("\0", Token::Type::END_OF_FILE, line);
+    return Token::Token{"", Token::Type::END_OF_FILE, line};
+}
+
+const std::vector<Token::Token> &Lexer::tokenize() {
+    do {
+        tokens.push_back(next_token());
+    } while (tokens.back().type != Token::Type::END_OF_FILE);
     return tokens;
-}
\ No newline at end of file
+}
+
+int Lexer::int_value(const std::string_view literal) {
+    int base = 10;
+    size_t offset = 0;
+    if (is_hex_prefix(literal)) {
+        base = 16;
+        offset = 2;
+    } else if (literal.size() > 1 && literal[0] == '0') {
+        base = 8;
+        offset = 1;
+    }
+    int value = 0;
+    const char *end = literal.data() + literal.size();
+    if (const auto [ptr, ec] = std::from_chars(literal.data() + offset, end, value, base);
+        ec != std::errc{} || ptr != end) {
+        log_fatal("Invalid integer literal %.*s", static_cast<int>(literal.size()), literal.data());
+    }
+    return value;
+}
+
+std::string Lexer::float_literal(const std::string_view literal) {
+    if (is_hex_prefix(literal)) {
+        return std::string{literal};
+    }
+    std::string number;
+    if (literal.size() > 1 && literal[0] == '0' && is(literal[1], OCT_DIGIT)) {
+        // 八进制的整数部分先转换为十进制
+        size_t end = 1;
+        while (end < literal.size() && is(literal[end], OCT_DIGIT)) {
+            ++end;
+        }
+        number = std::to_string(std::stoi(std::string{literal.substr(0, end)}, nullptr, 8));
+        number += literal.substr(end);
+    } else {
+        number = literal;
+    }
+    std::ostringstream oss;
+    oss << std::setprecision(12) << std::stod(number);
+    return oss.str();
+}
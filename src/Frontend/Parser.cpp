@@ -1,3 +1,4 @@
+#include "Frontend/Lexer.h"
 #include "Frontend/Parser.h"
 #include "Utils/AST.h"
 #include "Utils/Log.h"
@@ -16,7 +17,7 @@ bool Parser::panic_on(Types... expected_types) {
         oss << "}, got Token " << type_to_string(current_type) << " at line " << peek().line;
         log_fatal(oss.str().c_str());
     }
-    pos++;
+    advance();
     return true;
 }
 
@@ -25,175 +26,175 @@ bool Parser::match(Types... expected_types) {
     std::unordered_set<Token::Type> types = {expected_types...};
     if (const Token::Type current_type = peek().type; types.find(current_type) == types.end())
         return false;
-    pos++;
+    advance();
     return true;
 }
 
-std::shared_ptr<AST::CompUnit> Parser::parseCompUnit() {
-    std::vector<std::variant<std::shared_ptr<AST::Decl>, std::shared_ptr<AST::FuncDef>>> compunits;
+const AST::CompUnit *Parser::parseCompUnit() {
+    Utils::SmallVector<std::variant<const AST::Decl *, const AST::FuncDef *>, 4> compunits;
     while (!eof()) {
         if (next(2).type == Token::Type::LPAREN) {
-            compunits.emplace_back(parseFuncDef());
+            compunits.push_back(parseFuncDef());
         } else {
-            compunits.emplace_back(parseDecl());
+            compunits.push_back(parseDecl());
         }
     }
     panic_on(Token::Type::END_OF_FILE);
-    return std::make_shared<AST::CompUnit>(compunits);
+    return arena.create<AST::CompUnit>(arena.list(compunits));
 }
 
-std::shared_ptr<AST::Decl> Parser::parseDecl() {
+const AST::Decl *Parser::parseDecl() {
     if (peek().type == Token::Type::CONST) {
         return parseConstDecl();
     }
     return parseVarDecl();
 }
 
-std::shared_ptr<AST::ConstDecl> Parser::parseConstDecl() {
+const AST::ConstDecl *Parser::parseConstDecl() {
     panic_on(Token::Type::CONST);
     panic_on(Token::Type::INT, Token::Type::FLOAT);
     Token::Type bType = next(-1).type;
-    std::vector<std::shared_ptr<AST::ConstDef>> constDefs;
+    Utils::SmallVector<const AST::ConstDef *, 4> constDefs;
     do {
-        constDefs.emplace_back(parseConstDef());
+        constDefs.push_back(parseConstDef());
     } while (match(Token::Type::COMMA));
     panic_on(Token::Type::SEMICOLON);
-    return std::make_shared<AST::ConstDecl>(bType, constDefs);
+    return arena.create<AST::ConstDecl>(bType, arena.list(constDefs));
 }
 
-std::shared_ptr<AST::ConstDef> Parser::parseConstDef() {
+const AST::ConstDef *Parser::parseConstDef() {
     panic_on(Token::Type::IDENTIFIER);
     const auto tk = next(-1);
-    std::vector<std::shared_ptr<AST::ConstExp>> constExps;
+    Utils::SmallVector<const AST::ConstExp *, 4> constExps;
     if (match(Token::Type::LBRACKET)) {
         do {
-            constExps.emplace_back(parseConstExp());
+            constExps.push_back(parseConstExp());
             panic_on(Token::Type::RBRACKET);
         } while (match(Token::Type::LBRACKET));
     }
     panic_on(Token::Type::ASSIGN);
-    std::shared_ptr<AST::ConstInitVal> constInitVal = parseConstInitVal();
-    return std::make_shared<AST::ConstDef>(tk.content, constExps, constInitVal, tk.line);
+    const AST::ConstInitVal *constInitVal = parseConstInitVal();
+    return arena.create<AST::ConstDef>(tk.content, arena.list(constExps), constInitVal, tk.line);
 }
 
-std::shared_ptr<AST::ConstInitVal> Parser::parseConstInitVal() {
+const AST::ConstInitVal *Parser::parseConstInitVal() {
     if (match(Token::Type::LBRACE)) {
-        std::vector<std::shared_ptr<AST::ConstInitVal>> constInitVals;
+        Utils::SmallVector<const AST::ConstInitVal *, 4> constInitVals;
         if (match(Token::Type::RBRACE)) {
-            return std::make_shared<AST::ConstInitVal>(constInitVals);
+            return arena.create<AST::ConstInitVal>(arena.list(constInitVals));
         }
         do {
-            constInitVals.emplace_back(parseConstInitVal());
+            constInitVals.push_back(parseConstInitVal());
         } while (match(Token::Type::COMMA));
         panic_on(Token::Type::RBRACE);
-        return std::make_shared<AST::ConstInitVal>(constInitVals);
+        return arena.create<AST::ConstInitVal>(arena.list(constInitVals));
     }
-    std::shared_ptr<AST::ConstExp> constExp = parseConstExp();
-    return std::make_shared<AST::ConstInitVal>(constExp);
+    const AST::ConstExp *constExp = parseConstExp();
+    return arena.create<AST::ConstInitVal>(constExp);
 }
 
-std::shared_ptr<AST::VarDecl> Parser::parseVarDecl() {
+const AST::VarDecl *Parser::parseVarDecl() {
     panic_on(Token::Type::INT, Token::Type::FLOAT);
     Token::Type bType = next(-1).type;
-    std::vector<std::shared_ptr<AST::VarDef>> varDefs;
+    Utils::SmallVector<const AST::VarDef *, 4> varDefs;
     do {
-        varDefs.emplace_back(parseVarDef());
+        varDefs.push_back(parseVarDef());
     } while (match(Token::Type::COMMA));
     panic_on(Token::Type::SEMICOLON);
-    return std::make_shared<AST::VarDecl>(bType, varDefs);
+    return arena.create<AST::VarDecl>(bType, arena.list(varDefs));
 }
 
-std::shared_ptr<AST::VarDef> Parser::parseVarDef() {
+const AST::VarDef *Parser::parseVarDef() {
     panic_on(Token::Type::IDENTIFIER);
     const auto tk = next(-1);
-    std::vector<std::shared_ptr<AST::ConstExp>> constExps;
+    Utils::SmallVector<const AST::ConstExp *, 4> constExps;
     if (match(Token::Type::LBRACKET)) {
         do {
-            constExps.emplace_back(parseConstExp());
+            constExps.push_back(parseConstExp());
             panic_on(Token::Type::RBRACKET);
         } while (match(Token::Type::LBRACKET));
     }
-    std::shared_ptr<AST::InitVal> initVal = nullptr;
+    const AST::InitVal *initVal = nullptr;
     if (match(Token::Type::ASSIGN)) {
         initVal = parseInitVal();
     }
-    return std::make_shared<AST::VarDef>(tk.content, constExps, initVal, tk.line);
+    return arena.create<AST::VarDef>(tk.content, arena.list(constExps), initVal, tk.line);
 }
 
-std::shared_ptr<AST::InitVal> Parser::parseInitVal() {
+const AST::InitVal *Parser::parseInitVal() {
     if (match(Token::Type::LBRACE)) {
-        std::vector<std::shared_ptr<AST::InitVal>> initVals;
+        Utils::SmallVector<const AST::InitVal *, 4> initVals;
         if (match(Token::Type::RBRACE)) {
-            return std::make_shared<AST::InitVal>(initVals);
+            return arena.create<AST::InitVal>(arena.list(initVals));
         }
         do {
-            initVals.emplace_back(parseInitVal());
+            initVals.push_back(parseInitVal());
         } while (match(Token::Type::COMMA));
         panic_on(Token::Type::RBRACE);
-        return std::make_shared<AST::InitVal>(initVals);
+        return arena.create<AST::InitVal>(arena.list(initVals));
     }
-    std::shared_ptr<AST::Exp> exp = parseExp();
-    return std::make_shared<AST::InitVal>(exp);
+    const AST::Exp *exp = parseExp();
+    return arena.create<AST::InitVal>(exp);
 }
 
-std::shared_ptr<AST::FuncDef> Parser::parseFuncDef() {
+const AST::FuncDef *Parser::parseFuncDef() {
     panic_on(Token::Type::INT, Token::Type::FLOAT, Token::Type::VOID);
     const Token::Type func_type = next(-1).type;
     panic_on(Token::Type::IDENTIFIER);
-    const std::string ident = next(-1).content;
+    const auto ident = next(-1).content;
     panic_on(Token::Type::LPAREN);
-    std::vector<std::shared_ptr<AST::FuncFParam>> funcParams;
+    Utils::SmallVector<const AST::FuncFParam *, 4> funcParams;
     if (peek().type != Token::Type::RPAREN) {
         do {
-            funcParams.emplace_back(parseFuncFParam());
+            funcParams.push_back(parseFuncFParam());
         } while (match(Token::Type::COMMA));
     }
     panic_on(Token::Type::RPAREN);
     const auto block = parseBlock();
-    return std::make_shared<AST::FuncDef>(func_type, ident, funcParams, block);
+    return arena.create<AST::FuncDef>(func_type, ident, arena.list(funcParams), block);
 }
 
-std::shared_ptr<AST::FuncFParam> Parser::parseFuncFParam() {
+const AST::FuncFParam *Parser::parseFuncFParam() {
     panic_on(Token::Type::INT, Token::Type::FLOAT);
     const Token::Type bType = next(-1).type;
     panic_on(Token::Type::IDENTIFIER);
-    const std::string ident = next(-1).content;
-    std::vector<std::shared_ptr<AST::Exp>> exps;
+    const auto ident = next(-1).content;
+    Utils::SmallVector<const AST::Exp *, 4> exps;
     if (peek().type == Token::Type::LBRACKET && next().type == Token::Type::RBRACKET) {
         // 第一维默认为空，向exps插入一个nullptr
         panic_on(Token::Type::LBRACKET);
         panic_on(Token::Type::RBRACKET);
-        exps.emplace_back(nullptr);
+        exps.push_back(nullptr);
     }
     while (!(peek().type == Token::Type::RPAREN || peek().type == Token::Type::COMMA)) {
         panic_on(Token::Type::LBRACKET);
-        exps.emplace_back(parseExp());
+        exps.push_back(parseExp());
         panic_on(Token::Type::RBRACKET);
     }
-    return std::make_shared<AST::FuncFParam>(bType, ident, exps);
+    return arena.create<AST::FuncFParam>(bType, ident, arena.list(exps));
 }
 
-std::shared_ptr<AST::Block> Parser::parseBlock() {
+const AST::Block *Parser::parseBlock() {
     panic_on(Token::Type::LBRACE);
-    std::vector<std::variant<std::shared_ptr<AST::Decl>, std::shared_ptr<AST::Stmt>>> items;
+    Utils::SmallVector<std::variant<const AST::Decl *, const AST::Stmt *>, 4> items;
     while (!match(Token::Type::RBRACE)) {
         if (peek().type == Token::Type::CONST || peek().type == Token::Type::INT || peek().type == Token::Type::FLOAT) {
-            items.emplace_back(parseDecl());
+            items.push_back(parseDecl());
         } else {
-            items.emplace_back(parseStmt());
+            items.push_back(parseStmt());
         }
     }
-    return std::make_shared<AST::Block>(items);
+    return arena.create<AST::Block>(arena.list(items));
 }
 
-std::shared_ptr<AST::Stmt> Parser::parseStmt() {
+const AST::Stmt *Parser::parseStmt() {
     if (match(Token::Type::BREAK)) {
         panic_on(Token::Type::SEMICOLON);
-        return std::make_shared<AST::BreakStmt>();
+        return arena.create<AST::BreakStmt>();
     }
     if (match(Token::Type::CONTINUE)) {
         panic_on(Token::Type::SEMICOLON);
-        return std::make_shared<AST::ContinueStmt>();
+        return arena.create<AST::ContinueStmt>();
     }
     if (match(Token::Type::RETURN)) {
         return parseReturnStmt();
@@ -206,190 +207,191 @@ std::shared_ptr<AST::Stmt> Parser::parseStmt() {
     }
     if (peek().type == Token::Type::LBRACE) {
         const auto block = parseBlock();
-        return std::make_shared<AST::BlockStmt>(block);
+        return arena.create<AST::BlockStmt>(block);
     }
     if (peek().type == Token::Type::IDENTIFIER) {
-        const auto temp = pos;
+        const auto temp = mark();
         const auto lVal = parseLVal();
         if (match(Token::Type::ASSIGN)) {
+            release();
             const auto exp = parseExp();
             panic_on(Token::Type::SEMICOLON);
-            return std::make_shared<AST::AssignStmt>(lVal, exp);
+            return arena.create<AST::AssignStmt>(lVal, exp);
         }
-        pos = temp;
+        rewind(temp);
     }
-    std::shared_ptr<AST::Exp> exp = nullptr;
+    const AST::Exp *exp = nullptr;
     if (!match(Token::Type::SEMICOLON)) {
         exp = parseExp();
         panic_on(Token::Type::SEMICOLON);
     }
-    return std::make_shared<AST::ExpStmt>(exp);
+    return arena.create<AST::ExpStmt>(exp);
 }
 
-std::shared_ptr<AST::ReturnStmt> Parser::parseReturnStmt() {
-    std::shared_ptr<AST::Exp> exp = nullptr;
+const AST::ReturnStmt *Parser::parseReturnStmt() {
+    const AST::Exp *exp = nullptr;
     if (!match(Token::Type::SEMICOLON)) {
         exp = parseExp();
         panic_on(Token::Type::SEMICOLON);
     }
-    return std::make_shared<AST::ReturnStmt>(exp);
+    return arena.create<AST::ReturnStmt>(exp);
 }
 
-std::shared_ptr<AST::IfStmt> Parser::parseIfStmt() {
+const AST::IfStmt *Parser::parseIfStmt() {
     panic_on(Token::Type::LPAREN);
     const auto cond = parseCond();
     panic_on(Token::Type::RPAREN);
     const auto then_stmt = parseStmt();
-    std::shared_ptr<AST::Stmt> else_stmt = nullptr;
+    const AST::Stmt *else_stmt = nullptr;
     if (match(Token::Type::ELSE)) {
         else_stmt = parseStmt();
     }
-    return std::make_shared<AST::IfStmt>(cond, then_stmt, else_stmt);
+    return arena.create<AST::IfStmt>(cond, then_stmt, else_stmt);
 }
 
-std::shared_ptr<AST::WhileStmt> Parser::parseWhileStmt() {
+const AST::WhileStmt *Parser::parseWhileStmt() {
     panic_on(Token::Type::LPAREN);
     const auto cond = parseCond();
     panic_on(Token::Type::RPAREN);
     const auto body = parseStmt();
-    return std::make_shared<AST::WhileStmt>(cond, body);
+    return arena.create<AST::WhileStmt>(cond, body);
 }
 
-std::shared_ptr<AST::Exp> Parser::parseExp() {
+const AST::Exp *Parser::parseExp() {
     if (match(Token::Type::STRING_CONST)) {
-        const auto &string_const = next(-1).content;
-        return std::make_shared<AST::Exp>(string_const);
+        const auto string_const = next(-1).content;
+        return arena.create<AST::Exp>(string_const);
     }
-    std::shared_ptr<AST::AddExp> addExp = parseAddExp();
-    return std::make_shared<AST::Exp>(addExp);
+    const AST::AddExp *addExp = parseAddExp();
+    return arena.create<AST::Exp>(addExp);
 }
 
-std::shared_ptr<AST::Cond> Parser::parseCond() {
+const AST::Cond *Parser::parseCond() {
     const auto lOrExp = parseLOrExp();
-    return std::make_shared<AST::Cond>(lOrExp);
+    return arena.create<AST::Cond>(lOrExp);
 }
 
-std::shared_ptr<AST::LVal> Parser::parseLVal() {
+const AST::LVal *Parser::parseLVal() {
     panic_on(Token::Type::IDENTIFIER);
-    const std::string ident = next(-1).content;
-    std::vector<std::shared_ptr<AST::Exp>> exps;
+    const auto ident = next(-1).content;
+    Utils::SmallVector<const AST::Exp *, 4> exps;
     if (match(Token::Type::LBRACKET)) {
         do {
-            exps.emplace_back(parseExp());
+            exps.push_back(parseExp());
             panic_on(Token::Type::RBRACKET);
         } while (match(Token::Type::LBRACKET));
     }
-    return std::make_shared<AST::LVal>(ident, exps);
+    return arena.create<AST::LVal>(ident, arena.list(exps));
 }
 
-std::shared_ptr<AST::PrimaryExp> Parser::parsePrimaryExp() {
+const AST::PrimaryExp *Parser::parsePrimaryExp() {
     if (match(Token::Type::INT_CONST, Token::Type::FLOAT_CONST)) {
-        std::shared_ptr<AST::Number> number = parseNumber();
-        return std::make_shared<AST::PrimaryExp>(number);
+        const AST::Number *number = parseNumber();
+        return arena.create<AST::PrimaryExp>(number);
     }
     if (match(Token::Type::LPAREN)) {
-        std::shared_ptr<AST::Exp> exp = parseExp();
+        const AST::Exp *exp = parseExp();
         panic_on(Token::Type::RPAREN);
-        return std::make_shared<AST::PrimaryExp>(exp);
+        return arena.create<AST::PrimaryExp>(exp);
     }
-    std::shared_ptr<AST::LVal> lval = parseLVal();
-    return std::make_shared<AST::PrimaryExp>(lval);
+    const AST::LVal *lval = parseLVal();
+    return arena.create<AST::PrimaryExp>(lval);
 }
 
-std::shared_ptr<AST::Number> Parser::parseNumber() const {
+const AST::Number *Parser::parseNumber() {
     if (next(-1).type == Token::Type::INT_CONST) {
-        return std::make_shared<AST::IntNumber>(stoi(next(-1).content));
+        return arena.create<AST::IntNumber>(Lexer::int_value(next(-1).content));
     }
-    return std::make_shared<AST::FloatNumber>(next(-1).content);
+    return arena.create<AST::FloatNumber>(Lexer::float_literal(next(-1).content));
 }
 
-std::shared_ptr<AST::UnaryExp> Parser::parseUnaryExp() {
+const AST::UnaryExp *Parser::parseUnaryExp() {
     if (peek().type == Token::Type::IDENTIFIER && next().type == Token::Type::LPAREN) {
         const auto ident = peek();
         panic_on(Token::Type::IDENTIFIER);
         panic_on(Token::Type::LPAREN);
         // 解析实参列表
-        std::vector<std::shared_ptr<AST::Exp>> rParams;
+        Utils::SmallVector<const AST::Exp *, 4> rParams;
         if (match(Token::Type::RPAREN)) {
             // 实参列表为空
-            return std::make_shared<AST::UnaryExp>(ident, rParams);
+            return arena.create<AST::UnaryExp>(ident, arena.list(rParams));
         }
         do {
-            rParams.emplace_back(parseExp());
+            rParams.push_back(parseExp());
         } while (match(Token::Type::COMMA));
         panic_on(Token::Type::RPAREN);
-        return std::make_shared<AST::UnaryExp>(ident, rParams);
+        return arena.create<AST::UnaryExp>(ident, arena.list(rParams));
     }
     if (match(Token::Type::ADD, Token::Type::SUB, Token::Type::NOT)) {
         Token::Type type = next(-1).type;
-        std::shared_ptr<AST::UnaryExp> unaryExp = parseUnaryExp();
-        return std::make_shared<AST::UnaryExp>(type, unaryExp);
+        const AST::UnaryExp *unaryExp = parseUnaryExp();
+        return arena.create<AST::UnaryExp>(type, unaryExp);
     }
-    std::shared_ptr<AST::PrimaryExp> primaryExp = parsePrimaryExp();
-    return std::make_shared<AST::UnaryExp>(primaryExp);
+    const AST::PrimaryExp *primaryExp = parsePrimaryExp();
+    return arena.create<AST::UnaryExp>(primaryExp);
 }
 
-std::shared_ptr<AST::MulExp> Parser::parseMulExp() {
-    std::vector<std::shared_ptr<AST::UnaryExp>> unaryExps;
-    std::vector<Token::Type> operators;
-    unaryExps.emplace_back(parseUnaryExp());
+const AST::MulExp *Parser::parseMulExp() {
+    Utils::SmallVector<const AST::UnaryExp *, 4> unaryExps;
+    Utils::SmallVector<Token::Type, 4> operators;
+    unaryExps.push_back(parseUnaryExp());
     while (match(Token::Type::MUL, Token::Type::DIV, Token::Type::MOD)) {
-        operators.emplace_back(next(-1).type);
-        unaryExps.emplace_back(parseUnaryExp());
+        operators.push_back(next(-1).type);
+        unaryExps.push_back(parseUnaryExp());
     }
-    return std::make_shared<AST::MulExp>(unaryExps, operators);
+    return arena.create<AST::MulExp>(arena.list(unaryExps), arena.list(operators));
 }
 
-std::shared_ptr<AST::AddExp> Parser::parseAddExp() {
-    std::vector<std::shared_ptr<AST::MulExp>> mulExps;
-    std::vector<Token::Type> operators;
-    mulExps.emplace_back(parseMulExp());
+const AST::AddExp *Parser::parseAddExp() {
+    Utils::SmallVector<const AST::MulExp *, 4> mulExps;
+    Utils::SmallVector<Token::Type, 4> operators;
+    mulExps.push_back(parseMulExp());
     while (match(Token::Type::ADD, Token::Type::SUB)) {
-        operators.emplace_back(next(-1).type);
-        mulExps.emplace_back(parseMulExp());
+        operators.push_back(next(-1).type);
+        mulExps.push_back(parseMulExp());
     }
-    return std::make_shared<AST::AddExp>(mulExps, operators);
+    return arena.create<AST::AddExp>(arena.list(mulExps), arena.list(operators));
 }
 
-std::shared_ptr<AST::RelExp> Parser::parseRelExp() {
-    std::vector<std::shared_ptr<AST::AddExp>> addExps;
-    std::vector<Token::Type> operators;
-    addExps.emplace_back(parseAddExp());
+const AST::RelExp *Parser::parseRelExp() {
+    Utils::SmallVector<const AST::AddExp *, 4> addExps;
+    Utils::SmallVector<Token::Type, 4> operators;
+    addExps.push_back(parseAddExp());
     while (match(Token::Type::LE, Token::Type::GE, Token::Type::LT, Token::Type::GT)) {
-        operators.emplace_back(next(-1).type);
-        addExps.emplace_back(parseAddExp());
+        operators.push_back(next(-1).type);
+        addExps.push_back(parseAddExp());
     }
-    return std::make_shared<AST::RelExp>(addExps, operators);
+    return arena.create<AST::RelExp>(arena.list(addExps), arena.list(operators));
 }
 
-std::shared_ptr<AST::EqExp> Parser::parseEqExp() {
-    std::vector<std::shared_ptr<AST::RelExp>> relExps;
-    std::vector<Token::Type> operators;
-    relExps.emplace_back(parseRelExp());
+const AST::EqExp *Parser::parseEqExp() {
+    Utils::SmallVector<const AST::RelExp *, 4> relExps;
+    Utils::SmallVector<Token::Type, 4> operators;
+    relExps.push_back(parseRelExp());
     while (match(Token::Type::EQ, Token::Type::NE)) {
-        operators.emplace_back(next(-1).type);
-        relExps.emplace_back(parseRelExp());
+        operators.push_back(next(-1).type);
+        relExps.push_back(parseRelExp());
     }
-    return std::make_shared<AST::EqExp>(relExps, operators);
+    return arena.create<AST::EqExp>(arena.list(relExps), arena.list(operators));
 }
 
-std::shared_ptr<AST::LAndExp> Parser::parseLAndExp() {
-    std::vector<std::shared_ptr<AST::EqExp>> eqExps;
+const AST::LAndExp *Parser::parseLAndExp() {
+    Utils::SmallVector<const AST::EqExp *, 4> eqExps;
     do {
-        eqExps.emplace_back(parseEqExp());
+        eqExps.push_back(parseEqExp());
     } while (match(Token::Type::AND));
-    return std::make_shared<AST::LAndExp>(eqExps);
+    return arena.create<AST::LAndExp>(arena.list(eqExps));
 }
 
-std::shared_ptr<AST::LOrExp> Parser::parseLOrExp() {
-    std::vector<std::shared_ptr<AST::LAndExp>> lAndExps;
+const AST::LOrExp *Parser::parseLOrExp() {
+    Utils::SmallVector<const AST::LAndExp *, 4> lAndExps;
     do {
-        lAndExps.emplace_back(parseLAndExp());
+        lAndExps.push_back(parseLAndExp());
     } while (match(Token::Type::OR));
-    return std::make_shared<AST::LOrExp>(lAndExps);
+    return arena.create<AST::LOrExp>(arena.list(lAndExps));
 }
 
-std::shared_ptr<AST::ConstExp> Parser::parseConstExp() {
-    std::shared_ptr<AST::AddExp> addExp = parseAddExp();
-    return std::make_shared<AST::ConstExp>(addExp);
+const AST::ConstExp *Parser::parseConstExp() {
+    const AST::AddExp *addExp = parseAddExp();
+    return arena.create<AST::ConstExp>(addExp);
 }
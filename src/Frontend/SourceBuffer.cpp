@@ -0,0 +1,45 @@
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Frontend/SourceBuffer.h"
+#include "Utils/Log.h"
+
+SourceBuffer::SourceBuffer(const std::string &path) {
+    if (const int fd = open(path.c_str(), O_RDONLY); fd >= 0) {
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            if (void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0); mapping != MAP_FAILED) {
+                // 词法分析只顺序扫描一遍
+                madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+                mapping_ = mapping;
+                data_ = static_cast<const char *>(mapping);
+                size_ = static_cast<size_t>(st.st_size);
+            }
+        }
+        close(fd);
+        if (mapping_ != nullptr) {
+            return;
+        }
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        log_fatal("Could not open file %s: %s", path.c_str(), strerror(errno));
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    fallback_ = buffer.str();
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+}
+
+SourceBuffer::~SourceBuffer() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, size_);
+    }
+}
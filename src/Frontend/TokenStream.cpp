@@ -0,0 +1,32 @@
+#include "Frontend/TokenStream.h"
+
+TokenStream::TokenStream(Lexer &lexer, const size_t capacity) : lexer_{lexer} {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    ring_.assign(size, Token::Token{"", Token::Type::UNKNOWN, 0});
+}
+
+void TokenStream::fill() {
+    if (size_ == ring_.size()) {
+        if (first_ < discardable_) {
+            const size_t count = std::min(discardable_ - first_, size_);
+            first_ += count;
+            size_ -= count;
+        } else {
+            // 回溯期间窗口中的 Token 都不能丢弃
+            grow();
+        }
+    }
+    ring_[(first_ + size_) & (ring_.size() - 1)] = lexer_.next_token();
+    ++size_;
+}
+
+void TokenStream::grow() {
+    std::vector<Token::Token> ring(ring_.size() * 2, Token::Token{"", Token::Type::UNKNOWN, 0});
+    for (size_t index = first_; index < first_ + size_; ++index) {
+        ring[index & (ring.size() - 1)] = ring_[index & (ring_.size() - 1)];
+    }
+    ring_ = std::move(ring);
+}
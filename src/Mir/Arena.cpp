@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+
+#include "Mir/Arena.h"
+#include "Utils/Parallel.h"
+
+namespace Mir {
+Arena *Arena::active_{nullptr};
+
+void *Arena::bump(const size_t size, const size_t align) {
+    auto aligned = reinterpret_cast<std::byte *>((reinterpret_cast<uintptr_t>(cursor_) + align - 1) & ~(align - 1));
+    if (cursor_ == nullptr || aligned + size > limit_) {
+        const size_t bytes = std::max(chunk_size, size + align);
+        chunks_.emplace_back(new std::byte[bytes]);
+        cursor_ = chunks_.back().get();
+        limit_ = cursor_ + bytes;
+        statistics_.bytes_reserved += bytes;
+        ++statistics_.chunks;
+        aligned = reinterpret_cast<std::byte *>((reinterpret_cast<uintptr_t>(cursor_) + align - 1) & ~(align - 1));
+    }
+    cursor_ = aligned + size;
+    return aligned;
+}
+
+void *Arena::allocate(const size_t size, const size_t align) {
+    const Utils::ParallelLock lock{mutex_};
+    ++statistics_.allocations;
+    statistics_.peak_live = std::max(statistics_.peak_live, ++statistics_.live);
+    if (size <= max_small_size && align <= granularity) [[likely]] {
+        const auto index{size_class(size)};
+        statistics_.bytes_allocated += index * granularity;
+        if (const auto node{free_lists_[index]}) {
+            free_lists_[index] = node->next;
+            ++statistics_.reused;
+            return node;
+        }
+        return bump(index * granularity, granularity);
+    }
+    statistics_.bytes_allocated += size;
+    return bump(size, std::max(align, granularity));
+}
+
+void Arena::deallocate(void *ptr, const size_t size) noexcept {
+    bool last;
+    {
+        const Utils::ParallelLock lock{mutex_};
+        ++statistics_.deallocations;
+        --statistics_.live;
+        if (size <= max_small_size) [[likely]] {
+            const auto index{size_class(size)};
+            free_lists_[index] = new (ptr) FreeNode{free_lists_[index]};
+        }
+        last = orphaned_ && statistics_.live == 0;
+    }
+    if (last) {
+        delete this;
+    }
+}
+
+void Arena::release() noexcept {
+    if (active_ == this) {
+        active_ = nullptr;
+    }
+    if (statistics_.live == 0) {
+        delete this;
+    } else {
+        orphaned_ = true;
+    }
+}
+
+std::string Arena::statistics_string() const {
+    std::ostringstream oss;
+    oss << "arena.allocations " << statistics_.allocations << "\n"
+        << "arena.reused " << statistics_.reused << "\n"
+        << "arena.deallocations " << statistics_.deallocations << "\n"
+        << "arena.live " << statistics_.live << "\n"
+        << "arena.peak_live " << statistics_.peak_live << "\n"
+        << "arena.bytes_allocated " << statistics_.bytes_allocated << "\n"
+        << "arena.bytes_reserved " << statistics_.bytes_reserved << "\n"
+        << "arena.chunks " << statistics_.chunks;
+    return oss.str();
+}
+} // namespace Mir
@@ -10,16 +10,16 @@
 #include <unordered_set>
 
 namespace Mir {
-size_t Builder::block_count{0}, Builder::variable_count{0};
+NameCounter Builder::module_count;
 
-[[nodiscard]] std::shared_ptr<Module> &Builder::visit(const std::shared_ptr<AST::CompUnit> &ast) {
+[[nodiscard]] std::shared_ptr<Module> &Builder::visit(const AST::CompUnit *ast) {
     for (const auto &unit: ast->compunits()) {
-        if (std::holds_alternative<std::shared_ptr<AST::Decl>>(unit)) {
+        if (std::holds_alternative<const AST::Decl *>(unit)) {
             is_global = true;
-            visit_decl(std::get<std::shared_ptr<AST::Decl>>(unit));
+            visit_decl(std::get<const AST::Decl *>(unit));
             is_global = false;
-        } else if (std::holds_alternative<std::shared_ptr<AST::FuncDef>>(unit)) {
-            visit_funcDef(std::get<std::shared_ptr<AST::FuncDef>>(unit));
+        } else if (std::holds_alternative<const AST::FuncDef *>(unit)) {
+            visit_funcDef(std::get<const AST::FuncDef *>(unit));
         }
     }
     // 释放不必要的引用计数
@@ -32,23 +32,24 @@ size_t Builder::block_count{0}, Builder::variable_count{0};
     return module;
 }
 
-void Builder::visit_decl(const std::shared_ptr<AST::Decl> &decl) const {
-    if (const auto &constDecl = std::dynamic_pointer_cast<AST::ConstDecl>(decl)) {
+void Builder::visit_decl(const AST::Decl *decl) const {
+    if (const auto &constDecl = dynamic_cast<const AST::ConstDecl *>(decl)) {
         visit_constDecl(constDecl);
-    } else if (const auto &varDecl = std::dynamic_pointer_cast<AST::VarDecl>(decl)) {
+    } else if (const auto &varDecl = dynamic_cast<const AST::VarDecl *>(decl)) {
         visit_varDecl(varDecl);
     } else {
         log_fatal("unknown decl type");
     }
 }
 
-void Builder::visit_constDecl(const std::shared_ptr<AST::ConstDecl> &constDecl) const {
+void Builder::visit_constDecl(const AST::ConstDecl *constDecl) const {
     for (const auto &constDef: constDecl->constDefs()) {
         visit_constDef(constDecl->bType(), constDef);
     }
 }
 
-void Builder::visit_constDef(const Token::Type type, const std::shared_ptr<AST::ConstDef> &constDef) const {
+void Builder::visit_constDef(const Token::Type type, const AST::ConstDef *constDef) const {
+    const std::string ident{constDef->ident()};
     auto ir_type = Type::get_type(type);
     if (ir_type->is_void()) {
         log_error("Cannot define a void variable");
@@ -73,7 +74,7 @@ void Builder::visit_constDef(const Token::Type type, const std::shared_ptr<AST::
         if (constInitVal->is_constInitVals()) {
             log_fatal("Variable cannot be initialized as an array");
         }
-        const auto constExp = std::get<std::shared_ptr<AST::ConstExp>>(constInitVal->get_value());
+        const auto constExp = std::get<const AST::ConstExp *>(constInitVal->get_value());
         init_value = Init::Constant::create_constant_init_value(ir_type, constExp->addExp(), table);
     } else if (ir_type->is_array()) {
         if (constInitVal->is_constExp()) {
@@ -85,7 +86,7 @@ void Builder::visit_constDef(const Token::Type type, const std::shared_ptr<AST::
     }
     std::shared_ptr<Value> address = nullptr;
     if (is_global) {
-        const auto &gv = std::make_shared<GlobalVariable>(constDef->ident(), ir_type, true, init_value);
+        const auto &gv = make_ir<GlobalVariable>(ident, ir_type, true, init_value);
         module->add_global_variable(gv);
         address = gv;
     } else {
@@ -97,16 +98,17 @@ void Builder::visit_constDef(const Token::Type type, const std::shared_ptr<AST::
             std::static_pointer_cast<Init::Array>(init_value)->gen_store_inst(address, cur_block, dimensions);
         }
     }
-    table->insert_symbol(constDef->ident(), ir_type, init_value, address, true, false, false, constDef->lineno());
+    table->insert_symbol(ident, ir_type, init_value, address, true, false, false, constDef->lineno());
 }
 
-void Builder::visit_varDecl(const std::shared_ptr<AST::VarDecl> &varDecl) const {
+void Builder::visit_varDecl(const AST::VarDecl *varDecl) const {
     for (const auto &varDef: varDecl->varDefs()) {
         visit_varDef(varDecl->bType(), varDef);
     }
 }
 
-void Builder::visit_varDef(const Token::Type type, const std::shared_ptr<AST::VarDef> &varDef) const {
+void Builder::visit_varDef(const Token::Type type, const AST::VarDef *varDef) const {
+    const std::string ident{varDef->ident()};
     auto ir_type = Type::get_type(type);
     if (ir_type->is_void()) {
         log_error("Cannot define a void variable");
@@ -130,7 +132,7 @@ void Builder::visit_varDef(const Token::Type type, const std::shared_ptr<AST::Va
             if (initVal->is_initVals()) {
                 log_fatal("Variable cannot be initialized as an array");
             }
-            const auto exp = std::get<std::shared_ptr<AST::Exp>>(initVal->get_value());
+            const auto exp = std::get<const AST::Exp *>(initVal->get_value());
             if (is_global) {
                 init_value = Init::Constant::create_constant_init_value(ir_type, exp->addExp(), table);
             } else {
@@ -157,7 +159,7 @@ void Builder::visit_varDef(const Token::Type type, const std::shared_ptr<AST::Va
     }
     std::shared_ptr<Value> address = nullptr;
     if (is_global) {
-        const auto &gv = std::make_shared<GlobalVariable>(varDef->ident(), ir_type, false, init_value);
+        const auto &gv = make_ir<GlobalVariable>(ident, ir_type, false, init_value);
         module->add_global_variable(gv);
         address = gv;
         // 在控制流不明确的情况下，无法确定变量是否被修改
@@ -172,12 +174,12 @@ void Builder::visit_varDef(const Token::Type type, const std::shared_ptr<AST::Va
             std::static_pointer_cast<Init::Exp>(init_value)->gen_store_inst(address, cur_block);
         }
     }
-    table->insert_symbol(varDef->ident(), ir_type, init_value, address, false, is_global, false, varDef->lineno());
+    table->insert_symbol(ident, ir_type, init_value, address, false, is_global, false, varDef->lineno());
 }
 
-void Builder::visit_funcDef(const std::shared_ptr<AST::FuncDef> &funcDef) {
+void Builder::visit_funcDef(const AST::FuncDef *funcDef) {
     const auto &ir_type = Type::get_type(funcDef->funcType());
-    const auto &ident = funcDef->ident();
+    const std::string ident{funcDef->ident()};
     // 检查标识符是否重定义，是否与库函数重名
     if (table->lookup_in_current_scope(ident)) {
         log_error("Redefinition of %s", ident.c_str());
@@ -206,17 +208,17 @@ void Builder::visit_funcDef(const std::shared_ptr<AST::FuncDef> &funcDef) {
         }
     }
     // 创建llvm Function和第一个block，记作entry block
-    const auto func = std::make_shared<Function>(ident, ir_type);
+    const auto func = make_ir<Function>(ident, ir_type);
     cur_function = func;
     module->add_function(func);
-    // 清零变量计数器、基本块计数器
-    reset_count();
+    // 函数体内的名字从该函数自己的计数器开始编号
+    const NameScope name_scope{*func};
     // 创建第一个block
     const auto entry_block = Block::create(gen_block_name(), func);
     cur_block = entry_block;
     for (size_t i = 0; i < arguments.size(); ++i) {
         auto &[ident, ir_type] = arguments[i];
-        const auto argument = std::make_shared<Argument>(gen_variable_name(), ir_type, i);
+        const auto argument = make_ir<Argument>(gen_variable_name(), ir_type, i);
         func->add_argument(argument);
     }
     for (size_t i = 0; i < arguments.size(); ++i) {
@@ -275,7 +277,7 @@ void Builder::visit_funcDef(const std::shared_ptr<AST::FuncDef> &funcDef) {
         }
         const auto last_instruction = instructions.back();
         if (const auto op = last_instruction->get_op(); op == Operator::JUMP) {
-            self(self, last_instruction->as<Jump>()->get_target_block());
+            self(self, last_instruction->as_ptr<Jump>()->get_target_block());
         } else if (op == Operator::BRANCH) {
             const auto branch = last_instruction->as<Branch>();
             self(self, branch->get_true_block());
@@ -304,9 +306,9 @@ void Builder::visit_funcDef(const std::shared_ptr<AST::FuncDef> &funcDef) {
 }
 
 std::pair<std::string, std::shared_ptr<Type::Type>>
-Builder::visit_funcFParam(const std::shared_ptr<AST::FuncFParam> &funcFParam) const {
+Builder::visit_funcFParam(const AST::FuncFParam *funcFParam) const {
     auto ir_type = Type::get_type(funcFParam->bType());
-    const auto &ident = funcFParam->ident();
+    const std::string ident{funcFParam->ident()};
     if (funcFParam->exps().empty()) {
         return {ident, ir_type};
     }
@@ -328,23 +330,23 @@ Builder::visit_funcFParam(const std::shared_ptr<AST::FuncFParam> &funcFParam) co
     return {ident, Type::Pointer::create(ir_type)};
 }
 
-void Builder::visit_block(const std::shared_ptr<AST::Block> &block) {
+void Builder::visit_block(const AST::Block *block) {
     for (const auto &item: block->items()) {
-        if (std::holds_alternative<std::shared_ptr<AST::Decl>>(item)) {
-            visit_decl(std::get<std::shared_ptr<AST::Decl>>(item));
-        } else if (std::holds_alternative<std::shared_ptr<AST::Stmt>>(item)) {
-            visit_stmt(std::get<std::shared_ptr<AST::Stmt>>(item));
+        if (std::holds_alternative<const AST::Decl *>(item)) {
+            visit_decl(std::get<const AST::Decl *>(item));
+        } else if (std::holds_alternative<const AST::Stmt *>(item)) {
+            visit_stmt(std::get<const AST::Stmt *>(item));
         } else {
             log_fatal("Unknown item type");
         }
     }
 }
 
-std::shared_ptr<Value> Builder::visit_exp(const std::shared_ptr<AST::Exp> &exp) const {
+std::shared_ptr<Value> Builder::visit_exp(const AST::Exp *exp) const {
     return visit_addExp(exp->addExp());
 }
 
-std::shared_ptr<Value> Builder::visit_addExp(const std::shared_ptr<AST::AddExp> &addExp) const {
+std::shared_ptr<Value> Builder::visit_addExp(const AST::AddExp *addExp) const {
     const auto &mul_exps = addExp->mulExps();
     auto lhs = visit_mulExp(mul_exps[0]);
     for (size_t i = 1; i < mul_exps.size(); ++i) {
@@ -371,7 +373,7 @@ std::shared_ptr<Value> Builder::visit_addExp(const std::shared_ptr<AST::AddExp>
     return lhs;
 }
 
-std::shared_ptr<Value> Builder::visit_mulExp(const std::shared_ptr<AST::MulExp> &mulExp) const {
+std::shared_ptr<Value> Builder::visit_mulExp(const AST::MulExp *mulExp) const {
     const auto &unary_exps = mulExp->unaryExps();
     auto lhs = visit_unaryExp(unary_exps[0]);
     for (size_t i = 1; i < unary_exps.size(); ++i) {
@@ -404,23 +406,24 @@ std::shared_ptr<Value> Builder::visit_mulExp(const std::shared_ptr<AST::MulExp>
 
 std::shared_ptr<Value> Builder::visit_functionCall(const AST::UnaryExp::call &call) const {
     const auto &[ident, params] = call;
-    auto func = module->get_function(ident.content);
+    const std::string name{ident.content};
+    auto func = module->get_function(name);
     if (!func) {
-        if (const auto it = Function::sysy_runtime_functions.find(ident.content);
+        if (const auto it = Function::sysy_runtime_functions.find(name);
             it != Function::sysy_runtime_functions.end()) {
             func = it->second;
             module->add_used_runtime_functions(func);
         } else {
-            log_error("Unknown function: %s", ident.content.c_str());
+            log_error("Unknown function: %s", name.c_str());
         }
     }
     // 实参列表
     std::vector<std::shared_ptr<Value>> r_params;
-    if (ident.content == "starttime" || ident.content == "stoptime") {
+    if (name == "starttime" || name == "stoptime") {
         r_params.emplace_back(ConstInt::create(ident.line));
         return Call::create(func, r_params, cur_block);
     }
-    if (ident.content == "putf") {
+    if (name == "putf") {
         if (!params[0]->is_const_string()) {
             log_fatal("First parameter of putf must be a const string");
         }
@@ -431,12 +434,12 @@ std::shared_ptr<Value> Builder::visit_functionCall(const AST::UnaryExp::call &ca
             }
             r_params.emplace_back(visit_exp(params[i]));
         }
-        module->add_const_string(const_string);
+        module->add_const_string(std::string{const_string});
         return Call::create(func, r_params, cur_block, static_cast<int>(module->get_const_string_size()));
     }
     const auto &arguments = func->get_arguments();
     if (params.size() != arguments.size()) {
-        log_error("Function %s has %zu arguments, but %zu parameters are provided at line %d", ident.content.c_str(),
+        log_error("Function %s has %zu arguments, but %zu parameters are provided at line %d", name.c_str(),
                   arguments.size(), params.size(), ident.line);
     }
     for (size_t i = 0; i < params.size(); ++i) {
@@ -459,9 +462,9 @@ std::shared_ptr<Value> Builder::visit_functionCall(const AST::UnaryExp::call &ca
     return Call::create(gen_variable_name(), func, r_params, cur_block);
 }
 
-std::shared_ptr<Value> Builder::visit_unaryExp(const std::shared_ptr<AST::UnaryExp> &unaryExp) const {
+std::shared_ptr<Value> Builder::visit_unaryExp(const AST::UnaryExp *unaryExp) const {
     if (unaryExp->is_primaryExp()) {
-        return visit_primaryExp(std::get<std::shared_ptr<AST::PrimaryExp>>(unaryExp->get_value()));
+        return visit_primaryExp(std::get<const AST::PrimaryExp *>(unaryExp->get_value()));
     }
     if (unaryExp->is_call()) {
         return visit_functionCall(std::get<AST::UnaryExp::call>(unaryExp->get_value()));
@@ -496,31 +499,31 @@ std::shared_ptr<Value> Builder::visit_unaryExp(const std::shared_ptr<AST::UnaryE
     log_fatal("Invalid unaryExp");
 }
 
-std::shared_ptr<Value> Builder::visit_primaryExp(const std::shared_ptr<AST::PrimaryExp> &primaryExp) const {
+std::shared_ptr<Value> Builder::visit_primaryExp(const AST::PrimaryExp *primaryExp) const {
     if (primaryExp->is_number()) {
-        return visit_number(std::get<std::shared_ptr<AST::Number>>(primaryExp->get_value()));
+        return visit_number(std::get<const AST::Number *>(primaryExp->get_value()));
     }
     if (primaryExp->is_lVal()) {
-        return visit_lVal(std::get<std::shared_ptr<AST::LVal>>(primaryExp->get_value()));
+        return visit_lVal(std::get<const AST::LVal *>(primaryExp->get_value()));
     }
     if (primaryExp->is_exp()) {
-        return visit_exp(std::get<std::shared_ptr<AST::Exp>>(primaryExp->get_value()));
+        return visit_exp(std::get<const AST::Exp *>(primaryExp->get_value()));
     }
     log_fatal("Invalid primaryExp");
 }
 
-std::shared_ptr<Value> Builder::visit_number(const std::shared_ptr<AST::Number> &number) {
-    if (const auto &num = std::dynamic_pointer_cast<AST::FloatNumber>(number)) {
+std::shared_ptr<Value> Builder::visit_number(const AST::Number *number) {
+    if (const auto &num = dynamic_cast<const AST::FloatNumber *>(number)) {
         return ConstFloat::create(num->get_value());
     }
-    if (const auto &num = std::dynamic_pointer_cast<AST::IntNumber>(number)) {
+    if (const auto &num = dynamic_cast<const AST::IntNumber *>(number)) {
         return ConstInt::create(num->get_value());
     }
     log_fatal("Invalid number");
 }
 
-std::shared_ptr<Value> Builder::visit_lVal(const std::shared_ptr<AST::LVal> &lVal, const bool get_address) const {
-    const auto &ident = lVal->ident();
+std::shared_ptr<Value> Builder::visit_lVal(const AST::LVal *lVal, const bool get_address) const {
+    const std::string ident{lVal->ident()};
     const auto symbol = table->lookup_in_all_scopes(ident);
     if (!symbol) {
         log_error("Undefined variable: %s", ident.c_str());
@@ -585,7 +588,7 @@ std::shared_ptr<Value> Builder::visit_lVal(const std::shared_ptr<AST::LVal> &lVa
             std::vector<int> int_indexes;
             int_indexes.reserve(indexes.size());
             for (const auto &idx: indexes) {
-                int_indexes.push_back(idx->as<ConstInt>()->get<int>());
+                int_indexes.push_back(idx->as_ptr<ConstInt>()->get<int>());
             }
             initial = array_init->get_init_value(int_indexes);
             if (const auto constant_initial = std::dynamic_pointer_cast<Init::Constant>(initial)) {
@@ -628,12 +631,12 @@ std::shared_ptr<Value> Builder::visit_lVal(const std::shared_ptr<AST::LVal> &lVa
     log_fatal("Invalid lVal");
 }
 
-void Builder::visit_cond(const std::shared_ptr<AST::Cond> &cond, const std::shared_ptr<Block> &_then,
+void Builder::visit_cond(const AST::Cond *cond, const std::shared_ptr<Block> &_then,
                          const std::shared_ptr<Block> &_else) {
     visit_lOrExp(cond->lOrExp(), _then, _else);
 }
 
-void Builder::visit_lOrExp(const std::shared_ptr<AST::LOrExp> &lOrExp, const std::shared_ptr<Block> &_then,
+void Builder::visit_lOrExp(const AST::LOrExp *lOrExp, const std::shared_ptr<Block> &_then,
                            const std::shared_ptr<Block> &_else) {
     const auto &lAndExps = lOrExp->lAndExps();
     for (size_t i = 0; i < lAndExps.size(); ++i) {
@@ -648,7 +651,7 @@ void Builder::visit_lOrExp(const std::shared_ptr<AST::LOrExp> &lOrExp, const std
     }
 }
 
-void Builder::visit_lAndExp(const std::shared_ptr<AST::LAndExp> &lAndExp, const std::shared_ptr<Block> &_then,
+void Builder::visit_lAndExp(const AST::LAndExp *lAndExp, const std::shared_ptr<Block> &_then,
                             const std::shared_ptr<Block> &_else) {
     const auto &eqExps = lAndExp->eqExps();
     for (size_t i = 0; i < eqExps.size(); ++i) {
@@ -665,7 +668,7 @@ void Builder::visit_lAndExp(const std::shared_ptr<AST::LAndExp> &lAndExp, const
     }
 }
 
-std::shared_ptr<Value> Builder::visit_eqExp(const std::shared_ptr<AST::EqExp> &eqExp) const {
+std::shared_ptr<Value> Builder::visit_eqExp(const AST::EqExp *eqExp) const {
     const auto &relExps = eqExp->relExps();
     auto lhs = visit_relExp(relExps[0]);
     for (size_t i = 1; i < relExps.size(); ++i) {
@@ -693,7 +696,7 @@ std::shared_ptr<Value> Builder::visit_eqExp(const std::shared_ptr<AST::EqExp> &e
     return lhs;
 }
 
-std::shared_ptr<Value> Builder::visit_relExp(const std::shared_ptr<AST::RelExp> &relExp) const {
+std::shared_ptr<Value> Builder::visit_relExp(const AST::RelExp *relExp) const {
     const auto &addExps = relExp->addExps();
     auto lhs = visit_addExp(addExps[0]);
     for (size_t i = 1; i < addExps.size(); ++i) {
@@ -729,42 +732,43 @@ std::shared_ptr<Value> Builder::visit_relExp(const std::shared_ptr<AST::RelExp>
     return lhs;
 }
 
-void Builder::visit_stmt(const std::shared_ptr<AST::Stmt> &stmt) {
-    if (const auto blockStmt = std::dynamic_pointer_cast<AST::BlockStmt>(stmt)) {
+void Builder::visit_stmt(const AST::Stmt *stmt) {
+    if (const auto blockStmt = dynamic_cast<const AST::BlockStmt *>(stmt)) {
         visit_blockStmt(blockStmt);
-    } else if (const auto assignStmt = std::dynamic_pointer_cast<AST::AssignStmt>(stmt)) {
+    } else if (const auto assignStmt = dynamic_cast<const AST::AssignStmt *>(stmt)) {
         visit_assignStmt(assignStmt);
-    } else if (const auto expStmt = std::dynamic_pointer_cast<AST::ExpStmt>(stmt)) {
+    } else if (const auto expStmt = dynamic_cast<const AST::ExpStmt *>(stmt)) {
         visit_expStmt(expStmt);
-    } else if (const auto returnStmt = std::dynamic_pointer_cast<AST::ReturnStmt>(stmt)) {
+    } else if (const auto returnStmt = dynamic_cast<const AST::ReturnStmt *>(stmt)) {
         visit_returnStmt(returnStmt);
-    } else if (const auto ifStmt = std::dynamic_pointer_cast<AST::IfStmt>(stmt)) {
+    } else if (const auto ifStmt = dynamic_cast<const AST::IfStmt *>(stmt)) {
         visit_ifStmt(ifStmt);
-    } else if (const auto whileStmt = std::dynamic_pointer_cast<AST::WhileStmt>(stmt)) {
+    } else if (const auto whileStmt = dynamic_cast<const AST::WhileStmt *>(stmt)) {
         visit_whileStmt(whileStmt);
-    } else if (auto breakStmt = std::dynamic_pointer_cast<AST::BreakStmt>(stmt)) {
+    } else if (dynamic_cast<const AST::BreakStmt *>(stmt)) {
         visit_breakStmt();
-    } else if (auto continueStmt = std::dynamic_pointer_cast<AST::ContinueStmt>(stmt)) {
+    } else if (dynamic_cast<const AST::ContinueStmt *>(stmt)) {
         visit_continueStmt();
     } else {
         log_fatal("Invalid stmt type");
     }
 }
 
-void Builder::visit_blockStmt(const std::shared_ptr<AST::BlockStmt> &blockStmt) {
+void Builder::visit_blockStmt(const AST::BlockStmt *blockStmt) {
     table->push_scope();
     visit_block(blockStmt->block());
     table->pop_scope();
 }
 
 
-void Builder::visit_assignStmt(const std::shared_ptr<AST::AssignStmt> &assignStmt) const {
-    const auto symbol = table->lookup_in_all_scopes(assignStmt->lVal()->ident());
+void Builder::visit_assignStmt(const AST::AssignStmt *assignStmt) const {
+    const std::string ident{assignStmt->lVal()->ident()};
+    const auto symbol = table->lookup_in_all_scopes(ident);
     if (!symbol) {
-        log_error("Undefined variable: %s", assignStmt->lVal()->ident().c_str());
+        log_error("Undefined variable: %s", ident.c_str());
     }
     if (symbol->is_constant_symbol()) {
-        log_error("Cannot assign to constant variable: %s", assignStmt->lVal()->ident().c_str());
+        log_error("Cannot assign to constant variable: %s", ident.c_str());
     }
     const auto exp_value = visit_exp(assignStmt->exp());
     const auto address = visit_lVal(assignStmt->lVal(), true);
@@ -779,14 +783,14 @@ void Builder::visit_assignStmt(const std::shared_ptr<AST::AssignStmt> &assignStm
     Store::create(address, casted_exp_value, cur_block);
 }
 
-void Builder::visit_expStmt(const std::shared_ptr<AST::ExpStmt> &expStmt) const {
+void Builder::visit_expStmt(const AST::ExpStmt *expStmt) const {
     if (const auto exp = expStmt->exp()) {
         // ReSharper disable once CppExpressionWithoutSideEffects
         visit_exp(exp);
     }
 }
 
-void Builder::visit_returnStmt(const std::shared_ptr<AST::ReturnStmt> &returnStmt) const {
+void Builder::visit_returnStmt(const AST::ReturnStmt *returnStmt) const {
     if (const auto exp = returnStmt->exp()) {
         if (cur_function->get_return_type()->is_void()) {
             log_error("Cannot return value in void function");
@@ -802,7 +806,7 @@ void Builder::visit_returnStmt(const std::shared_ptr<AST::ReturnStmt> &returnStm
     }
 }
 
-void Builder::visit_ifStmt(const std::shared_ptr<AST::IfStmt> &ifStmt) {
+void Builder::visit_ifStmt(const AST::IfStmt *ifStmt) {
     const auto then_block = Block::create(gen_block_name(), cur_function);
     cond_stats.emplace_back(ifStmt->cond());
     if (const auto else_stmt = ifStmt->_else()) {
@@ -827,7 +831,7 @@ void Builder::visit_ifStmt(const std::shared_ptr<AST::IfStmt> &ifStmt) {
     cond_stats.pop_back();
 }
 
-void Builder::visit_whileStmt(const std::shared_ptr<AST::WhileStmt> &whileStmt) {
+void Builder::visit_whileStmt(const AST::WhileStmt *whileStmt) {
     auto cond_block = Block::create(gen_block_name(), cur_function),
          body_block = Block::create(gen_block_name(), cur_function),
          follow_block = Block::create(gen_block_name(), cur_function);
@@ -5,13 +5,13 @@
 #include <unordered_map>
 
 namespace Mir::Type {
-const std::shared_ptr<Integer> Integer::i1 = std::make_shared<Integer>(1);
-const std::shared_ptr<Integer> Integer::i8 = std::make_shared<Integer>(8);
-const std::shared_ptr<Integer> Integer::i32 = std::make_shared<Integer>(32);
-const std::shared_ptr<Integer> Integer::i64 = std::make_shared<Integer>(64);
-const std::shared_ptr<Float> Float::f32 = std::make_shared<Float>();
-const std::shared_ptr<Void> Void::void_ = std::make_shared<Void>();
-const std::shared_ptr<Label> Label::label = std::make_shared<Label>();
+const std::shared_ptr<Integer> Integer::i1 = std::shared_ptr<Integer>(new Integer(1));
+const std::shared_ptr<Integer> Integer::i8 = std::shared_ptr<Integer>(new Integer(8));
+const std::shared_ptr<Integer> Integer::i32 = std::shared_ptr<Integer>(new Integer(32));
+const std::shared_ptr<Integer> Integer::i64 = std::shared_ptr<Integer>(new Integer(64));
+const std::shared_ptr<Float> Float::f32 = std::shared_ptr<Float>(new Float());
+const std::shared_ptr<Void> Void::void_ = std::shared_ptr<Void>(new Void());
+const std::shared_ptr<Label> Label::label = std::shared_ptr<Label>(new Label());
 } // namespace Mir::Type
 
 namespace Mir {
@@ -41,4 +41,5 @@ const std::unordered_map<std::string, std::shared_ptr<Function>> Function::llvm_
 };
 
 std::shared_ptr<Module> Module::instance_ = nullptr;
+bool Module::arena_enabled_ = true;
 } // namespace Mir
@@ -1,110 +1,77 @@
-#include <unordered_map>
+#include <sstream>
 
 #include "Mir/Const.h"
+#include "Mir/ConstantPool.h"
 
 #include "Utils/SimpleFloat.h"
 
 namespace Mir {
-std::shared_ptr<ConstBool> ConstBool::create(const int value) {
-    const int normalized = value ? 1 : 0;
-
-    struct Key {
-        int value;
-        bool operator==(const Key &other) const { return value == other.value; }
-    };
-
-    struct KeyHash {
-        size_t operator()(const Key &key) const { return std::hash<int>{}(key.value); }
-    };
+ConstantPool *ConstantPool::active_{nullptr};
 
-    static std::unordered_map<Key, std::weak_ptr<ConstBool>, KeyHash> cache;
-    const Key key{normalized};
-
-    if (const auto it = cache.find(key); it != cache.end()) {
-        if (auto existing = it->second.lock()) {
-            return existing;
-        }
+ConstantPool &ConstantPool::active() {
+    if (active_ != nullptr) [[likely]] {
+        return *active_;
     }
-    auto new_const = std::shared_ptr<ConstBool>(new ConstBool(normalized));
-    cache[key] = new_const;
-    return new_const;
+    static ConstantPool global_pool;
+    return global_pool;
 }
 
+std::shared_ptr<Const> &ConstantPool::lookup(const Tag tag, const std::shared_ptr<Type::Type> &type,
+                                             const uint64_t bits) {
+    auto &slot = constants_[{tag, type.get(), bits}];
+    if (slot == nullptr) {
+        ++statistics_.misses;
+    } else {
+        ++statistics_.hits;
+    }
+    return slot;
+}
 
-std::shared_ptr<ConstInt> ConstInt::create(const int value, const std::shared_ptr<Type::Type> &type) {
-    struct Key {
-        int value;
-        std::shared_ptr<Type::Type> type;
-
-        bool operator==(const Key &other) const { return value == other.value && type == other.type; }
-    };
+std::string ConstantPool::statistics_string() const {
+    std::ostringstream oss;
+    oss << "constant_pool.hits " << statistics_.hits << "\n"
+        << "constant_pool.misses " << statistics_.misses << "\n"
+        << "constant_pool.size " << constants_.size();
+    return oss.str();
+}
 
-    struct KeyHash {
-        size_t operator()(const Key &key) const {
-            return std::hash<int>{}(key.value) ^ std::hash<std::shared_ptr<Type::Type>>{}(key.type);
-        }
-    };
+std::shared_ptr<ConstBool> ConstBool::create(const int value) {
+    const int normalized = value ? 1 : 0;
+    const auto constant = ConstantPool::active().intern(ConstantPool::Tag::Bool, Type::Integer::i1, normalized, [&] {
+        return std::shared_ptr<ConstBool>(new ConstBool(normalized));
+    });
+    return std::static_pointer_cast<ConstBool>(constant);
+}
 
+std::shared_ptr<ConstInt> ConstInt::create(const int value, const std::shared_ptr<Type::Type> &type) {
     if (!type->is_integer()) [[unlikely]] {
         log_error("Invalid Integer Type");
     }
-
-    static std::unordered_map<Key, std::weak_ptr<ConstInt>, KeyHash> cache;
-    const Key key{value, type};
-
-    if (const auto it = cache.find(key); it != cache.end()) {
-        if (auto existing = it->second.lock()) {
-            return existing;
-        }
-    }
-    auto new_const = std::shared_ptr<ConstInt>(new ConstInt(value, type));
-    cache[key] = new_const;
-    return new_const;
+    const auto constant = ConstantPool::active().intern(ConstantPool::Tag::Int, type, static_cast<uint32_t>(value), [&] {
+        return std::shared_ptr<ConstInt>(new ConstInt(value, type));
+    });
+    return std::static_pointer_cast<ConstInt>(constant);
 }
 
 std::shared_ptr<ConstFloat> ConstFloat::create(const double value) {
-    uint64_t bits;
-    static_assert(sizeof(value) == sizeof(bits), "Size mismatch");
-    std::memcpy(&bits, &value, sizeof(value));
-
-    struct Key {
-        uint64_t bits;
-        bool operator==(const Key &other) const { return bits == other.bits; }
-    };
-
-    struct KeyHash {
-        size_t operator()(const Key &key) const { return std::hash<uint64_t>{}(key.bits); }
-    };
-
-    static std::unordered_map<Key, std::weak_ptr<ConstFloat>, KeyHash> cache;
-    const Key key{bits};
-
-    if (const auto it = cache.find(key); it != cache.end()) {
-        if (auto existing = it->second.lock()) {
-            return existing;
-        }
-    }
-
+    // 以舍入到单精度后的位模式为键，使舍入后相等的字面量共享同一个常量
     IEEE754_Single::SimpleFloat simple_float;
     simple_float.encode(value);
-
-    auto new_const = std::shared_ptr<ConstFloat>(new ConstFloat(simple_float.to_float()));
-    cache[key] = new_const;
-    return new_const;
+    const auto constant = ConstantPool::active().intern(ConstantPool::Tag::Float, Type::Float::f32,
+                                                        simple_float.bits(), [&] {
+                                                            return std::shared_ptr<ConstFloat>(
+                                                                    new ConstFloat(simple_float.to_float()));
+                                                        });
+    return std::static_pointer_cast<ConstFloat>(constant);
 }
 
 std::shared_ptr<Undef> Undef::create(const std::shared_ptr<Type::Type> &type) {
     if (!(type->is_integer() || type->is_float())) [[unlikely]] {
         log_error("Invalid type: %s", type->to_string().c_str());
     }
-    static std::unordered_map<std::shared_ptr<Type::Type>, std::weak_ptr<Undef>> cache;
-    if (const auto it = cache.find(type); it != cache.end()) {
-        if (auto existing = it->second.lock()) {
-            return existing;
-        }
-    }
-    auto new_const = std::shared_ptr<Undef>(new Undef(type));
-    cache[type] = new_const;
-    return new_const;
+    const auto constant = ConstantPool::active().intern(ConstantPool::Tag::Undef, type, 0, [&] {
+        return std::shared_ptr<Undef>(new Undef(type));
+    });
+    return std::static_pointer_cast<Undef>(constant);
 }
 } // namespace Mir
@@ -7,8 +7,8 @@
 
 using namespace Mir;
 
-eval_t eval_lVal(const std::shared_ptr<AST::LVal> &lVal, const std::shared_ptr<Symbol::Table> &table) {
-    const std::string &ident = lVal->ident();
+eval_t eval_lVal(const AST::LVal *lVal, const std::shared_ptr<Symbol::Table> &table) {
+    const std::string ident{lVal->ident()};
     const auto &symbol = table->lookup_in_all_scopes(ident);
     if (symbol == nullptr) {
         log_fatal("Undefined variable: %s", ident.c_str());
@@ -37,7 +37,7 @@ eval_t eval_lVal(const std::shared_ptr<AST::LVal> &lVal, const std::shared_ptr<S
         if (!constant_value->is_constant()) {
             log_error("Non-constant expression");
         }
-        return constant_value->as<Const>()->get_constant_value();
+        return constant_value->as_ptr<Const>()->get_constant_value();
     }
     if (init_value->is_array_init()) {
         init_value = std::static_pointer_cast<Init::Array>(init_value)->get_init_value(indexes);
@@ -48,7 +48,7 @@ eval_t eval_lVal(const std::shared_ptr<AST::LVal> &lVal, const std::shared_ptr<S
         if (!constant_value->is_constant()) {
             log_error("Non-constant expression");
         }
-        return constant_value->as<Const>()->get_constant_value();
+        return constant_value->as_ptr<Const>()->get_constant_value();
     }
     log_error("Unknown constant type");
 }
@@ -70,43 +70,43 @@ eval_t eval(const eval_t lhs, const eval_t rhs, const Token::Type type) {
     }
 }
 
-eval_t eval_number(const std::shared_ptr<AST::Number> &number) {
-    if (const auto int_number = std::dynamic_pointer_cast<AST::IntNumber>(number)) {
+eval_t eval_number(const AST::Number *number) {
+    if (const auto int_number = dynamic_cast<const AST::IntNumber *>(number)) {
         return eval_t{int_number->get_value()};
     }
-    if (const auto float_number = std::dynamic_pointer_cast<AST::FloatNumber>(number)) {
+    if (const auto float_number = dynamic_cast<const AST::FloatNumber *>(number)) {
         return eval_t{float_number->get_value()};
     }
     log_fatal("Fatal at eval number");
 }
 
-eval_t eval_primaryExp(const std::shared_ptr<AST::PrimaryExp> &primaryExp,
+eval_t eval_primaryExp(const AST::PrimaryExp *primaryExp,
                        const std::shared_ptr<Symbol::Table> &table) {
     if (primaryExp->is_number()) {
-        const auto number = std::get<std::shared_ptr<AST::Number>>(primaryExp->get_value());
+        const auto number = std::get<const AST::Number *>(primaryExp->get_value());
         return eval_number(number);
     }
     if (primaryExp->is_lVal()) {
-        const auto lVal = std::get<std::shared_ptr<AST::LVal>>(primaryExp->get_value());
+        const auto lVal = std::get<const AST::LVal *>(primaryExp->get_value());
         return eval_lVal(lVal, table);
     }
     if (primaryExp->is_exp()) {
-        const auto exp = std::get<std::shared_ptr<AST::Exp>>(primaryExp->get_value());
+        const auto exp = std::get<const AST::Exp *>(primaryExp->get_value());
         return eval_exp(exp->addExp(), table);
     }
     log_fatal("Fatal at eval primaryExp");
 }
 
-eval_t eval_unaryExp(const std::shared_ptr<AST::UnaryExp> &unaryExp, const std::shared_ptr<Symbol::Table> &table) {
+eval_t eval_unaryExp(const AST::UnaryExp *unaryExp, const std::shared_ptr<Symbol::Table> &table) {
     if (unaryExp->is_call()) {
         log_error("Function call cannot be calculated at compile time.");
     }
     if (unaryExp->is_primaryExp()) {
-        const auto primaryExp = std::get<std::shared_ptr<AST::PrimaryExp>>(unaryExp->get_value());
+        const auto primaryExp = std::get<const AST::PrimaryExp *>(unaryExp->get_value());
         return eval_primaryExp(primaryExp, table);
     }
     if (unaryExp->is_opExp()) {
-        using opExp = std::pair<Token::Type, std::shared_ptr<AST::UnaryExp>>;
+        using opExp = std::pair<Token::Type, const AST::UnaryExp *>;
         const auto [op, unary] = std::get<opExp>(unaryExp->get_value());
         const auto val = eval_unaryExp(unary, table);
         switch (op) {
@@ -129,7 +129,7 @@ eval_t eval_unaryExp(const std::shared_ptr<AST::UnaryExp> &unaryExp, const std::
     log_fatal("Fatal at eval unaryExp");
 }
 
-eval_t eval_mulExp(const std::shared_ptr<AST::MulExp> &mulExp, const std::shared_ptr<Symbol::Table> &table) {
+eval_t eval_mulExp(const AST::MulExp *mulExp, const std::shared_ptr<Symbol::Table> &table) {
     eval_t res = eval_unaryExp(mulExp->unaryExps()[0], table);
     for (size_t i = 1; i < mulExp->unaryExps().size(); ++i) {
         const eval_t rhs = eval_unaryExp(mulExp->unaryExps()[i], table);
@@ -138,7 +138,7 @@ eval_t eval_mulExp(const std::shared_ptr<AST::MulExp> &mulExp, const std::shared
     return res;
 }
 
-eval_t eval_addExp(const std::shared_ptr<AST::AddExp> &addExp, const std::shared_ptr<Symbol::Table> &table) {
+eval_t eval_addExp(const AST::AddExp *addExp, const std::shared_ptr<Symbol::Table> &table) {
     eval_t res = eval_mulExp(addExp->mulExps()[0], table);
     for (size_t i = 1; i < addExp->mulExps().size(); ++i) {
         const eval_t rhs = eval_mulExp(addExp->mulExps()[i], table);
@@ -147,6 +147,6 @@ eval_t eval_addExp(const std::shared_ptr<AST::AddExp> &addExp, const std::shared
     return res;
 }
 
-eval_t eval_exp(const std::shared_ptr<AST::AddExp> &exp, const std::shared_ptr<Symbol::Table> &table) {
+eval_t eval_exp(const AST::AddExp *exp, const std::shared_ptr<Symbol::Table> &table) {
     return eval_addExp(exp, table);
 }
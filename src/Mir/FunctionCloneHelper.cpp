@@ -57,11 +57,11 @@ void FunctionCloneHelper::clone_block(const std::shared_ptr<Block> &origin_block
 
 std::shared_ptr<Function> FunctionCloneHelper::clone_function(const std::shared_ptr<Function> &origin_func) {
     current_func = origin_func;
-    auto cloned_function = std::make_shared<Function>(origin_func->get_name() + "_cloned",
+    auto cloned_function = make_ir<Function>(origin_func->get_name() + "_cloned",
                                                       origin_func->get_return_type());
     const auto &origin_arguments{origin_func->get_arguments()};
     for (size_t i{0}; i < origin_arguments.size(); ++i) {
-        const auto cloned_arg = std::make_shared<Argument>("arg" + std::to_string(i),
+        const auto cloned_arg = make_ir<Argument>("arg" + std::to_string(i),
                                                            origin_arguments[i]->get_type(), i);
         value_map.insert({origin_arguments[i], cloned_arg});
         cloned_function->add_argument(cloned_arg);
@@ -91,7 +91,7 @@ std::shared_ptr<Function> FunctionCloneHelper::clone_function(const std::shared_
 #define STD_STRING(s) (std::string{#s})
 
 std::shared_ptr<Instruction> Alloc::clone(FunctionCloneHelper &helper) {
-    return make_noinsert_instruction<Alloc>(STD_STRING(alloc), get_type()->as<Type::Pointer>()->get_contain_type());
+    return make_noinsert_instruction<Alloc>(STD_STRING(alloc), get_type()->as_ptr<Type::Pointer>()->get_contain_type());
 }
 
 std::shared_ptr<Instruction> Load::clone(FunctionCloneHelper &helper) {
@@ -105,7 +105,7 @@ std::shared_ptr<Instruction> Store::clone(FunctionCloneHelper &helper) {
 std::shared_ptr<Instruction> GetElementPtr::clone(FunctionCloneHelper &helper) {
     std::vector<std::shared_ptr<Value>> indexes;
     for (size_t i = 1; i < operands_.size(); ++i) {
-        indexes.push_back(HELPER_VALUE(operands_[i]));
+        indexes.push_back(HELPER_VALUE(get_operand(i)));
     }
     return make_noinsert_instruction<GetElementPtr>(STD_STRING(gep), HELPER_VALUE(get_addr()), indexes);
 }
@@ -1,24 +1,33 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
 #include "Mir/Init.h"
 #include "Mir/Builder.h"
 #include "Mir/Instruction.h"
 #include "Utils/Log.h"
 
 namespace Mir::Init {
-std::shared_ptr<Constant> Constant::create_constant_init_value(const std::shared_ptr<Type::Type> &type,
-                                                               const std::shared_ptr<AST::AddExp> &addExp,
-                                                               const std::shared_ptr<Symbol::Table> &table) {
+std::shared_ptr<Const> Constant::eval_const_value(const std::shared_ptr<Type::Type> &type, const AST::AddExp *addExp,
+                                                  const std::shared_ptr<Symbol::Table> &table) {
     const auto res = eval_exp(addExp, table);
     if (type->is_int32()) {
         const int value = std::visit([](auto &&arg) { return static_cast<int>(arg); }, res);
-        return std::make_shared<Constant>(type, ConstInt::create(value));
+        return ConstInt::create(value);
     }
     if (type->is_float()) {
         const double value = std::visit([](auto &&arg) { return static_cast<double>(arg); }, res);
-        return std::make_shared<Constant>(type, ConstFloat::create(value));
+        return ConstFloat::create(value);
     }
     log_error("Illegal type: %s", type->to_string().c_str());
 }
 
+std::shared_ptr<Constant> Constant::create_constant_init_value(const std::shared_ptr<Type::Type> &type,
+                                                               const AST::AddExp *addExp,
+                                                               const std::shared_ptr<Symbol::Table> &table) {
+    return std::make_shared<Constant>(type, eval_const_value(type, addExp, table));
+}
+
 std::shared_ptr<Constant> Constant::create_zero_constant_init_value(const std::shared_ptr<Type::Type> &type) {
     if (type->is_int32()) {
         return std::make_shared<Constant>(type, ConstInt::create(0));
@@ -37,12 +46,51 @@ std::shared_ptr<Init> Exp::create_exp_init_value(const std::shared_ptr<Type::Typ
     return std::make_shared<Exp>(type, exp_value);
 }
 
-[[nodiscard]] std::shared_ptr<Init> Array::get_init_value(const std::vector<int> &indexes) {
+std::vector<Array::Run>::const_iterator Array::find_run(const size_t offset) const {
+    // 各段互不重叠，end() 与 offset 同样升序
+    return std::partition_point(runs.begin(), runs.end(), [offset](const Run &run) { return run.end() <= offset; });
+}
+
+bool Array::has_value_in(const size_t begin, const size_t end) const {
+    const auto it = find_run(begin);
+    return it != runs.end() && it->offset < end;
+}
+
+namespace {
+// 只有按位为零的常量才能省略：ConstFloat::is_zero 带有容差，会把极小的非零浮点数当作零
+bool is_exact_zero(const std::shared_ptr<Value> &value) {
+    if (!value->is_constant()) {
+        return false;
+    }
+    if (const auto const_float = std::dynamic_pointer_cast<ConstFloat>(value)) {
+        const auto f = static_cast<float>(**const_float);
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(f));
+        return bits == 0;
+    }
+    if (const auto const_int = std::dynamic_pointer_cast<ConstInt>(value)) {
+        return **const_int == 0;
+    }
+    return false;
+}
+} // namespace
+
+void Array::append(std::vector<Run> &runs, const size_t offset, const std::shared_ptr<Value> &value) {
+    if (is_exact_zero(value)) {
+        return;
+    }
+    if (runs.empty() || runs.back().end() != offset) {
+        runs.push_back(Run{offset, {}});
+    }
+    runs.back().values.push_back(value);
+}
+
+size_t Array::flat_index(const std::vector<int> &indexes) const {
     if (!type->is_array()) {
         log_error("Illegal type: %s", type->to_string().c_str());
     }
     auto current_type = type;
-    size_t dim_count = 0;
+    size_t dim_count = 0, offset = 0;
     while (current_type->is_array()) {
         const auto arr_type = std::static_pointer_cast<Type::Array>(current_type);
         if (dim_count >= indexes.size())
@@ -51,32 +99,30 @@ std::shared_ptr<Init> Exp::create_exp_init_value(const std::shared_ptr<Type::Typ
             log_error("Index out of range[%zu]: [0, %zu) vs %d", dim_count, arr_type->get_size(), indexes[dim_count]);
         }
         current_type = arr_type->get_element_type();
+        const size_t stride =
+                current_type->is_array() ? std::static_pointer_cast<Type::Array>(current_type)->get_flattened_size() : 1;
+        offset += indexes[dim_count] * stride;
         dim_count++;
     }
     if (dim_count != indexes.size()) {
         log_error("Index depth %zu mismatch array dimensions %zu", indexes.size(), dim_count);
     }
-    std::shared_ptr<Init> current_init = shared_from_this();
-    for (const int &idx: indexes) {
-        const auto arr = std::dynamic_pointer_cast<Array>(current_init);
-        if (!arr) {
-            log_error("Indexing into non-array init value");
-        }
-        if (arr->is_zero_initialized) {
-            return Constant::create_zero_constant_init_value(
-                    std::static_pointer_cast<Type::Array>(arr->type)->get_atomic_type());
-        }
-        if (idx < 0 || idx >= static_cast<int>(arr->init_values.size())) {
-            log_error("Index %d out of array bounds[0, %zu)", idx, arr->init_values.size());
-        }
-        current_init = arr->init_values[idx];
-    }
-    if (current_init->is_array_init()) {
+    if (current_type->is_array()) {
         log_error("Remaining array type after full indexing");
     }
-    return current_init;
+    return offset;
 }
 
+std::shared_ptr<Value> Array::get_value(const size_t offset) const {
+    if (const auto it = find_run(offset); it != runs.end() && it->offset <= offset) {
+        return it->values[offset - it->offset];
+    }
+    return Constant::create_zero_constant_init_value(get_atomic_type())->get_const_value();
+}
+
+std::shared_ptr<Init> Array::get_init_value(const std::vector<int> &indexes) {
+    return Exp::create_exp_init_value(get_atomic_type(), get_value(flat_index(indexes)));
+}
 
 void Constant::gen_store_inst(const std::shared_ptr<Value> &addr, const std::shared_ptr<Block> &block) {
     if (!addr->get_type()->is_pointer()) {
@@ -104,7 +150,7 @@ std::shared_ptr<Array> Array::create_zero_array_init_value(const std::shared_ptr
     if (!type->is_array()) {
         log_error("%s is not an array type", type->to_string().c_str());
     }
-    return std::make_shared<Array>(type, std::vector<std::shared_ptr<Init>>{}, true);
+    return std::make_shared<Array>(type);
 }
 
 void Array::gen_store_inst(const std::shared_ptr<Value> &addr, const std::shared_ptr<Block> &block,
@@ -113,8 +159,7 @@ void Array::gen_store_inst(const std::shared_ptr<Value> &addr, const std::shared
         log_error("Illegal type: %s", addr->get_type()->to_string().c_str());
     }
     if (std::dynamic_pointer_cast<Alloc>(addr)) {
-        const auto array_type = std::static_pointer_cast<Type::Array>(type);
-        const auto atomic_type = array_type->get_atomic_type();
+        const auto atomic_type = get_atomic_type();
         size_t element_size = 0;
         // 基本类型占4字节
         if (atomic_type->is_int32() || atomic_type->is_float()) {
@@ -139,39 +184,29 @@ void Array::gen_store_inst(const std::shared_ptr<Value> &addr, const std::shared
         // 用 memset 将整个数组内存区域置 0
         Call::create(func_memset, {bitcast, zero_val, size_val, is_volatile}, block);
     }
-    // 遍历 init_values，对于非零初始化的元素生成 store 指令
-    for (size_t i = 0; i < init_values.size(); ++i) {
-        auto init = init_values[i];
-        // 如果当前元素为零初始化，则跳过（memset 已完成清零）
-        bool skip = false;
-        if (init->is_constant_init()) {
-            if (const auto constant_init = std::static_pointer_cast<Constant>(init); constant_init->is_zero()) {
-                skip = true;
-            }
-        } else if (init->is_array_init()) {
-            if (const auto array_init = std::static_pointer_cast<Array>(init); array_init->is_zero_initialized) {
-                skip = true;
-            }
-        }
-        if (skip)
+    gen_store_inst(addr, block, type, 0);
+}
+
+void Array::gen_store_inst(const std::shared_ptr<Value> &addr, const std::shared_ptr<Block> &block,
+                           const std::shared_ptr<Type::Type> &sub_type, const size_t offset) const {
+    const auto array_type = std::static_pointer_cast<Type::Array>(sub_type);
+    const auto &element_type = array_type->get_element_type();
+    const size_t element_size =
+            element_type->is_array() ? std::static_pointer_cast<Type::Array>(element_type)->get_flattened_size() : 1;
+    const auto zero_index = ConstInt::create(0);
+    for (size_t i = 0; i < array_type->get_size(); ++i) {
+        const size_t element_offset = offset + i * element_size;
+        // 全零的元素或子数组已由 memset 清零，跳过
+        if (!has_value_in(element_offset, element_offset + element_size))
             continue;
-        auto index_val = ConstInt::create(static_cast<int>(i));
-        const auto zero_index = ConstInt::create(0);
-        auto element_addr = GetElementPtr::create(Builder::gen_variable_name(), addr, {zero_index, index_val}, block);
-        // 如果当前元素是子数组，则递归生成内部 store 指令
-        if (init->is_array_init()) {
-            // 对于子数组，其对应的维度为原 dimensions 去掉第一维
-            if (dimensions.size() < 2) {
-                log_error("Insufficient dimensions for array initializer");
-            }
-            std::vector sub_dimensions(dimensions.begin() + 1, dimensions.end());
-            std::static_pointer_cast<Array>(init)->gen_store_inst(element_addr, block, sub_dimensions);
-        } else if (init->is_exp_init() || init->is_constant_init()) {
-            if (init->is_constant_init()) {
-                std::static_pointer_cast<Constant>(init)->gen_store_inst(element_addr, block);
-            } else {
-                std::static_pointer_cast<Exp>(init)->gen_store_inst(element_addr, block);
-            }
+        const auto index_val = ConstInt::create(static_cast<int>(i));
+        const auto element_addr =
+                GetElementPtr::create(Builder::gen_variable_name(), addr, {zero_index, index_val}, block);
+        if (element_type->is_array()) {
+            gen_store_inst(element_addr, block, element_type, element_offset);
+        } else {
+            const auto &casted_value = type_cast(get_value(element_offset), element_type, block);
+            Store::create(element_addr, casted_value, block);
         }
     }
 }
@@ -21,7 +21,7 @@ void Instruction::fix_clone_info(const std::shared_ptr<Pass::LoopNodeClone> &clo
 
 std::shared_ptr<Alloc> Alloc::create(const std::string &name, const std::shared_ptr<Type::Type> &type,
                                      const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Alloc>(name, type);
+    const auto instruction = make_ir<Alloc>(name, type);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -30,7 +30,7 @@ std::shared_ptr<Alloc> Alloc::create(const std::string &name, const std::shared_
 
 std::shared_ptr<Load> Load::create(const std::string &name, const std::shared_ptr<Value> &addr,
                                    const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Load>(name, addr);
+    const auto instruction = make_ir<Load>(name, addr);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -40,7 +40,7 @@ std::shared_ptr<Load> Load::create(const std::string &name, const std::shared_pt
 
 std::shared_ptr<Store> Store::create(const std::shared_ptr<Value> &addr, const std::shared_ptr<Value> &value,
                                      const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Store>(addr, value);
+    const auto instruction = make_ir<Store>(addr, value);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -62,10 +62,10 @@ std::shared_ptr<Store> Store::create(const std::shared_ptr<Value> &addr, const s
 std::shared_ptr<Type::Type> GetElementPtr::calc_type_(const std::shared_ptr<Value> &addr,
                                                       const std::vector<std::shared_ptr<Value>> &indexes) {
     const auto type = addr->get_type();
-    const auto ptr_type = std::dynamic_pointer_cast<Type::Pointer>(type);
-    if (!ptr_type) {
+    if (!type->is_pointer()) {
         log_error("First operand of getelementptr must be a pointer type");
     }
+    const auto ptr_type = type->as<Type::Pointer>();
     if (indexes.size() == 1) {
         return ptr_type;
     }
@@ -82,7 +82,7 @@ std::shared_ptr<Type::Type> GetElementPtr::calc_type_(const std::shared_ptr<Valu
             if (!current->is_array()) {
                 log_error("Indexing on non-array type");
             }
-            current = current->as<Type::Array>()->get_element_type();
+            current = current->as_ptr<Type::Array>()->get_element_type();
         }
         return Type::Pointer::create(current);
     }
@@ -92,7 +92,7 @@ std::shared_ptr<Type::Type> GetElementPtr::calc_type_(const std::shared_ptr<Valu
 std::shared_ptr<GetElementPtr> GetElementPtr::create(const std::string &name, const std::shared_ptr<Value> &addr,
                                                      const std::vector<std::shared_ptr<Value>> &indexes,
                                                      const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<GetElementPtr>(name, addr, indexes);
+    const auto instruction = make_ir<GetElementPtr>(name, addr, indexes);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -109,7 +109,7 @@ std::shared_ptr<GetElementPtr> GetElementPtr::create(const std::string &name, co
 std::shared_ptr<BitCast> BitCast::create(const std::string &name, const std::shared_ptr<Value> &value,
                                          const std::shared_ptr<Type::Type> &target_type,
                                          const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<BitCast>(name, value, target_type);
+    const auto instruction = make_ir<BitCast>(name, value, target_type);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -119,7 +119,7 @@ std::shared_ptr<BitCast> BitCast::create(const std::string &name, const std::sha
 
 std::shared_ptr<Fptosi> Fptosi::create(const std::string &name, const std::shared_ptr<Value> &value,
                                        const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Fptosi>(name, value);
+    const auto instruction = make_ir<Fptosi>(name, value);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -129,7 +129,7 @@ std::shared_ptr<Fptosi> Fptosi::create(const std::string &name, const std::share
 
 std::shared_ptr<Sitofp> Sitofp::create(const std::string &name, const std::shared_ptr<Value> &value,
                                        const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Sitofp>(name, value);
+    const auto instruction = make_ir<Sitofp>(name, value);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -146,7 +146,7 @@ std::shared_ptr<Fcmp> Fcmp::create(const std::string &name, Op op, std::shared_p
         std::swap(lhs, rhs);
         op = swap_op(op);
     }
-    const auto instruction = std::make_shared<Fcmp>(name, op, lhs, rhs);
+    const auto instruction = make_ir<Fcmp>(name, op, lhs, rhs);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -164,7 +164,7 @@ std::shared_ptr<Icmp> Icmp::create(const std::string &name, Op op, std::shared_p
         std::swap(lhs, rhs);
         op = swap_op(op);
     }
-    const auto instruction = std::make_shared<Icmp>(name, op, lhs, rhs);
+    const auto instruction = make_ir<Icmp>(name, op, lhs, rhs);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -175,7 +175,7 @@ std::shared_ptr<Icmp> Icmp::create(const std::string &name, Op op, std::shared_p
 
 std::shared_ptr<Zext> Zext::create(const std::string &name, const std::shared_ptr<Value> &value,
                                    const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Zext>(name, value);
+    const auto instruction = make_ir<Zext>(name, value);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -184,7 +184,7 @@ std::shared_ptr<Zext> Zext::create(const std::string &name, const std::shared_pt
 }
 
 std::shared_ptr<Jump> Jump::create(const std::shared_ptr<Block> &target_block, const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Jump>(target_block);
+    const auto instruction = make_ir<Jump>(target_block);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -197,7 +197,7 @@ std::shared_ptr<Branch> Branch::create(const std::shared_ptr<Value> &cond, const
     if (!cond->get_type()->is_int1()) {
         log_error("Cond must be an integer 1");
     }
-    const auto instruction = std::make_shared<Branch>(cond, true_block, false_block);
+    const auto instruction = make_ir<Branch>(cond, true_block, false_block);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -208,7 +208,7 @@ std::shared_ptr<Branch> Branch::create(const std::shared_ptr<Value> &cond, const
 }
 
 std::shared_ptr<Ret> Ret::create(const std::shared_ptr<Value> &value, const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Ret>(value);
+    const auto instruction = make_ir<Ret>(value);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -217,7 +217,7 @@ std::shared_ptr<Ret> Ret::create(const std::shared_ptr<Value> &value, const std:
 }
 
 std::shared_ptr<Ret> Ret::create(const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Ret>();
+    const auto instruction = make_ir<Ret>();
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -226,7 +226,7 @@ std::shared_ptr<Ret> Ret::create(const std::shared_ptr<Block> &block) {
 
 std::shared_ptr<Switch> Switch::create(const std::shared_ptr<Value> &base, const std::shared_ptr<Block> &default_block,
                                        const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<Switch>(base, default_block);
+    const auto instruction = make_ir<Switch>(base, default_block);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -256,8 +256,7 @@ void Switch::remove_case(const std::shared_ptr<Const> &value) {
     cases_table.erase(value);
 }
 
-void Switch::modify_operand(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value) {
-    User::modify_operand(old_value, new_value);
+void Switch::on_operand_modified(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value) {
     if (const auto old_block{old_value->is<Block>()}) {
         const auto new_block{new_value->is<Block>()};
         if (new_block == nullptr) [[unlikely]] {
@@ -293,7 +292,7 @@ std::shared_ptr<Call> Call::create(const std::string &name, const std::shared_pt
     if (function->get_return_type()->is_void()) {
         log_error("Void function must not have a return value");
     }
-    const auto instruction = std::make_shared<Call>(name, function, params);
+    const auto instruction = make_ir<Call>(name, function, params);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -319,7 +318,7 @@ std::shared_ptr<Call> Call::create(const std::shared_ptr<Function> &function,
     if (!function->get_return_type()->is_void()) {
         log_error("Non-Void function must have a return value");
     }
-    const auto instruction = std::make_shared<Call>(function, params, const_string_index);
+    const auto instruction = make_ir<Call>(function, params, const_string_index);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -347,7 +346,7 @@ std::shared_ptr<Call> Call::create(const std::shared_ptr<Function> &function,
         if (!lhs->get_type()->TypeCheck() || !rhs->get_type()->TypeCheck()) {                                          \
             log_error("Operands does not fit %s", #TypeCheck);                                                         \
         }                                                                                                              \
-        const auto instruction = std::make_shared<Type>(name, lhs, rhs);                                               \
+        const auto instruction = make_ir<Type>(name, lhs, rhs);                                                        \
         if (block != nullptr) [[likely]] {                                                                             \
             instruction->set_block(block);                                                                             \
         }                                                                                                              \
@@ -363,7 +362,7 @@ std::shared_ptr<Call> Call::create(const std::shared_ptr<Function> &function,
         if (!x->get_type()->TypeCheck() || !y->get_type()->TypeCheck() || !z->get_type()->TypeCheck()) {               \
             log_error("Operands does not fit %s", #TypeCheck);                                                         \
         }                                                                                                              \
-        const auto instruction = std::make_shared<Type>(name, x, y, z);                                                \
+        const auto instruction = make_ir<Type>(name, x, y, z);                                                         \
         if (block != nullptr) [[likely]] {                                                                             \
             instruction->set_block(block);                                                                             \
         }                                                                                                              \
@@ -399,7 +398,7 @@ CREATE_TERNARY(FNmsub, is_float)
 
 std::shared_ptr<FNeg> FNeg::create(const std::string &name, const std::shared_ptr<Value> &value,
                                    const std::shared_ptr<Block> &block) {
-    const auto instruction = std::make_shared<FNeg>(name, value);
+    const auto instruction = make_ir<FNeg>(name, value);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -412,7 +411,7 @@ std::shared_ptr<FNeg> FNeg::create(const std::string &name, const std::shared_pt
 
 std::shared_ptr<Phi> Phi::create(const std::string &name, const std::shared_ptr<Type::Type> &type,
                                  const std::shared_ptr<Block> &block, const Optional_Values &optional_values) {
-    const auto instruction = std::make_shared<Phi>(name, type, optional_values);
+    const auto instruction = make_ir<Phi>(name, type, optional_values);
     for (const auto &[block, value]: optional_values) {
         // block 和 value 均视为 phi 指令的操作数
         instruction->add_operand(block);
@@ -441,8 +440,7 @@ void Phi::set_optional_value(const std::shared_ptr<Block> &block, const std::sha
     add_operand(optional_value);
 }
 
-void Phi::modify_operand(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value) {
-    User::modify_operand(old_value, new_value);
+void Phi::on_operand_modified(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value) {
     if (const auto old_block = std::dynamic_pointer_cast<Block>(old_value)) {
         const auto new_block = std::dynamic_pointer_cast<Block>(new_value);
         if (new_block == nullptr) {
@@ -508,7 +506,7 @@ std::shared_ptr<Select> Select::create(const std::string &name, const std::share
     if (condition->get_type() != Type::Integer::i1) {
         log_error("condition should be an i1");
     }
-    const auto instruction = std::make_shared<Select>(name, condition, true_value, false_value);
+    const auto instruction = make_ir<Select>(name, condition, true_value, false_value);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -522,7 +520,7 @@ std::shared_ptr<Move> Move::create(const std::shared_ptr<Value> &to_value,
     if (!to_value->get_type()->is_integer() && !to_value->get_type()->is_float()) [[unlikely]] {
         log_error("Unsupported type");
     }
-    const auto instruction = std::make_shared<Move>(to_value, from_value);
+    const auto instruction = make_ir<Move>(to_value, from_value);
     if (block != nullptr) [[likely]] {
         instruction->set_block(block);
     }
@@ -13,7 +13,7 @@ size_t size_of_type(const std::shared_ptr<Type::Type> &type) {
         return sizeof(double);
     }
     if (type->is_array()) {
-        return size_of_type(type->as<Type::Array>()->get_atomic_type()) * type->as<Type::Array>()->get_flattened_size();
+        return size_of_type(type->as_ptr<Type::Array>()->get_atomic_type()) * type->as_ptr<Type::Array>()->get_flattened_size();
     }
     log_error("Invalid type %s", type->to_string().c_str());
 }
@@ -84,7 +84,7 @@ void Alloc::do_interpret(Interpreter *interpreter) {
     if (!interpreter->is_module_mode())
         abort();
 
-    const auto array_ty = get_type()->as<Type::Pointer>()->get_contain_type()->as<Type::Array>();
+    const auto array_ty = get_type()->as_ptr<Type::Pointer>()->get_contain_type()->as<Type::Array>();
     const auto size = size_of_type(array_ty);
     const auto base = array_ty->get_atomic_type()->is_float() ? sizeof(double) : sizeof(int);
     const auto ad = interpreter->frame->memory.allocate(size, base);
@@ -126,7 +126,7 @@ void GetElementPtr::do_interpret(Interpreter *interpreter) {
 
     const auto base_addr = static_cast<size_t>(interpreter->get_runtime_value(get_addr()).get<int>());
     const auto index = static_cast<size_t>(interpreter->get_runtime_value(get_index()).get<int>());
-    const auto element_ty = get_type()->as<Type::Pointer>()->get_contain_type();
+    const auto element_ty = get_type()->as_ptr<Type::Pointer>()->get_contain_type();
     const auto element_size = size_of_type(element_ty);
     if (element_size == 0) {
         abort();
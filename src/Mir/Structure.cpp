@@ -11,6 +11,7 @@ void Module::update_id() const {
 }
 
 void Function::update_id() const {
+    const Builder::NameScope scope{*this};
     Builder::reset_count();
     for (size_t i = 0; i < arguments.size(); ++i) {
         arguments[i]->set_index(static_cast<int>(i));
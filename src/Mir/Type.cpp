@@ -1,48 +1,62 @@
 #include "Mir/Type.h"
 #include "Mir/Structure.h"
+#include "Utils/Parallel.h"
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace Mir::Type {
-std::shared_ptr<Array> Array::create(const size_t size, const std::shared_ptr<Type> &element_type) {
-    struct Key {
+namespace {
+// 复合类型的唯一化表：子类型本身已唯一化，因此可以直接以其地址作为键
+// 表中持有强引用，类型一经创建便存活至进程结束，保证同一结构始终对应同一实例
+struct TypeContext {
+    struct ArrayKey {
         size_t size;
-        std::shared_ptr<Type> element_type;
+        const Type *element_type;
 
-        bool operator==(const Key &other) const { return size == other.size && element_type == other.element_type; }
+        bool operator==(const ArrayKey &other) const {
+            return size == other.size && element_type == other.element_type;
+        }
     };
 
-    struct KeyHash {
-        size_t operator()(const Key &key) const {
-            return std::hash<size_t>{}(key.size) ^ std::hash<std::shared_ptr<Type>>{}(key.element_type);
+    struct ArrayKeyHash {
+        size_t operator()(const ArrayKey &key) const {
+            return std::hash<size_t>{}(key.size) * 31 ^ std::hash<const Type *>{}(key.element_type);
         }
     };
-    static std::unordered_map<Key, std::weak_ptr<Array>, KeyHash> cache;
-    const Key key{size, element_type};
-    if (const auto it = cache.find(key); it != cache.end()) {
-        if (auto existing = it->second.lock()) {
-            return existing;
-        }
+
+    std::unordered_map<ArrayKey, std::shared_ptr<Array>, ArrayKeyHash> arrays;
+    std::unordered_map<const Type *, std::shared_ptr<Pointer>> pointers;
+    std::mutex mutex;
+
+    static TypeContext &instance() {
+        static TypeContext context;
+        return context;
     }
-    const auto new_array = std::shared_ptr<Array>(new Array(size, element_type));
-    cache[key] = new_array;
-    return new_array;
+};
+} // namespace
+
+std::shared_ptr<Array> Array::create(const size_t size, const std::shared_ptr<Type> &element_type) {
+    auto &context = TypeContext::instance();
+    const Utils::ParallelLock lock{context.mutex};
+    auto &slot = context.arrays[{size, element_type.get()}];
+    if (slot == nullptr) [[unlikely]] {
+        slot = std::shared_ptr<Array>(new Array(size, element_type));
+    }
+    return slot;
 }
 
 std::shared_ptr<Pointer> Pointer::create(const std::shared_ptr<Type> &contain_type) {
-    static std::unordered_map<std::shared_ptr<Type>, std::weak_ptr<Pointer>> cache;
-    if (const auto it = cache.find(contain_type); it != cache.end()) {
-        if (auto existing = it->second.lock()) {
-            return existing;
-        }
+    auto &context = TypeContext::instance();
+    const Utils::ParallelLock lock{context.mutex};
+    auto &slot = context.pointers[contain_type.get()];
+    if (slot == nullptr) [[unlikely]] {
+        slot = std::shared_ptr<Pointer>(new Pointer(contain_type));
     }
-    const auto new_pointer = std::shared_ptr<Pointer>(new Pointer(contain_type));
-    cache[contain_type] = new_pointer;
-    return new_pointer;
+    return slot;
 }
 
-
 std::shared_ptr<Type> Array::get_atomic_type() const {
     std::shared_ptr<Type> current = element_type;
     while (current->is_array()) {
@@ -1,37 +1,35 @@
 #include <algorithm>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include "Mir/Value.h"
 #include "Utils/Log.h"
 
 namespace Mir {
-void Value::_add_user(const std::shared_ptr<User> &user) {
-    if (!user)
-        return;
-    cleanup_users();
-    if (std::none_of(users_.begin(), users_.end(),
-                     [&user](const std::weak_ptr<User> &wp) { return wp.lock() == user; })) {
-        users_.emplace_back(user);
+std::vector<std::shared_ptr<User>> Value::UserRange::lock() const {
+    std::vector<std::shared_ptr<User>> result;
+    result.reserve(size_);
+    std::unordered_set<const User *> seen;
+    for (auto use{head_}; use != nullptr; use = use->get_next()) {
+        if (seen.insert(use->get_user()).second) {
+            result.push_back(std::static_pointer_cast<User>(use->get_user()->shared_from_this()));
+        }
     }
+    return result;
 }
 
-void Value::_remove_user(const std::shared_ptr<User> &user) {
-    if (!user)
-        return;
-    cleanup_users();
-    users_.erase(std::remove_if(users_.begin(), users_.end(),
-                                [&user](const std::weak_ptr<User> &wp) {
-                                    const auto sp = wp.lock();
-                                    return sp && sp.get() == user.get();
-                                }),
-                 users_.end());
-}
-
-void Value::cleanup_users() {
-    users_.erase(
-            std::remove_if(users_.begin(), users_.end(), [](const std::weak_ptr<User> &wp) { return wp.expired(); }),
-            users_.end());
+std::shared_ptr<User> Value::single_user() const {
+    if (use_head_ == nullptr) {
+        return nullptr;
+    }
+    const auto user{use_head_->get_user()};
+    for (auto use{use_head_->get_next()}; use != nullptr; use = use->get_next()) {
+        if (use->get_user() != user) {
+            return nullptr;
+        }
+    }
+    return std::static_pointer_cast<User>(user->shared_from_this());
 }
 
 void Value::replace_by_new_value(const std::shared_ptr<Value> &new_value) {
@@ -39,79 +37,69 @@ void Value::replace_by_new_value(const std::shared_ptr<Value> &new_value) {
         log_error("type mismatch: expected %s, got %s", type_->to_string().c_str(),
                   new_value->get_type()->to_string().c_str());
     }
-    cleanup_users();
     if (is_constant()) [[unlikely]] {
         log_error("Cannot replace from a constant");
     }
-    const auto copied_users = users_;
-    for (const auto &user: copied_users) {
-        if (const auto sp = user.lock()) {
-            sp->modify_operand(shared_from_this(), new_value);
-        }
+    if (new_value.get() == this) [[unlikely]] {
+        return;
+    }
+    // 持有自身，防止最后一个use被替换时自身被析构
+    const auto self{shared_from_this()};
+    // 每轮把头部use所属user中指向自身的operand全部移到new_value的链表上，
+    // 同一user即使多次引用自身也只触发一次 on_operand_modified
+    while (use_head_ != nullptr) {
+        use_head_->get_user()->modify_operand(self, new_value);
     }
-    users_.clear();
 }
 
 void Value::add_user(const std::shared_ptr<User> &user) {
     if (user) [[likely]] {
-        _add_user(user);
-        user->_add_operand(shared_from_this());
+        user->add_operand(shared_from_this());
     }
 }
 
 void Value::remove_user(const std::shared_ptr<User> &user) {
     if (user) [[likely]] {
-        _remove_user(user);
-        user->_remove_operand(shared_from_this());
+        user->remove_operand(shared_from_this());
     }
 }
 
 void User::add_operand(const std::shared_ptr<Value> &value) {
     if (value) [[likely]] {
-        operands_.push_back(value);
-        value->_add_user(std::static_pointer_cast<User>(shared_from_this()));
+        operands_.emplace_back(this, value);
     }
 }
 
-void User::_add_operand(const std::shared_ptr<Value> &value) {
-    if (value) [[likely]] {
-        operands_.push_back(value);
-    }
-}
-
-void User::clear_operands() {
-    for (const auto &operand: operands_) {
-        operand->_remove_user(std::static_pointer_cast<User>(shared_from_this()));
-    }
-    operands_.clear();
-}
+void User::clear_operands() { operands_.clear(); }
 
 void User::remove_operand(const std::shared_ptr<Value> &value) {
     if (!value)
         return;
-    _remove_operand(value);
-    value->_remove_user(std::static_pointer_cast<User>(shared_from_this()));
-}
-
-void User::_remove_operand(const std::shared_ptr<Value> &value) {
-    if (!value)
-        return;
-    if (const auto it = std::find(operands_.begin(), operands_.end(), value);
+    if (const auto it = std::find_if(operands_.begin(), operands_.end(),
+                                     [&value](const Use &use) { return use.get() == value; });
         it != operands_.end()) {
         operands_.erase(it);
     }
 }
 
+void User::exchange_operands(const size_t i, const size_t j) {
+    const auto value_i{operands_[i].get()};
+    operands_[i].set(operands_[j].get());
+    operands_[j].set(value_i);
+}
+
 void User::modify_operand(const std::shared_ptr<Value> &old_value, const std::shared_ptr<Value> &new_value) {
     if (*old_value->get_type() != *new_value->get_type()) {
         log_error("type mismatch");
     }
+    if (old_value == new_value) [[unlikely]] {
+        return;
+    }
     for (auto &operand: operands_) {
-        if (operand == old_value) {
-            operand->_remove_user(std::static_pointer_cast<User>(shared_from_this()));
-            operand = new_value;
-            operand->_add_user(std::static_pointer_cast<User>(shared_from_this()));
+        if (operand.get() == old_value) {
+            operand.set(new_value);
         }
     }
+    on_operand_modified(old_value, new_value);
 }
 } // namespace Mir
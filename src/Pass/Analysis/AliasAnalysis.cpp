@@ -104,14 +104,14 @@ void AliasAnalysis::run_on_func(const std::shared_ptr<Mir::Function> &func) {
                     while (true) {
                         const auto base = gep->get_addr(), index = gep->get_index();
                         if (index->is_constant()) {
-                            if (**index->as<Mir::ConstInt>() == 0) {
+                            if (**index->as_ptr<Mir::ConstInt>() == 0) {
                                 // gep的索引为0，则该 gep 的结果与 gep 的 base 指向相同的内存地址
                                 inherit_graph.insert(InheritEdge{gep, base});
                                 break;
                             }
                         }
                         if (cur == gep && index->is_constant()) {
-                            if (**index->as<Mir::ConstInt>() != 0) {
+                            if (**index->as_ptr<Mir::ConstInt>() != 0) {
                                 // gep的索引不为0，则该 gep 的结果与 gep 的 base 不可能别名
                                 const auto id1 = gen_alloc_id(), id2 = gen_alloc_id();
                                 alias_result->add_distinct_pair_id(id1, id2);
@@ -161,12 +161,12 @@ void AliasAnalysis::run_on_func(const std::shared_ptr<Mir::Function> &func) {
     }
 
     for (const auto &[type1, id1]: types) {
-        const auto x = type1->as<Mir::Type::Pointer>()->get_contain_type();
+        const auto x = type1->as_ptr<Mir::Type::Pointer>()->get_contain_type();
         if (x == Mir::Type::Integer::i8) {
             continue;
         }
         for (const auto &[type2, id2]: types) {
-            const auto y = type2->as<Mir::Type::Pointer>()->get_contain_type();
+            const auto y = type2->as_ptr<Mir::Type::Pointer>()->get_contain_type();
             if (y == Mir::Type::Integer::i8) {
                 continue;
             }
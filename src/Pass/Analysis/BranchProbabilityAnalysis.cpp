@@ -68,7 +68,7 @@ void BranchProbabilityImpl::calc_branch(const Branch *const branch) const {
             std::find(exitings.begin(), exitings.end(), current_block) != loop->get_exits().end()) {
             const bool flag1 = is_exiting_loop(false_block, loop), flag2 = is_exiting_loop(true_block, loop);
             if (flag1 && flag2) {
-                if (dom_graph.dominated_blocks.at(true_block).size() > dom_graph.dominated_blocks.at(false_block).size()) {
+                if (dom_graph.dominated_count(true_block) > dom_graph.dominated_count(false_block)) {
                     MAKE_EDGE(current_block, true_block).weight = 25;
                     MAKE_EDGE(current_block, false_block).weight = 7;
                 } else {
@@ -92,7 +92,7 @@ void BranchProbabilityImpl::calc_branch(const Branch *const branch) const {
     const auto cond{branch->get_cond()};
     if (const auto icmp{cond->is<Icmp>()}) {
         if (icmp->get_rhs()->is_constant()) {
-            if (const auto rhs{**icmp->get_rhs()->as<ConstInt>()}; rhs == 0) {
+            if (const auto rhs{**icmp->get_rhs()->as_ptr<ConstInt>()}; rhs == 0) {
                 switch (icmp->icmp_op()) {
                     case Icmp::Op::EQ:
                     case Icmp::Op::LE:
@@ -139,7 +139,7 @@ void BranchProbabilityImpl::calc_branch(const Branch *const branch) const {
             return;
         }
     }
-    if (dom_graph.dominated_blocks.at(true_block).size() > dom_graph.dominated_blocks.at(false_block).size()) {
+    if (dom_graph.dominated_count(true_block) > dom_graph.dominated_count(false_block)) {
         MAKE_EDGE(current_block, true_block).weight = 20;
         MAKE_EDGE(current_block, false_block).weight = 12;
     } else {
@@ -158,7 +158,7 @@ void BranchProbabilityImpl::impl() const {
         switch (const auto &terminator = block->get_instructions().back();
             terminator->get_op()) {
             case Operator::JUMP: {
-                const auto target = terminator->as<Jump>()->get_target_block().get();
+                const auto target = terminator->as_ptr<Jump>()->get_target_block().get();
                 MAKE_EDGE(block, target).weight = MAX_WEIGHT;
                 break;
             }
@@ -182,21 +182,7 @@ void BranchProbabilityImpl::impl() const {
 
     block_probability[current_function->get_blocks().front().get()] = 1.0;
 
-    std::vector<std::shared_ptr<Block>> rpo;
-    std::unordered_set<std::shared_ptr<Block>> visited;
-
-    const auto dfs = [&](auto &&self, const std::shared_ptr<Block> &block) -> void {
-        visited.insert(block);
-        for (const auto &succ: cfg_graph.successors.at(block)) {
-            if (!visited.count(succ)) {
-                self(self, succ);
-            }
-        }
-        rpo.push_back(block);
-    };
-
-    dfs(dfs, current_function->get_blocks().front());
-    std::reverse(rpo.begin(), rpo.end());
+    const auto &rpo = cfg_graph.reverse_post_order();
 
     const auto entry = current_function->get_blocks().front().get();
     bool changed;
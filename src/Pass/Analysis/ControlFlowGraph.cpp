@@ -10,91 +10,65 @@ using FunctionPtr = std::shared_ptr<Mir::Function>;
 using BlockPtr = std::shared_ptr<Mir::Block>;
 
 namespace {
-// 构建函数中每个基本块的前驱和后继映射
-void build_predecessors_successors(const FunctionPtr &func,
-                                   std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &pred_map,
-                                   std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &succ_map) {
-    for (const auto &block: func->get_blocks()) {
-        const auto last_instruction = block->get_instructions().back();
-        const auto terminator = std::dynamic_pointer_cast<Mir::Terminator>(last_instruction);
-        if (terminator == nullptr) {
-            log_error("Last instruction of block %s is not a terminator: %s", block->get_name().c_str(),
-                      last_instruction->to_string().c_str());
-        }
-        std::unordered_set<BlockPtr> successors;
-        if (const auto t = terminator->get_op(); t == Mir::Operator::BRANCH) {
-            const auto branch = std::static_pointer_cast<Mir::Branch>(terminator);
-            successors.insert(branch->get_true_block());
-            successors.insert(branch->get_false_block());
-        } else if (t == Mir::Operator::JUMP) {
-            const auto jump = std::static_pointer_cast<Mir::Jump>(terminator);
-            successors.insert(jump->get_target_block());
-        } else if (t == Mir::Operator::SWITCH) {
-            const auto switch_ = std::static_pointer_cast<Mir::Switch>(terminator);
-            successors.insert(switch_->get_default_block());
-            for (const auto &[value, block]: switch_->cases()) {
-                successors.insert(block);
-            }
-        } else if (t != Mir::Operator::RET) {
-            log_error("Last instruction of block %s is not a terminator: %s", block->get_name().c_str(),
-                      last_instruction->to_string().c_str());
-        }
-        for (const auto &successor: successors) {
-            succ_map[block].insert(successor);
-            pred_map[successor].insert(block);
-        }
+// 终结指令的所有目标块，按出现的顺序排列
+std::vector<BlockPtr> terminator_successors(const BlockPtr &block) {
+    const auto last_instruction = block->get_instructions().back();
+    const auto terminator = std::dynamic_pointer_cast<Mir::Terminator>(last_instruction);
+    if (terminator == nullptr) {
+        log_error("Last instruction of block %s is not a terminator: %s", block->get_name().c_str(),
+                  last_instruction->to_string().c_str());
     }
-    std::ostringstream oss;
-    oss << "\n▷▷ Function: [" << func->get_name() << "]\n";
-    for (const auto &block: func->get_blocks()) {
-        const auto &preds = pred_map[block], &succs = succ_map[block];
-        oss << "  ■ Block: \"" << block->get_name() << "\"\n"
-                << "    ├─←←← " << Pass::Utils::format_blocks(preds) << "\n"
-                << "    └─→→→ " << Pass::Utils::format_blocks(succs) << "\n";
-    }
-    // log_trace("%s", oss.str().c_str());
-}
-
-[[maybe_unused]]
-void build_post_order(const FunctionPtr &func,
-                      const std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &dominance_children_map,
-                      std::vector<BlockPtr> &post_order) {
-    std::unordered_set<BlockPtr> visited;
-    auto dfs = [&](auto &&self, const BlockPtr &block) -> void {
-        if (visited.count(block)) {
-            return;
-        }
-        visited.insert(block);
-        for (const auto &child: dominance_children_map.at(block)) {
-            self(self, child);
+    std::vector<BlockPtr> successors;
+    if (const auto t = terminator->get_op(); t == Mir::Operator::BRANCH) {
+        const auto branch = std::static_pointer_cast<Mir::Branch>(terminator);
+        successors.push_back(branch->get_true_block());
+        successors.push_back(branch->get_false_block());
+    } else if (t == Mir::Operator::JUMP) {
+        const auto jump = std::static_pointer_cast<Mir::Jump>(terminator);
+        successors.push_back(jump->get_target_block());
+    } else if (t == Mir::Operator::SWITCH) {
+        const auto switch_ = std::static_pointer_cast<Mir::Switch>(terminator);
+        successors.push_back(switch_->get_default_block());
+        for (const auto &[value, block]: switch_->cases()) {
+            successors.push_back(block);
         }
-        post_order.push_back(block);
-    };
-    dfs(dfs, func->get_blocks().front());
+    } else if (t != Mir::Operator::RET) {
+        log_error("Last instruction of block %s is not a terminator: %s", block->get_name().c_str(),
+                  last_instruction->to_string().c_str());
+    }
+    return successors;
 }
 } // namespace
 
 namespace Pass {
-void ControlFlowGraph::analyze(const std::shared_ptr<const Mir::Module> module) {
-    if (const auto func_size = module->get_functions().size();
-        func_size != dirty_funcs_.size() || func_size != graphs_.size()) {
-        // 部分函数被删除了
-        graphs_.clear();
-        dirty_funcs_.clear();
-    }
+void ControlFlowGraph::prepare(const std::shared_ptr<const Mir::Module> &module) {
+    // 部分函数被删除了，只丢弃这些函数的结果
+    prune_removed_functions(module, dirty_funcs_, graphs_);
     for (const auto &func: *module) {
         dirty_funcs_.try_emplace(func, true);
+        graphs_.try_emplace(func);
     }
-    for (const auto &func: *module) {
+}
+
+void ControlFlowGraph::analyze(const std::shared_ptr<const Mir::Module> module) {
+    if (_current_function() == nullptr) {
+        prepare(module);
+    }
+    for (const auto &func: functions_to_analyze(module)) {
+        record_function(dirty_funcs_[func]);
         if (!dirty_funcs_[func]) {
             continue;
         }
-        if (graphs_.count(func)) {
-            graphs_.erase(func);
+        auto &graph = graphs_[func] = Graph{};
+        graph.entry_ = func->get_blocks().front();
+        for (const auto &block: func->get_blocks()) {
+            add_block(graph, block);
+        }
+        for (const auto &block: func->get_blocks()) {
+            for (const auto &successor: terminator_successors(block)) {
+                add_edge(graph, block, successor);
+            }
         }
-        graphs_.try_emplace(func, Graph{});
-        auto &pred_map = graphs_[func].predecessors, &succ_map = graphs_[func].successors;
-        build_predecessors_successors(func, pred_map, succ_map);
         dirty_funcs_[func] = false;
     }
 }
@@ -104,7 +78,8 @@ bool ControlFlowGraph::is_dirty() const {
 }
 
 bool ControlFlowGraph::is_dirty(const std::shared_ptr<Mir::Function> &function) const {
-    return dirty_funcs_.at(function);
+    const auto it = dirty_funcs_.find(function);
+    return it == dirty_funcs_.end() || it->second;
 }
 
 void ControlFlowGraph::set_dirty(const FunctionPtr &func) {
@@ -112,28 +87,208 @@ void ControlFlowGraph::set_dirty(const FunctionPtr &func) {
         return;
     }
     dirty_funcs_[func] = true;
+    // 支配树与循环都由控制流图导出
     set_analysis_result_dirty<DominanceGraph>(func);
     set_analysis_result_dirty<LoopAnalysis>(func);
 }
 
-std::vector<BlockPtr> ControlFlowGraph::reverse_post_order(const FunctionPtr &func) const {
-    std::vector<BlockPtr> post_order;
-    std::unordered_set<BlockPtr> visited;
-    auto dfs = [&](auto &&self, const BlockPtr &block) -> void {
-        if (visited.count(block)) {
-            return;
-        }
-        visited.insert(block);
-        for (const auto &child: graphs_.at(func).successors.at(block)) {
-            self(self, child);
+const std::vector<BlockPtr> &ControlFlowGraph::Graph::post_order() const {
+    if (post_order_.has_value()) {
+        return *post_order_;
+    }
+    auto &order = post_order_.emplace();
+    std::vector<bool> visited(successors.size(), false);
+    // 栈中记录块及其下一个待访问的后继的位置
+    std::vector<std::pair<BlockPtr, size_t>> stack{{entry_, 0}};
+    visited[entry_->get_index()] = true;
+    while (!stack.empty()) {
+        auto &[block, next] = stack.back();
+        if (const auto &block_successors = successors.at(block); next < block_successors.size()) {
+            const auto successor = block_successors[next++];
+            if (!visited[successor->get_index()]) {
+                visited[successor->get_index()] = true;
+                stack.emplace_back(successor, 0);
+            }
+            continue;
         }
-        post_order.push_back(block);
-    };
-    dfs(dfs, func->get_blocks().front());
-    std::reverse(post_order.begin(), post_order.end());
-    if (post_order.size() != func->get_blocks().size()) {
+        order.push_back(block);
+        stack.pop_back();
+    }
+    return order;
+}
+
+const std::vector<BlockPtr> &ControlFlowGraph::Graph::reverse_post_order() const {
+    if (!reverse_post_order_.has_value()) {
+        const auto &order = post_order();
+        reverse_post_order_.emplace(order.rbegin(), order.rend());
+    }
+    return *reverse_post_order_;
+}
+
+const std::vector<BlockPtr> &ControlFlowGraph::reverse_post_order(const FunctionPtr &func) const {
+    const auto &order = graph(func).reverse_post_order();
+    if (order.size() != func->get_blocks().size()) {
         log_error("Unexpected error");
     }
-    return post_order;
+    return order;
+}
+
+void ControlFlowGraph::add_block(Graph &graph, const BlockPtr &block) {
+    block->set_index(graph.successors.slots_.size());
+    graph.successors.slots_.emplace_back(block, BlockList{});
+    graph.predecessors.slots_.emplace_back(block, BlockList{});
+}
+
+void ControlFlowGraph::erase_block(Graph &graph, const BlockPtr &block) {
+    graph.successors.slots_[block->get_index()] = {};
+    graph.predecessors.slots_[block->get_index()] = {};
+}
+
+void ControlFlowGraph::add_edge(Graph &graph, const BlockPtr &from, const BlockPtr &to) {
+    for (const auto &block: {from, to}) {
+        if (!graph.successors.count(block)) {
+            add_block(graph, block);
+        }
+    }
+    auto &successors = graph.successors.edges(from);
+    if (successors.count(to)) {
+        return;
+    }
+    successors.push_back(to);
+    graph.predecessors.edges(to).push_back(from);
+}
+
+void ControlFlowGraph::remove_edge(Graph &graph, const BlockPtr &from, const BlockPtr &to) {
+    auto &successors = graph.successors.edges(from);
+    auto &predecessors = graph.predecessors.edges(to);
+    if (const auto it = successors.find(to); it != successors.end()) {
+        successors.erase(it);
+    }
+    if (const auto it = predecessors.find(from); it != predecessors.end()) {
+        predecessors.erase(it);
+    }
+}
+
+void ControlFlowGraph::update_dominance(const FunctionPtr &func,
+                                        const std::function<bool(DominanceGraph &)> &update) {
+    auto &graph = graphs_.at(func);
+    graph.post_order_.reset();
+    graph.reverse_post_order_.reset();
+    set_analysis_result_dirty<LoopAnalysis>(func);
+    const auto dom_info = valid_analysis_result<DominanceGraph>(func);
+    if (dom_info == nullptr) {
+        return;
+    }
+    if (!update(*dom_info)) {
+        dom_info->compute(func, graph);
+    }
+}
+
+void ControlFlowGraph::insert_edge(const FunctionPtr &func, const BlockPtr &from, const BlockPtr &to) {
+    if (is_dirty(func)) {
+        return;
+    }
+    auto &graph = graphs_.at(func);
+    if (graph.successors.count(from) && graph.successors.at(from).count(to)) {
+        return;
+    }
+    add_edge(graph, from, to);
+    update_dominance(func, [&](DominanceGraph &dom_info) { return dom_info.insert_edge(func, from, to); });
+}
+
+void ControlFlowGraph::delete_edge(const FunctionPtr &func, const BlockPtr &from, const BlockPtr &to) {
+    if (is_dirty(func)) {
+        return;
+    }
+    auto &graph = graphs_.at(func);
+    if (!graph.successors.count(from) || !graph.successors.at(from).count(to)) {
+        return;
+    }
+    remove_edge(graph, from, to);
+    update_dominance(func, [&](DominanceGraph &dom_info) { return dom_info.delete_edge(func, from, to); });
+}
+
+void ControlFlowGraph::split_block(const FunctionPtr &func, const BlockPtr &block, const BlockPtr &new_block) {
+    if (is_dirty(func)) {
+        return;
+    }
+    auto &graph = graphs_.at(func);
+    add_block(graph, new_block);
+    const auto successors = graph.successors.at(block);
+    for (const auto &successor: successors) {
+        remove_edge(graph, block, successor);
+        add_edge(graph, new_block, successor);
+    }
+    add_edge(graph, block, new_block);
+    update_dominance(func, [&](DominanceGraph &dom_info) {
+        dom_info.split_block(func, block, new_block);
+        return true;
+    });
+}
+
+void ControlFlowGraph::merge_blocks(const FunctionPtr &func, const BlockPtr &block, const BlockPtr &child) {
+    if (is_dirty(func)) {
+        return;
+    }
+    auto &graph = graphs_.at(func);
+    remove_edge(graph, block, child);
+    const auto successors = graph.successors.at(child);
+    for (const auto &successor: successors) {
+        remove_edge(graph, child, successor);
+        add_edge(graph, block, successor);
+    }
+    erase_block(graph, child);
+    update_dominance(func, [&](DominanceGraph &dom_info) { return dom_info.contract_block(func, child); });
+}
+
+void ControlFlowGraph::bypass_block(const FunctionPtr &func, const BlockPtr &block) {
+    if (is_dirty(func)) {
+        return;
+    }
+    auto &graph = graphs_.at(func);
+    if (graph.successors.at(block).size() != 1) [[unlikely]] {
+        log_error("Block %s does not have a unique successor", block->get_name().c_str());
+    }
+    const auto target = graph.successors.at(block).front();
+    remove_edge(graph, block, target);
+    const auto predecessors = graph.predecessors.at(block);
+    for (const auto &predecessor: predecessors) {
+        remove_edge(graph, predecessor, block);
+        add_edge(graph, predecessor, target);
+    }
+    erase_block(graph, block);
+    update_dominance(func, [&](DominanceGraph &dom_info) { return dom_info.contract_block(func, block); });
+}
+
+void ControlFlowGraph::remove_block(const FunctionPtr &func, const BlockPtr &block) {
+    if (is_dirty(func)) {
+        return;
+    }
+    auto &graph = graphs_.at(func);
+    if (!graph.successors.count(block)) {
+        return;
+    }
+    const auto successors = graph.successors.at(block);
+    for (const auto &successor: successors) {
+        remove_edge(graph, block, successor);
+    }
+    const auto predecessors = graph.predecessors.at(block);
+    for (const auto &predecessor: predecessors) {
+        remove_edge(graph, predecessor, block);
+    }
+    erase_block(graph, block);
+    update_dominance(func, [&](DominanceGraph &dom_info) { return dom_info.remove_block(func, block); });
+}
+
+void ControlFlowGraph::insert_block(const FunctionPtr &func, const BlockPtr &block) {
+    if (is_dirty(func)) {
+        return;
+    }
+    if (auto &graph = graphs_.at(func); !graph.successors.count(block)) {
+        add_block(graph, block);
+    }
+    for (const auto &successor: terminator_successors(block)) {
+        insert_edge(func, block, successor);
+    }
 }
 } // namespace Pass
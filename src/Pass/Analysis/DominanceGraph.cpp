@@ -1,4 +1,6 @@
+#include <limits>
 #include <queue>
+#include <tuple>
 
 #include "Mir/Instruction.h"
 #include "Pass/Analyses/ControlFlowGraph.h"
@@ -10,203 +12,83 @@ using FunctionPtr = std::shared_ptr<Mir::Function>;
 using BlockPtr = std::shared_ptr<Mir::Block>;
 
 namespace {
-// 构建每个基本块的支配集（dominator）以及被支配集（dominated）
-void build_dominators_dominated(const FunctionPtr &func,
-                                const std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &pred_map,
-                                std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &dominator,
-                                std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &dominated) {
-    const auto &blocks = func->get_blocks();
-    const std::unordered_set all_blocks(blocks.begin(), blocks.end());
-    for (const auto &block: blocks) {
-        if (block == blocks.front())
-            dominator[block] = {block};
-        else
-            dominator[block] = all_blocks;
-    }
-    bool changed = true;
-    while (changed) {
-        changed = false;
-        for (const auto &block: blocks) {
-            if (block == blocks.front())
-                continue;
-            // 新支配集为其所有前驱支配集的交集，再加上自身
-            std::unordered_set<BlockPtr> new_dom;
-            bool first = true;
-            for (const auto &pred: pred_map.at(block)) {
-                if (first) {
-                    new_dom = dominator.at(pred);
-                    first = false;
-                } else {
-                    std::unordered_set<BlockPtr> temp;
-                    for (const auto &d: new_dom) {
-                        if (dominator.at(pred).count(d))
-                            temp.insert(d);
-                    }
-                    new_dom = std::move(temp);
-                }
-            }
-            new_dom.insert(block);
-            if (new_dom != dominator[block]) {
-                dominator[block] = std::move(new_dom);
-                changed = true;
-            }
-        }
-    }
-    for (const auto &b: blocks) {
-        for (const auto &c: blocks) {
-            if (dominator.at(c).count(b))
-                dominated[b].insert(c);
-        }
-    }
-    std::ostringstream oss;
-    oss << "\n▷▷ Dominated blocks for function: [" << func->get_name() << "]\n";
-    for (const auto &block: func->get_blocks()) {
-        const auto &dominated_blocks = dominated[block];
-        oss << "  ■ Block: \"" << block->get_name() << "\"\n"
-                << "    └─ Dominates: " << Pass::Utils::format_blocks(dominated_blocks) << "\n";
-    }
-    // log_trace("%s", oss.str().c_str());
-}
-
-[[deprecated("Use Tarjan instead"), maybe_unused]]
-void build_immediate_dominators(const FunctionPtr &func,
-                                const std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &dominator,
-                                std::unordered_map<BlockPtr, BlockPtr> &imm_dom_map) {
-    const auto &blocks = func->get_blocks();
-    if (blocks.empty())
-        return;
-    const BlockPtr entry_block = blocks.front();
-    for (const auto &block: blocks) {
-        if (block == entry_block)
-            continue; // 入口块没有直接支配者
-        const auto &dominators = dominator.at(block);
-        std::unordered_set<BlockPtr> strict_dominators;
-        for (const auto &d: dominators) {
-            if (d != block) {
-                strict_dominators.insert(d);
-            }
-        }
-        BlockPtr idom = nullptr;
-        for (const auto &d_candidate: strict_dominators) {
-            bool valid = true;
-            for (const auto &d_prime: strict_dominators) {
-                if (d_prime == d_candidate)
-                    continue;
-                if (const auto &dom_of_candidate = dominator.at(d_candidate); !dom_of_candidate.count(d_prime)) {
-                    valid = false;
-                    break;
-                }
-            }
-            if (valid) {
-                idom = d_candidate;
-                break;
-            }
-        }
-        if (idom) {
-            imm_dom_map[block] = idom;
-        } else {
-            log_error("No immediate dominator found for block %s", block->get_name().c_str());
-        }
-    }
-}
-
 // Lengauer–Tarjan 算法求解有向图的支配树
 // 参见：https://oi-wiki.org/graph/dominator-tree/
+// 除 dfs_num 以基本块编号为下标外，其余数组都以 dfs 序号为下标
 struct LengauerTarjan {
-    std::vector<BlockPtr> dfs_order;
-    std::unordered_map<BlockPtr, size_t> dfs_num;
-    std::unordered_map<BlockPtr, BlockPtr> parent, ancestor, semi, idom;
-    std::unordered_map<BlockPtr, BlockPtr> best;
-    std::unordered_map<BlockPtr, std::vector<BlockPtr>> bucket;
-    const std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &succ_map;
-
-    explicit LengauerTarjan(const std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &succ_map) :
-        succ_map(succ_map) {}
-
-    void dfs(const BlockPtr &v) {
-        dfs_num[v] = dfs_order.size();
-        dfs_order.push_back(v);
-        if (const auto it = succ_map.find(v); it != succ_map.end()) {
-            for (const auto &w: it->second) {
-                if (!dfs_num.count(w)) {
-                    parent[w] = v;
-                    dfs(w);
-                }
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    const Pass::ControlFlowGraph::Graph &cfg;
+    std::vector<size_t> dfs_num;
+    std::vector<BlockPtr> vertex;
+    std::vector<size_t> parent, ancestor, semi, idom, best;
+    std::vector<std::vector<size_t>> bucket;
+
+    explicit LengauerTarjan(const Pass::ControlFlowGraph::Graph &cfg) :
+        cfg(cfg), dfs_num(cfg.successors.size(), none) {}
+
+    void dfs(const BlockPtr &v, const size_t parent_num) {
+        dfs_num[v->get_index()] = vertex.size();
+        vertex.push_back(v);
+        parent.push_back(parent_num);
+        for (const auto &w: cfg.successors.at(v)) {
+            if (dfs_num[w->get_index()] == none) {
+                dfs(w, dfs_num[v->get_index()]);
             }
         }
     }
 
-    BlockPtr find(BlockPtr v) {
-        if (!ancestor.count(v) || ancestor[v] == nullptr)
+    size_t find(const size_t v) {
+        if (ancestor[v] == none) {
             return v;
+        }
         compress(v);
         return best[v];
     }
 
-    void compress(const BlockPtr &v) {
-        if (ancestor.count(v) && ancestor[v] != nullptr && ancestor.count(ancestor[v]) &&
-            ancestor[ancestor[v]] != nullptr) {
-            compress(ancestor[v]);
-            if (dfs_num[semi[best[ancestor[v]]]] < dfs_num[semi[best[v]]]) {
-                best[v] = best[ancestor[v]];
-            }
-            ancestor[v] = ancestor[ancestor[v]];
+    void compress(const size_t v) {
+        const auto a = ancestor[v];
+        if (ancestor[a] == none) {
+            return;
+        }
+        compress(a);
+        if (semi[best[a]] < semi[best[v]]) {
+            best[v] = best[a];
         }
+        ancestor[v] = ancestor[a];
     }
 
     void compute(const FunctionPtr &func) {
-        const BlockPtr entry = func->get_blocks().front();
-        dfs_num.clear();
-        dfs_order.clear();
-        parent.clear();
-        ancestor.clear();
-        semi.clear();
-        idom.clear();
-        best.clear();
-        bucket.clear();
-
-        parent[entry] = nullptr;
-        dfs(entry);
-
-        for (const auto &v: dfs_order) {
-            ancestor[v] = nullptr;
-            best[v] = v;
-            semi[v] = v;
+        dfs(func->get_blocks().front(), none);
+        const auto n = vertex.size();
+        ancestor.assign(n, none);
+        idom.assign(n, none);
+        bucket.assign(n, {});
+        semi.resize(n);
+        best.resize(n);
+        for (size_t v = 0; v < n; ++v) {
+            semi[v] = best[v] = v;
         }
-
-        for (auto it = dfs_order.rbegin(); it != dfs_order.rend(); ++it) {
-            const BlockPtr &v = *it;
-            if (v == entry) {
-                continue;
-            }
-            for (const auto &pred: func->get_blocks()) {
-                if (succ_map.count(pred) && succ_map.at(pred).count(v)) {
-                    BlockPtr u = pred;
-                    BlockPtr s = u;
-                    if (dfs_num[u] > dfs_num[v]) {
-                        s = semi[find(u)];
-                    }
-                    if (dfs_num[s] < dfs_num[semi[v]]) {
-                        semi[v] = s;
-                    }
+        for (size_t w = n - 1; w > 0; --w) {
+            for (const auto &predecessor: cfg.predecessors.at(vertex[w])) {
+                // 不可达的前驱不参与计算
+                if (const auto u = dfs_num[predecessor->get_index()]; u != none) {
+                    semi[w] = std::min(semi[w], semi[find(u)]);
                 }
             }
-            bucket[semi[v]].push_back(v);
-            ancestor[v] = parent[v];
-            if (parent[v] != nullptr) {
-                for (const auto &w: bucket[parent[v]]) {
-                    BlockPtr u = find(w);
-                    idom[w] = semi[u] == semi[w] ? parent[v] : u;
-                }
-                bucket[parent[v]].clear();
+            bucket[semi[w]].push_back(w);
+            ancestor[w] = parent[w];
+            for (const auto v: bucket[parent[w]]) {
+                const auto u = find(v);
+                idom[v] = semi[u] == semi[v] ? parent[w] : u;
             }
+            bucket[parent[w]].clear();
         }
-        for (const auto &v: dfs_order) {
-            if (v != entry && idom[v] != semi[v]) {
-                idom[v] = idom[idom[v]];
+        for (size_t w = 1; w < n; ++w) {
+            if (idom[w] != semi[w]) {
+                idom[w] = idom[idom[w]];
             }
         }
-        idom[entry] = nullptr;
     }
 };
 
@@ -231,8 +113,7 @@ void build_dominance_children(const FunctionPtr &func, const std::unordered_map<
 }
 
 // 构建支配边界
-void build_dominance_frontier(const FunctionPtr &func,
-                              const std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &pred_map,
+void build_dominance_frontier(const FunctionPtr &func, const Pass::ControlFlowGraph::BlockListMap &pred_map,
                               const std::unordered_map<BlockPtr, BlockPtr> &imm_dom_map,
                               std::unordered_map<BlockPtr, std::unordered_set<BlockPtr>> &dominance_frontier) {
     dominance_frontier.clear();
@@ -240,7 +121,7 @@ void build_dominance_frontier(const FunctionPtr &func,
     for (const auto &x_block: func->get_blocks()) {
         // 只有拥有多个前驱的块才可能产生非空的支配边界集合。
         // （或只有一个前驱但该前驱不支配它的块，例如循环头）
-        if (pred_map.at(x_block).size() < 2) {
+        if (!pred_map.count(x_block) || pred_map.at(x_block).size() < 2) {
             continue;
         }
         const auto it = imm_dom_map.find(x_block);
@@ -278,97 +159,207 @@ void build_dominance_frontier(const FunctionPtr &func,
 } // namespace
 
 namespace Pass {
-void DominanceGraph::analyze(const std::shared_ptr<const Mir::Module> module) {
-    if (const auto func_size = module->get_functions().size();
-        func_size != dirty_funcs_.size() || func_size != graphs_.size()) {
-        // 部分函数被删除了
-        graphs_.clear();
-        dirty_funcs_.clear();
+bool DominanceGraph::Graph::dominates(const BlockPtr &a, const BlockPtr &b) const {
+    if (a == b) {
+        return true;
+    }
+    const auto it_b = intervals_.find(b);
+    if (it_b == intervals_.end()) {
+        return true;
+    }
+    const auto it_a = intervals_.find(a);
+    if (it_a == intervals_.end()) {
+        return false;
+    }
+    return it_a->second.pre <= it_b->second.pre && it_b->second.pre <= it_a->second.last;
+}
+
+size_t DominanceGraph::Graph::dominated_count(const BlockPtr &block) const {
+    const auto it = intervals_.find(block);
+    return it == intervals_.end() ? 0 : it->second.last - it->second.pre + 1;
+}
+
+size_t DominanceGraph::Graph::depth(const BlockPtr &block) const {
+    const auto it = intervals_.find(block);
+    return it == intervals_.end() ? 0 : it->second.depth;
+}
+
+const std::unordered_set<BlockPtr> &DominanceGraph::dominance_frontier(const FunctionPtr &func,
+                                                                        const BlockPtr &block) {
+    static const std::unordered_set<BlockPtr> empty;
+    auto &graph = graphs_.at(func);
+    if (!graph.dominance_frontier_.has_value()) {
+        const auto cfg = get_analysis_result<ControlFlowGraph>(Mir::Module::instance());
+        build_dominance_frontier(func, cfg->graph(func).predecessors, graph.immediate_dominator,
+                                 graph.dominance_frontier_.emplace());
     }
+    const auto it = graph.dominance_frontier_->find(block);
+    return it == graph.dominance_frontier_->end() ? empty : it->second;
+}
+
+void DominanceGraph::prepare(const std::shared_ptr<const Mir::Module> &module) {
+    // 部分函数被删除了，只丢弃这些函数的结果
+    prune_removed_functions(module, dirty_funcs_, graphs_);
     for (const auto &func: *module) {
         dirty_funcs_.try_emplace(func, true);
+        graphs_.try_emplace(func);
     }
-    const auto cfg = get_analysis_result<ControlFlowGraph>(module);
-    for (const auto &func: *module) {
-        if (!dirty_funcs_[func]) {
+}
+
+void DominanceGraph::number_tree(const FunctionPtr &func, Graph &graph) {
+    graph.intervals_.clear();
+    graph.pre_order_.clear();
+    graph.post_order_.clear();
+    // 栈中的块第一次弹出时编号，子树中的块都编号后再次弹出并记录区间的右端点
+    std::vector<std::tuple<BlockPtr, size_t, bool>> stack{{func->get_blocks().front(), 0, false}};
+    while (!stack.empty()) {
+        const auto [block, depth, leaving] = stack.back();
+        stack.pop_back();
+        if (leaving) {
+            graph.intervals_.at(block).last = graph.pre_order_.size() - 1;
+            graph.post_order_.push_back(block);
             continue;
         }
-        if (graphs_.count(func)) {
-            graphs_.erase(func);
+        graph.intervals_[block] = Graph::Interval{graph.pre_order_.size(), 0, depth};
+        graph.pre_order_.push_back(block);
+        stack.emplace_back(block, depth, true);
+        for (const auto &child: graph.dominance_children.at(block)) {
+            stack.emplace_back(child, depth + 1, false);
         }
-        graphs_.try_emplace(func, Graph{});
-        auto &dominator_map = graphs_[func].dominator_blocks, // 支配该块的所有块集合（含自身）
-             &dominated_map = graphs_[func].dominated_blocks; // 被该块支配的所有块集合（含自身）
-        auto &imm_dom_map = graphs_[func].immediate_dominator; // 该块的唯一直接支配者（支配树中的父节点）
-        auto &dominance_children_map = graphs_[func].dominance_children, // 该块在支配树中的直接子节点
-             &dominance_frontier_map = graphs_[func].dominance_frontier; // 该块的支配边界
-        build_dominators_dominated(func, cfg->graph(func).predecessors, dominator_map, dominated_map);
-        LengauerTarjan lt(cfg->graph(func).successors);
-        lt.compute(func);
-        for (const auto &block: func->get_blocks()) {
-            imm_dom_map[block] = lt.idom[block];
+    }
+}
+
+void DominanceGraph::compute(const FunctionPtr &func, const ControlFlowGraph::Graph &cfg) {
+    auto &graph = graphs_[func] = Graph{};
+    auto &imm_dom_map = graph.immediate_dominator; // 该块的唯一直接支配者（支配树中的父节点）
+    auto &dominance_children_map = graph.dominance_children; // 该块在支配树中的直接子节点
+    LengauerTarjan lt(cfg);
+    lt.compute(func);
+    for (size_t w = 1; w < lt.vertex.size(); ++w) {
+        imm_dom_map[lt.vertex[w]] = lt.vertex[lt.idom[w]];
+    }
+    build_dominance_children(func, imm_dom_map, dominance_children_map);
+    number_tree(func, graph);
+}
+
+void DominanceGraph::analyze(const std::shared_ptr<const Mir::Module> module) {
+    if (_current_function() == nullptr) {
+        prepare(module);
+    }
+    const auto cfg = get_analysis_result<ControlFlowGraph>(module);
+    for (const auto &func: functions_to_analyze(module)) {
+        record_function(dirty_funcs_[func]);
+        if (!dirty_funcs_[func]) {
+            continue;
         }
-        imm_dom_map.erase(func->get_blocks().front());
-        build_dominance_children(func, imm_dom_map, dominance_children_map);
-        build_dominance_frontier(func, cfg->graph(func).predecessors, imm_dom_map, dominance_frontier_map);
+        compute(func, cfg->graph(func));
         dirty_funcs_[func] = false;
     }
 }
 
+bool DominanceGraph::insert_edge(const FunctionPtr &func, const BlockPtr &from, const BlockPtr &to) {
+    auto &graph = graphs_.at(func);
+    graph.dominance_frontier_.reset();
+    if (!graph.intervals_.count(from)) {
+        // 起点不可达，新边不在任何从入口出发的路径上
+        return true;
+    }
+    if (!graph.intervals_.count(to)) {
+        // 终点由不可达变为可达
+        return false;
+    }
+    // 终点的直接支配者 d 支配起点时，经过新边的路径在到达起点前已经经过 d，其余块的支配者都不变
+    const auto it = graph.immediate_dominator.find(to);
+    return it == graph.immediate_dominator.end() || graph.dominates(it->second, from);
+}
+
+bool DominanceGraph::delete_edge(const FunctionPtr &func, const BlockPtr &from, const BlockPtr &to) {
+    auto &graph = graphs_.at(func);
+    graph.dominance_frontier_.reset();
+    // 起点不可达，或者删除的是回边（终点支配起点）时，从入口出发的无环路径都不经过这条边
+    return !graph.intervals_.count(from) || graph.dominates(to, from);
+}
+
+void DominanceGraph::split_block(const FunctionPtr &func, const BlockPtr &block, const BlockPtr &new_block) {
+    auto &graph = graphs_.at(func);
+    graph.dominance_frontier_.reset();
+    auto &children = graph.dominance_children;
+    children[new_block].clear();
+    if (!graph.intervals_.count(block)) {
+        return;
+    }
+    // block 的唯一后继是 new_block，原先被 block 直接支配的块现在由 new_block 直接支配
+    for (const auto &child: children.at(block)) {
+        graph.immediate_dominator[child] = new_block;
+    }
+    children[new_block] = std::move(children.at(block));
+    children[block] = {new_block};
+    graph.immediate_dominator[new_block] = block;
+    number_tree(func, graph);
+}
+
+bool DominanceGraph::contract_block(const FunctionPtr &func, const BlockPtr &block) {
+    auto &graph = graphs_.at(func);
+    graph.dominance_frontier_.reset();
+    auto &children = graph.dominance_children;
+    if (!graph.intervals_.count(block)) {
+        children.erase(block);
+        return true;
+    }
+    const auto it = graph.immediate_dominator.find(block);
+    if (it == graph.immediate_dominator.end()) {
+        // 入口块
+        return false;
+    }
+    // 其余块之间的路径只是少经过了 block，支配关系不变
+    const auto parent = it->second;
+    children.at(parent).erase(block);
+    for (const auto &child: children.at(block)) {
+        graph.immediate_dominator[child] = parent;
+        children.at(parent).insert(child);
+    }
+    children.erase(block);
+    graph.immediate_dominator.erase(it);
+    number_tree(func, graph);
+    return true;
+}
+
+bool DominanceGraph::remove_block(const FunctionPtr &func, const BlockPtr &block) {
+    auto &graph = graphs_.at(func);
+    graph.dominance_frontier_.reset();
+    if (graph.intervals_.count(block)) {
+        return false;
+    }
+    graph.dominance_children.erase(block);
+    return true;
+}
+
 bool DominanceGraph::is_dirty() const {
     return std::any_of(dirty_funcs_.begin(), dirty_funcs_.end(), [](const auto &pair) { return pair.second; });
 }
 
 bool DominanceGraph::is_dirty(const std::shared_ptr<Mir::Function> &function) const {
-    return dirty_funcs_.at(function);
+    const auto it = dirty_funcs_.find(function);
+    return it == dirty_funcs_.end() || it->second;
 }
 
-
 void DominanceGraph::set_dirty(const FunctionPtr &func) {
     if (dirty_funcs_[func]) {
         return;
     }
     dirty_funcs_[func] = true;
-    set_analysis_result_dirty<ControlFlowGraph>(func);
+    // 控制流图不依赖支配树，无需随之重建
     set_analysis_result_dirty<LoopAnalysis>(func);
 }
 
-std::vector<BlockPtr> DominanceGraph::pre_order_blocks(const FunctionPtr &func) {
-    std::unordered_set<BlockPtr> visited;
-    std::vector<BlockPtr> post_order;
-    auto dfs = [&](auto &&self, const BlockPtr &block) -> void {
-        if (visited.count(block)) {
-            return;
-        }
-        visited.insert(block);
-        post_order.push_back(block);
-        for (const auto &child: graphs_[func].dominance_children.at(block)) {
-            self(self, child);
-        }
-    };
-    dfs(dfs, func->get_blocks().front());
-    return post_order;
+const std::vector<BlockPtr> &DominanceGraph::pre_order_blocks(const FunctionPtr &func) const {
+    return graph(func).pre_order_;
 }
 
-
-std::vector<BlockPtr> DominanceGraph::post_order_blocks(const FunctionPtr &func) {
-    std::unordered_set<BlockPtr> visited;
-    std::vector<BlockPtr> post_order;
-    auto dfs = [&](auto &&self, const BlockPtr &block) -> void {
-        if (visited.count(block)) {
-            return;
-        }
-        visited.insert(block);
-        for (const auto &child: graphs_[func].dominance_children.at(block)) {
-            self(self, child);
-        }
-        post_order.push_back(block);
-    };
-    dfs(dfs, func->get_blocks().front());
-    return post_order;
+const std::vector<BlockPtr> &DominanceGraph::post_order_blocks(const FunctionPtr &func) const {
+    return graph(func).post_order_;
 }
 
-
 std::vector<BlockPtr> DominanceGraph::dom_tree_layer(const FunctionPtr &func) {
     std::vector<BlockPtr> dom_tree_layer_order;
     std::unordered_set<BlockPtr> visited;
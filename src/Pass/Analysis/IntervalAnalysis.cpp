@@ -15,7 +15,7 @@ using IntervalSetDouble = Pass::IntervalAnalysis::IntervalSet<double>;
 using Context = Pass::IntervalAnalysis::Context;
 
 void evaluate(const std::shared_ptr<Instruction> &inst, Context &ctx, const SummaryManager &summary_manager) {
-    if (inst->is<Terminator>() || inst->get_op() == Operator::PHI) {
+    if (inst->is_ptr<Terminator>() || inst->get_op() == Operator::PHI) {
         return;
     }
     AnyIntervalSet result_interval;
@@ -105,7 +105,7 @@ void evaluate(const std::shared_ptr<Instruction> &inst, Context &ctx, const Summ
         }
         case Operator::FNEG: {
             result_interval = std::visit([](const auto &a) { return IntervalSetDouble(-a); },
-                                         ctx.get(inst->as<FNeg>()->get_value()));
+                                         ctx.get(inst->as_ptr<FNeg>()->get_value()));
             break;
         }
         case Operator::ICMP:
@@ -115,21 +115,21 @@ void evaluate(const std::shared_ptr<Instruction> &inst, Context &ctx, const Summ
         }
         case Operator::SITOFP: {
             result_interval = std::visit([](const auto &a) { return IntervalSetDouble(a); },
-                                         ctx.get(inst->as<Sitofp>()->get_value()));
+                                         ctx.get(inst->as_ptr<Sitofp>()->get_value()));
             break;
         }
         case Operator::FPTOSI: {
             result_interval = std::visit([](const auto &a) { return IntervalSetInt(a); },
-                                         ctx.get(inst->as<Fptosi>()->get_value()));
+                                         ctx.get(inst->as_ptr<Fptosi>()->get_value()));
             break;
         }
         case Operator::ZEXT: {
             result_interval =
-                    std::visit([](const auto &a) { return IntervalSetInt(a); }, ctx.get(inst->as<Zext>()->get_value()));
+                    std::visit([](const auto &a) { return IntervalSetInt(a); }, ctx.get(inst->as_ptr<Zext>()->get_value()));
             break;
         }
         case Operator::CALL: {
-            if (const auto func{inst->as<Call>()->get_function()->as<Function>()}; func->is_runtime_func()) {
+            if (const auto func{inst->as_ptr<Call>()->get_function()->as<Function>()}; func->is_runtime_func()) {
                 if (const auto name{func->get_name()}; name == "getch") {
                     result_interval = IntervalSetInt{-128, 127};
                 } else if (name == "getint") {
@@ -220,7 +220,7 @@ IntervalAnalysis::AnyIntervalSet IntervalAnalysis::rabai_function(const std::sha
             return;
         }
         auto lhs{std::get<IntervalSet<int>>(lhs_interval_any)};
-        const auto rhs{**icmp->get_rhs()->as<ConstInt>()};
+        const auto rhs{**icmp->get_rhs()->as_ptr<ConstInt>()};
         const auto interval = [&]() -> IntervalSet<int> {
             switch (icmp->op) {
                 case Icmp::Op::EQ:
@@ -269,7 +269,7 @@ IntervalAnalysis::AnyIntervalSet IntervalAnalysis::rabai_function(const std::sha
         auto &current_out_ctx = out_ctxs[current_block];
         current_out_ctx = in_ctxs[current_block];
         for (const auto &inst: current_block->get_instructions()) {
-            if (inst->is<Terminator>() || inst->get_op() == Operator::PHI)
+            if (inst->is_ptr<Terminator>() || inst->get_op() == Operator::PHI)
                 continue;
             evaluate(inst, current_out_ctx, summary_manager);
         }
@@ -7,35 +7,41 @@ using FunctionPtr = std::shared_ptr<Mir::Function>;
 using BlockPtr = std::shared_ptr<Mir::Block>;
 
 namespace Pass {
+void LoopAnalysis::prepare(const std::shared_ptr<const Mir::Module> &module) {
+    prune_removed_functions(module, dirty_funcs_, loops_, loop_forest_);
+    for (const auto &func: *module) {
+        dirty_funcs_.try_emplace(func, true);
+        loops_.try_emplace(func);
+        loop_forest_.try_emplace(func);
+    }
+}
+
 void LoopAnalysis::analyze(std::shared_ptr<const Mir::Module> module) {
     std::shared_ptr<ControlFlowGraph> cfg_info = get_analysis_result<ControlFlowGraph>(module);
     const auto dom_info = get_analysis_result<DominanceGraph>(module);
     std::shared_ptr<Mir::Module> mutable_module = std::const_pointer_cast<Mir::Module>(module);
     cfg_info->run_on(mutable_module);
 
-    if (const auto func_size = module->get_functions().size();
-        func_size != dirty_funcs_.size() || func_size != loop_forest_.size() || func_size != loops_.size()) {
-        loops_.clear();
-        loop_forest_.clear();
-        dirty_funcs_.clear();
-    }
-    for (const auto &func: *module) {
-        dirty_funcs_.try_emplace(func, true);
+    if (_current_function() == nullptr) {
+        prepare(module);
     }
 
     // TODO: 这里的逻辑也稍有混乱了，好好设计整理一下
-    for (const auto &func: *module) {
+    for (const auto &func: functions_to_analyze(module)) {
+        record_function(dirty_funcs_.at(func));
         if (!dirty_funcs_.at(func))
             continue;
+        loops_[func].clear();
+        loop_forest_[func].clear();
 
         auto &block_predecessors = cfg_info->graph(func).predecessors;
         auto &block_successors = cfg_info->graph(func).successors;
-        auto &block_dominators = dom_info->graph(func).dominator_blocks;
+        const auto &dom_graph = dom_info->graph(func);
 
         std::vector<std::shared_ptr<Mir::Block>> headers;
         for (const auto &block: dom_info->post_order_blocks(func)) {
             for (const auto &predecessor: block_predecessors.at(block)) {
-                if (block_dominators.at(predecessor).find(block) != block_dominators.at(predecessor).end()) {
+                if (dom_graph.dominates(block, predecessor)) {
                     headers.push_back(block);
                     break;
                 }
@@ -46,7 +52,7 @@ void LoopAnalysis::analyze(std::shared_ptr<const Mir::Module> module) {
         for (const auto &header_block: headers) {
             std::vector<BlockPtr> latching_blocks;
             for (const auto &predecessor: block_predecessors.at(header_block)) {
-                if (block_dominators.at(predecessor).find(header_block) != block_dominators.at(predecessor).end()) {
+                if (dom_graph.dominates(header_block, predecessor)) {
                     latching_blocks.push_back(predecessor);
                 }
             } // 确认 latching_blocks,接下来 latching 节点的支配节点组成该循环
@@ -117,6 +123,7 @@ void LoopAnalysis::analyze(std::shared_ptr<const Mir::Module> module) {
             }
         }
         // log_debug("%s", oss.str().c_str());
+        dirty_funcs_[func] = false;
     }
 }
 
@@ -164,8 +171,6 @@ void LoopAnalysis::set_dirty(const FunctionPtr &func) {
         return;
     }
     dirty_funcs_[func] = true;
-    set_analysis_result_dirty<ControlFlowGraph>(func);
-    set_analysis_result_dirty<DominanceGraph>(func);
 }
 
 std::shared_ptr<LoopNodeTreeNode> LoopNodeTreeNode::find_block_in_loop(const std::shared_ptr<Mir::Block> &block) {
@@ -202,7 +207,7 @@ bool Loop::contain_block(const std::shared_ptr<Mir::Block> &block) {
 
 bool LoopNodeTreeNode::def_value(const std::shared_ptr<Mir::Value> &value) {
 
-    if (value->is<Mir::Const>() || value->is<Mir::Argument>())
+    if (value->is_ptr<Mir::Const>() || value->is_ptr<Mir::Argument>())
         return false;
 
     auto cond_instr = value->as<Mir::Instruction>();
@@ -21,7 +21,7 @@ void SCEVAnalysis::analyze(std::shared_ptr<const Mir::Module> module) {
                     if (phi->get_optional_values().size() == 2) {
                         auto initial_value = get_initial(phi, loop);
                         auto next_value = get_next(phi, loop);
-                        if (next_value->is<Mir::Const>() || !next_value->is<Mir::IntBinary>())
+                        if (next_value->is_ptr<Mir::Const>() || !next_value->is_ptr<Mir::IntBinary>())
                             return;
 
                         auto next_inst = next_value->as<Mir::IntBinary>();
@@ -31,7 +31,7 @@ void SCEVAnalysis::analyze(std::shared_ptr<const Mir::Module> module) {
                         auto op2 = next_inst->get_rhs();
                         if (op1 == phi || op2 == phi) {
                             auto step = (op1 == phi) ? op2 : op1;
-                            if (step->is<Mir::ConstInt>()) {
+                            if (step->is_ptr<Mir::ConstInt>()) {
                                 auto init_scev = this->query(initial_value);
                                 auto step_scev = this->query(step);
                                 if (init_scev && step_scev) {
@@ -112,8 +112,8 @@ std::shared_ptr<Mir::Value> SCEVAnalysis::get_next(std::shared_ptr<Mir::Phi> phi
 
 std::shared_ptr<SCEVExpr> SCEVAnalysis::query(std::shared_ptr<Mir::Value> value) {
     if (this->get_SCEVinfo().find(value) == this->get_SCEVinfo().end()) {
-        if (value->is<Mir::ConstInt>()) {
-            addSCEV(value, std::make_shared<SCEVExpr>(std::get<int>(value->as<Mir::ConstInt>()->get_constant_value())));
+        if (value->is_ptr<Mir::ConstInt>()) {
+            addSCEV(value, std::make_shared<SCEVExpr>(std::get<int>(value->as_ptr<Mir::ConstInt>()->get_constant_value())));
         }
     }
     return this->get_SCEVinfo().find(value)->second;
@@ -1,3 +1,12 @@
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+
+#include "Pass/Analyses/ControlFlowGraph.h"
+#include "Pass/Analyses/DominanceGraph.h"
+#include "Pass/Analyses/LoopAnalysis.h"
+#include "Pass/Pipeline.h"
 #include "Pass/Transforms/Array.h"
 #include "Pass/Transforms/Common.h"
 #include "Pass/Transforms/ControlFlow.h"
@@ -5,6 +14,195 @@
 #include "Pass/Transforms/DataFlow.h"
 #include "Pass/Transforms/Loop.h"
 #include "Pass/Util.h"
+#include "Utils/ThreadPool.h"
+
+namespace Pass {
+PreservedAnalyses PreservedAnalyses::control_flow() {
+    PreservedAnalyses preserved;
+    preserved.preserve<ControlFlowGraph>().preserve<DominanceGraph>().preserve<LoopAnalysis>();
+    return preserved;
+}
+
+void invalidate_analyses(const PreservedAnalyses &preserved, const std::shared_ptr<Mir::Module> &module,
+                         const std::shared_ptr<Mir::Function> &function) {
+    const ::Utils::ParallelLock lock{_analysis_mutex()};
+    for (const auto &[idx, analysis]: _analysis_results()) {
+        if (preserved.preserved(idx)) {
+            continue;
+        }
+        if (function != nullptr) {
+            analysis->invalidate(function);
+            continue;
+        }
+        for (const auto &func: module->get_functions()) {
+            analysis->invalidate(func);
+        }
+    }
+}
+
+void Analysis::record_function(const bool recomputed) const {
+    const ::Utils::ParallelLock lock{_analysis_mutex()};
+    auto &stat = _analysis_statistics()[name()];
+    ++(recomputed ? stat.functions_computed : stat.functions_reused);
+}
+
+std::vector<std::shared_ptr<Mir::Function>>
+Analysis::functions_to_analyze(const std::shared_ptr<const Mir::Module> &module) {
+    if (const auto &function = _current_function(); function != nullptr) {
+        return {function};
+    }
+    return module->get_functions();
+}
+
+namespace {
+size_t function_parallelism_{1};
+} // namespace
+
+void set_function_parallelism(const size_t threads) { function_parallelism_ = std::max<size_t>(threads, 1); }
+
+size_t function_parallelism() { return function_parallelism_; }
+
+namespace {
+// 各线程只读写自己所处理函数的结果槽位，需要事先为所有函数预留
+void prepare_analyses(const std::shared_ptr<Mir::Module> &module) {
+    for (const auto &[idx, analysis]: _analysis_results()) {
+        analysis->prepare(module);
+    }
+}
+
+// 作用域内 func 为当前线程正在处理的函数，离开时（包括异常退出）清除
+struct CurrentFunctionScope {
+    explicit CurrentFunctionScope(const std::shared_ptr<Mir::Function> &func) { _current_function() = func; }
+
+    ~CurrentFunctionScope() { _current_function() = nullptr; }
+
+    CurrentFunctionScope(const CurrentFunctionScope &) = delete;
+
+    CurrentFunctionScope &operator=(const CurrentFunctionScope &) = delete;
+};
+} // namespace
+
+bool run_on_functions_in_parallel(const std::shared_ptr<Mir::Module> &module,
+                                  const std::function<std::shared_ptr<Transform>()> &create_transform) {
+    const auto preserved = create_transform()->preserved_analyses();
+    prepare_analyses(module);
+    std::atomic<bool> changed{false};
+    ::Utils::for_each_in_parallel(module->get_functions(), function_parallelism_, [&](const auto &func) {
+        const CurrentFunctionScope scope{func};
+        if (create_transform()->run_on(func)) {
+            changed.store(true, std::memory_order_relaxed);
+        }
+    });
+    // 执行期间推迟的整体分析在此失效
+    invalidate_analyses(preserved, module);
+    return changed.load(std::memory_order_relaxed);
+}
+
+bool run_until_fixpoint(const std::shared_ptr<Mir::Module> &module, const std::vector<FunctionPassEntry> &group) {
+    std::vector<PreservedAnalyses> preserved;
+    std::string name = "fixpoint(";
+    for (const auto &entry: group) {
+        const auto transform = entry.create();
+        preserved.push_back(transform->preserved_analyses());
+        name += (preserved.size() == 1 ? "" : ",") + transform->name();
+    }
+    name += ")";
+    log_info("Running pass: %s", name.c_str());
+    bool changed = false;
+    run_timed(module, name, [&] {
+        for (const auto &entry: group) {
+            entry.prepare(module);
+        }
+        // 与并行执行相同，整体分析在迭代期间作为只读快照，结束后统一失效
+        prepare_analyses(module);
+        std::vector<std::pair<std::shared_ptr<Mir::Function>, bool>> pending;
+        for (const auto &func: module->get_functions()) {
+            pending.emplace_back(func, false);
+        }
+        size_t iteration = 0;
+        while (!pending.empty() && iteration < max_fixpoint_iterations) {
+            ++iteration;
+            ::Utils::for_each_in_parallel(pending, function_parallelism_, [&](auto &item) {
+                const CurrentFunctionScope scope{item.first};
+                for (const auto &entry: group) {
+                    item.second |= entry.create()->run_on(item.first);
+                }
+            });
+            pending.erase(std::remove_if(pending.begin(), pending.end(), [](const auto &item) { return !item.second; }),
+                          pending.end());
+            log_debug("%s: %zu functions changed in iteration %zu", name.c_str(), pending.size(), iteration);
+            changed |= !pending.empty();
+            for (auto &item: pending) {
+                item.second = false;
+            }
+        }
+        if (pending.empty()) {
+            log_info("%s converged after %zu iterations", name.c_str(), iteration);
+        } else {
+            log_info("%s stopped after %zu iterations", name.c_str(), iteration);
+        }
+        for (const auto &p: preserved) {
+            invalidate_analyses(p, module);
+        }
+    });
+    return changed;
+}
+
+std::string analysis_statistics_string() {
+    std::ostringstream oss;
+    oss << "analyses: requests / computed / reused, functions computed / reused";
+    for (const auto &[name, stat]: _analysis_statistics()) {
+        oss << "\n  " << std::left << std::setw(28) << name << std::right << std::setw(6) << stat.requests << " / "
+            << std::setw(6) << stat.computations << " / " << std::setw(6) << stat.requests - stat.computations;
+        if (stat.functions_computed + stat.functions_reused > 0) {
+            oss << ", " << std::setw(6) << stat.functions_computed << " / " << std::setw(6) << stat.functions_reused;
+        }
+    }
+    return oss.str();
+}
+
+::Utils::IRSize ir_size(const std::shared_ptr<Mir::Module> &module) {
+    ::Utils::IRSize size;
+    for (const auto &func: module->get_functions()) {
+        ++size.functions;
+        for (const auto &block: func->get_blocks()) {
+            if (block->is_deleted()) {
+                continue;
+            }
+            ++size.blocks;
+            size.instructions += block->get_instructions().size();
+        }
+    }
+    return size;
+}
+
+void run_timed(const std::shared_ptr<Mir::Module> &module, const std::string &name, const std::function<void()> &run) {
+    const ::Utils::TraceSpan span{"pass", name};
+    if (!::Utils::time_report_enabled()) {
+        run();
+        return;
+    }
+    const auto analysis_computations = [] {
+        size_t computations = 0;
+        for (const auto &[analysis, stat]: _analysis_statistics()) {
+            computations += stat.computations;
+        }
+        return computations;
+    };
+    ::Utils::TimeRecord record;
+    record.group = "pass";
+    record.name = name;
+    record.before = ir_size(module);
+    const size_t computations = analysis_computations();
+    const ::Utils::Stopwatch stopwatch;
+    run();
+    record.wall_ms = stopwatch.wall_ms();
+    record.cpu_ms = stopwatch.cpu_ms();
+    record.analyses = analysis_computations() - computations;
+    record.after = ir_size(module);
+    ::Utils::record_time(std::move(record));
+}
+} // namespace Pass
 
 [[maybe_unused]]
 void execute_O0_passes(std::shared_ptr<Mir::Module> &module) {
@@ -43,15 +241,14 @@ void execute_O1_passes(std::shared_ptr<Mir::Module> &module) {
     }
     apply<Pass::LocalValueNumbering, Pass::GepFolding>(module);
     apply<Pass::DeadCodeEliminate>(module);
-    apply<Pass::LocalValueNumbering, Pass::SimplifyControlFlow>(module);
+    apply_until_fixpoint<Pass::LocalValueNumbering, Pass::SimplifyControlFlow>(module);
     apply<Pass::Inlining, Pass::DeadFuncEliminate>(module);
     // apply<Pass::TailCallOptimize>(module);
     apply<Pass::GlobalVariableLocalize>(module);
     apply<Pass::GlobalArrayLocalize>(module);
     apply<Pass::LoadEliminate>(module);
     apply<Pass::StoreEliminate>(module);
-    apply<Pass::AlgebraicSimplify>(module);
-    apply<Pass::LocalValueNumbering, Pass::SimplifyControlFlow>(module);
+    apply_until_fixpoint<Pass::AlgebraicSimplify, Pass::LocalValueNumbering, Pass::SimplifyControlFlow>(module);
     apply<Pass::DeadCodeEliminate>(module);
     apply<Pass::ConstexprFuncEval<>>(module);
     apply<Pass::DeadFuncEliminate>(module);
@@ -60,3 +257,42 @@ void execute_O1_passes(std::shared_ptr<Mir::Module> &module) {
 
     module->update_id();
 }
+
+void execute_O2_passes(std::shared_ptr<Mir::Module> &module) {
+    try {
+        apply<Pass::Mem2Reg>(module);
+    } catch (const std::invalid_argument &) {
+        apply<Pass::AlgebraicSimplify>(module);
+        apply<Pass::SimplifyControlFlow>(module);
+        module->update_id();
+        return;
+    }
+    Pass::Pipeline::parse(Pass::O2_pipeline).run(module);
+
+    module->update_id();
+}
+
+void execute_pipeline(std::shared_ptr<Mir::Module> &module, const std::string &pipeline) {
+    const auto parsed = Pass::Pipeline::parse(pipeline);
+    const auto lowered = parsed.lowered_for_backend();
+    if (const auto text = lowered.to_string(); text != parsed.to_string()) {
+        log_info("Running pipeline for the backend: %s", text.c_str());
+    }
+    for (const auto &name: Pass::registered_passes()) {
+        if (name.rfind(Pass::unsafe_pass_prefix, 0) == 0 && parsed.contains(name)) {
+            log_warn("Pass '%s' crashes or miscompiles some inputs", name.c_str());
+        }
+    }
+    try {
+        lowered.run(module);
+    } catch (const std::invalid_argument &) {
+        // 与 -O0/-O1/-O2 相同，alloca 过多时 Mem2Reg 放弃，退回只做简单化简的流水线
+        apply<Pass::AlgebraicSimplify>(module);
+        apply<Pass::SimplifyControlFlow>(module);
+        apply<Pass::RemovePhi>(module);
+        module->update_id();
+        return;
+    }
+
+    module->update_id();
+}
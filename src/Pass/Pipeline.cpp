@@ -0,0 +1,314 @@
+#include "Pass/Pipeline.h"
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <map>
+#include <optional>
+#include <sstream>
+
+#include "Pass/Transforms/Array.h"
+#include "Pass/Transforms/Common.h"
+#include "Pass/Transforms/ControlFlow.h"
+#include "Pass/Transforms/DCE.h"
+#include "Pass/Transforms/DataFlow.h"
+#include "Pass/Transforms/Loop.h"
+#include "Utils/Log.h"
+
+namespace Pass {
+namespace {
+using PassRunner = void (*)(std::shared_ptr<Mir::Module> &);
+// 在 fixpoint 组中执行，返回是否修改了模块
+using TrackedPassRunner = bool (*)(std::shared_ptr<Mir::Module> &);
+
+struct RegisteredPass {
+    PassRunner run;
+    TrackedPassRunner run_tracked;
+    // 只有 FunctionTransform 才有，fixpoint 组全部由它们组成时逐函数迭代
+    std::optional<FunctionPassEntry> function_pass;
+};
+
+// FunctionTransform 逐函数执行并汇总各函数报告的修改，其余变换报告整个模块是否被修改
+template<typename PassType>
+bool apply_tracked(std::shared_ptr<Mir::Module> &module) {
+    const auto pass = Pass::create<PassType>();
+    log_info("Running pass: %s", pass->name().c_str());
+    bool changed = false;
+    run_timed(module, pass->name(), [&] {
+        if constexpr (is_function_transform_v<PassType>) {
+            PassType::prepare(module);
+            changed = run_on_functions_in_parallel(module, [] { return Pass::create<PassType>(); });
+        } else {
+            changed = pass->run_on_module(module);
+        }
+    });
+    return changed;
+}
+
+template<typename PassType>
+RegisteredPass registered() {
+    if constexpr (is_function_transform_v<PassType>) {
+        return {&apply_one<PassType>, &apply_tracked<PassType>, function_pass_entry<PassType>()};
+    } else {
+        return {&apply_one<PassType>, &apply_tracked<PassType>, std::nullopt};
+    }
+}
+
+const std::map<std::string, RegisteredPass> &pass_registry() {
+    static const std::map<std::string, RegisteredPass> registry{
+            // Common
+            {"algebraic-simplify", registered<AlgebraicSimplify>()},
+            {"standardize-binary", registered<StandardizeBinary>()},
+            {"constexpr-func-eval", registered<ConstexprFuncEval<>>()},
+            {"constexpr-func-eval-module", registered<ConstexprFuncEval<true>>()},
+            // Array
+            {"gep-folding", registered<GepFolding>()},
+            {"load-eliminate", registered<LoadEliminate>()},
+            {"store-eliminate", registered<StoreEliminate>()},
+            {"unsafe-sroa", registered<SROA>()},
+            {"const-index-to-value", registered<ConstIndexToValue>()},
+            // ControlFlow
+            {"simplify-cfg", registered<SimplifyControlFlow>()},
+            {"block-positioning", registered<BlockPositioning<1>>()},
+            {"block-positioning-rpo", registered<BlockPositioning<0>>()},
+            {"unsafe-branch-merging", registered<BranchMerging>()},
+            {"unsafe-if-chain-to-switch", registered<IfChainToSwitch>()},
+            {"unsafe-tail-call-optimize", registered<TailCallOptimize>()},
+            {"single-return", registered<SingleReturnTransform>()},
+            {"inline", registered<Inlining>()},
+            // DCE
+            {"dce", registered<DeadCodeEliminate>()},
+            {"dead-inst-eliminate", registered<DeadInstEliminate>()},
+            {"dead-func-eliminate", registered<DeadFuncEliminate>()},
+            {"dead-func-arg-eliminate", registered<DeadFuncArgEliminate>()},
+            {"dead-return-eliminate", registered<DeadReturnEliminate>()},
+            // DataFlow
+            {"mem2reg", registered<Mem2Reg>()},
+            {"gcm", registered<GlobalCodeMotion>()},
+            {"gvn", registered<GlobalValueNumbering>()},
+            {"lvn", registered<LocalValueNumbering>()},
+            {"global-variable-localize", registered<GlobalVariableLocalize>()},
+            {"global-array-localize", registered<GlobalArrayLocalize>()},
+            {"tree-height-balance", registered<TreeHeightBalance>()},
+            {"reassociate", registered<Reassociate>()},
+            {"constrain-reduce", registered<ConstrainReduce>()},
+            {"remove-phi", registered<RemovePhi>()},
+            {"inst-schedule", registered<InstSchedule>()},
+            // Loop
+            {"loop-simplify", registered<LoopSimplyForm>()},
+            {"lcssa", registered<LCSSA>()},
+            {"unsafe-loop-unswitch", registered<LoopUnSwitch>()},
+            {"unsafe-indvars", registered<InductionVariables>()},
+            {"unsafe-loop-interchange", registered<LoopInterchange>()},
+            {"unsafe-const-loop-unroll", registered<ConstLoopUnroll>()},
+            {"unsafe-loop-unroll", registered<LoopUnroll>()},
+            {"licm", registered<LoopInvariantCodeMotion>()},
+    };
+    return registry;
+}
+
+class Parser {
+public:
+    explicit Parser(const std::string &text) : text_{text} {}
+
+    template<typename Node>
+    std::vector<Node> parse() {
+        auto nodes = parse_list<Node>();
+        skip_spaces();
+        if (pos_ != text_.size()) {
+            error("unexpected '" + std::string(1, text_[pos_]) + "'");
+        }
+        return nodes;
+    }
+
+private:
+    const std::string &text_;
+    size_t pos_{0};
+
+    [[noreturn]] void error(const std::string &message) const {
+        log_error("Invalid pass pipeline \"%s\" at column %zu: %s", text_.c_str(), pos_ + 1, message.c_str());
+    }
+
+    void skip_spaces() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool consume(const char c) {
+        skip_spaces();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    template<typename Node>
+    std::vector<Node> parse_list() {
+        std::vector<Node> nodes;
+        do {
+            nodes.push_back(parse_item<Node>());
+        } while (consume(','));
+        return nodes;
+    }
+
+    template<typename Node>
+    Node parse_item() {
+        skip_spaces();
+        const size_t start = pos_;
+        while (pos_ < text_.size() && (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '-')) {
+            ++pos_;
+        }
+        if (start == pos_) {
+            error("expected a pass name");
+        }
+        std::string name = text_.substr(start, pos_ - start);
+        if (name == "fixpoint") {
+            if (!consume('(')) {
+                error("expected '(' after fixpoint");
+            }
+            Node node{"", parse_list<Node>()};
+            if (!consume(')')) {
+                error("expected ')'");
+            }
+            return node;
+        }
+        if (pass_registry().find(name) == pass_registry().end()) {
+            pos_ = start;
+            if (pass_registry().find(unsafe_pass_prefix + name) != pass_registry().end()) {
+                error("pass '" + name + "' crashes or miscompiles some inputs, use '" + unsafe_pass_prefix + name +
+                      "' to run it anyway");
+            }
+            std::string available;
+            for (const auto &registered: registered_passes()) {
+                available += (available.empty() ? "" : ", ") + registered;
+            }
+            error("unknown pass '" + name + "', available passes: " + available);
+        }
+        return Node{std::move(name), {}};
+    }
+};
+} // namespace
+
+Pipeline Pipeline::parse(const std::string &text) {
+    Pipeline pipeline;
+    pipeline.nodes_ = Parser{text}.parse<Node>();
+    return pipeline;
+}
+
+void Pipeline::run(std::shared_ptr<Mir::Module> &module) const { run(nodes_, module); }
+
+void Pipeline::run(const std::vector<Node> &nodes, std::shared_ptr<Mir::Module> &module) {
+    for (const auto &node: nodes) {
+        if (!node.pass.empty()) {
+            pass_registry().at(node.pass).run(module);
+            continue;
+        }
+        run_group(node.group, module);
+    }
+}
+
+bool Pipeline::run_tracked(const std::vector<Node> &nodes, std::shared_ptr<Mir::Module> &module) {
+    bool changed = false;
+    for (const auto &node: nodes) {
+        if (!node.pass.empty()) {
+            changed |= pass_registry().at(node.pass).run_tracked(module);
+        } else {
+            changed |= run_group(node.group, module);
+        }
+    }
+    return changed;
+}
+
+bool Pipeline::run_group(const std::vector<Node> &group, std::shared_ptr<Mir::Module> &module) {
+    std::vector<FunctionPassEntry> function_passes;
+    for (const auto &member: group) {
+        if (member.pass.empty()) {
+            break;
+        }
+        if (const auto &function_pass = pass_registry().at(member.pass).function_pass) {
+            function_passes.push_back(*function_pass);
+        }
+    }
+    if (function_passes.size() == group.size()) {
+        return run_until_fixpoint(module, function_passes);
+    }
+    bool changed = false;
+    for (size_t iteration = 1;; ++iteration) {
+        if (!run_tracked(group, module)) {
+            log_info("fixpoint(%s) converged after %zu iterations", to_string(group).c_str(), iteration);
+            break;
+        }
+        changed = true;
+        if (iteration == max_fixpoint_iterations) {
+            log_info("fixpoint(%s) stopped after %zu iterations", to_string(group).c_str(), iteration);
+            break;
+        }
+    }
+    return changed;
+}
+
+std::string Pipeline::to_string() const { return to_string(nodes_); }
+
+std::string Pipeline::to_string(const std::vector<Node> &nodes) {
+    std::ostringstream oss;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (i > 0) {
+            oss << ",";
+        }
+        if (nodes[i].pass.empty()) {
+            oss << "fixpoint(" << to_string(nodes[i].group) << ")";
+        } else {
+            oss << nodes[i].pass;
+        }
+    }
+    return oss.str();
+}
+
+bool Pipeline::contains(const std::string &pass) const { return contains(nodes_, pass); }
+
+bool Pipeline::contains(const std::vector<Node> &nodes, const std::string &pass) {
+    return std::any_of(nodes.begin(), nodes.end(), [&pass](const Node &node) {
+        return node.pass.empty() ? contains(node.group, pass) : node.pass == pass;
+    });
+}
+
+Pipeline Pipeline::lowered_for_backend() const {
+    Pipeline pipeline;
+    pipeline.nodes_ = lowered_for_backend(nodes_);
+    if (!contains("remove-phi")) {
+        pipeline.nodes_.push_back({"algebraic-simplify", {}});
+        pipeline.nodes_.push_back({"simplify-cfg", {}});
+        pipeline.nodes_.push_back({"remove-phi", {}});
+    }
+    return pipeline;
+}
+
+std::vector<Pipeline::Node> Pipeline::lowered_for_backend(const std::vector<Node> &nodes) {
+    std::vector<Node> lowered;
+    for (const auto &node: nodes) {
+        if (node.pass.empty()) {
+            lowered.push_back({"", lowered_for_backend(node.group)});
+            continue;
+        }
+        // remove-phi 之后的 IR 不再是 SSA 形式，化简只能在它之前进行
+        if (node.pass == "remove-phi" &&
+            !(lowered.size() >= 2 && lowered[lowered.size() - 2].pass == "algebraic-simplify" &&
+              lowered.back().pass == "simplify-cfg")) {
+            lowered.push_back({"algebraic-simplify", {}});
+            lowered.push_back({"simplify-cfg", {}});
+        }
+        lowered.push_back(node);
+    }
+    return lowered;
+}
+
+std::vector<std::string> registered_passes() {
+    std::vector<std::string> names;
+    for (const auto &[name, runner]: pass_registry()) {
+        names.push_back(name);
+    }
+    return names;
+}
+} // namespace Pass
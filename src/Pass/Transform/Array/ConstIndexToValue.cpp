@@ -7,34 +7,12 @@
 using namespace Mir;
 
 namespace {
-std::vector<int> gen_indexes(const std::shared_ptr<Type::Array> &type, const int size) {
-    int x = size;
-    if (static_cast<size_t>(size) > type->get_flattened_size()) {
-        log_error("Index out of bound");
+// 返回是否替换了 load
+bool transform_global_variable(const std::shared_ptr<GlobalVariable> &gv) {
+    if (!gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type()->is_array()) {
+        return false;
     }
-    std::shared_ptr<Type::Type> current_type = type;
-    std::vector<int> indexes, dimensions;
-    while (current_type->is_array()) {
-        dimensions.push_back(static_cast<int>(current_type->as<Type::Array>()->get_size()));
-        current_type = current_type->as<Type::Array>()->get_element_type();
-    }
-    for (size_t i = 0; i < dimensions.size(); ++i) {
-        int stride = 1;
-        for (size_t j = i + 1; j < dimensions.size(); ++j) {
-            stride *= dimensions[j];
-        }
-        int index = x / stride % dimensions[i];
-        indexes.push_back(index);
-        x -= index * stride;
-    }
-    return indexes;
-}
-
-void transform_global_variable(const std::shared_ptr<GlobalVariable> &gv) {
-    if (!gv->get_type()->as<Type::Pointer>()->get_contain_type()->is_array()) {
-        return;
-    }
-    const auto array_type = gv->get_type()->as<Type::Pointer>()->get_contain_type()->as<Type::Array>();
+    const auto array_type = gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type()->as<Type::Array>();
     std::vector<std::shared_ptr<Instruction>> load_instructions{};
     std::deque<std::shared_ptr<Instruction>> use_instructions{};
     std::unordered_set<std::shared_ptr<Instruction>> deleted_instructions{};
@@ -45,7 +23,7 @@ void transform_global_variable(const std::shared_ptr<GlobalVariable> &gv) {
         const auto instruction = use_instructions.front();
         use_instructions.pop_front();
         if (const auto op = instruction->get_op(); op == Operator::STORE || op == Operator::CALL) {
-            return;
+            return false;
         } else if (op == Operator::LOAD) {
             load_instructions.push_back(instruction);
         } else if (op == Operator::BITCAST || op == Operator::GEP) {
@@ -62,17 +40,22 @@ void transform_global_variable(const std::shared_ptr<GlobalVariable> &gv) {
         if (!gep->get_index()->is_constant()) {
             continue;
         }
-        const auto indexes = gen_indexes(array_type, **gep->get_index()->as<ConstInt>());
-        const auto constant_value = init_value->get_init_value(indexes)->as<Init::Constant>();
-        const auto value = constant_value->get_const_value();
-        load->replace_by_new_value(value);
+        const int offset = **gep->get_index()->as_ptr<ConstInt>();
+        if (static_cast<size_t>(offset) > array_type->get_flattened_size()) {
+            log_error("Index out of bound");
+        }
+        load->replace_by_new_value(init_value->get_value(offset));
         deleted_instructions.insert(load);
     }
     Pass::Utils::delete_instruction_set(Module::instance(), deleted_instructions);
+    return !deleted_instructions.empty();
 }
 } // namespace
 
-void Pass::ConstIndexToValue::transform(const std::shared_ptr<Module> module) {
-    std::for_each(module->get_global_variables().begin(), module->get_global_variables().end(),
-                  transform_global_variable);
+bool Pass::ConstIndexToValue::transform(const std::shared_ptr<Module> module) {
+    bool changed = false;
+    for (const auto &gv: module->get_global_variables()) {
+        changed |= transform_global_variable(gv);
+    }
+    return changed;
 }
@@ -10,7 +10,7 @@ size_t size_of_type(const std::shared_ptr<Type::Type> &type) {
         return 1;
     }
     if (type->is_array()) {
-        return type->as<Type::Array>()->get_flattened_size();
+        return type->as_ptr<Type::Array>()->get_flattened_size();
     }
     log_error("invalid type: %s", type->to_string().c_str());
 }
@@ -24,9 +24,10 @@ bool is_folded_leaf_gep(const std::shared_ptr<Instruction> &instruction) {
     return is_folded;
 }
 
-void try_fold_gep(const std::shared_ptr<GetElementPtr> &gep) {
-    if (gep->users().size() == 0) {
-        return;
+// 返回是否折叠了 gep
+bool try_fold_gep(const std::shared_ptr<GetElementPtr> &gep) {
+    if (gep->num_uses() == 0) {
+        return false;
     }
     const auto current_block = gep->get_block();
     std::vector<std::shared_ptr<GetElementPtr>> chain;
@@ -49,7 +50,7 @@ void try_fold_gep(const std::shared_ptr<GetElementPtr> &gep) {
     }
     std::shared_ptr<Value> offset = nullptr;
     for (const auto &chain_gep: chain) {
-        const auto base_type = chain_gep->get_type()->as<Type::Pointer>()->get_contain_type();
+        const auto base_type = chain_gep->get_type()->as_ptr<Type::Pointer>()->get_contain_type();
         const auto size = size_of_type(base_type);
         const auto const_int = ConstInt::create(static_cast<int>(size));
         const auto new_mul = Mul::create("mul", const_int, chain_gep->get_index(), current_block);
@@ -73,12 +74,14 @@ void try_fold_gep(const std::shared_ptr<GetElementPtr> &gep) {
         }
         Pass::Utils::move_instruction_before(new_inst, gep);
         gep->replace_by_new_value(new_inst);
+        return true;
     }
+    return false;
 }
 } // namespace
 
 namespace Pass {
-void GepFolding::run_on_func(const std::shared_ptr<Function> &func) const {
+bool GepFolding::run_on_func(const std::shared_ptr<Function> &func) const {
     std::vector<std::shared_ptr<GetElementPtr>> geps;
     for (const auto &block: dom_graph->dom_tree_layer(func)) {
         for (const auto &instruction: block->get_instructions()) {
@@ -88,24 +91,29 @@ void GepFolding::run_on_func(const std::shared_ptr<Function> &func) const {
         }
     }
     std::reverse(geps.begin(), geps.end());
+    bool changed = false;
     for (const auto &gep: geps) {
-        try_fold_gep(gep);
+        changed |= try_fold_gep(gep);
     }
+    return changed;
 }
 
-void GepFolding::transform(const std::shared_ptr<Module> module) {
+bool GepFolding::transform(const std::shared_ptr<Module> module) {
     dom_graph = get_analysis_result<DominanceGraph>(module);
+    bool changed = false;
     for (const auto &func: *module) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     module->update_id();
     dom_graph = nullptr;
+    return changed;
 }
 
-void GepFolding::transform(const std::shared_ptr<Function> &func) {
+bool GepFolding::transform(const std::shared_ptr<Function> &func) {
     dom_graph = get_analysis_result<DominanceGraph>(Module::instance());
-    run_on_func(func);
+    const bool changed = run_on_func(func);
     func->update_id();
     dom_graph = nullptr;
+    return changed;
 }
 } // namespace Pass
@@ -21,10 +21,10 @@ namespace Pass {
 void LoadEliminate::handle_load(const std::shared_ptr<Load> &load) {
     // 获取基础地址
     std::shared_ptr<Value> addr = load->get_addr();
-    while (addr->is<BitCast>()) {
-        addr = addr->as<BitCast>()->get_value();
+    while (addr->is_ptr<BitCast>()) {
+        addr = addr->as_ptr<BitCast>()->get_value();
     }
-    if (addr->is<Load>()) {
+    if (addr->is_ptr<Load>()) {
         return;
     }
     if (const auto gep = addr->is<GetElementPtr>()) {
@@ -61,10 +61,10 @@ void LoadEliminate::handle_load(const std::shared_ptr<Load> &load) {
 void LoadEliminate::handle_store(const std::shared_ptr<Store> &store) {
     // 获取基础地址
     std::shared_ptr<Value> addr = store->get_addr();
-    while (addr->is<BitCast>()) {
-        addr = addr->as<BitCast>()->get_value();
+    while (addr->is_ptr<BitCast>()) {
+        addr = addr->as_ptr<BitCast>()->get_value();
     }
-    if (addr->is<Load>()) {
+    if (addr->is_ptr<Load>()) {
         return;
     }
     if (const auto gep = addr->is<GetElementPtr>()) {
@@ -119,7 +119,7 @@ void LoadEliminate::handle_call(const std::shared_ptr<Call> &call) {
     }
     if (memory_write) {
         for (const auto &used_gv: used_global_variables) {
-            if (used_gv->get_type()->as<Type::Pointer>()->get_contain_type()->is_array()) {
+            if (used_gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type()->is_array()) {
                 load_indexes.erase(used_gv);
                 store_indexes.erase(used_gv);
             } else {
@@ -168,7 +168,7 @@ void LoadEliminate::run_on_func(const std::shared_ptr<Function> &func) {
     dfs(func->get_blocks().front());
 }
 
-void LoadEliminate::transform(const std::shared_ptr<Module> module) {
+bool LoadEliminate::transform(const std::shared_ptr<Module> module) {
     deleted_instructions.clear();
     cfg_info = get_analysis_result<ControlFlowGraph>(module);
     dom_info = get_analysis_result<DominanceGraph>(module);
@@ -176,23 +176,27 @@ void LoadEliminate::transform(const std::shared_ptr<Module> module) {
     for (const auto &function: *module) {
         run_on_func(function);
     }
+    const bool changed = !deleted_instructions.empty();
     Utils::delete_instruction_set(module, deleted_instructions);
     cfg_info = nullptr;
     dom_info = nullptr;
     function_analysis = nullptr;
     deleted_instructions.clear();
+    return changed;
 }
 
-void LoadEliminate::transform(const std::shared_ptr<Function> &func) {
+bool LoadEliminate::transform(const std::shared_ptr<Function> &func) {
     deleted_instructions.clear();
     cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
     dom_info = get_analysis_result<DominanceGraph>(Module::instance());
     function_analysis = get_analysis_result<FunctionAnalysis>(Module::instance());
     run_on_func(func);
+    const bool changed = !deleted_instructions.empty();
     Utils::delete_instruction_set(Module::instance(), deleted_instructions);
     cfg_info = nullptr;
     dom_info = nullptr;
     function_analysis = nullptr;
     deleted_instructions.clear();
+    return changed;
 }
 } // namespace Pass
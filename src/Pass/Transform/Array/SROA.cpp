@@ -6,7 +6,7 @@ using namespace Mir;
 
 namespace Pass {
 bool SROA::can_be_split(const std::shared_ptr<Alloc> &alloc) {
-    if (!alloc->get_type()->as<Type::Pointer>()->get_contain_type()->is_array()) {
+    if (!alloc->get_type()->as_ptr<Type::Pointer>()->get_contain_type()->is_array()) {
         return false;
     }
     std::unordered_set<std::shared_ptr<Instruction>> current_deleted;
@@ -26,9 +26,9 @@ bool SROA::can_be_split(const std::shared_ptr<Alloc> &alloc) {
             for (const auto &user: gep->users()) {
                 alloc_users.push_back(user->as<Instruction>());
             }
-            if (const auto &contain = gep->get_type()->as<Type::Pointer>()->get_contain_type();
+            if (const auto &contain = gep->get_type()->as_ptr<Type::Pointer>()->get_contain_type();
                 contain->is_integer() || contain->is_float()) {
-                int index = **gep->get_index()->as<ConstInt>();
+                int index = **gep->get_index()->as_ptr<ConstInt>();
                 index_use.try_emplace(index, std::vector<std::shared_ptr<GetElementPtr>>{});
                 index_use[index].push_back(gep);
             }
@@ -38,7 +38,7 @@ bool SROA::can_be_split(const std::shared_ptr<Alloc> &alloc) {
             }
             current_deleted.insert(instruction);
         } else if (op == Operator::CALL) {
-            if (const auto &func_name = instruction->as<Call>()->get_function()->get_name();
+            if (const auto &func_name = instruction->as_ptr<Call>()->get_function()->get_name();
                 func_name.find("llvm.memset") == std::string::npos) {
                 return false;
             }
@@ -50,7 +50,7 @@ bool SROA::can_be_split(const std::shared_ptr<Alloc> &alloc) {
     return true;
 }
 
-void SROA::run_on_func(const std::shared_ptr<Function> &func) {
+bool SROA::run_on_func(const std::shared_ptr<Function> &func) {
     clear();
     for (const auto &block: func->get_blocks()) {
         for (const auto &instruction: block->get_instructions()) {
@@ -68,7 +68,7 @@ void SROA::run_on_func(const std::shared_ptr<Function> &func) {
         const auto block = alloc->get_block();
         for (const auto &[index, geps]: index_geps) {
             const auto atomic_type =
-                    alloc->get_type()->as<Type::Pointer>()->get_contain_type()->as<Type::Array>()->get_atomic_type();
+                    alloc->get_type()->as_ptr<Type::Pointer>()->get_contain_type()->as_ptr<Type::Array>()->get_atomic_type();
             const auto new_alloc = Alloc::create("alloc", atomic_type, block);
             Utils::move_instruction_before(new_alloc, alloc);
             for (const auto &gep: geps) {
@@ -78,20 +78,24 @@ void SROA::run_on_func(const std::shared_ptr<Function> &func) {
         }
     }
     Utils::delete_instruction_set(Module::instance(), deleted_instructions);
+    return !alloc_index_geps.empty();
 }
 
-void SROA::transform(const std::shared_ptr<Module> module) {
+bool SROA::transform(const std::shared_ptr<Module> module) {
+    bool changed = false;
     for (const auto &func: *module) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     module->update_id();
-    create<Mem2Reg>()->run_on(module);
+    changed |= create<Mem2Reg>()->run_on_module(module);
+    return changed;
 }
 
-void SROA::transform(const std::shared_ptr<Function> &func) {
-    run_on_func(func);
+bool SROA::transform(const std::shared_ptr<Function> &func) {
+    bool changed = run_on_func(func);
     func->update_id();
-    create<Mem2Reg>()->run_on(func);
+    changed |= create<Mem2Reg>()->run_on(func);
+    return changed;
 }
 
 } // namespace Pass
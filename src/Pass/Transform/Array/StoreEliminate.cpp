@@ -20,10 +20,10 @@ std::shared_ptr<Value> base_addr(const std::shared_ptr<Value> &inst) {
 namespace Pass {
 void StoreEliminate::handle_load(const std::shared_ptr<Load> &load) {
     std::shared_ptr<Value> addr = load->get_addr();
-    while (addr->is<BitCast>()) {
-        addr = addr->as<BitCast>()->get_value();
+    while (addr->is_ptr<BitCast>()) {
+        addr = addr->as_ptr<BitCast>()->get_value();
     }
-    if (addr->is<Load>()) {
+    if (addr->is_ptr<Load>()) {
         return;
     }
     if (const auto gv = addr->is<GlobalVariable>()) {
@@ -41,10 +41,10 @@ void StoreEliminate::handle_load(const std::shared_ptr<Load> &load) {
 
 void StoreEliminate::handle_store(const std::shared_ptr<Store> &store) {
     std::shared_ptr<Value> addr = store->get_addr();
-    while (addr->is<BitCast>()) {
-        addr = addr->as<BitCast>()->get_value();
+    while (addr->is_ptr<BitCast>()) {
+        addr = addr->as_ptr<BitCast>()->get_value();
     }
-    if (addr->is<Load>()) {
+    if (addr->is_ptr<Load>()) {
         return;
     }
     if (const auto gv = addr->is<GlobalVariable>()) {
@@ -107,7 +107,8 @@ void StoreEliminate::handle_call(const std::shared_ptr<Call> &call) {
     }
 }
 
-void StoreEliminate::run_on_func(const std::shared_ptr<Function> &func) {
+bool StoreEliminate::run_on_func(const std::shared_ptr<Function> &func) {
+    bool changed = false;
     for (const auto &block: func->get_blocks()) {
         clear();
         deleted_instructions.clear();
@@ -120,25 +121,30 @@ void StoreEliminate::run_on_func(const std::shared_ptr<Function> &func) {
                 handle_call(instruction->as<Call>());
             }
         }
+        changed |= !deleted_instructions.empty();
         Utils::delete_instruction_set(Module::instance(), deleted_instructions);
     }
+    return changed;
 }
 
-void StoreEliminate::transform(const std::shared_ptr<Module> module) {
+bool StoreEliminate::transform(const std::shared_ptr<Module> module) {
     deleted_instructions.clear();
     function_analysis = get_analysis_result<FunctionAnalysis>(module);
+    bool changed = false;
     for (const auto &function: *module) {
-        run_on_func(function);
+        changed |= run_on_func(function);
     }
     function_analysis = nullptr;
     deleted_instructions.clear();
+    return changed;
 }
 
-void StoreEliminate::transform(const std::shared_ptr<Function> &func) {
+bool StoreEliminate::transform(const std::shared_ptr<Function> &func) {
     deleted_instructions.clear();
     function_analysis = get_analysis_result<FunctionAnalysis>(Module::instance());
-    run_on_func(func);
+    const bool changed = run_on_func(func);
     function_analysis = nullptr;
     deleted_instructions.clear();
+    return changed;
 }
 } // namespace Pass
@@ -261,7 +261,7 @@ bool _reduce_icmp_with_zext(std::vector<std::shared_ptr<Instruction>> &instructi
     const auto cmp{instructions[idx]->as<Icmp>()};
     const auto &lhs{cmp->get_lhs()};
 
-    if (const auto &rhs{cmp->get_rhs()}; **rhs->as<ConstInt>() != 0)
+    if (const auto &rhs{cmp->get_rhs()}; **rhs->as_ptr<ConstInt>() != 0)
         return false;
     if (cmp->icmp_op() != Icmp::Op::NE)
         return false;
@@ -270,7 +270,7 @@ bool _reduce_icmp_with_zext(std::vector<std::shared_ptr<Instruction>> &instructi
     if (const auto icmp = zext->get_value()->is<Icmp>()) {
         if (!(!icmp->get_lhs()->is_constant() && icmp->get_rhs()->is_constant()))
             return false;
-        if (**icmp->get_rhs()->as<ConstInt>() != 0)
+        if (**icmp->get_rhs()->as_ptr<ConstInt>() != 0)
             return false;
         cmp->replace_by_new_value(icmp);
         return true;
@@ -278,7 +278,7 @@ bool _reduce_icmp_with_zext(std::vector<std::shared_ptr<Instruction>> &instructi
     if (const auto fcmp = zext->get_value()->is<Fcmp>()) {
         if (!(!fcmp->get_lhs()->is_constant() && fcmp->get_rhs()->is_constant()))
             return false;
-        if (**fcmp->get_rhs()->as<ConstFloat>() != 0.0)
+        if (**fcmp->get_rhs()->as_ptr<ConstFloat>() != 0.0)
             return false;
         cmp->replace_by_new_value(fcmp);
         return true;
@@ -293,7 +293,7 @@ bool _reduce_fcmp_with_zext(std::vector<std::shared_ptr<Instruction>> &instructi
     const auto cmp{instructions[idx]->as<Fcmp>()};
     const auto &lhs{cmp->get_lhs()};
 
-    if (const auto &rhs{cmp->get_rhs()}; **rhs->as<ConstFloat>() != 0.0)
+    if (const auto &rhs{cmp->get_rhs()}; **rhs->as_ptr<ConstFloat>() != 0.0)
         return false;
     if (cmp->fcmp_op() != Fcmp::Op::NE)
         return false;
@@ -309,7 +309,7 @@ bool _reduce_fcmp_with_zext(std::vector<std::shared_ptr<Instruction>> &instructi
     if (const auto fcmp = zext->get_value()->is<Fcmp>()) {
         if (!(!fcmp->get_lhs()->is_constant() && fcmp->get_rhs()->is_constant()))
             return false;
-        if (**fcmp->get_rhs()->as<ConstFloat>() != 0.0)
+        if (**fcmp->get_rhs()->as_ptr<ConstFloat>() != 0.0)
             return false;
         if (fcmp->fcmp_op() != Fcmp::Op::NE)
             return false;
@@ -1042,10 +1042,10 @@ bool handle_float_ternary(const std::shared_ptr<Function> &func) {
             if (const auto t{fb->floatbinary_op()}; t == FloatBinary::Op::MUL) {
                 const auto fmul{fb->as<FMul>()};
                 const auto candidate = [&]() -> std::optional<std::shared_ptr<Value>> {
-                    if (fmul->get_lhs()->is_constant() && std::fabs(**fmul->get_lhs()->as<ConstFloat>() + 1.0) < abs_) {
+                    if (fmul->get_lhs()->is_constant() && std::fabs(**fmul->get_lhs()->as_ptr<ConstFloat>() + 1.0) < abs_) {
                         return fmul->get_rhs();
                     }
-                    if (fmul->get_rhs()->is_constant() && std::fabs(**fmul->get_rhs()->as<ConstFloat>() + 1.0) < abs_) {
+                    if (fmul->get_rhs()->is_constant() && std::fabs(**fmul->get_rhs()->as_ptr<ConstFloat>() + 1.0) < abs_) {
                         return fmul->get_lhs();
                     }
                     return std::nullopt;
@@ -1057,14 +1057,14 @@ bool handle_float_ternary(const std::shared_ptr<Function> &func) {
                 }
             } else if (t == FloatBinary::Op::SUB) {
                 if (const auto fsub{fb->as<FSub>()};
-                    fsub->get_lhs()->is_constant() && std::fabs(**fsub->get_lhs()->as<ConstFloat>()) < abs_) {
+                    fsub->get_lhs()->is_constant() && std::fabs(**fsub->get_lhs()->as_ptr<ConstFloat>()) < abs_) {
                     const auto fneg{FNeg::create("fneg", fsub->get_rhs(), nullptr)};
                     replace_instruction(fb, fneg, block, instructions, i);
                     changed = true;
                 }
             } else if (t == FloatBinary::Op::DIV) {
                 if (const auto fdiv{fb->as<FDiv>()};
-                    fdiv->get_rhs()->is_constant() && std::fabs(**fdiv->get_rhs()->as<ConstFloat>() + 1.0) < abs_) {
+                    fdiv->get_rhs()->is_constant() && std::fabs(**fdiv->get_rhs()->as_ptr<ConstFloat>() + 1.0) < abs_) {
                     const auto fneg{FNeg::create("fneg", fdiv->get_lhs(), nullptr)};
                     replace_instruction(fb, fneg, block, instructions, i);
                     changed = true;
@@ -1163,14 +1163,14 @@ bool handle_float_ternary(const std::shared_ptr<Function> &func) {
 } // namespace
 
 namespace Pass {
-void AlgebraicSimplify::transform(const std::shared_ptr<Module> module) {
-    bool changed = false;
+bool AlgebraicSimplify::transform(const std::shared_ptr<Module> module) {
+    bool changed = false, modified = false;
     do {
         changed = false;
         // 对于每一条满足交换律的IntBinary，满足常数均位于运算符右侧
-        const auto standardize_binary = create<StandardizeBinary>();
-        standardize_binary->run_on(module);
+        modified |= create<StandardizeBinary>()->run_on_module(module);
         std::for_each(module->get_functions().begin(), module->get_functions().end(), [&](const auto &func) {
+            const Builder::NameScope name_scope{*func};
             std::for_each(func->get_blocks().begin(), func->get_blocks().end(), [&](const auto &b) {
                 std::for_each(b->get_instructions().begin(), b->get_instructions().end(),
                               [&](const auto &inst) { changed |= GlobalValueNumbering::fold_instruction(inst); });
@@ -1182,16 +1182,18 @@ void AlgebraicSimplify::transform(const std::shared_ptr<Module> module) {
         if (changed) [[likely]] {
             create<DeadInstEliminate>()->run_on(module);
         }
+        modified |= changed;
     } while (changed);
-    create<DeadInstEliminate>()->run_on(module);
+    modified |= create<DeadInstEliminate>()->run_on_module(module);
+    return modified;
 }
 
-void AlgebraicSimplify::transform(const std::shared_ptr<Function> &func) {
-    bool changed = false;
+bool AlgebraicSimplify::transform(const std::shared_ptr<Function> &func) {
+    bool changed = false, modified = false;
     do {
         changed = false;
         // 对于每一条满足交换律的IntBinary，满足常数均位于运算符右侧
-        create<StandardizeBinary>()->run_on(func);
+        modified |= create<StandardizeBinary>()->run_on(func);
         std::for_each(func->get_blocks().begin(), func->get_blocks().end(), [&](const auto &b) {
             std::for_each(b->get_instructions().begin(), b->get_instructions().end(),
                           [&](const auto &inst) { changed |= GlobalValueNumbering::fold_instruction(inst); });
@@ -1201,7 +1203,9 @@ void AlgebraicSimplify::transform(const std::shared_ptr<Function> &func) {
         if (changed) [[likely]] {
             create<DeadInstEliminate>()->run_on(func);
         }
+        modified |= changed;
     } while (changed);
-    create<DeadInstEliminate>()->run_on(func);
+    modified |= create<DeadInstEliminate>()->run_on(func);
+    return modified;
 }
 } // namespace Pass
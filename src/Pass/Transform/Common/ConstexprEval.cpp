@@ -15,7 +15,7 @@ size_t size_of_type(const std::shared_ptr<Type::Type> &type) {
         return sizeof(double);
     }
     if (type->is_array()) {
-        return size_of_type(type->as<Type::Array>()->get_atomic_type()) * type->as<Type::Array>()->get_flattened_size();
+        return size_of_type(type->as_ptr<Type::Array>()->get_atomic_type()) * type->as_ptr<Type::Array>()->get_flattened_size();
     }
     log_error("Invalid type %s", type->to_string().c_str());
 }
@@ -52,7 +52,7 @@ bool ModuleInterpreter::can_run() const {
         for (const auto &inst : block->get_instructions()) {
             if (inst->get_op() == Operator::ALLOC) {
                 const auto alloc = inst->as<Alloc>();
-                alloc_size += size_of_type(alloc->get_type()->as<Type::Pointer>()->get_contain_type());
+                alloc_size += size_of_type(alloc->get_type()->as_ptr<Type::Pointer>()->get_contain_type());
             }
         }
     }
@@ -136,7 +136,7 @@ bool ConstexprFuncEval<module_mode>::run_on_func(const std::shared_ptr<Function>
                         all_params_constant = false;
                         break;
                     }
-                    args.emplace_back(param->as<Const>()->get_constant_value());
+                    args.emplace_back(param->as_ptr<Const>()->get_constant_value());
                 }
                 return args;
             }();
@@ -177,9 +177,9 @@ bool ConstexprFuncEval<module_mode>::run_on_func(const std::shared_ptr<Function>
 }
 
 template<bool module_mode>
-void ConstexprFuncEval<module_mode>::transform(const std::shared_ptr<Module> module) {
+bool ConstexprFuncEval<module_mode>::transform(const std::shared_ptr<Module> module) {
     func_analysis = get_analysis_result<FunctionAnalysis>(module);
-    bool changed{false};
+    bool changed{false}, modified{false};
 
     do {
         changed = false;
@@ -188,6 +188,7 @@ void ConstexprFuncEval<module_mode>::transform(const std::shared_ptr<Module> mod
         if (changed) {
             create<DeadInstEliminate>()->run_on(module);
         }
+        modified |= changed;
     } while (changed);
 
     if constexpr (module_mode) {
@@ -196,9 +197,11 @@ void ConstexprFuncEval<module_mode>::transform(const std::shared_ptr<Module> mod
             create<GepFolding>()->run_on(module);
             log_debug("\n%s", module->to_string().c_str());
             module_interpreter.run();
+            modified = true;
         }
     }
     func_analysis = nullptr;
+    return modified;
 }
 
 template class ConstexprFuncEval<true>;
@@ -7,11 +7,12 @@ using namespace Mir;
 
 namespace {
 // 判断一个指令是否满足交换律，即调换两个操作数的顺序不会改变操作结果
-void try_exchange_operands(const std::shared_ptr<Instruction> &instruction) {
+bool try_exchange_operands(const std::shared_ptr<Instruction> &instruction) {
     if (const auto op = instruction->get_op(); op == Operator::INTBINARY) {
         if (const auto int_binary = std::static_pointer_cast<IntBinary>(instruction); int_binary->is_commutative()) {
             if (int_binary->get_lhs()->is_constant() && !int_binary->get_rhs()->is_constant()) {
                 int_binary->swap_operands();
+                return true;
             }
         }
     } else if (op == Operator::FLOATBINARY) {
@@ -19,19 +20,23 @@ void try_exchange_operands(const std::shared_ptr<Instruction> &instruction) {
             float_binary->is_commutative()) {
             if (float_binary->get_lhs()->is_constant() && !float_binary->get_rhs()->is_constant()) {
                 float_binary->swap_operands();
+                return true;
             }
         }
     } else if (op == Operator::ICMP) {
         if (const auto &icmp = std::static_pointer_cast<Icmp>(instruction);
             icmp->get_lhs()->is_constant() && !icmp->get_rhs()->is_constant()) {
             icmp->reverse_op();
+            return true;
         }
     } else if (op == Operator::FCMP) {
         if (const auto &fcmp = std::static_pointer_cast<Fcmp>(instruction);
             fcmp->get_lhs()->is_constant() && !fcmp->get_rhs()->is_constant()) {
             fcmp->reverse_op();
+            return true;
         }
     }
+    return false;
 }
 
 void replace_instruction(const std::shared_ptr<Instruction> &from, const std::shared_ptr<Value> &to,
@@ -48,46 +53,59 @@ void replace_instruction(const std::shared_ptr<Instruction> &from, const std::sh
     }
 }
 
-void reverse_sign(std::vector<std::shared_ptr<Instruction>> &instructions, const size_t &idx,
+bool reverse_sign(std::vector<std::shared_ptr<Instruction>> &instructions, const size_t &idx,
                   const std::shared_ptr<Block> &current_block) {
     const auto binary = std::static_pointer_cast<IntBinary>(instructions[idx]);
     if (!binary->get_rhs()->is_constant()) {
-        return;
+        return false;
     }
     if (binary->op == IntBinary::Op::ADD) {
-        if (const int int_rhs = binary->get_rhs()->as<ConstInt>()->get<int>(); int_rhs < 0) {
+        if (const int int_rhs = binary->get_rhs()->as_ptr<ConstInt>()->get<int>(); int_rhs < 0) {
             const auto c = ConstInt::create(-int_rhs);
             const auto new_sub = Sub::create(Builder::gen_variable_name(), binary->get_lhs(), c, nullptr);
             replace_instruction(binary, new_sub, current_block, instructions, idx);
+            return true;
         }
     } else if (binary->op == IntBinary::Op::SUB) {
-        if (const int int_rhs = binary->get_rhs()->as<ConstInt>()->get<int>(); int_rhs < 0) {
+        if (const int int_rhs = binary->get_rhs()->as_ptr<ConstInt>()->get<int>(); int_rhs < 0) {
             const auto c = ConstInt::create(-int_rhs);
             const auto new_add = Add::create(Builder::gen_variable_name(), binary->get_lhs(), c, nullptr);
             replace_instruction(binary, new_add, current_block, instructions, idx);
+            return true;
         }
     }
+    return false;
 }
 
-void run_on_block(const std::shared_ptr<Block> &block) {
-    std::for_each(block->get_instructions().begin(), block->get_instructions().end(), try_exchange_operands);
+bool run_on_block(const std::shared_ptr<Block> &block) {
+    bool changed = false;
+    std::for_each(block->get_instructions().begin(), block->get_instructions().end(),
+                  [&](const auto &instruction) { changed |= try_exchange_operands(instruction); });
     auto &instructions = block->get_instructions();
     for (size_t i = 0; i < instructions.size(); ++i) {
         if (instructions[i]->get_op() == Operator::INTBINARY) {
-            reverse_sign(instructions, i, block);
+            changed |= reverse_sign(instructions, i, block);
         }
     }
+    return changed;
 }
 } // namespace
 
 namespace Pass {
-void StandardizeBinary::transform(const std::shared_ptr<Module> module) {
-    std::for_each(module->get_functions().begin(), module->get_functions().end(), [&](const auto &func) {
-        std::for_each(func->get_blocks().begin(), func->get_blocks().end(), run_on_block);
-    });
+bool StandardizeBinary::transform(const std::shared_ptr<Module> module) {
+    bool changed = false;
+    std::for_each(module->get_functions().begin(), module->get_functions().end(),
+                  [&](const auto &func) {
+                      const Builder::NameScope name_scope{*func};
+                      changed |= transform(func);
+                  });
+    return changed;
 }
 
-void StandardizeBinary::transform(const std::shared_ptr<Function> &func) {
-    std::for_each(func->get_blocks().begin(), func->get_blocks().end(), run_on_block);
+bool StandardizeBinary::transform(const std::shared_ptr<Function> &func) {
+    bool changed = false;
+    std::for_each(func->get_blocks().begin(), func->get_blocks().end(),
+                  [&](const auto &block) { changed |= run_on_block(block); });
+    return changed;
 }
 } // namespace Pass
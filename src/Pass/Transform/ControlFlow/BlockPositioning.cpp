@@ -5,31 +5,19 @@
 using namespace Mir;
 
 namespace {
+// 以下返回基本块的顺序是否改变
 [[maybe_unused]]
-void reverse_postorder_placement(const std::shared_ptr<Function> &func,
+bool reverse_postorder_placement(const std::shared_ptr<Function> &func,
                                  const Pass::ControlFlowGraph::Graph &graph) {
-    auto &blocks = func->get_blocks();
-    std::vector<std::shared_ptr<Block>> rpo;
-    std::unordered_set<std::shared_ptr<Block>> visited;
-
-    auto dfs = [&](auto &&self, const std::shared_ptr<Block> &block) -> void {
-        visited.insert(block);
-        for (const auto &succ: graph.successors.at(block)) {
-            if (!visited.count(succ)) {
-                self(self, succ);
-            }
-        }
-        rpo.push_back(block);
-    };
-
-    const auto entry = func->get_blocks().front();
-    dfs(dfs, entry);
-    std::reverse(rpo.begin(), rpo.end());
-    blocks = std::move(rpo);
+    if (func->get_blocks() == graph.reverse_post_order()) {
+        return false;
+    }
+    func->get_blocks() = graph.reverse_post_order();
+    return true;
 }
 
 [[maybe_unused]]
-void static_probability_placement(const std::shared_ptr<Function> &func,
+bool static_probability_placement(const std::shared_ptr<Function> &func,
                                   const std::shared_ptr<Pass::ControlFlowGraph> &cfg,
                                   const std::shared_ptr<Pass::BranchProbabilityAnalysis> &branch_prob) {
     const auto blocks_snap{func->get_blocks()};
@@ -79,28 +67,36 @@ void static_probability_placement(const std::shared_ptr<Function> &func,
         chain.insert(chain.end(), cur_chain.begin(), cur_chain.end());
     }
 
+    if (func->get_blocks() == chain) {
+        return false;
+    }
     func->get_blocks() = std::move(chain);
+    return true;
 }
 }
 
 namespace Pass {
 template<int level>
-void BlockPositioning<level>::do_reverse_postorder_placement(const std::shared_ptr<Module> &module) {
+bool BlockPositioning<level>::do_reverse_postorder_placement(const std::shared_ptr<Module> &module) {
     set_analysis_result_dirty<ControlFlowGraph>(module);
     const auto cfg_info = get_analysis_result<ControlFlowGraph>(module);
+    bool changed = false;
     for (const auto &func: module->get_functions()) {
-        reverse_postorder_placement(func, cfg_info->graph(func));
+        changed |= reverse_postorder_placement(func, cfg_info->graph(func));
     }
+    return changed;
 }
 
 template<int level>
-void BlockPositioning<level>::do_static_probability_placement(const std::shared_ptr<Module> &module) {
+bool BlockPositioning<level>::do_static_probability_placement(const std::shared_ptr<Module> &module) {
     set_analysis_result_dirty<ControlFlowGraph>(module);
     const auto cfg_info = get_analysis_result<ControlFlowGraph>(module);
     const auto branch_prob_info = get_analysis_result<BranchProbabilityAnalysis>(module);
+    bool changed = false;
     for (const auto &func: module->get_functions()) {
-        static_probability_placement(func, cfg_info, branch_prob_info);
+        changed |= static_probability_placement(func, cfg_info, branch_prob_info);
     }
+    return changed;
 }
 
 template class BlockPositioning<0>;
@@ -43,8 +43,9 @@ namespace {
 // int max_value(int a, int b) {
 //     return max(a, b);  // 直接使用max指令
 // }
+// 返回是否将 phi 替换为了 max/min
 template<typename Compare>
-void select_handle(const std::shared_ptr<Block> &end_block, const std::shared_ptr<Block> &true_block,
+bool select_handle(const std::shared_ptr<Block> &end_block, const std::shared_ptr<Block> &true_block,
                    const std::shared_ptr<Compare> &cmp) {
     using MaxInst = typename Trait<Compare>::MaxInst;
     using MinInst = typename Trait<Compare>::MinInst;
@@ -97,12 +98,33 @@ void select_handle(const std::shared_ptr<Block> &end_block, const std::shared_pt
         }
         break;
     }
+    return !deleted_instructions.empty();
+}
+
+// 将 block 的分支改为跳转到 target，同时在控制流图与支配树上修改对应的边
+// 失去所有前驱的原后继随之从控制流图中删除，之后由 remove_unreachable_blocks 从函数中删除
+void jump_to(const std::shared_ptr<Function> &func, const std::shared_ptr<Pass::ControlFlowGraph> &cfg,
+             const std::shared_ptr<Block> &block, const std::shared_ptr<Block> &target) {
+    const auto successors = cfg->graph(func).successors.at(block);
+    block->get_instructions().pop_back();
+    Jump::create(target, block);
+    cfg->insert_edge(func, block, target);
+    for (const auto &successor: successors) {
+        if (successor == target) {
+            continue;
+        }
+        cfg->delete_edge(func, block, successor);
+        if (cfg->graph(func).predecessors.at(successor).empty()) {
+            cfg->remove_block(func, successor);
+        }
+    }
 }
 
 template<typename Compare>
-void select_to_min_max(const std::shared_ptr<Function> &func, const std::shared_ptr<Pass::ControlFlowGraph> &cfg) {
+bool select_to_min_max(const std::shared_ptr<Function> &func, const std::shared_ptr<Pass::ControlFlowGraph> &cfg) {
     static_assert(is_compare_v<Compare>, "Class Type is not a compare instruction");
     std::unordered_set<std::shared_ptr<Block>> visited;
+    bool changed = false;
     for (const auto &block: func->get_blocks()) {
         if (visited.find(block) != visited.end()) {
             continue;
@@ -134,12 +156,12 @@ void select_to_min_max(const std::shared_ptr<Function> &func, const std::shared_
                 if (cfg->graph(func).predecessors.at(end_block).size() > 2) {
                     continue;
                 }
-                select_handle<Compare>(end_block, true_block, compare);
+                changed |= select_handle<Compare>(end_block, true_block, compare);
                 if (std::none_of(end_block->get_instructions().begin(), end_block->get_instructions().end(),
                                  [&](const auto &inst) { return inst->get_op() == Operator::PHI; }) &&
                     true_block->get_instructions().size() == 1 && false_block->get_instructions().size() == 1) {
-                    block->get_instructions().pop_back();
-                    Jump::create(end_block, block);
+                    jump_to(func, cfg, block, end_block);
+                    changed = true;
                 }
             }
         } else if (const auto flag{cfg->graph(func).predecessors.at(true_block).size() == 2};
@@ -158,15 +180,16 @@ void select_to_min_max(const std::shared_ptr<Function> &func, const std::shared_
             if (true_block == end_block) {
                 true_block = block;
             }
-            select_handle<Compare>(end_block, true_block, compare);
+            changed |= select_handle<Compare>(end_block, true_block, compare);
             if (std::none_of(end_block->get_instructions().begin(), end_block->get_instructions().end(),
                              [&](const auto &inst) { return inst->get_op() == Operator::PHI; }) &&
                 pass_block->get_instructions().size() == 1) {
-                block->get_instructions().pop_back();
-                Jump::create(end_block, block);
+                jump_to(func, cfg, block, end_block);
+                changed = true;
             }
         }
     }
+    return changed;
 }
 
 
@@ -195,38 +218,39 @@ bool _branch_to_min_max(const std::shared_ptr<Block> &block) {
 } // namespace
 
 namespace Pass {
-void BranchMerging::run_on_func(const std::shared_ptr<Function> &func) {
-    const auto refresh = [&]() -> void {
+bool BranchMerging::run_on_func(const std::shared_ptr<Function> &func) {
+    // 控制流图与支配树由增量更新维护，这里只重新编号并删除不可达的基本块
+    const auto refresh = [&]() -> bool {
         func->update_id();
-        SimplifyControlFlow::remove_unreachable_blocks(func);
-        set_analysis_result_dirty<ControlFlowGraph>(func);
-        set_analysis_result_dirty<DominanceGraph>(func);
-        cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
-        dom_info = get_analysis_result<DominanceGraph>(Module::instance());
+        return SimplifyControlFlow::remove_unreachable_blocks(func);
     };
 
-    refresh();
-    select_to_min_max<Icmp>(func, cfg_info);
-    refresh();
-    select_to_min_max<Fcmp>(func, cfg_info);
-    refresh();
+    bool changed = refresh();
+    changed |= select_to_min_max<Icmp>(func, cfg_info);
+    changed |= refresh();
+    changed |= select_to_min_max<Fcmp>(func, cfg_info);
+    changed |= refresh();
+    return changed;
 }
 
-void BranchMerging::transform(const std::shared_ptr<Module> module) {
+bool BranchMerging::transform(const std::shared_ptr<Module> module) {
     cfg_info = get_analysis_result<ControlFlowGraph>(module);
     dom_info = get_analysis_result<DominanceGraph>(module);
+    bool changed = false;
     for (const auto &func: module->get_functions()) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     cfg_info = nullptr;
     dom_info = nullptr;
+    return changed;
 }
 
-void BranchMerging::transform(const std::shared_ptr<Function> &func) {
+bool BranchMerging::transform(const std::shared_ptr<Function> &func) {
     cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
     dom_info = get_analysis_result<DominanceGraph>(Module::instance());
-    run_on_func(func);
+    const bool changed = run_on_func(func);
     cfg_info = nullptr;
     dom_info = nullptr;
+    return changed;
 }
 } // namespace Pass
@@ -6,18 +6,19 @@
 using namespace Mir;
 
 namespace {
-void run_on_block(const std::shared_ptr<Block> &block, std::unordered_set<std::shared_ptr<Block>> &visited) {
+// 返回是否将 if 链替换为了 switch
+bool run_on_block(const std::shared_ptr<Block> &block, std::unordered_set<std::shared_ptr<Block>> &visited) {
     const auto &terminator{block->get_instructions().back()};
     if (terminator->get_op() != Operator::BRANCH)
-        return;
+        return false;
     const auto branch{terminator->as<Branch>()};
     const auto icmp{branch->get_cond()->is<Icmp>()};
     if (!icmp)
-        return;
+        return false;
     if (icmp->op != Icmp::Op::EQ && icmp->op != Icmp::Op::NE)
-        return;
+        return false;
     if (icmp->get_lhs()->is_constant() || !icmp->get_rhs()->is_constant())
-        return;
+        return false;
 
     const auto base_value{icmp->get_lhs()};
     std::shared_ptr<Block> default_block{nullptr}, parent_block{nullptr};
@@ -68,7 +69,7 @@ void run_on_block(const std::shared_ptr<Block> &block, std::unordered_set<std::s
                 return false;
             if (_icmp->get_lhs() != base_value)
                 return false;
-            key = std::make_optional(**_icmp->get_rhs()->as<ConstInt>());
+            key = std::make_optional(**_icmp->get_rhs()->as_ptr<ConstInt>());
             if (_icmp->op == Icmp::Op::EQ) {
                 then_block = _branch->get_true_block();
                 else_block = _branch->get_false_block();
@@ -101,12 +102,12 @@ void run_on_block(const std::shared_ptr<Block> &block, std::unordered_set<std::s
     // log_info("  default: %s", default_block->get_name().c_str());
 
     if (chain_map.size() <= 1)
-        return;
+        return false;
 
     if (std::any_of(chain_map.begin(), chain_map.end(), [](const auto &pair) {
             return pair.second->get_instructions().front()->get_op() == Operator::PHI;
         })) {
-        return;
+        return false;
     }
     block->get_instructions().pop_back();
     const auto switch_{Switch::create(base_value, default_block, block)};
@@ -120,37 +121,42 @@ void run_on_block(const std::shared_ptr<Block> &block, std::unordered_set<std::s
     }
     std::for_each(chain_map.begin(), chain_map.end(),
                   [&](const auto &pair) { switch_->set_case(ConstInt::create(pair.first), pair.second); });
+    return true;
 }
 } // namespace
 
 namespace Pass {
-void IfChainToSwitch::run_on_func(const std::shared_ptr<Function> &func) const {
+bool IfChainToSwitch::run_on_func(const std::shared_ptr<Function> &func) const {
     std::unordered_set<std::shared_ptr<Block>> visited;
+    bool changed = false;
     const auto pre_order_blocks{dom_info->pre_order_blocks(func)};
     for (const auto &block: pre_order_blocks) {
         if (visited.find(block) != visited.end())
             continue;
-        run_on_block(block, visited);
+        changed |= run_on_block(block, visited);
     }
+    return changed;
 }
 
-void IfChainToSwitch::transform(const std::shared_ptr<Module> module) {
-    create<StandardizeBinary>()->run_on(module);
+bool IfChainToSwitch::transform(const std::shared_ptr<Module> module) {
+    bool changed = create<StandardizeBinary>()->run_on_module(module);
     cfg_info = get_analysis_result<ControlFlowGraph>(module);
     dom_info = get_analysis_result<DominanceGraph>(module);
     for (const auto &func: module->get_functions()) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     cfg_info = nullptr;
     dom_info = nullptr;
+    return changed;
 }
 
-void IfChainToSwitch::transform(const std::shared_ptr<Function> &func) {
-    create<StandardizeBinary>()->run_on(func);
+bool IfChainToSwitch::transform(const std::shared_ptr<Function> &func) {
+    bool changed = create<StandardizeBinary>()->run_on(func);
     cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
     dom_info = get_analysis_result<DominanceGraph>(Module::instance());
-    run_on_func(func);
+    changed |= run_on_func(func);
     cfg_info = nullptr;
     dom_info = nullptr;
+    return changed;
 }
 } // namespace Pass
@@ -33,7 +33,7 @@ bool Inlining::can_inline(const std::shared_ptr<Function> &func) const {
     return call_graph.empty() && !reverse_call_graph.empty() && !info.is_recursive;
 }
 
-void Inlining::do_inline(const std::shared_ptr<Function> &func) {
+bool Inlining::do_inline(const std::shared_ptr<Function> &func) {
     std::vector<std::shared_ptr<Call>> calls;
     const auto &reverse_call_graph{func_info->call_graph_reverse_func(func)};
 
@@ -48,12 +48,17 @@ void Inlining::do_inline(const std::shared_ptr<Function> &func) {
             }
         }
     };
-    std::for_each(reverse_call_graph.begin(), reverse_call_graph.end(), filter_calls);
+    // 调用者集合以函数的地址为键，按模块中函数的顺序遍历，内联顺序才是确定的
+    for (const auto &f: Module::instance()->get_functions()) {
+        if (reverse_call_graph.count(f)) {
+            filter_calls(f);
+        }
+    }
 
     for (const auto &call: calls) {
         replace_call(call, call->get_block()->get_function(), func);
-        cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
     }
+    return !calls.empty();
 }
 
 // 替换调用指令call为内联的函数体
@@ -80,6 +85,9 @@ void Inlining::replace_call(const std::shared_ptr<Call> &call, const std::shared
             }
         }
     }
+    // 内联体整体插入后支配关系变化较大，支配树不做局部修补，留待下次请求时重新计算
+    set_analysis_result_dirty<DominanceGraph>(caller);
+    cfg_info->split_block(caller, current_block, next_block);
 
     FunctionCloneHelper helper;
     const auto cloned_func = helper.clone_function(callee);
@@ -130,14 +138,16 @@ void Inlining::replace_call(const std::shared_ptr<Call> &call, const std::shared
     }
     for (const auto &block: cloned_func->get_blocks()) {
         block->set_function(caller);
+        cfg_info->insert_block(caller, block);
     }
+    cfg_info->insert_edge(caller, current_block, cloned_func->get_blocks().front());
+    cfg_info->delete_edge(caller, current_block, next_block);
     call->clear_operands();
     current_block->get_instructions().erase(Utils::inst_as_iter(call).value());
-    set_analysis_result_dirty<ControlFlowGraph>(caller);
     caller->update_id();
 }
 
-void Inlining::transform(const std::shared_ptr<Module> module) {
+bool Inlining::transform(const std::shared_ptr<Module> module) {
     cfg_info = get_analysis_result<ControlFlowGraph>(module);
     func_info = get_analysis_result<FunctionAnalysis>(module);
 
@@ -149,12 +159,14 @@ void Inlining::transform(const std::shared_ptr<Module> module) {
             can_inlined_functions.emplace_back(func);
     }
 
+    bool changed = false;
     for (const auto &func: can_inlined_functions) {
-        do_inline(func);
+        changed |= do_inline(func);
     }
 
     cfg_info = nullptr;
     func_info = nullptr;
-    create<SimplifyControlFlow>()->run_on(module);
+    changed |= create<SimplifyControlFlow>()->run_on_module(module);
+    return changed;
 }
 } // namespace Pass
@@ -8,17 +8,20 @@
 using namespace Mir;
 
 namespace {
-void try_constant_fold(const std::shared_ptr<Function> &func) {
+bool try_constant_fold(const std::shared_ptr<Function> &func) {
+    bool changed = false;
     for (const auto &block: func->get_blocks()) {
         for (auto it = block->get_instructions().begin(); it != block->get_instructions().end();) {
             if (Pass::GlobalValueNumbering::fold_instruction(*it)) {
                 (*it)->clear_operands();
                 it = block->get_instructions().erase(it);
+                changed = true;
             } else {
                 ++it;
             }
         }
     }
+    return changed;
 }
 
 void perform_merge(const std::shared_ptr<Block> &block, const std::shared_ptr<Block> &child) {
@@ -45,7 +48,8 @@ void perform_merge(const std::shared_ptr<Block> &block, const std::shared_ptr<Bl
     child->set_deleted();
 }
 
-void cleanup_phi(const std::shared_ptr<Function> &func, const std::shared_ptr<Pass::ControlFlowGraph> &cfg_info) {
+// 返回是否删除了 phi 指令或其中的选项
+bool cleanup_phi(const std::shared_ptr<Function> &func, const std::shared_ptr<Pass::ControlFlowGraph> &cfg_info) {
     const auto all_options_equal = [&](const std::shared_ptr<Phi> &phi) -> bool {
         const auto &optional_values = phi->get_optional_values();
         if (optional_values.empty()) {
@@ -59,7 +63,7 @@ void cleanup_phi(const std::shared_ptr<Function> &func, const std::shared_ptr<Pa
                            [&](const auto &pair) { return pair.second->get_name() == first_val->get_name(); });
     };
 
-    const auto remove_unreachable_phi_pairs = [&](const std::shared_ptr<Phi> &phi) -> void {
+    const auto remove_unreachable_phi_pairs = [&](const std::shared_ptr<Phi> &phi) -> bool {
         const auto &current_block = phi->get_block();
         const auto block_is_unreachable = [&](const std::shared_ptr<Block> &block) -> bool {
             if (block->is_deleted()) {
@@ -80,25 +84,29 @@ void cleanup_phi(const std::shared_ptr<Function> &func, const std::shared_ptr<Pa
         // 同时维护 operands 列表和 phi 指令自身持有的 optional_values
         std::for_each(to_be_deleted.begin(), to_be_deleted.end(),
                       [&](const auto &block) { phi->remove_optional_value(block); });
+        return !to_be_deleted.empty();
     };
 
+    bool changed = false;
     const auto &blocks = func->get_blocks();
     for (const auto &block: blocks) {
         for (auto it = block->get_instructions().begin(); it != block->get_instructions().end();) {
             if ((*it)->get_op() != Operator::PHI)
                 break;
             auto phi = std::static_pointer_cast<Phi>(*it);
-            remove_unreachable_phi_pairs(phi);
-            if (all_options_equal(phi) || phi->users().size() == 0) {
+            changed |= remove_unreachable_phi_pairs(phi);
+            if (all_options_equal(phi) || phi->num_uses() == 0) {
                 auto first_val = phi->get_optional_values().begin()->second;
                 phi->replace_by_new_value(first_val);
                 phi->clear_operands();
                 it = block->get_instructions().erase(it);
+                changed = true;
             } else {
                 ++it;
             }
         }
     }
+    return changed;
 }
 } // namespace
 
@@ -119,9 +127,6 @@ void SimplifyControlFlow::remove_deleted_blocks(const std::shared_ptr<Function>
                                     return true;
                                 }),
                  blocks.end());
-
-    set_analysis_result_dirty<ControlFlowGraph>(func);
-    set_analysis_result_dirty<DominanceGraph>(func);
 }
 
 bool SimplifyControlFlow::remove_unreachable_blocks(const std::shared_ptr<Function> &func) {
@@ -138,7 +143,7 @@ bool SimplifyControlFlow::remove_unreachable_blocks(const std::shared_ptr<Functi
         }
         const auto last_instruction = instructions.back();
         if (const auto op = last_instruction->get_op(); op == Operator::JUMP) {
-            self(self, last_instruction->as<Jump>()->get_target_block());
+            self(self, last_instruction->as_ptr<Jump>()->get_target_block());
         } else if (op == Operator::BRANCH) {
             const auto branch = last_instruction->as<Branch>();
             self(self, branch->get_true_block());
@@ -156,6 +161,7 @@ bool SimplifyControlFlow::remove_unreachable_blocks(const std::shared_ptr<Functi
 
     dfs(dfs, func->get_blocks().front());
 
+    const auto cfg_info = valid_analysis_result<ControlFlowGraph>(func);
     bool changed = false;
     auto &blocks = func->get_blocks();
     blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
@@ -169,21 +175,21 @@ bool SimplifyControlFlow::remove_unreachable_blocks(const std::shared_ptr<Functi
                                                   });
                                     block->clear_operands();
                                     block->set_deleted();
-                                    set_analysis_result_dirty<ControlFlowGraph>(func);
+                                    if (cfg_info != nullptr) {
+                                        cfg_info->remove_block(func, block);
+                                    }
                                     changed = true;
                                     return true;
                                 }),
                  blocks.end());
-
-    set_analysis_result_dirty<ControlFlowGraph>(func);
-    set_analysis_result_dirty<DominanceGraph>(func);
     return changed;
 }
 
 bool SimplifyControlFlow::run_on_func(const std::shared_ptr<Function> &func) const {
-    auto predecessors = cfg_info->graph(func).predecessors;
-    auto successors = cfg_info->graph(func).successors;
-    bool graph_modified{false}, changed{false};
+    // 修改控制流时通过增量更新同时维护控制流图与支配树
+    const auto &predecessors = cfg_info->graph(func).predecessors;
+    const auto &successors = cfg_info->graph(func).successors;
+    bool graph_modified{false}, changed{false}, folded{false};
 
     // 合并冗余分支：分支指令的两个目标为同一个块，或者分支指令的条件变量为常数
     [[maybe_unused]] const auto fold_redundant_branch = [&]() -> void {
@@ -208,14 +214,13 @@ bool SimplifyControlFlow::run_on_func(const std::shared_ptr<Function> &func) con
                 jump->set_block(block, false);
                 last_instruction->replace_by_new_value(jump);
                 last_instruction = jump;
-                // 手动更新
-                if (target_block == branch->get_true_block()) {
-                    successors.at(block).erase(branch->get_false_block());
-                    predecessors.at(branch->get_false_block()).erase(block);
-                } else {
-                    successors.at(block).erase(branch->get_true_block());
-                    predecessors.at(branch->get_true_block()).erase(block);
+                if (branch->get_true_block() != branch->get_false_block()) {
+                    cfg_info->delete_edge(func, block,
+                                          target_block == branch->get_true_block()
+                                              ? branch->get_false_block()
+                                              : branch->get_true_block());
                 }
+                graph_modified = true;
                 continue;
             }
             if (branch->get_true_block() == branch->get_false_block()) {
@@ -223,6 +228,7 @@ bool SimplifyControlFlow::run_on_func(const std::shared_ptr<Function> &func) con
                 jump->set_block(block, false);
                 last_instruction->replace_by_new_value(jump);
                 last_instruction = jump;
+                graph_modified = true;
             }
         }
     };
@@ -252,21 +258,13 @@ bool SimplifyControlFlow::run_on_func(const std::shared_ptr<Function> &func) con
             if (last_inst->get_op() != Operator::JUMP) {
                 continue;
             }
-            if (last_inst->as<Jump>()->get_target_block() != child) {
+            if (last_inst->as_ptr<Jump>()->get_target_block() != child) {
                 continue;
             }
             perform_merge(block, child);
             modified = true;
             graph_modified = true;
-            // 手动维护cfg
-            successors.at(block).erase(child);
-            successors.at(block).insert(successors.at(child).begin(), successors.at(child).end());
-            std::for_each(successors.at(child).begin(), successors.at(child).end(), [&](const auto &b) {
-                predecessors.at(b).erase(child);
-                predecessors.at(b).insert(block);
-            });
-            predecessors.erase(child);
-            successors.erase(child);
+            cfg_info->merge_blocks(func, block, child);
         }
         if (modified) {
             changed = true;
@@ -310,7 +308,7 @@ bool SimplifyControlFlow::run_on_func(const std::shared_ptr<Function> &func) con
                 continue;
             }
             const auto target = is_single_jump_block(block);
-            if (target == nullptr || target->is_deleted()) {
+            if (target == nullptr || target == block || target->is_deleted()) {
                 continue;
             }
             auto locked_users{block->users().lock()};
@@ -344,15 +342,7 @@ bool SimplifyControlFlow::run_on_func(const std::shared_ptr<Function> &func) con
                     user->modify_operand(block, target);
                 }
             }
-            // 手动维护cfg
-            for (const auto &pre: predecessors.at(block)) {
-                successors.at(pre).erase(block);
-                successors.at(pre).insert(target);
-                predecessors.at(target).insert(pre);
-            }
-            predecessors.erase(block);
-            successors.erase(block);
-            predecessors.at(target).erase(block);
+            cfg_info->bypass_block(func, block);
 
             block->get_instructions().clear();
             block->clear_operands();
@@ -422,14 +412,7 @@ bool SimplifyControlFlow::run_on_func(const std::shared_ptr<Function> &func) con
             Branch::create(branch->get_cond(), branch->get_true_block(), branch->get_false_block(), candidate_block);
             block->replace_by_new_value(candidate_block);
 
-            // 手动维护cfg
-            successors.at(candidate_block).erase(block);
-            successors.at(candidate_block).insert({branch->get_true_block(), branch->get_false_block()});
-            predecessors.at(branch->get_true_block()).insert(candidate_block);
-            predecessors.at(branch->get_false_block()).insert(candidate_block);
-
-            predecessors.erase(block);
-            successors.erase(block);
+            cfg_info->merge_blocks(func, candidate_block, block);
             block->get_instructions().clear();
             block->clear_operands();
             block->set_deleted();
@@ -475,21 +458,16 @@ bool SimplifyControlFlow::run_on_func(const std::shared_ptr<Function> &func) con
             remove_deleted_blocks(func);
             remove_unreachable_blocks(func);
         }
-        try_constant_fold(func);
+        folded |= try_constant_fold(func);
     } while (changed);
-
-    if (graph_modified) {
-        set_analysis_result_dirty<ControlFlowGraph>(func);
-        set_analysis_result_dirty<DominanceGraph>(func);
-    }
-    return graph_modified;
+    return graph_modified || folded;
 }
 
-void SimplifyControlFlow::transform(const std::shared_ptr<Module> module) {
+bool SimplifyControlFlow::transform(const std::shared_ptr<Module> module) {
     // 预处理：清除不可达基本块
-    create<AlgebraicSimplify>()->run_on(module);
+    bool modified = create<AlgebraicSimplify>()->run_on_module(module);
     for (const auto &func: module->get_functions()) {
-        remove_unreachable_blocks(func);
+        modified |= remove_unreachable_blocks(func);
     }
 
     bool changed;
@@ -504,29 +482,33 @@ void SimplifyControlFlow::transform(const std::shared_ptr<Module> module) {
         cfg_info = get_analysis_result<ControlFlowGraph>(module);
 
         for (const auto &func: module->get_functions()) {
-            cleanup_phi(func, cfg_info);
+            modified |= cleanup_phi(func, cfg_info);
         }
 
         for (const auto &func: module->get_functions()) {
-            remove_unreachable_blocks(func);
+            modified |= remove_unreachable_blocks(func);
         }
+        modified |= changed;
     } while (changed);
-    set_analysis_result_dirty<ControlFlowGraph>(module);
     cfg_info = nullptr;
-    create<AlgebraicSimplify>()->run_on(module);
+    modified |= create<AlgebraicSimplify>()->run_on_module(module);
+    return modified;
 }
 
-void SimplifyControlFlow::transform(const std::shared_ptr<Function> &func) {
-    remove_unreachable_blocks(func);
+bool SimplifyControlFlow::transform(const std::shared_ptr<Function> &func) {
+    // 与模块级驱动保持一致：run_on_func 折叠常量分支后不一定报告修改，需要在每轮之后清除不可达基本块
+    bool modified = create<AlgebraicSimplify>()->run_on(func);
+    modified |= remove_unreachable_blocks(func);
     bool changed;
     do {
         cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
         changed = run_on_func(func);
         cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
-        cleanup_phi(func, cfg_info);
+        modified |= changed | cleanup_phi(func, cfg_info);
+        modified |= remove_unreachable_blocks(func);
     } while (changed);
-    set_analysis_result_dirty<ControlFlowGraph>(func);
     cfg_info = nullptr;
-    create<AlgebraicSimplify>()->run_on(func);
+    modified |= create<AlgebraicSimplify>()->run_on(func);
+    return modified;
 }
 } // namespace Pass
@@ -4,7 +4,7 @@
 using namespace Mir;
 
 namespace Pass {
-void SingleReturnTransform::run_on_func(const std::shared_ptr<Function> &func) {
+bool SingleReturnTransform::run_on_func(const std::shared_ptr<Function> &func) {
     const auto &blocks{func->get_blocks()};
     std::unordered_map<std::shared_ptr<Block>, std::shared_ptr<Ret>> rets;
     const auto return_cnt = std::count_if(blocks.begin(), blocks.end(), [&rets](const auto &block) {
@@ -15,7 +15,7 @@ void SingleReturnTransform::run_on_func(const std::shared_ptr<Function> &func) {
         return false;
     });
     if (return_cnt < 2) {
-        return;
+        return false;
     }
     const auto ret_block{Block::create("ret_block", func)};
     for (const auto &[block, ret]: rets) {
@@ -26,7 +26,7 @@ void SingleReturnTransform::run_on_func(const std::shared_ptr<Function> &func) {
     set_analysis_result_dirty<DominanceGraph>(func);
     if (func->get_return_type()->is_void()) {
         Ret::create(ret_block);
-        return;
+        return true;
     }
     const auto phi{Phi::create("ret.phi", func->get_return_type(), ret_block, {})};
     for (const auto &[block, ret]: rets) {
@@ -42,13 +42,16 @@ void SingleReturnTransform::run_on_func(const std::shared_ptr<Function> &func) {
         }
     }
     Ret::create(phi, ret_block);
+    return true;
 }
 
-void SingleReturnTransform::transform(const std::shared_ptr<Module> module) {
+bool SingleReturnTransform::transform(const std::shared_ptr<Module> module) {
+    bool changed = false;
     for (const auto &func: *module) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
+    return changed;
 }
 
-void SingleReturnTransform::transform(const std::shared_ptr<Function> &func) { run_on_func(func); }
+bool SingleReturnTransform::transform(const std::shared_ptr<Function> &func) { return run_on_func(func); }
 } // namespace Pass
@@ -52,10 +52,10 @@ bool path_without_stack_access(const std::shared_ptr<Call> &call, const std::sha
     const auto stack_access_in_inst = [&](const std::shared_ptr<Instruction> &inst) -> bool {
         switch (inst->get_op()) {
             case Operator::LOAD: {
-                return access_stack(access_stack, inst->as<Load>()->get_addr());
+                return access_stack(access_stack, inst->as_ptr<Load>()->get_addr());
             }
             case Operator::STORE: {
-                return access_stack(access_stack, inst->as<Store>()->get_addr());
+                return access_stack(access_stack, inst->as_ptr<Store>()->get_addr());
             }
             case Operator::CALL: {
                 const auto _call{inst->as<Call>()};
@@ -150,10 +150,10 @@ bool has_stack_access_in_range(const std::vector<std::shared_ptr<Instruction>>::
     const auto stack_access_in_inst = [&](const std::shared_ptr<Instruction> &inst) -> bool {
         switch (inst->get_op()) {
             case Operator::LOAD: {
-                return access_stack(access_stack, inst->as<Load>()->get_addr());
+                return access_stack(access_stack, inst->as_ptr<Load>()->get_addr());
             }
             case Operator::STORE: {
-                return access_stack(access_stack, inst->as<Store>()->get_addr());
+                return access_stack(access_stack, inst->as_ptr<Store>()->get_addr());
             }
             case Operator::CALL: {
                 const auto _call{inst->as<Call>()};
@@ -174,7 +174,7 @@ bool has_stack_access_in_range(const std::vector<std::shared_ptr<Instruction>>::
 // 恒等元用于在 phi 节点初始化时能够正确地表示“还没累积任何值”的状态
 std::shared_ptr<Value> get_identity_element(const std::shared_ptr<Instruction> &inst) {
     const auto &type{inst->get_type()};
-    switch (inst->as<IntBinary>()->intbinary_op()) {
+    switch (inst->as_ptr<IntBinary>()->intbinary_op()) {
         case IntBinary::Op::ADD:
         case IntBinary::Op::SUB:
         case IntBinary::Op::OR:
@@ -191,7 +191,7 @@ std::shared_ptr<Value> get_identity_element(const std::shared_ptr<Instruction> &
 } // namespace
 
 namespace Pass {
-void TailCallOptimize::tail_call_detect(const std::shared_ptr<Function> &func) const {
+bool TailCallOptimize::tail_call_detect(const std::shared_ptr<Function> &func) const {
     // 1. 收集所有 alloca 指令 (栈分配)
     std::unordered_set<std::shared_ptr<Value>> stack_allocs;
     for (const auto &block: func->get_blocks()) {
@@ -201,16 +201,19 @@ void TailCallOptimize::tail_call_detect(const std::shared_ptr<Function> &func) c
             }
         }
     }
+    bool marked = false;
     if (stack_allocs.empty()) {
         // 如果没有栈分配，所有对自身函数的调用都可以是尾调用
         for (const auto &block: func->get_blocks()) {
             for (const auto &inst: block->get_instructions()) {
-                if (inst->get_op() == Operator::CALL && inst->as<Call>()->get_function() == func) {
-                    inst->as<Call>()->set_tail_call();
+                if (inst->get_op() == Operator::CALL && inst->as_ptr<Call>()->get_function() == func &&
+                    !inst->as_ptr<Call>()->is_tail_call()) {
+                    inst->as_ptr<Call>()->set_tail_call();
+                    marked = true;
                 }
             }
         }
-        return;
+        return marked;
     }
 
     // 识别所有直接包含栈访问的块
@@ -260,7 +263,7 @@ void TailCallOptimize::tail_call_detect(const std::shared_ptr<Function> &func) c
     std::vector<std::shared_ptr<Call>> candidates;
     for (const auto &block: func->get_blocks()) {
         for (const auto &inst: block->get_instructions()) {
-            if (inst->get_op() == Operator::CALL && inst->as<Call>()->get_function() == func) {
+            if (inst->get_op() == Operator::CALL && inst->as_ptr<Call>()->get_function() == func) {
                 candidates.push_back(inst->as<Call>());
             }
         }
@@ -280,24 +283,26 @@ void TailCallOptimize::tail_call_detect(const std::shared_ptr<Function> &func) c
             continue;
         }
         // 从该块退出后，路径上是否可能有栈访问
-        if (may_access_stack_on_exit.at(call_block)) {
+        if (may_access_stack_on_exit.at(call_block) || call->is_tail_call()) {
             continue;
         }
         call->set_tail_call();
+        marked = true;
     }
+    return marked;
 }
 
 // 参见：https://github.com/llvm/llvm-project/blob/main/llvm/lib/Transforms/Scalar/TailRecursionElimination.cpp
-void TailCallOptimize::tail_call_eliminate(const std::shared_ptr<Function> &func) const {
+bool TailCallOptimize::tail_call_eliminate(const std::shared_ptr<Function> &func) const {
     const auto &func_data{func_info->func_info(func)};
     if (!func_data.is_recursive) {
-        return;
+        return false;
     }
     if (func_data.memory_alloc || func_data.has_side_effect || func_data.memory_write || !func_data.no_state) {
-        return;
+        return false;
     }
     if (const auto &entry{func->get_blocks().front()}; entry->get_instructions().empty() || find_tre_candidate(entry)) {
-        return;
+        return false;
     }
 
     const auto handle_block = [&](const std::shared_ptr<Block> &block) -> bool {
@@ -307,7 +312,7 @@ void TailCallOptimize::tail_call_eliminate(const std::shared_ptr<Function> &func
                 return handle_tail_call(call);
             }
         } else if (type == Operator::JUMP) {
-            const auto &target_block{terminator->as<Jump>()->get_target_block()};
+            const auto &target_block{terminator->as_ptr<Jump>()->get_target_block()};
             for (const auto &inst: target_block->get_instructions()) {
                 if (const auto _type{inst->get_op()}; _type == Operator::PHI) {
                     continue;
@@ -337,7 +342,7 @@ void TailCallOptimize::tail_call_eliminate(const std::shared_ptr<Function> &func
                     if (phi->get_op() != Operator::PHI) {
                         break;
                     }
-                    phi->as<Phi>()->remove_optional_value(block);
+                    phi->as_ptr<Phi>()->remove_optional_value(block);
                 }
                 handle_tail_call(call);
                 return true;
@@ -350,9 +355,10 @@ void TailCallOptimize::tail_call_eliminate(const std::shared_ptr<Function> &func
     for (const auto &block: func->get_blocks()) {
         if (handle_block(block)) {
             set_analysis_result_dirty<ControlFlowGraph>(func);
-            return;
+            return true;
         }
     }
+    return false;
 }
 
 bool TailCallOptimize::handle_tail_call(const std::shared_ptr<Call> &call) {
@@ -383,7 +389,7 @@ bool TailCallOptimize::handle_tail_call(const std::shared_ptr<Call> &call) {
                 return false;
             }
             // 确保累加器的结果只被return语句使用
-            if (!(accumulator->users().size() == 1 && *accumulator->users().begin() == ret)) {
+            if (accumulator->single_user() != ret) {
                 return false;
             }
         } else if (intbinary->intbinary_op() == IntBinary::Op::SUB) {
@@ -392,7 +398,7 @@ bool TailCallOptimize::handle_tail_call(const std::shared_ptr<Call> &call) {
                 return false;
             }
             // 确保累加器的结果只被return语句使用
-            if (!(accumulator->users().size() == 1 && *accumulator->users().begin() == ret)) {
+            if (accumulator->single_user() != ret) {
                 return false;
             }
         } else {
@@ -459,7 +465,7 @@ bool TailCallOptimize::handle_tail_call(const std::shared_ptr<Call> &call) {
         // 用累加器的phi节点替换递归调用
         call->replace_by_new_value(acc_value);
 
-        if (call->users().size() != 0) {
+        if (call->num_uses() != 0) {
             log_error("Shouldn't reach here");
         }
     }
@@ -467,7 +473,7 @@ bool TailCallOptimize::handle_tail_call(const std::shared_ptr<Call> &call) {
     std::vector<std::shared_ptr<Select>> selects;
     // 处理返回值的phi节点设置
     if (ret_value) {
-        if (acc_value || call->users().size() > 0) {
+        if (acc_value || call->num_uses() > 0) {
             // 如果有累加器或调用有其他用户，直接设置phi值
             ret_value->set_optional_value(block, ret_value);
             ret_valid->set_optional_value(block, ret_valid);
@@ -500,13 +506,13 @@ bool TailCallOptimize::handle_tail_call(const std::shared_ptr<Call> &call) {
             if (acc_value && accumulator) {
                 for (const auto &b: func->get_blocks()) {
                     if (const auto terminator{b->get_instructions().back()}; terminator->get_op() == Operator::RET) {
-                        const auto _ret_value{terminator->as<Ret>()->get_value()};
+                        const auto _ret_value{terminator->as_ptr<Ret>()->get_value()};
                         // 克隆累加器指令
                         const auto _acc{accumulator->clone_exact()};
                         // 修改累加器操作数，将累加器值替换为当前返回值
                         _acc->modify_operand(_acc->get_operands()[_acc->get_operands()[0] == acc_value], _ret_value);
                         Utils::move_instruction_before(_acc, terminator);
-                        terminator->as<Ret>()->modify_operand(_ret_value, _acc);
+                        terminator->as_ptr<Ret>()->modify_operand(_ret_value, _acc);
                     }
                 }
             }
@@ -514,11 +520,11 @@ bool TailCallOptimize::handle_tail_call(const std::shared_ptr<Call> &call) {
             // 为每个return语句创建条件选择
             for (const auto &b: func->get_blocks()) {
                 if (const auto terminator{b->get_instructions().back()}; terminator->get_op() == Operator::RET) {
-                    const auto _ret_value{terminator->as<Ret>()->get_value()};
+                    const auto _ret_value{terminator->as_ptr<Ret>()->get_value()};
                     const auto select{Select::create("select", ret_valid, ret_value, _ret_value, block)};
                     Utils::move_instruction_before(select, terminator);
                     selects.push_back(select);
-                    terminator->as<Ret>()->modify_operand(_ret_value, select);
+                    terminator->as_ptr<Ret>()->modify_operand(_ret_value, select);
                 }
             }
             // 为每个条件选择添加累加操作
@@ -536,30 +542,34 @@ bool TailCallOptimize::handle_tail_call(const std::shared_ptr<Call> &call) {
     return true;
 }
 
-void TailCallOptimize::run_on_func(const std::shared_ptr<Function> &func) const {
-    tail_call_detect(func);
+bool TailCallOptimize::run_on_func(const std::shared_ptr<Function> &func) const {
+    bool changed = tail_call_detect(func);
     // log_debug("%s", func->to_string().c_str());
-    tail_call_eliminate(func);
+    changed |= tail_call_eliminate(func);
     // log_debug("%s", func->to_string().c_str());
+    return changed;
 }
 
-void TailCallOptimize::transform(const std::shared_ptr<Module> module) {
-    create<SimplifyControlFlow>()->run_on(module);
+bool TailCallOptimize::transform(const std::shared_ptr<Module> module) {
+    bool changed = create<SimplifyControlFlow>()->run_on_module(module);
     cfg_info = get_analysis_result<ControlFlowGraph>(module);
     func_info = get_analysis_result<FunctionAnalysis>(module);
     for (const auto &func: module->get_functions()) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     cfg_info = nullptr;
     func_info = nullptr;
+    return changed;
 }
 
-void TailCallOptimize::transform(const std::shared_ptr<Function> &func) {
+bool TailCallOptimize::transform(const std::shared_ptr<Function> &func) {
+    // 简化控制流作用于整个模块，其他函数的修改无法在此报告，保守地认为已修改
     create<SimplifyControlFlow>()->run_on(Module::instance());
     cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
     func_info = get_analysis_result<FunctionAnalysis>(Module::instance());
     run_on_func(func);
     cfg_info = nullptr;
     func_info = nullptr;
+    return true;
 }
 } // namespace Pass
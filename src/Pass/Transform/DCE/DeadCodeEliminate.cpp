@@ -60,7 +60,7 @@ void DeadCodeEliminate::update_useful_instruction(const std::shared_ptr<Instruct
             if (const auto op = inst->get_op();
                 op == Operator::STORE || op == Operator::GEP || op == Operator::CALL || op == Operator::BITCAST) {
                 useful_instructions_.insert(inst);
-            } else if (inst->users().size() > 0) {
+            } else if (inst->num_uses() > 0) {
                 useful_instructions_.insert(inst);
             }
         }
@@ -70,7 +70,7 @@ void DeadCodeEliminate::update_useful_instruction(const std::shared_ptr<Instruct
 std::unordered_set<std::shared_ptr<Instruction>>
 DeadCodeEliminate::dead_global_variable_eliminate(const std::shared_ptr<Module> &module) {
     for (auto it = module->get_global_variables().begin(); it != module->get_global_variables().end();) {
-        if (const auto &gv = *it; gv->users().size() == 0) {
+        if (const auto &gv = *it; gv->num_uses() == 0) {
             it = module->get_global_variables().erase(it);
         } else {
             ++it;
@@ -86,7 +86,7 @@ DeadCodeEliminate::dead_global_variable_eliminate(const std::shared_ptr<Module>
             if (const auto op = inst->get_op();
                 op == Operator::STORE || op == Operator::GEP || op == Operator::CALL || op == Operator::BITCAST) {
                 useful_instructions.insert(inst);
-            } else if (inst->users().size() > 0) {
+            } else if (inst->num_uses() > 0) {
                 useful_instructions.insert(inst);
             }
         }
@@ -94,7 +94,7 @@ DeadCodeEliminate::dead_global_variable_eliminate(const std::shared_ptr<Module>
     return useful_instructions;
 }
 
-void DeadCodeEliminate::run_on_func(const std::shared_ptr<Function> &func,
+bool DeadCodeEliminate::run_on_func(const std::shared_ptr<Function> &func,
                                     const std::unordered_set<std::shared_ptr<Instruction>> &initial) {
     useful_instructions_.clear();
     useful_instructions_.insert(initial.begin(), initial.end());
@@ -107,33 +107,40 @@ void DeadCodeEliminate::run_on_func(const std::shared_ptr<Function> &func,
         }
         changed = snap.size() != useful_instructions_.size();
     } while (changed);
+    bool removed = false;
     for (const auto &block: func->get_blocks()) {
         for (auto it = block->get_instructions().begin(); it != block->get_instructions().end();) {
             if (useful_instructions_.find(*it) == useful_instructions_.end()) {
                 (*it)->clear_operands();
                 it = block->get_instructions().erase(it);
+                removed = true;
             } else {
                 ++it;
             }
         }
     }
+    return removed;
 }
 
-void DeadCodeEliminate::transform(const std::shared_ptr<Module> module) {
+bool DeadCodeEliminate::transform(const std::shared_ptr<Module> module) {
     function_analysis_ = get_analysis_result<FunctionAnalysis>(module);
+    const size_t global_count = module->get_global_variables().size();
     const auto initial_usefuls = dead_global_variable_eliminate(module);
+    bool changed = false;
     for (const auto &func: *module) {
-        run_on_func(func, initial_usefuls);
+        changed |= run_on_func(func, initial_usefuls);
     }
     dead_global_variable_eliminate(module);
     function_analysis_ = nullptr;
+    return changed || module->get_global_variables().size() != global_count;
 }
 
-void DeadCodeEliminate::transform(const std::shared_ptr<Function> &func) {
+bool DeadCodeEliminate::transform(const std::shared_ptr<Function> &func) {
     function_analysis_ = get_analysis_result<FunctionAnalysis>(Module::instance());
     const auto initial_usefuls = dead_global_variable_eliminate(Module::instance());
-    run_on_func(func, initial_usefuls);
+    const bool changed = run_on_func(func, initial_usefuls);
     dead_global_variable_eliminate(Module::instance());
     function_analysis_ = nullptr;
+    return changed;
 }
 } // namespace Pass
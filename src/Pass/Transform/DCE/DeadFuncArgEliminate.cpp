@@ -3,9 +3,9 @@
 using namespace Mir;
 
 namespace Pass {
-void DeadFuncArgEliminate::run_on_func(const std::shared_ptr<Function> &func) const {
+bool DeadFuncArgEliminate::run_on_func(const std::shared_ptr<Function> &func) const {
     if (func->get_arguments().empty()) {
-        return;
+        return false;
     }
     std::unordered_set<std::shared_ptr<Argument>> args_to_delete;
     std::vector<size_t> indices_to_delete;
@@ -13,10 +13,13 @@ void DeadFuncArgEliminate::run_on_func(const std::shared_ptr<Function> &func) co
                                const std::shared_ptr<Value> &arg) -> bool {
         auto current_value = arg;
         auto current_inst = inst;
-        while (current_inst->get_op() != Operator::CALL && current_inst->users().size() == 1 &&
-               std::dynamic_pointer_cast<Instruction>(*current_inst->users().begin())) {
+        while (current_inst->get_op() != Operator::CALL) {
+            const auto next_inst = std::dynamic_pointer_cast<Instruction>(current_inst->single_user());
+            if (next_inst == nullptr) {
+                break;
+            }
             current_value = current_inst;
-            current_inst = (*current_inst->users().begin())->as<Instruction>();
+            current_inst = next_inst;
         }
         if (current_inst->get_op() == Operator::CALL) {
             const auto &call = current_inst->as<Call>();
@@ -29,7 +32,7 @@ void DeadFuncArgEliminate::run_on_func(const std::shared_ptr<Function> &func) co
     };
     for (size_t i = 0; i < func->get_arguments().size(); ++i) {
         const auto &arg = func->get_arguments()[i];
-        if (arg->users().size() == 0) {
+        if (arg->num_uses() == 0) {
             args_to_delete.insert(arg);
             indices_to_delete.push_back(i);
             continue;
@@ -48,6 +51,9 @@ void DeadFuncArgEliminate::run_on_func(const std::shared_ptr<Function> &func) co
             }
         }
     }
+    if (args_to_delete.empty()) {
+        return false;
+    }
     for (auto it = func->get_arguments().begin(); it != func->get_arguments().end();) {
         if (args_to_delete.find(*it) != args_to_delete.end()) {
             it = func->get_arguments().erase(it);
@@ -57,7 +63,7 @@ void DeadFuncArgEliminate::run_on_func(const std::shared_ptr<Function> &func) co
     }
     func->update_id();
     std::vector<std::shared_ptr<Call>> calls;
-    calls.reserve(func->users().size());
+    calls.reserve(func->num_uses());
     for (const auto &user: func->users()) {
         if (const auto call = std::dynamic_pointer_cast<Call>(user)) {
             calls.push_back(call);
@@ -91,14 +97,17 @@ void DeadFuncArgEliminate::run_on_func(const std::shared_ptr<Function> &func) co
         *it = new_call;
     }
     func->update_id();
+    return true;
 }
 
-void DeadFuncArgEliminate::transform(const std::shared_ptr<Module> module) {
+bool DeadFuncArgEliminate::transform(const std::shared_ptr<Module> module) {
     function_analysis_ = get_analysis_result<FunctionAnalysis>(module);
     const auto &topo = function_analysis_->topo();
+    bool changed = false;
     for (const auto &func: topo) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     function_analysis_ = nullptr;
+    return changed;
 }
 } // namespace Pass
@@ -9,7 +9,7 @@ using FunctionMap = std::unordered_map<FunctionPtr, std::unordered_set<FunctionP
 using FunctionSet = std::unordered_set<FunctionPtr>;
 
 namespace Pass {
-void DeadFuncEliminate::transform(const std::shared_ptr<Module> module) {
+bool DeadFuncEliminate::transform(const std::shared_ptr<Module> module) {
     const auto func_analysis = get_analysis_result<FunctionAnalysis>(module);
     const auto main_func = module->get_main_function();
     FunctionSet reachable_functions;
@@ -24,6 +24,7 @@ void DeadFuncEliminate::transform(const std::shared_ptr<Module> module) {
         }
     };
     dfs(dfs, main_func, reachable_functions);
+    bool changed = false;
     for (auto it = module->get_functions().begin(); it != module->get_functions().end();) {
         if (reachable_functions.find(*it) == reachable_functions.end()) {
             const auto func = *it;
@@ -37,9 +38,11 @@ void DeadFuncEliminate::transform(const std::shared_ptr<Module> module) {
             it = module->get_functions().erase(it);
             get_analysis_result<ControlFlowGraph>(module)->remove(func);
             get_analysis_result<DominanceGraph>(module)->remove(func);
+            changed = true;
         } else {
             ++it;
         }
     }
+    return changed;
 }
 } // namespace Pass
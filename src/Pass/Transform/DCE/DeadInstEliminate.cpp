@@ -9,7 +9,7 @@ namespace Pass {
 // 如果指令User为空，且指令本身不带有副作用，则认为其是无用的
 // 效果较差，无法删除冗余数组的定义，可使用DCE取得更好的效果
 bool DeadInstEliminate::is_dead_instruction(const std::shared_ptr<Instruction> &instruction) const {
-    if (instruction->users().size() > 0) {
+    if (instruction->num_uses() > 0) {
         return false;
     }
     // instruction无返回值
@@ -50,15 +50,18 @@ bool DeadInstEliminate::remove_unused_instructions(const std::shared_ptr<Module>
     return changed;
 }
 
-void DeadInstEliminate::transform(const std::shared_ptr<Module> module) {
+bool DeadInstEliminate::transform(const std::shared_ptr<Module> module) {
     func_analysis = get_analysis_result<FunctionAnalysis>(module);
+    bool changed = false;
     while (remove_unused_instructions(module)) {
         func_analysis = get_analysis_result<FunctionAnalysis>(module);
+        changed = true;
     }
     func_analysis = nullptr;
+    return changed;
 }
 
-void DeadInstEliminate::transform(const std::shared_ptr<Function> &func) {
+bool DeadInstEliminate::transform(const std::shared_ptr<Function> &func) {
     func_analysis = get_analysis_result<FunctionAnalysis>(Module::instance());
     bool changed = false;
     for (const auto &block: func->get_blocks()) {
@@ -76,5 +79,6 @@ void DeadInstEliminate::transform(const std::shared_ptr<Function> &func) {
         func_analysis = get_analysis_result<FunctionAnalysis>(Module::instance());
     }
     func_analysis = nullptr;
+    return changed;
 }
 } // namespace Pass
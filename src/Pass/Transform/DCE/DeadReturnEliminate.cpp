@@ -3,20 +3,20 @@
 using namespace Mir;
 
 namespace Pass {
-void DeadReturnEliminate::run_on_func(const std::shared_ptr<Function> &func) {
+bool DeadReturnEliminate::run_on_func(const std::shared_ptr<Function> &func) {
     // 不处理main；不处理返回值已为void的函数
     if (func->get_name() == "main" || func->get_return_type()->is_void()) {
-        return;
+        return false;
     }
     bool ret_used = false;
     for (const auto &user: func->users()) {
-        if (user->users().size() > 0) {
+        if (user->num_uses() > 0) {
             ret_used = true;
             break;
         }
     }
     if (ret_used) {
-        return;
+        return false;
     }
     func->set_type(Type::Void::void_);
     for (const auto &block: func->get_blocks()) {
@@ -34,19 +34,23 @@ void DeadReturnEliminate::run_on_func(const std::shared_ptr<Function> &func) {
             call->set_type(Type::Void::void_);
         }
     }
+    return true;
 }
 
-void DeadReturnEliminate::transform(const std::shared_ptr<Module> module) {
+bool DeadReturnEliminate::transform(const std::shared_ptr<Module> module) {
     function_analysis_ = get_analysis_result<FunctionAnalysis>(module);
+    bool changed = false;
     for (const auto &func: *module) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     function_analysis_ = nullptr;
+    return changed;
 }
 
-void DeadReturnEliminate::transform(const std::shared_ptr<Function> &func) {
+bool DeadReturnEliminate::transform(const std::shared_ptr<Function> &func) {
     function_analysis_ = get_analysis_result<FunctionAnalysis>(Module::instance());
-    run_on_func(func);
+    const bool changed = run_on_func(func);
     function_analysis_ = nullptr;
+    return changed;
 }
 } // namespace Pass
@@ -207,7 +207,7 @@ Pass::IntervalAnalysis::IntervalSet<T> BranchConstrainReduceImpl::get_interval(c
                                                                                const std::shared_ptr<Block> &block) {
     Pass::IntervalAnalysis::IntervalSet<T> res;
     if (value->is_constant()) {
-        const auto constant = value->as<Const>()->get_constant_value();
+        const auto constant = value->as_ptr<Const>()->get_constant_value();
         res = std::visit([](const auto c) { return Pass::IntervalAnalysis::IntervalSet<T>(c); }, constant);
     } else if (const auto inst = value->is<Instruction>()) {
         const auto ctx = interval->ctx_after(inst, block);
@@ -238,7 +238,7 @@ void BranchConstrainReduceImpl::run_on_block(const std::shared_ptr<Block> &block
                 if (rhs->is_constant()) {
                     // b是常数 => c - a = b, a - c = -b
                     // c - a <= b, a - c <= -b
-                    const auto constant_rhs = **rhs->as<ConstInt>();
+                    const auto constant_rhs = **rhs->as_ptr<ConstInt>();
                     const int idx = id_map[lhs];
                     constraint.add_relation(intbinary_id, idx, constant_rhs);
                     constraint.add_relation(idx, intbinary_id, -constant_rhs);
@@ -251,7 +251,7 @@ void BranchConstrainReduceImpl::run_on_block(const std::shared_ptr<Block> &block
                 if (rhs->is_constant()) {
                     // b是常数 => c - a = -b, a - c = b
                     // c - a <= -b, a - c <= b
-                    const auto constant_rhs = **rhs->as<ConstInt>();
+                    const auto constant_rhs = **rhs->as_ptr<ConstInt>();
                     const int idx = id_map[lhs];
                     constraint.add_relation(intbinary_id, idx, -constant_rhs);
                     constraint.add_relation(idx, intbinary_id, constant_rhs);
@@ -263,14 +263,14 @@ void BranchConstrainReduceImpl::run_on_block(const std::shared_ptr<Block> &block
                 // c = a * b;
                 if (!lhs->is_constant()) {
                     const int idx = id_map[lhs];
-                    if (rhs->is_constant() && **rhs->as<ConstInt>() == 1) {
+                    if (rhs->is_constant() && **rhs->as_ptr<ConstInt>() == 1) {
                         // c = a * 1 => c = a;
                         constraint.add_relation(intbinary_id, idx, Icmp::Op::EQ);
                     }
                 }
                 if (!rhs->is_constant()) {
                     const int idx = id_map[rhs];
-                    if (lhs->is_constant() && **lhs->as<ConstInt>() == 1) {
+                    if (lhs->is_constant() && **lhs->as_ptr<ConstInt>() == 1) {
                         constraint.add_relation(intbinary_id, idx, Icmp::Op::EQ);
                     }
                 }
@@ -280,7 +280,7 @@ void BranchConstrainReduceImpl::run_on_block(const std::shared_ptr<Block> &block
                 // c = a / b
                 if (!lhs->is_constant()) {
                     const int idx = id_map[lhs];
-                    if (rhs->is_constant() && **rhs->as<ConstInt>() == 1) {
+                    if (rhs->is_constant() && **rhs->as_ptr<ConstInt>() == 1) {
                         // c = a / 1 => c = a;
                         constraint.add_relation(intbinary_id, idx, Icmp::Op::EQ);
                     }
@@ -315,7 +315,7 @@ void BranchConstrainReduceImpl::run_on_block(const std::shared_ptr<Block> &block
         auto child_constraint = constraint;
         if (const auto terminator = block->get_instructions().back(); terminator->get_op() == Operator::BRANCH) {
             const auto branch = terminator->as<Branch>();
-            if (const auto icmp = terminator->as<Branch>()->get_cond()->is<Icmp>()) {
+            if (const auto icmp = terminator->as_ptr<Branch>()->get_cond()->is<Icmp>()) {
                 if (const auto &lhs = icmp->get_lhs(), &rhs = icmp->get_rhs();
                     !lhs->is_constant() && !rhs->is_constant()) {
                     const auto idx1 = id_map[lhs], idx2 = id_map[rhs];
@@ -347,8 +347,8 @@ bool BranchConstrainReduceImpl::impl() {
 } // namespace
 
 namespace Pass {
-void ConstrainReduce::transform(const std::shared_ptr<Module> module) {
-    create<StandardizeBinary>()->run_on(module);
+bool ConstrainReduce::transform(const std::shared_ptr<Module> module) {
+    bool changed = create<StandardizeBinary>()->run_on_module(module);
     const auto cfg_info = get_analysis_result<ControlFlowGraph>(module);
     const auto dom_info = get_analysis_result<DominanceGraph>(module);
     const auto loop_info = get_analysis_result<LoopAnalysis>(module);
@@ -359,8 +359,10 @@ void ConstrainReduce::transform(const std::shared_ptr<Module> module) {
         if (impl.impl()) {
             set_analysis_result_dirty<ControlFlowGraph>(func);
             set_analysis_result_dirty<DominanceGraph>(func);
+            changed = true;
         }
     }
-    create<DeadInstEliminate>()->run_on(module);
+    changed |= create<DeadInstEliminate>()->run_on_module(module);
+    return changed;
 }
 } // namespace Pass
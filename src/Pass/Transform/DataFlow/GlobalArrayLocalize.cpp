@@ -5,68 +5,40 @@
 using namespace Mir;
 
 namespace {
-void replace_const_array_gv(const std::shared_ptr<Module> &module) {
+// 返回是否替换了 load
+bool replace_const_array_gv(const std::shared_ptr<Module> &module) {
     std::vector<std::shared_ptr<GlobalVariable>> can_replaced;
     for (const auto &gv: module->get_global_variables()) {
-        if (const auto gv_type = gv->get_type()->as<Type::Pointer>()->get_contain_type();
+        if (const auto gv_type = gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type();
             gv_type->is_array() && gv->is_constant_gv()) {
             can_replaced.push_back(gv);
         }
     }
 
+    bool changed = false;
     for (const auto &gv: can_replaced) {
-        const auto array_type = gv->get_type()->as<Type::Pointer>()->get_contain_type();
-        std::vector<int> array_dimensions;
-        std::shared_ptr<Type::Type> _type = array_type;
-        while (_type->is_array()) {
-            array_dimensions.push_back(static_cast<int>(_type->as<Type::Array>()->get_size()));
-            _type = _type->as<Type::Array>()->get_element_type();
-        }
-
-        const auto l = array_dimensions.size();
-        if (l == 0) {
-            continue;
-        }
-
-        std::vector<int> array_strides;
-        array_strides.resize(l);
-
-        array_strides[l - 1] = 1;
-        for (int i = static_cast<int>(l) - 2; i >= 0; --i) {
-            array_strides[i] = array_strides[i + 1] * array_dimensions[i + 1];
-        }
-
+        const auto array_type = gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type()->as<Type::Array>();
         const auto array_initial = gv->get_init_value()->as<Init::Array>();
         for (const auto &gv_user: gv->users()) {
             const auto gep{gv_user->is<GetElementPtr>()};
             if (gep == nullptr || !gep->get_index()->is_constant()) {
                 continue;
             }
-            int offset{**gep->get_index()->as<ConstInt>()};
-            std::vector<int> indexes;
-            indexes.reserve(array_strides.size());
-
-            for (const auto &stride: array_strides) {
-                indexes.push_back(offset / stride);
-                offset %= stride;
-            }
-
-            if (offset != 0) [[unlikely]] {
+            const int offset{**gep->get_index()->as_ptr<ConstInt>()};
+            if (offset < 0 || static_cast<size_t>(offset) >= array_type->get_flattened_size()) [[unlikely]] {
                 continue;
             }
 
-            const auto constant_initial = array_initial->get_init_value(indexes)->as<Init::Constant>();
-            if (constant_initial == nullptr) {
-                continue;
-            }
-            const auto constant_value = constant_initial->get_const_value();
+            const auto constant_value = array_initial->get_value(offset);
             for (const auto &_load: gep->users()) {
-                if (const auto load = _load->is<Load>()) {
+                if (const auto load = _load->is<Load>(); load && load->num_uses() > 0) {
                     load->replace_by_new_value(constant_value);
+                    changed = true;
                 }
             }
         }
     }
+    return changed;
 }
 
 bool array_can_localized(const std::shared_ptr<GlobalVariable> &gv) {
@@ -75,8 +47,10 @@ bool array_can_localized(const std::shared_ptr<GlobalVariable> &gv) {
 
     for (const auto &user: gv->users()) {
         if (const auto inst = user->is<Instruction>()) [[likely]] {
-            worklist.push_back(inst);
-            visited.insert(inst);
+            // 同一条指令可能多次使用gv（如 f(a, a)），只入队一次
+            if (visited.insert(inst).second) {
+                worklist.push_back(inst);
+            }
         } else {
             log_error("%s is not an instruction user of gv %s", user->to_string().c_str(), gv->to_string().c_str());
         }
@@ -101,7 +75,7 @@ bool array_can_localized(const std::shared_ptr<GlobalVariable> &gv) {
                 }
             }
         } else if (op == Operator::CALL) {
-            if (const auto &func_name = instruction->as<Call>()->get_function()->get_name();
+            if (const auto &func_name = instruction->as_ptr<Call>()->get_function()->get_name();
                 func_name.find("llvm.memset") == std::string::npos) {
                 return false;
             }
@@ -110,11 +84,12 @@ bool array_can_localized(const std::shared_ptr<GlobalVariable> &gv) {
     return true;
 }
 
-void localize(const std::shared_ptr<Module> &module) {
+// 返回是否将全局数组转为了局部数组
+bool localize(const std::shared_ptr<Module> &module) {
     const auto func_analysis = Pass::get_analysis_result<Pass::FunctionAnalysis>(module);
     std::unordered_set<std::shared_ptr<GlobalVariable>> can_replace, replaced;
     for (const auto &gv: module->get_global_variables()) {
-        if (const auto gv_type = gv->get_type()->as<Type::Pointer>()->get_contain_type(); gv_type->is_array()) {
+        if (const auto gv_type = gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type(); gv_type->is_array()) {
             can_replace.insert(gv);
         }
     }
@@ -138,16 +113,17 @@ void localize(const std::shared_ptr<Module> &module) {
         if (!array_can_localized(gv)) {
             continue;
         }
+        const Builder::NameScope name_scope{*func};
         const auto new_entry = Block::create(Builder::gen_block_name()), current_entry = func->get_blocks().front();
         new_entry->set_function(func, false);
         func->get_blocks().insert(func->get_blocks().begin(), new_entry);
         const auto new_alloc = Alloc::create(Builder::gen_variable_name(),
-                                             gv->get_type()->as<Type::Pointer>()->get_contain_type(), new_entry);
+                                             gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type(), new_entry);
         std::vector<int> indexes;
-        auto type = gv->get_type()->as<Type::Pointer>()->get_contain_type();
+        auto type = gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type();
         while (type->is_array()) {
-            indexes.push_back(static_cast<int>(type->as<Type::Array>()->get_size()));
-            type = type->as<Type::Array>()->get_element_type();
+            indexes.push_back(static_cast<int>(type->as_ptr<Type::Array>()->get_size()));
+            type = type->as_ptr<Type::Array>()->get_element_type();
         }
         const auto array_init = gv->get_init_value()->as<Init::Array>();
         array_init->gen_store_inst(new_alloc, new_entry, indexes);
@@ -165,13 +141,15 @@ void localize(const std::shared_ptr<Module> &module) {
             }
         }
     }
+    return !replaced.empty();
 }
 } // namespace
 
 namespace Pass {
-void GlobalArrayLocalize::transform(const std::shared_ptr<Module> module) {
-    create<GepFolding>()->run_on(module);
-    replace_const_array_gv(module);
-    localize(module);
+bool GlobalArrayLocalize::transform(const std::shared_ptr<Module> module) {
+    bool changed = create<GepFolding>()->run_on_module(module);
+    changed |= replace_const_array_gv(module);
+    changed |= localize(module);
+    return changed;
 }
 } // namespace Pass
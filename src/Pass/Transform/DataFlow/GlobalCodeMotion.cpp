@@ -38,14 +38,7 @@ int GlobalCodeMotion::dom_tree_depth(const BlockPtr &block) const {
     if (block == nullptr) {
         log_error("BlockPtr cannot be nullptr");
     }
-    int depth = 0;
-    BlockPtr current = block;
-    const auto &imm_dom_map = dom_info->graph(current_function).immediate_dominator;
-    while (imm_dom_map.find(current) != imm_dom_map.end()) {
-        ++depth;
-        current = imm_dom_map.at(current);
-    }
-    return depth;
+    return static_cast<int>(dom_info->graph(current_function).depth(block));
 }
 
 int GlobalCodeMotion::loop_depth(const BlockPtr &block) const {
@@ -63,17 +56,11 @@ BlockPtr GlobalCodeMotion::find_lca(const BlockPtr &block1, const BlockPtr &bloc
     if (block2 == nullptr) {
         return block1;
     }
-    const auto &imm_dom_map = dom_info->graph(current_function).immediate_dominator;
-    auto p = block1, q = block2;
-    while (dom_tree_depth(p) < dom_tree_depth(q)) {
-        q = imm_dom_map.at(q);
-    }
-    while (dom_tree_depth(p) > dom_tree_depth(q)) {
-        p = imm_dom_map.at(p);
-    }
-    while (p != q) {
-        p = imm_dom_map.at(p);
-        q = imm_dom_map.at(q);
+    const auto &graph = dom_info->graph(current_function);
+    // 沿支配树向上，第一个支配 block2 的祖先即为最近公共祖先
+    auto p = block1;
+    while (!graph.dominates(p, block2)) {
+        p = graph.immediate_dominator.at(p);
     }
     return p;
 }
@@ -90,7 +77,7 @@ bool GlobalCodeMotion::is_pinned(const InstructionPtr &instruction) const {
         case Operator::LOAD:
             return true;
         case Operator::CALL: {
-            const auto called_func = instruction->as<Call>()->get_function()->as<Function>();
+            const auto called_func = instruction->as_ptr<Call>()->get_function()->as<Function>();
             if (called_func->is_runtime_func()) {
                 return true;
             }
@@ -162,7 +149,7 @@ void GlobalCodeMotion::schedule_late(const InstructionPtr &instruction) {
             lca = find_lca(use_block, lca);
         }
     }
-    if (instruction->users().size() != 0) {
+    if (instruction->num_uses() != 0) {
         if (lca == nullptr) {
             log_error("LCA is null for instruction %s", instruction->to_string().c_str());
         }
@@ -197,7 +184,7 @@ void GlobalCodeMotion::schedule_late(const InstructionPtr &instruction) {
     }
 }
 
-void GlobalCodeMotion::run_on_func(const FunctionPtr &func) {
+bool GlobalCodeMotion::run_on_func(const FunctionPtr &func) {
     current_function = func;
     visited_instructions.clear();
     std::vector<BlockPtr> post_order_blocks = dom_info->post_order_blocks(func);
@@ -215,6 +202,12 @@ void GlobalCodeMotion::run_on_func(const FunctionPtr &func) {
             snap_instructions.push_back(instruction);
         }
     }
+    // 调度前各指令所在的基本块，块内的重新排列不算作修改，否则每次执行都会报告修改
+    std::vector<BlockPtr> origin_blocks;
+    origin_blocks.reserve(total_instructions);
+    for (const auto &instruction: snap_instructions) {
+        origin_blocks.push_back(instruction->get_block());
+    }
     for (const auto &instruction: snap_instructions) {
         schedule_early(instruction);
     }
@@ -223,9 +216,16 @@ void GlobalCodeMotion::run_on_func(const FunctionPtr &func) {
     for (const auto &instruction: snap_instructions) {
         schedule_late(instruction);
     }
+    std::reverse(snap_instructions.begin(), snap_instructions.end());
+    for (size_t i = 0; i < snap_instructions.size(); ++i) {
+        if (snap_instructions[i]->get_block() != origin_blocks[i]) {
+            return true;
+        }
+    }
+    return false;
 }
 
-void GlobalCodeMotion::transform(const std::shared_ptr<Module> module) {
+bool GlobalCodeMotion::transform(const std::shared_ptr<Module> module) {
     // 计算支配树和支配关系
     cfg_info = get_analysis_result<ControlFlowGraph>(module);
     dom_info = get_analysis_result<DominanceGraph>(module);
@@ -235,17 +235,19 @@ void GlobalCodeMotion::transform(const std::shared_ptr<Module> module) {
     function_analysis = get_analysis_result<FunctionAnalysis>(module);
     visited_instructions.clear();
     current_function = nullptr;
+    bool changed = false;
     for (const auto &func: *module) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     cfg_info = nullptr;
     dom_info = nullptr;
     loop_analysis = nullptr;
     current_function = nullptr;
     visited_instructions.clear();
+    return changed;
 }
 
-void GlobalCodeMotion::transform(const std::shared_ptr<Function> &func) {
+bool GlobalCodeMotion::transform(const std::shared_ptr<Function> &func) {
     // 计算支配树和支配关系
     cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
     dom_info = get_analysis_result<DominanceGraph>(Module::instance());
@@ -254,11 +256,12 @@ void GlobalCodeMotion::transform(const std::shared_ptr<Function> &func) {
     function_analysis = get_analysis_result<FunctionAnalysis>(Module::instance());
     visited_instructions.clear();
     current_function = nullptr;
-    run_on_func(func);
+    const bool changed = run_on_func(func);
     cfg_info = nullptr;
     dom_info = nullptr;
     loop_analysis = nullptr;
     current_function = nullptr;
     visited_instructions.clear();
+    return changed;
 }
 } // namespace Pass
@@ -11,149 +11,6 @@ using BlockPtr = std::shared_ptr<Block>;
 using InstructionPtr = std::shared_ptr<Instruction>;
 
 namespace {
-std::string get_hash(const std::shared_ptr<GetElementPtr> &instruction) {
-    std::ostringstream oss;
-    oss << "gep";
-    for (const auto &operand: instruction->get_operands()) {
-        oss << " " << operand.get();
-    }
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<Fcmp> &instruction) {
-    std::ostringstream oss;
-    oss << "fcmp " << std::to_string(static_cast<int>(instruction->op))
-        << " " << instruction->get_lhs().get()
-        << " " << instruction->get_rhs().get();
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<Icmp> &instruction) {
-    std::ostringstream oss;
-    oss << "icmp " << std::to_string(static_cast<int>(instruction->op))
-        << " " << instruction->get_lhs().get()
-        << " " << instruction->get_rhs().get();
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<IntBinary> &instruction) {
-    auto lhs_ptr = static_cast<const void *>(instruction->get_lhs().get());
-    auto rhs_ptr = static_cast<const void*>(instruction->get_rhs().get());
-
-    if (instruction->is_commutative() && lhs_ptr > rhs_ptr) {
-        std::swap(lhs_ptr, rhs_ptr);
-    }
-
-    std::ostringstream oss;
-    oss << "intbinary " << std::to_string(static_cast<int>(instruction->op))
-        << " " << lhs_ptr
-        << " " << rhs_ptr;
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<FloatBinary> &instruction) {
-    auto lhs_ptr = static_cast<const void *>(instruction->get_lhs().get());
-    auto rhs_ptr = static_cast<const void*>(instruction->get_rhs().get());
-
-    if (instruction->is_commutative() && lhs_ptr > rhs_ptr) {
-        std::swap(lhs_ptr, rhs_ptr);
-    }
-
-    std::ostringstream oss;
-    oss << "floatbinary " << std::to_string(static_cast<int>(instruction->op))
-        << " " << lhs_ptr
-        << " " << rhs_ptr;
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<FloatTernary> &instruction) {
-    std::ostringstream oss;
-    oss << "floatternary " << std::to_string(static_cast<int>(instruction->floatternary_op()))
-        << " " << instruction->get_x().get()
-        << " " << instruction->get_y().get()
-        << " " << instruction->get_z().get();
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<FNeg> &instruction) {
-    std::ostringstream oss;
-    oss << "fneg " << instruction->get_value().get();
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<Zext> &instruction) {
-    std::ostringstream oss;
-    oss << "zext " << instruction->get_value().get()
-        << " " << instruction->get_value()->get_type()->to_string()
-        << " " << instruction->get_type()->to_string();
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<Fptosi> &instruction) {
-    std::ostringstream oss;
-    oss << "fptosi " << instruction->get_value().get()
-        << " " << instruction->get_value()->get_type()->to_string()
-        << " " << instruction->get_type()->to_string();
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<Sitofp> &instruction) {
-    std::ostringstream oss;
-    oss << "sitofp " << instruction->get_value().get()
-        << " " << instruction->get_value()->get_type()->to_string()
-        << " " << instruction->get_type()->to_string();
-    return oss.str();
-}
-
-std::string get_hash(const std::shared_ptr<Call> &instruction,
-                     const std::shared_ptr<Pass::FunctionAnalysis> &func_analysis) {
-    const auto &func = instruction->get_function()->as<Function>();
-    if (func->is_runtime_func()) {
-        return "";
-    }
-    if (const auto &func_info = func_analysis->func_info(func);
-        func_info.has_return && func_info.no_state && !func_info.io_read && !func_info.io_write) {
-        std::ostringstream oss;
-        oss << "call " << func->get_name(); // 函数名本身是OK的
-        for (const auto &operand: instruction->get_params()) {
-            // [FIX] 使用指针地址代替参数名字
-            oss << " " << static_cast<const void*>(operand.get()) << ",";
-        }
-        return oss.str();
-    }
-    return "";
-}
-
-std::string get_instruction_hash(const InstructionPtr &instruction,
-                                 const std::shared_ptr<Pass::FunctionAnalysis> &func_analysis) {
-    switch (instruction->get_op()) {
-        case Operator::GEP:
-            return get_hash(instruction->as<GetElementPtr>());
-        case Operator::FCMP:
-            return get_hash(instruction->as<Fcmp>());
-        case Operator::ICMP:
-            return get_hash(instruction->as<Icmp>());
-        case Operator::INTBINARY:
-            return get_hash(instruction->as<IntBinary>());
-        case Operator::FLOATBINARY:
-            return get_hash(instruction->as<FloatBinary>());
-        case Operator::FLOATTERNARY:
-            return get_hash(instruction->as<FloatTernary>());
-        case Operator::FNEG:
-            return get_hash(instruction->as<FNeg>());
-        case Operator::ZEXT:
-            return get_hash(instruction->as<Zext>());
-        case Operator::SITOFP:
-            return get_hash(instruction->as<Sitofp>());
-        case Operator::FPTOSI:
-            return get_hash(instruction->as<Fptosi>());
-        case Operator::CALL:
-            return get_hash(instruction->as<Call>(), func_analysis);
-        default:
-            return "";
-    }
-}
-
 template<typename>
 struct always_false : std::false_type {};
 
@@ -310,7 +167,7 @@ bool evaluate_float_ternary(const std::shared_ptr<FloatTernary> &inst, double &r
     if (!x->get_type()->is_float() || !y->get_type()->is_float() || !z->get_type()->is_float()) {
         log_error("Illegal operator type for %s", inst->to_string().c_str());
     }
-    const auto x_val = **x->as<ConstFloat>(), y_val = **y->as<ConstFloat>(), z_val = **z->as<ConstFloat>();
+    const auto x_val = **x->as_ptr<ConstFloat>(), y_val = **y->as_ptr<ConstFloat>(), z_val = **z->as_ptr<ConstFloat>();
     res = [&]() -> double {
         switch (inst->floatternary_op()) {
             case FloatTernary::Op::FMADD:
@@ -334,7 +191,7 @@ bool evaluate_fneg(const std::shared_ptr<FNeg> &inst, double &res) {
     if (!value->get_type()->is_float()) {
         log_error("Illegal operator type for %s", inst->to_string().c_str());
     }
-    res = -value->as<ConstFloat>()->get_constant_value().get<double>();
+    res = -value->as_ptr<ConstFloat>()->get_constant_value().get<double>();
     return true;
 }
 } // namespace
@@ -428,8 +285,7 @@ bool GlobalValueNumbering::fold_instruction(const std::shared_ptr<Instruction> &
     return false;
 }
 
-bool GlobalValueNumbering::run_on_block(const FunctionPtr &func, const BlockPtr &block,
-                                        std::unordered_map<std::string, InstructionPtr> &value_hashmap) {
+bool GlobalValueNumbering::run_on_block(const FunctionPtr &func, const BlockPtr &block, ValueTable &value_table) {
     bool changed = false;
     for (auto it = block->get_instructions().begin(); it != block->get_instructions().end();) {
         if (fold_instruction(*it)) {
@@ -437,37 +293,37 @@ bool GlobalValueNumbering::run_on_block(const FunctionPtr &func, const BlockPtr
             it = block->get_instructions().erase(it);
             changed = true;
         }
-        const auto &instruction_hash = get_instruction_hash(*it, func_analysis);
-        if (instruction_hash.empty()) {
+        auto key = InstructionKey::create(*it, func_analysis);
+        if (!key.has_value()) {
             ++it;
             continue;
         }
-        if (value_hashmap.find(instruction_hash) != value_hashmap.end()) {
-            (*it)->replace_by_new_value(value_hashmap[instruction_hash]);
+        if (const auto existing = value_table.find(*key)) {
+            (*it)->replace_by_new_value(existing);
             (*it)->clear_operands();
             it = block->get_instructions().erase(it);
             changed = true;
         } else {
-            value_hashmap[instruction_hash] = *it;
+            value_table.insert(std::move(*key), *it);
             ++it;
         }
     }
     for (const auto &child: dom_info->graph(func).dominance_children.at(block)) {
-        changed |= run_on_block(func, child, value_hashmap);
+        changed |= run_on_block(func, child, value_table);
     }
     return changed;
 }
 
 bool GlobalValueNumbering::run_on_func(const FunctionPtr &func) {
     const auto &entry_block = func->get_blocks().front();
-    std::unordered_map<std::string, InstructionPtr> value_hashmap;
-    return run_on_block(func, entry_block, value_hashmap);
+    ValueTable value_table;
+    return run_on_block(func, entry_block, value_table);
 }
 
-void GlobalValueNumbering::transform(const std::shared_ptr<Module> module) {
+bool GlobalValueNumbering::transform(const std::shared_ptr<Module> module) {
     dom_info = get_analysis_result<DominanceGraph>(module);
     func_analysis = get_analysis_result<FunctionAnalysis>(module);
-    create<AlgebraicSimplify>()->run_on(module);
+    bool modified = create<AlgebraicSimplify>()->run_on_module(module);
     // 不同的遍历顺序可能导致化简的结果不同
     // 跑多次GVN直到一个不动点
     bool changed = false;
@@ -476,19 +332,22 @@ void GlobalValueNumbering::transform(const std::shared_ptr<Module> module) {
         for (const auto &func: *module) {
             changed |= run_on_func(func);
         }
+        modified |= changed;
     } while (changed);
     do {
         changed = false;
         for (const auto &func: *module) {
             changed |= run_on_func(func);
         }
+        modified |= changed;
     } while (changed);
     dom_info = nullptr;
     func_analysis = nullptr;
     // GVN后可能出现一条指令被替换成其另一条指令，但是那条指令并不支配这条指令的users的问题
     // 可以通过 GCM 解决。在 GCM 中考虑value之间的依赖，会根据依赖将那条指令移动到正确的位置
-    create<GlobalCodeMotion>()->run_on(module);
-    create<AlgebraicSimplify>()->run_on(module);
-    create<DeadInstEliminate>()->run_on(module);
+    modified |= create<GlobalCodeMotion>()->run_on_module(module);
+    modified |= create<AlgebraicSimplify>()->run_on_module(module);
+    modified |= create<DeadInstEliminate>()->run_on_module(module);
+    return modified;
 }
 } // namespace Pass
@@ -6,33 +6,38 @@ using namespace Mir;
 
 namespace {
 // Replaces loads from simple, constant global variables with their initial values.
-void replace_const_normal_gv(const std::shared_ptr<Module> &module) {
+// Returns whether any load was replaced.
+bool replace_const_normal_gv(const std::shared_ptr<Module> &module) {
     std::vector<std::shared_ptr<GlobalVariable>> can_replaced;
     for (const auto &gv: module->get_global_variables()) {
         // Check if the global variable is a constant and not an array.
-        if (const auto gv_type = gv->get_type()->as<Type::Pointer>()->get_contain_type();
+        if (const auto gv_type = gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type();
             !gv_type->is_array() && gv->is_constant_gv()) {
             can_replaced.push_back(gv);
         }
     }
     // Replace all loads of these constant globals with the constant value itself.
+    bool changed = false;
     for (const auto &gv: can_replaced) {
         for (const auto &user: gv->users()) {
-            if (const auto load = std::dynamic_pointer_cast<Load>(user)) {
+            if (const auto load = std::dynamic_pointer_cast<Load>(user); load && load->num_uses() > 0) {
                 const auto init = gv->get_init_value();
-                load->replace_by_new_value(init->as<Init::Constant>()->get_const_value());
+                load->replace_by_new_value(init->as_ptr<Init::Constant>()->get_const_value());
+                changed = true;
             }
         }
     }
+    return changed;
 }
 
 // Attempts to convert global variables into local variables.
-void localize(const std::shared_ptr<Module> &module) {
+// Returns whether any global variable was localized or removed.
+bool localize(const std::shared_ptr<Module> &module) {
     const auto func_analysis = Pass::get_analysis_result<Pass::FunctionAnalysis>(module);
     std::unordered_set<std::shared_ptr<GlobalVariable>> can_replaced;
     // Find all non-array global variables that could potentially be localized.
     for (const auto &gv: module->get_global_variables()) {
-        if (const auto gv_type = gv->get_type()->as<Type::Pointer>()->get_contain_type(); !gv_type->is_array()) {
+        if (const auto gv_type = gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type(); !gv_type->is_array()) {
             can_replaced.insert(gv);
         }
     }
@@ -66,13 +71,14 @@ void localize(const std::shared_ptr<Module> &module) {
         }
 
         // If all conditions are met, create a local variable (alloca) in the function's entry block.
+        const Builder::NameScope name_scope{*func};
         const auto &entry = func->get_blocks().front();
         const auto new_alloc = Alloc::create(Builder::gen_variable_name(),
-                                             gv->get_type()->as<Type::Pointer>()->get_contain_type(), nullptr);
+                                             gv->get_type()->as_ptr<Type::Pointer>()->get_contain_type(), nullptr);
 
         // Initialize the new local variable with the global's initial value.
         const auto new_store =
-                Store::create(new_alloc, gv->get_init_value()->as<Init::Constant>()->get_const_value(), nullptr);
+                Store::create(new_alloc, gv->get_init_value()->as_ptr<Init::Constant>()->get_const_value(), nullptr);
 
         new_alloc->set_block(entry, false);
         new_store->set_block(entry, false);
@@ -88,7 +94,7 @@ void localize(const std::shared_ptr<Module> &module) {
     // Clean up any global variables that are no longer used.
     const auto origin_size = module->get_global_variables().size();
     for (auto it = module->get_global_variables().begin(); it != module->get_global_variables().end();) {
-        if ((*it)->users().size() == 0) {
+        if ((*it)->num_uses() == 0) {
             it = module->get_global_variables().erase(it);
         } else {
             ++it;
@@ -98,13 +104,15 @@ void localize(const std::shared_ptr<Module> &module) {
     // If we removed globals and created allocas, run Mem2Reg to promote the allocas to registers.
     if (origin_size != module->get_global_variables().size()) {
         Pass::Pass::create<Pass::Mem2Reg>()->run_on(module);
+        return true;
     }
+    return false;
 }
 } // namespace
 
 namespace Pass {
-void GlobalVariableLocalize::transform(const std::shared_ptr<Module> module) {
-    replace_const_normal_gv(module);
-    localize(module);
+bool GlobalVariableLocalize::transform(const std::shared_ptr<Module> module) {
+    const bool replaced = replace_const_normal_gv(module);
+    return localize(module) || replaced;
 }
 } // namespace Pass
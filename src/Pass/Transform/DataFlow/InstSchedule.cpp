@@ -62,7 +62,8 @@ public:
         SchedulerInstruction::reset();
     }
 
-    void schedule();
+    // 返回是否改变了指令顺序
+    bool schedule();
 };
 
 int InBlockScheduler::SchedulerInstruction::cnt = 0;
@@ -73,7 +74,7 @@ bool InBlockScheduler::is_pinned(const std::shared_ptr<Instruction> &instruction
         case Operator::STORE:
             return true;
         case Operator::CALL: {
-            const auto called_func{instruction->as<Call>()->get_function()->as<Function>()};
+            const auto called_func{instruction->as_ptr<Call>()->get_function()->as<Function>()};
             if (called_func->is_runtime_func()) {
                 if (const auto name = called_func->get_name();
                     name.find("get") != std::string::npos || name.find("put") != std::string::npos) {
@@ -177,7 +178,7 @@ std::shared_ptr<Instruction> InBlockScheduler::get_from_queue() {
     return nullptr;
 }
 
-void InBlockScheduler::schedule() {
+bool InBlockScheduler::schedule() {
     log_trace("%s", block->get_name().c_str());
     const auto snap{instructions};
     const auto terminator{instructions.back()};
@@ -251,11 +252,12 @@ void InBlockScheduler::schedule() {
         // something went wrong. just revert.
         instructions = snap;
     }
+    return instructions != snap;
 }
 } // namespace
 
 namespace Pass {
-void InstSchedule::in_block_schedule(const std::shared_ptr<Function> &func) const {
+bool InstSchedule::in_block_schedule(const std::shared_ptr<Function> &func) const {
     std::unordered_map<std::shared_ptr<Block>, std::unordered_set<std::shared_ptr<Instruction>>> out_live_variables;
     for (const auto &block: func->get_blocks()) {
         out_live_variables[block] = {};
@@ -273,6 +275,7 @@ void InstSchedule::in_block_schedule(const std::shared_ptr<Function> &func) cons
     }
 
     const auto &graph{dom_graph->graph(func)};
+    bool changed = false;
     auto dfs = [&](auto &&self, const std::shared_ptr<Block> &block) -> void {
         const auto &terminator{block->get_instructions().back()};
         for (const auto &operand: terminator->get_operands()) {
@@ -284,22 +287,23 @@ void InstSchedule::in_block_schedule(const std::shared_ptr<Function> &func) cons
             out_live_variables[block].insert(out_live_variables[child].begin(), out_live_variables[child].end());
         }
         InBlockScheduler scheduler{block, func_info, out_live_variables};
-        scheduler.schedule();
+        changed |= scheduler.schedule();
     };
     dfs(dfs, func->get_blocks().front());
+    return changed;
 }
 
-void InstSchedule::run_on_func(const std::shared_ptr<Function> &func) const {
-    in_block_schedule(func);
-}
+bool InstSchedule::run_on_func(const std::shared_ptr<Function> &func) const { return in_block_schedule(func); }
 
-void InstSchedule::transform(const std::shared_ptr<Module> module) {
+bool InstSchedule::transform(const std::shared_ptr<Module> module) {
     dom_graph = get_analysis_result<DominanceGraph>(module);
     func_info = get_analysis_result<FunctionAnalysis>(module);
+    bool changed = false;
     for (const auto &func: module->get_functions()) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     dom_graph = nullptr;
     func_info = nullptr;
+    return changed;
 }
 } // namespace Pass
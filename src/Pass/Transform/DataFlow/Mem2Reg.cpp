@@ -37,7 +37,7 @@ void Mem2Reg::insert_phi() {
     while (!worklist.empty()) {
         const auto x = worklist.front();
         worklist.erase(worklist.begin());
-        for (const auto &y: dom_info->graph(current_function).dominance_frontier.at(x)) {
+        for (const auto &y: dom_info->dominance_frontier(current_function, x)) {
             if (processed_blocks.find(y) != processed_blocks.end())
                 continue;
             std::unordered_map<std::shared_ptr<Block>, std::shared_ptr<Value>> optional_map;
@@ -125,7 +125,8 @@ void Mem2Reg::rename_variables(const std::shared_ptr<Block> &block) {
     }
 }
 
-void Mem2Reg::run_on_func(const std::shared_ptr<Function> &func) {
+bool Mem2Reg::run_on_func(const std::shared_ptr<Function> &func) {
+    const Builder::NameScope name_scope{*func};
     std::vector<std::shared_ptr<Alloc>> valid_allocs;
     for (const auto &block: func->get_blocks()) {
         for (const auto &inst: block->get_instructions()) {
@@ -152,14 +153,16 @@ void Mem2Reg::run_on_func(const std::shared_ptr<Function> &func) {
         insert_phi();
         rename_variables(current_function->get_blocks().front());
     }
+    return !valid_allocs.empty();
 }
 
-void Mem2Reg::transform(const std::shared_ptr<Module> module) {
+bool Mem2Reg::transform(const std::shared_ptr<Module> module) {
     cfg_info = get_analysis_result<ControlFlowGraph>(module);
     dom_info = get_analysis_result<DominanceGraph>(module);
+    bool changed = false;
     for (const auto &func: *module) {
         // 收集当前函数的所有Alloc指令
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
     current_alloc = nullptr;
     current_function = nullptr;
@@ -169,12 +172,13 @@ void Mem2Reg::transform(const std::shared_ptr<Module> module) {
     use_instructions.clear();
     def_blocks.clear();
     def_stack.clear();
+    return changed;
 }
 
-void Mem2Reg::transform(const std::shared_ptr<Function> &func) {
+bool Mem2Reg::transform(const std::shared_ptr<Function> &func) {
     cfg_info = get_analysis_result<ControlFlowGraph>(Module::instance());
     dom_info = get_analysis_result<DominanceGraph>(Module::instance());
-    run_on_func(func);
+    const bool changed = run_on_func(func);
     current_alloc = nullptr;
     current_function = nullptr;
     cfg_info = nullptr;
@@ -183,5 +187,6 @@ void Mem2Reg::transform(const std::shared_ptr<Function> &func) {
     use_instructions.clear();
     def_blocks.clear();
     def_stack.clear();
+    return changed;
 }
 } // namespace Pass
\ No newline at end of file
@@ -1,3 +1,6 @@
+#include <deque>
+
+#include "Mir/Builder.h"
 #include "Pass/Util.h"
 #include "Pass/Transforms/Common.h"
 #include "Pass/Transforms/DCE.h"
@@ -53,25 +56,26 @@ struct BinaryOpKeyHasher {
     }
 };
 
+// 同一等级内按名字排序而不是按地址，重排的结果才不依赖对象的分配顺序
 struct Ranker_ {
-    using Key = std::pair<int, uintptr_t>;
+    using Key = std::pair<int, const std::string &>;
 
     Key operator()(const std::shared_ptr<Value> &value) const {
         int rank_val;
         if (const auto inst = value->is<Instruction>()) {
             if (inst->get_op() == Operator::LOAD &&
-                base_addr(inst->as<Load>()->get_addr())->is<GlobalVariable>() != nullptr) {
+                base_addr(inst->as_ptr<Load>()->get_addr())->is<GlobalVariable>() != nullptr) {
                 rank_val = 3;
             } else {
                 rank_val = 1;
             }
-        } else if (value->is<Argument>())
+        } else if (value->is_ptr<Argument>())
             rank_val = 2;
         else if (value->is_constant())
             rank_val = 4;
         else
             rank_val = 5;
-        return {rank_val, reinterpret_cast<uintptr_t>(value.get())};
+        return {rank_val, value->get_name()};
     }
 } ranker;
 }
@@ -91,11 +95,19 @@ public:
 
 private:
     const std::shared_ptr<Function> &current_function;
-    std::unordered_set<std::shared_ptr<IntBinary>> worklist{};
+    // 按加入的顺序处理，集合只用于去重
+    std::deque<std::shared_ptr<IntBinary>> worklist{};
+    std::unordered_set<std::shared_ptr<IntBinary>> in_worklist{};
     std::unordered_set<std::shared_ptr<Instruction>> to_erase{};
     bool changed{false};
     std::unordered_map<BinaryOpKey, std::shared_ptr<IntBinary>, BinaryOpKeyHasher> value_table;
 
+    void push(const std::shared_ptr<IntBinary> &instruction) {
+        if (in_worklist.insert(instruction).second) {
+            worklist.push_back(instruction);
+        }
+    }
+
     static bool is_candidate(const std::shared_ptr<Instruction> &instruction);
 
     void initialize();
@@ -117,7 +129,7 @@ private:
 
 bool SimpleReassociateImpl::is_candidate(const std::shared_ptr<Instruction> &instruction) {
     if (instruction->get_op() == Operator::INTBINARY) {
-        return instruction->as<IntBinary>()->is_associative();
+        return instruction->as_ptr<IntBinary>()->is_associative();
     }
     return false;
 }
@@ -136,7 +148,7 @@ void SimpleReassociateImpl::initialize() {
             for (const auto &user: inst->users()) {
                 if (const auto user_inst = user->is<Instruction>()) {
                     if (user_inst->get_op() == Operator::INTBINARY &&
-                        user_inst->as<IntBinary>()->intbinary_op() == int_binary->intbinary_op()) {
+                        user_inst->as_ptr<IntBinary>()->intbinary_op() == int_binary->intbinary_op()) {
                         is_root = false;
                         break;
                     }
@@ -145,7 +157,7 @@ void SimpleReassociateImpl::initialize() {
                 }
             }
             if (is_root) {
-                worklist.insert(int_binary);
+                push(int_binary);
             }
         }
     }
@@ -156,7 +168,7 @@ std::shared_ptr<Value> SimpleReassociateImpl::get_or_create(const std::shared_pt
                                                             const IntBinary::Op type,
                                                             const std::shared_ptr<Instruction> &origin) {
     if (lhs->is_constant() && rhs->is_constant()) {
-        const auto _l = **lhs->as<ConstInt>(), _r = **rhs->as<ConstInt>();
+        const auto _l = **lhs->as_ptr<ConstInt>(), _r = **rhs->as_ptr<ConstInt>();
         const auto _res = [&]() -> int {
             switch (type) {
                 case IntBinary::Op::ADD:
@@ -186,25 +198,26 @@ std::shared_ptr<Value> SimpleReassociateImpl::get_or_create(const std::shared_pt
         return value_table.at(key);
     }
 
-    static int id = 0;
+    // 新指令的名字参与排序，从所在函数的计数器取名以保证在函数内唯一
+    const auto name = Builder::gen_variable_name();
     auto new_inst = [&]() -> std::shared_ptr<IntBinary> {
         switch (type) {
             case IntBinary::Op::ADD:
-                return Add::create("%add" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Add::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::SUB:
-                return Sub::create("%sub" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Sub::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::MUL:
-                return Mul::create("%mul" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Mul::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::AND:
-                return And::create("%and" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return And::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::OR:
-                return Or::create("%or" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Or::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::XOR:
-                return Xor::create("%xor" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Xor::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::SMAX:
-                return Smax::create("%smax" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Smax::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::SMIN:
-                return Smin::create("%smin" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Smin::create(name, lhs, rhs, origin->get_block());
             default:
                 log_error("Not supported");
         }
@@ -222,7 +235,7 @@ std::vector<std::shared_ptr<Value>> SimpleReassociateImpl::linearize(const std::
 
     auto make_negative = [&](const std::shared_ptr<Value> &v) -> std::shared_ptr<Value> {
         if (v->is_constant()) {
-            return ConstInt::create(-**v->as<ConstInt>());
+            return ConstInt::create(-**v->as_ptr<ConstInt>());
         }
         return get_or_create(ConstInt::create(0), v, IntBinary::Op::SUB, intbinary);
     };
@@ -273,12 +286,13 @@ std::shared_ptr<Value> SimpleReassociateImpl::rebuild_right_deep_tree(
 
 void SimpleReassociateImpl::main_loop() {
     while (!worklist.empty()) {
-        const auto instruction = *worklist.begin();
-        worklist.erase(instruction);
+        const auto instruction = worklist.front();
+        worklist.pop_front();
+        in_worklist.erase(instruction);
 
         if (to_erase.count(instruction))
             continue;
-        if (instruction->users().size() == 0) {
+        if (instruction->num_uses() == 0) {
             to_erase.insert(instruction);
             continue;
         }
@@ -309,7 +323,7 @@ void SimpleReassociateImpl::main_loop() {
             for (const auto &user: users_copy) {
                 if (auto user_inst = user->is<Instruction>()) {
                     if (is_candidate(user_inst))
-                        worklist.insert(std::dynamic_pointer_cast<IntBinary>(user_inst));
+                        push(std::dynamic_pointer_cast<IntBinary>(user_inst));
                 } else {
                     log_error("");
                 }
@@ -317,12 +331,12 @@ void SimpleReassociateImpl::main_loop() {
             for (const auto &operand: instruction->get_operands()) {
                 if (auto op_inst = operand->is<IntBinary>()) {
                     if (is_candidate(op_inst))
-                        worklist.insert(op_inst->as<IntBinary>());
+                        push(op_inst->as<IntBinary>());
                 }
             }
             if (auto new_inst = new_value->is<Instruction>()) {
                 if (is_candidate(new_inst))
-                    worklist.insert(new_inst->as<IntBinary>());
+                    push(new_inst->as<IntBinary>());
             }
         }
     }
@@ -374,7 +388,7 @@ private:
 
 bool NaryReassociateImpl::is_candidate(const std::shared_ptr<Instruction> &instruction) {
     if (instruction->get_op() == Operator::INTBINARY) {
-        return instruction->as<IntBinary>()->is_associative();
+        return instruction->as_ptr<IntBinary>()->is_associative();
     }
     return false;
 }
@@ -383,25 +397,26 @@ std::shared_ptr<IntBinary> NaryReassociateImpl::create_int_binary(const std::sha
                                                                   const std::shared_ptr<Value> &rhs,
                                                                   const IntBinary::Op type,
                                                                   const std::shared_ptr<Instruction> &origin) {
-    static int id = 0;
+    // 新指令的名字参与排序，从所在函数的计数器取名以保证在函数内唯一
+    const auto name = Builder::gen_variable_name();
     auto new_inst = [&]() -> std::shared_ptr<IntBinary> {
         switch (type) {
             case IntBinary::Op::ADD:
-                return Add::create("%add" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Add::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::SUB:
-                return Sub::create("%sub" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Sub::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::MUL:
-                return Mul::create("%mul" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Mul::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::AND:
-                return And::create("%and" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return And::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::OR:
-                return Or::create("%or" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Or::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::XOR:
-                return Xor::create("%xor" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Xor::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::SMAX:
-                return Smax::create("%smax" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Smax::create(name, lhs, rhs, origin->get_block());
             case IntBinary::Op::SMIN:
-                return Smin::create("%smin" + std::to_string(++id), lhs, rhs, origin->get_block());
+                return Smin::create(name, lhs, rhs, origin->get_block());
             default:
                 log_error("Not supported");
         }
@@ -493,18 +508,22 @@ void NaryReassociateImpl::run_on_block(const std::shared_ptr<Block> &block, cons
 }
 }
 
-void Pass::Reassociate::transform(const std::shared_ptr<Module> module) {
-    create<AlgebraicSimplify>()->run_on(module);
-    create<StandardizeBinary>()->run_on(module);
+bool Pass::Reassociate::transform(const std::shared_ptr<Module> module) {
+    bool changed = create<AlgebraicSimplify>()->run_on_module(module);
+    changed |= create<StandardizeBinary>()->run_on_module(module);
     const auto dom_info = get_analysis_result<DominanceGraph>(module);
     for (const auto &func: module->get_functions()) {
+        const Builder::NameScope name_scope{*func};
         if (SimpleReassociateImpl{func}.run()) {
             create<DeadCodeEliminate>()->run_on(func);
+            changed = true;
         }
         if (NaryReassociateImpl{func, dom_info->graph(func)}.run()) {
             create<DeadCodeEliminate>()->run_on(func);
+            changed = true;
         }
     }
-    create<GlobalValueNumbering>()->run_on(module);
-    create<DeadCodeEliminate>()->run_on(module);
+    changed |= create<GlobalValueNumbering>()->run_on_module(module);
+    changed |= create<DeadCodeEliminate>()->run_on_module(module);
+    return changed;
 }
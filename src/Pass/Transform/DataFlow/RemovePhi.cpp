@@ -24,7 +24,8 @@ public:
     Helper(const std::shared_ptr<Block> &block, const Pass::ControlFlowGraph::Graph &cfg_info,
            const std::vector<std::shared_ptr<Phi>> &phis) : block{block}, cfg_info{cfg_info}, phis{phis} {}
 
-    std::unordered_set<std::shared_ptr<Value>> phicopy_variables{};
+    // 按 phi 的顺序排列，使输出不依赖对象的地址
+    std::vector<std::shared_ptr<Value>> phicopy_variables{};
 
     void build();
 };
@@ -72,7 +73,7 @@ void Helper::insert_moves(const std::shared_ptr<Block> &prev,
     for (const auto &move : moves) {
         // 如果源也是一个目标，并且我们还没有为它创建临时变量
         if (auto src = move->get_from_value(); destinations.count(src) && !saved_values.count(src)) {
-            const auto temp = std::make_shared<Value>(make_name("%temp_"), src->get_type());
+            const auto temp = make_ir<Value>(make_name("%temp_"), src->get_type());
             final_moves.push_back(Move::create(temp, src, nullptr)); // temp = src
             saved_values[src] = temp;
         }
@@ -100,26 +101,35 @@ void Helper::insert_moves(const std::shared_ptr<Block> &prev,
 
 
 void Helper::build() {
-    std::unordered_map<std::shared_ptr<Block>, std::vector<std::shared_ptr<Move>>> move_map;
+    // phi 的入边表以块的地址为键，按控制流图中前驱的顺序收集 move，插入顺序与新建块的名字才是确定的
+    std::vector<std::pair<std::shared_ptr<Block>, std::vector<std::shared_ptr<Move>>>> move_list;
+    std::unordered_set<std::shared_ptr<Block>> visited;
+    for (const auto &pre: cfg_info.predecessors.at(block)) {
+        if (visited.insert(pre).second) {
+            move_list.emplace_back(pre, std::vector<std::shared_ptr<Move>>{});
+        }
+    }
 
     // 收集所有 move 操作，并按照前驱块分组
     for (const auto &phi: phis) {
-        const auto phicopy_value = std::make_shared<Value>(make_name("%temp_"), phi->get_type());
+        const auto phicopy_value = make_ir<Value>(make_name("%temp_"), phi->get_type());
         phi_map[phi] = phicopy_value;
         // log_debug("%s -> %s", phi->to_string().c_str(), phicopy_value->get_name().c_str());
-        phicopy_variables.insert(phicopy_value);
-        for (const auto &[pre, value]: phi->get_optional_values()) {
-            if (value != phi) [[likely]] {
-                move_map.try_emplace(pre, std::vector<std::shared_ptr<Move>>{});
-                move_map[pre].push_back(Move::create(phi_map[phi], value, nullptr));
+        phicopy_variables.push_back(phicopy_value);
+        const auto &optional_values = phi->get_optional_values();
+        for (auto &[pre, moves]: move_list) {
+            if (const auto it = optional_values.find(pre); it != optional_values.end() && it->second != phi) [[likely]] {
+                moves.push_back(Move::create(phicopy_value, it->second, nullptr));
             }
         }
-        phi->replace_by_new_value(phi_map[phi]);
+        phi->replace_by_new_value(phicopy_value);
     }
 
     // 为需要插入 move 的前驱块进行插入操作
-    for (const auto &[pre, moves]: move_map) {
-        insert_moves(pre, moves);
+    for (const auto &[pre, moves]: move_list) {
+        if (!moves.empty()) {
+            insert_moves(pre, moves);
+        }
     }
 }
 } // namespace
@@ -145,14 +155,16 @@ void RemovePhi::run_on_func(const std::shared_ptr<Function> &func) {
     }
 }
 
-void RemovePhi::transform(const std::shared_ptr<Module> module) {
+bool RemovePhi::transform(const std::shared_ptr<Module> module) {
     cfg_info = get_analysis_result<ControlFlowGraph>(module);
     for (const auto &func: module->get_functions()) {
         run_on_func(func);
     }
+    const bool changed = !to_be_deleted.empty();
     Utils::delete_instruction_set(module, to_be_deleted);
     to_be_deleted.clear();
     set_analysis_result_dirty<ControlFlowGraph>(module);
     cfg_info = nullptr;
+    return changed;
 }
 } // namespace Pass
@@ -71,20 +71,21 @@ std::optional<std::shared_ptr<BinaryType>> is_binary_type(const std::shared_ptr<
     }
     if constexpr (std::is_base_of_v<IntBinary, BinaryType>) {
         if (inst->get_op() == Operator::INTBINARY &&
-            inst->as<BinaryType>()->intbinary_op() == BinaryTypeOp<BinaryType>::type_op) {
+            inst->as_ptr<BinaryType>()->intbinary_op() == BinaryTypeOp<BinaryType>::type_op) {
             return inst->as<BinaryType>();
         }
     } else if constexpr (std::is_base_of_v<FloatBinary, BinaryType>) {
         if (inst->get_op() == Operator::FLOATBINARY &&
-            inst->as<BinaryType>()->floatbinary_op() == BinaryTypeOp<BinaryType>::type_op) {
+            inst->as_ptr<BinaryType>()->floatbinary_op() == BinaryTypeOp<BinaryType>::type_op) {
             return inst->as<BinaryType>();
         }
     }
     return std::nullopt;
 }
 
+// 返回是否重建了表达式树
 template<typename BinaryType>
-void handle(const std::shared_ptr<Block> &block) {
+bool handle(const std::shared_ptr<Block> &block) {
     static_assert(is_supported_v<BinaryType>, "Unsupported binary type");
     using BinaryInst = std::shared_ptr<BinaryType>;
     std::vector<BinaryInst> candidates;
@@ -94,6 +95,7 @@ void handle(const std::shared_ptr<Block> &block) {
         }
     }
     std::unordered_set<std::shared_ptr<Value>> visited;
+    bool changed = false;
 
     for (const auto &root: candidates) {
         if (visited.count(root)) {
@@ -119,23 +121,29 @@ void handle(const std::shared_ptr<Block> &block) {
         }
         const auto new_root = build_balanced<BinaryType>(block, root, leaves, 0, leaves.size());
         root->replace_by_new_value(new_root);
+        changed = true;
     }
+    return changed;
 }
 } // namespace
 
 namespace Pass {
-void TreeHeightBalance::run_on_func(const std::shared_ptr<Function> &func) {
+bool TreeHeightBalance::run_on_func(const std::shared_ptr<Function> &func) {
+    bool changed = false;
     for (const auto &block: func->get_blocks()) {
-        handle<Add>(block);
-        handle<Mul>(block);
+        changed |= handle<Add>(block);
+        changed |= handle<Mul>(block);
     }
+    return changed;
 }
 
-void TreeHeightBalance::transform(const std::shared_ptr<Module> module) {
+bool TreeHeightBalance::transform(const std::shared_ptr<Module> module) {
+    bool changed = false;
     for (const auto &func: *module) {
-        run_on_func(func);
+        changed |= run_on_func(func);
     }
+    return changed;
 }
 
-void TreeHeightBalance::transform(const std::shared_ptr<Function> &func) { run_on_func(func); }
+bool TreeHeightBalance::transform(const std::shared_ptr<Function> &func) { return run_on_func(func); }
 } // namespace Pass
@@ -0,0 +1,175 @@
+#include "Pass/Transforms/ValueNumbering.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "Mir/Structure.h"
+
+using namespace Mir;
+
+namespace {
+size_t hash_combine(const size_t seed, const size_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+template<typename T>
+int sub_op_of(const T op) {
+    return static_cast<int>(op);
+}
+} // namespace
+
+namespace Pass {
+std::optional<InstructionKey> InstructionKey::create(const std::shared_ptr<Instruction> &instruction,
+                                                     const std::shared_ptr<FunctionAnalysis> &func_analysis) {
+    const auto op{instruction->get_op()};
+    const auto from_operands = [&](const int sub_op, const void *extra) {
+        InstructionKey key{op, sub_op, extra};
+        for (const auto &operand: instruction->get_operands()) {
+            key.push_operand(operand.get());
+        }
+        key.finalize();
+        return key;
+    };
+    switch (op) {
+        case Operator::GEP:
+        case Operator::FNEG:
+            return from_operands(0, nullptr);
+        case Operator::ICMP:
+            return from_operands(sub_op_of(instruction->as_ptr<Icmp>()->op), nullptr);
+        case Operator::FCMP:
+            return from_operands(sub_op_of(instruction->as_ptr<Fcmp>()->op), nullptr);
+        case Operator::FLOATTERNARY:
+            return from_operands(sub_op_of(instruction->as_ptr<FloatTernary>()->floatternary_op()), nullptr);
+        case Operator::ZEXT:
+        case Operator::SITOFP:
+        case Operator::FPTOSI:
+            return from_operands(0, instruction->get_type().get());
+        case Operator::INTBINARY:
+        case Operator::FLOATBINARY: {
+            const auto binary{instruction->as<Binary>()};
+            const int sub_op = op == Operator::INTBINARY ? sub_op_of(instruction->as_ptr<IntBinary>()->op)
+                                                         : sub_op_of(instruction->as_ptr<FloatBinary>()->op);
+            InstructionKey key{op, sub_op, nullptr};
+            const Value *lhs{binary->get_operand(0).get()}, *rhs{binary->get_operand(1).get()};
+            if (binary->is_commutative() && std::less<const Value *>{}(rhs, lhs)) {
+                std::swap(lhs, rhs);
+            }
+            key.push_operand(lhs);
+            key.push_operand(rhs);
+            key.finalize();
+            return key;
+        }
+        case Operator::CALL: {
+            // 只有无副作用、不读写IO且有返回值的用户函数调用可以编号，第0个操作数即为被调函数
+            const auto func{instruction->as_ptr<Call>()->get_function()->as<Function>()};
+            if (func->is_runtime_func()) {
+                return std::nullopt;
+            }
+            if (const auto &func_info = func_analysis->func_info(func);
+                func_info.has_return && func_info.no_state && !func_info.io_read && !func_info.io_write) {
+                return from_operands(0, nullptr);
+            }
+            return std::nullopt;
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+void InstructionKey::push_operand(const Value *operand) {
+    if (size_ < inline_capacity) [[likely]] {
+        inline_operands_[size_++] = operand;
+        return;
+    }
+    if (size_ == inline_capacity) {
+        spilled_operands_.assign(inline_operands_.begin(), inline_operands_.end());
+    }
+    spilled_operands_.push_back(operand);
+    ++size_;
+}
+
+void InstructionKey::finalize() {
+    size_t seed = hash_combine(static_cast<size_t>(op_), static_cast<size_t>(sub_op_));
+    seed = hash_combine(seed, std::hash<const void *>{}(extra_));
+    for (size_t i = 0; i < size_; ++i) {
+        seed = hash_combine(seed, std::hash<const Value *>{}(operand(i)));
+    }
+    hash_ = seed;
+}
+
+bool InstructionKey::operator==(const InstructionKey &other) const {
+    if (hash_ != other.hash_ || op_ != other.op_ || sub_op_ != other.sub_op_ || extra_ != other.extra_ ||
+        size_ != other.size_) {
+        return false;
+    }
+    for (size_t i = 0; i < size_; ++i) {
+        if (operand(i) != other.operand(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t ValueTable::locate(const InstructionKey &key) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = key.hash() & mask;; i = (i + 1) & mask) {
+        const auto &slot = slots_[i];
+        if (slot.state == State::Empty) {
+            return slots_.size();
+        }
+        if (slot.state == State::Occupied && *slot.key == key) {
+            return i;
+        }
+    }
+}
+
+std::shared_ptr<Instruction> ValueTable::find(const InstructionKey &key) const {
+    if (const auto index = locate(key); index != slots_.size()) {
+        return slots_[index].instruction;
+    }
+    return nullptr;
+}
+
+void ValueTable::insert(InstructionKey key, const std::shared_ptr<Instruction> &instruction) {
+    // 负载（含墓碑）超过 3/4 时重建；墓碑较多时只需原地重建
+    if ((size_ + deleted_ + 1) * 4 > slots_.size() * 3) [[unlikely]] {
+        rehash((size_ + 1) * 2 > slots_.size() ? slots_.size() * 2 : slots_.size());
+    }
+    const size_t mask = slots_.size() - 1;
+    size_t i = key.hash() & mask;
+    while (slots_[i].state == State::Occupied) {
+        i = (i + 1) & mask;
+    }
+    auto &slot = slots_[i];
+    if (slot.state == State::Deleted) {
+        --deleted_;
+    }
+    slot.state = State::Occupied;
+    slot.key = std::move(key);
+    slot.instruction = instruction;
+    ++size_;
+}
+
+void ValueTable::erase(const InstructionKey &key) {
+    if (const auto index = locate(key); index != slots_.size()) {
+        auto &slot = slots_[index];
+        slot.state = State::Deleted;
+        slot.key.reset();
+        slot.instruction = nullptr;
+        --size_;
+        ++deleted_;
+    }
+}
+
+void ValueTable::rehash(const size_t capacity) {
+    auto old_slots = std::move(slots_);
+    slots_ = std::vector<Slot>(capacity);
+    size_ = 0;
+    deleted_ = 0;
+    for (auto &slot: old_slots) {
+        if (slot.state == State::Occupied) {
+            insert(std::move(*slot.key), slot.instruction);
+        }
+    }
+}
+} // namespace Pass
@@ -9,31 +9,35 @@
 #include "Pass/Util.h"
 
 namespace Pass {
-    void ConstLoopUnroll::transform(std::shared_ptr<Mir::Module> module) {
+    bool ConstLoopUnroll::transform(std::shared_ptr<Mir::Module> module) {
         this->cfg_info_ = get_analysis_result<ControlFlowGraph>(module);
         this->scev_info_ = get_analysis_result<SCEVAnalysis>(module);
         this->loop_info_ = get_analysis_result<LoopAnalysis>(module);
+        bool changed = false;
         for (auto &function : *module) {
-            run_on( function);
+            changed |= run_on(function);
         }
+        return changed;
     }
 
-    void ConstLoopUnroll::transform(const std::shared_ptr<Mir::Function> &fun) {
-        bool modified = true;
+    bool ConstLoopUnroll::transform(const std::shared_ptr<Mir::Function> &fun) {
+        bool modified = true, changed = false;
         while (modified) {
             modified = false;
             this->cfg_info_->set_dirty(fun);
             this->loop_info_->set_dirty(fun);
-            create<LoopSimplyForm>()->run_on(fun);
-            create<LCSSA>()->run_on(fun);
-            create<LoopInvariantCodeMotion>()->run_on(fun);
+            changed |= create<LoopSimplyForm>()->run_on(fun);
+            changed |= create<LCSSA>()->run_on(fun);
+            changed |= create<LoopInvariantCodeMotion>()->run_on(fun);
             auto new_loop_info = get_analysis_result<LoopAnalysis>(Mir::Module::instance());
             for (auto node: new_loop_info->loop_forest(fun)) {
                 modified |= try_unroll(node, fun);
             }
-            create<GlobalValueNumbering>()->run_on(fun);
-            create<SimplifyControlFlow>()->run_on(fun);
+            changed |= modified;
+            changed |= create<GlobalValueNumbering>()->run_on(fun);
+            changed |= create<SimplifyControlFlow>()->run_on(fun);
         }
+        return changed;
     }
 
     bool ConstLoopUnroll::try_unroll(std::shared_ptr<LoopNodeTreeNode> loop_node, std::shared_ptr<Mir::Function> func) {
@@ -126,7 +130,6 @@ namespace Pass {
             auto terminator = header_block->get_instructions().back();
             if (auto br = terminator->is<Mir::Branch>()) {
                 auto next_block = (br->get_true_block() == loop_node->get_loop()->get_exits()[0]) ? br->get_false_block() : br->get_true_block();
-                br->cleanup_users();
                 br->clear_operands();
                 auto jump_instruction = Mir::Jump::create(next_block, header_block);
             }
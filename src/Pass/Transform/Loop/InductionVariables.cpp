@@ -6,18 +6,22 @@
 #include "Pass/Analyses/SCEVAnalysis.h"
 
 namespace Pass {
-    void InductionVariables::transform(std::shared_ptr<Mir::Module> module) {
+    bool InductionVariables::transform(std::shared_ptr<Mir::Module> module) {
         this->scev_info_ = get_analysis_result<SCEVAnalysis>(module);
         this->loop_info_ = get_analysis_result<LoopAnalysis>(module);
+        bool changed = false;
         for (auto &function : *module) {
-            run_on(function);
+            changed |= run_on(function);
         }
+        return changed;
     }
 
-    void InductionVariables::transform(const std::shared_ptr<Mir::Function> &function) {
+    bool InductionVariables::transform(const std::shared_ptr<Mir::Function> &function) {
         for (auto loop_node : this->loop_info_->loop_forest(function)) {
             run(loop_node);
         }
+        // 目前只计算循环次数，不修改函数
+        return false;
     }
 
     void InductionVariables::run(std::shared_ptr<LoopNodeTreeNode> &loop_node) {
@@ -35,26 +39,26 @@ namespace Pass {
 
         if(loop->get_exits().size() > 1) return false;
         auto instr = loop->get_header()->get_instructions().back();
-        if (!instr->is<Mir::Branch>()) return false;
+        if (!instr->is_ptr<Mir::Branch>()) return false;
         auto br = instr->as<Mir::Branch>();
         auto cond = br->get_cond();
-        if (!cond->is<Mir::Icmp>()) return false;
+        if (!cond->is_ptr<Mir::Icmp>()) return false;
 
         auto cond_instr = cond->as<Mir::Icmp>();
         auto lhs = cond_instr->get_lhs();
         auto rhs = cond_instr->get_rhs();
 
-        if (lhs->is<Mir::Phi>() && rhs->is<Mir::ConstInt>()) {
+        if (lhs->is_ptr<Mir::Phi>() && rhs->is_ptr<Mir::ConstInt>()) {
             if(!this->scev_info_->query(lhs)) return false;
-            int n = rhs->as<Mir::ConstInt>()->get_constant_value().get<int>();
+            int n = rhs->as_ptr<Mir::ConstInt>()->get_constant_value().get<int>();
 
             int ans = get_tick_num(this->scev_info_->query(lhs), cond_instr->icmp_op(), n);
             loop->set_trip_count(ans);
             return ans != -1;
         }
-        else if (rhs->is<Mir::Phi>() && lhs->is<Mir::ConstInt>()) {
+        else if (rhs->is_ptr<Mir::Phi>() && lhs->is_ptr<Mir::ConstInt>()) {
             if(!this->scev_info_->query(rhs)) return false;
-            int n = lhs->as<Mir::ConstInt>()->get_constant_value().get<int>();
+            int n = lhs->as_ptr<Mir::ConstInt>()->get_constant_value().get<int>();
 
             int ans = get_tick_num(this->scev_info_->query(rhs), Mir::Icmp::swap_op(cond_instr->icmp_op()), n);
             loop->set_trip_count(ans);
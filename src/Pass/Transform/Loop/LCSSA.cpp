@@ -5,22 +5,26 @@
 #include "Pass/Transforms/Loop.h"
 
 namespace Pass {
-void LCSSA::transform(std::shared_ptr<Mir::Module> module) {
+bool LCSSA::transform(std::shared_ptr<Mir::Module> module) {
     const auto cfg_info = get_analysis_result<ControlFlowGraph>(module);
     const auto dom_info = get_analysis_result<DominanceGraph>(module);
     const auto loop_info = get_analysis_result<LoopAnalysis>(module);
     this->set_cfg(cfg_info);
+    this->set_dom(dom_info);
     this->set_loop_info(loop_info);
 
 
+    bool changed = false;
     for (auto &fun: *module) {
-        this->run_on(fun);
+        changed |= this->run_on(fun);
     }
+    return changed;
 }
 
-void LCSSA::runOnNode(const std::shared_ptr<LoopNodeTreeNode> &loop_node) {
+bool LCSSA::runOnNode(const std::shared_ptr<LoopNodeTreeNode> &loop_node) {
+    bool changed = false;
     for (auto &child: loop_node->get_children())
-        runOnNode(child);
+        changed |= runOnNode(child);
 
     for (auto &block: loop_node->get_loop()->get_blocks()) {
         for (auto &inst: block->get_instructions()) {
@@ -28,9 +32,11 @@ void LCSSA::runOnNode(const std::shared_ptr<LoopNodeTreeNode> &loop_node) {
             if (usedOutLoop(inst, loop)) {
                 for (auto &exit: loop->get_exits())
                     addPhi4Exit(inst, exit, loop);
+                changed |= !loop->get_exits().empty();
             }
         }
     }
+    return changed;
 }
 
 void LCSSA::addPhi4Exit(const std::shared_ptr<Mir::Instruction> &inst, const std::shared_ptr<Mir::Block> &exit,
@@ -40,15 +46,14 @@ void LCSSA::addPhi4Exit(const std::shared_ptr<Mir::Instruction> &inst, const std
     new_phi->set_block(exit, false);
     exit->get_instructions().insert(exit->get_instructions().begin(), new_phi);
 
-    auto block_pre = this->cfg_info()->graph(exit->get_function()).predecessors;
-    for (auto &pre: block_pre[exit]) {
+    const auto &block_pre = this->cfg_info()->graph(exit->get_function()).predecessors;
+    for (auto &pre: block_pre.lookup(exit)) {
         new_phi->set_optional_value(pre, inst);
     }
 
     std::vector<std::shared_ptr<Mir::Instruction>> out_user;
-    auto block_dominated = this->dom_info()->graph(exit->get_function()).dominated_blocks;
-    auto dominated = block_dominated[exit];
-    for (auto user: inst->users()) {
+    const auto &dom_graph = this->dom_info()->graph(exit->get_function());
+    for (auto user: inst->users().lock()) {
         if (auto user_instr = std::dynamic_pointer_cast<Mir::Instruction>(user)) {
             if (loop->contain_block(user_instr->get_block()))
                 continue;
@@ -59,10 +64,10 @@ void LCSSA::addPhi4Exit(const std::shared_ptr<Mir::Instruction> &inst, const std
 
                 auto phi_user = std::dynamic_pointer_cast<Mir::Phi>(user_instr);
                 auto coming_block = phi_user->find_optional_block(inst);
-                if (std::find(dominated.begin(), dominated.end(), coming_block) == dominated.end())
+                if (!dom_graph.dominates(exit, coming_block))
                     continue;
             } else {
-                if (std::find(dominated.begin(), dominated.end(), user_instr->get_block()) == dominated.end())
+                if (!dom_graph.dominates(exit, user_instr->get_block()))
                     continue;
             }
             out_user.push_back(user_instr);
@@ -85,16 +90,19 @@ bool LCSSA::usedOutLoop(const std::shared_ptr<Mir::Instruction> &inst, const std
     return false;
 }
 
-void LCSSA::transform(const std::shared_ptr<Mir::Function> &func) {
+bool LCSSA::transform(const std::shared_ptr<Mir::Function> &func) {
     auto module = Mir::Module::instance();
     const auto cfg_info = get_analysis_result<ControlFlowGraph>(module);
     const auto dom_info = get_analysis_result<DominanceGraph>(module);
     const auto loop_info = get_analysis_result<LoopAnalysis>(module);
     this->set_cfg(cfg_info);
+    this->set_dom(dom_info);
     this->set_loop_info(loop_info);
 
+    bool changed = false;
     for (const auto &loop_node: loop_info->loop_forest(func)) {
-        runOnNode(loop_node);
+        changed |= runOnNode(loop_node);
     }
+    return changed;
 }
 } // namespace Pass
@@ -7,7 +7,7 @@
 
 namespace Pass {
 
-    void LoopInterchange::transform(std::shared_ptr<Mir::Module> module) {
+    bool LoopInterchange::transform(std::shared_ptr<Mir::Module> module) {
         const auto loop_info = get_analysis_result<LoopAnalysis>(module);
         const auto scev_info = get_analysis_result<SCEVAnalysis>(module);
         loop_info_ = loop_info;
@@ -15,6 +15,8 @@ namespace Pass {
         for(auto &func : *module) {
             run_on(func);
         }
+        // 交换循环尚未启用，只做合法性检查
+        return false;
     }
 
     void LoopInterchange::run_on(const std::shared_ptr<Mir::Function> &function) {
@@ -47,19 +49,19 @@ namespace Pass {
     bool LoopInterchange::is_computable(const std::shared_ptr<LoopNodeTreeNode> &loop_node) {
         auto loop = loop_node->get_loop();
         auto instr = loop->get_header()->get_instructions().back();
-        if (!instr->is<Mir::Branch>()) return false;
+        if (!instr->is_ptr<Mir::Branch>()) return false;
         auto br = instr->as<Mir::Branch>();
         auto cond = br->get_cond();
-        if (!cond->is<Mir::Icmp>()) return false;
+        if (!cond->is_ptr<Mir::Icmp>()) return false;
         auto cond_instr = cond->as<Mir::Icmp>();
 
         if(loop_node->def_value(cond_instr->get_lhs())) {
             if (!this->scev_info_->query(cond_instr->get_lhs())) return false;
-            if (!cond_instr->get_lhs()->is<Mir::Phi>()) return false;
+            if (!cond_instr->get_lhs()->is_ptr<Mir::Phi>()) return false;
         }
         else if (loop_node->def_value(cond_instr->get_rhs())) {
             if (!this->scev_info_->query(cond_instr->get_rhs())) return false;
-            if (!cond_instr->get_rhs()->is<Mir::Phi>()) return false;
+            if (!cond_instr->get_rhs()->is_ptr<Mir::Phi>()) return false;
         }
         //这里是在分析 回边是否可计算，不过可能不够严谨，先这样写
 
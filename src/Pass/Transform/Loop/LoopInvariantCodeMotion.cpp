@@ -5,7 +5,7 @@
 
 namespace Pass {
 
-void LoopInvariantCodeMotion::transform(std::shared_ptr<Mir::Module> module) {
+bool LoopInvariantCodeMotion::transform(std::shared_ptr<Mir::Module> module) {
     module->update_id(); // DEBUG
     const auto cfg_info = get_analysis_result<ControlFlowGraph>(module);
     const auto dom_info = get_analysis_result<DominanceGraph>(module);
@@ -21,6 +21,8 @@ void LoopInvariantCodeMotion::transform(std::shared_ptr<Mir::Module> module) {
             }
         }
     }
+    // 尚未移动任何指令
+    return false;
 }
 
 } // namespace Pass
@@ -5,7 +5,7 @@
 #include "Pass/Transforms/Loop.h"
 
 namespace Pass {
-void LoopSimplyForm::transform(std::shared_ptr<Mir::Module> module) {
+bool LoopSimplyForm::transform(std::shared_ptr<Mir::Module> module) {
     module->update_id(); // DEBUG
     const auto cfg_info = get_analysis_result<ControlFlowGraph>(module);
     const auto dom_info = get_analysis_result<DominanceGraph>(module);
@@ -14,20 +14,23 @@ void LoopSimplyForm::transform(std::shared_ptr<Mir::Module> module) {
     module->update_id(); // DEBUG
     loop_info->run_on(module);
 
+    // 每种修改都会新建基本块，据此判断是否修改了模块
+    bool changed = false;
     for (auto &func: *module) {
+        const Mir::Builder::NameScope name_scope{*func};
+        const size_t block_count = func->get_blocks().size();
         auto loops = loop_info->loops(func);
         auto block_predecessors = cfg_info->graph(func).predecessors;
-        auto block_dominators = dom_info->graph(func).dominator_blocks;
+        const auto &dom_graph = dom_info->graph(func);
         ;
         // TODO:以下为了分割三种动作的逻辑，拆分出了三个循环，之后需要把这个架构重构一下
 
         for (auto &loop: loops) {
             // 首先进行 entering 单一化：对于 header, 如果存在多个 entering, 则新建一个 , 将所有 entering 的跳转都指向它
-            auto predecessors = block_predecessors[loop->get_header()];
+            auto predecessors = block_predecessors.lookup(loop->get_header());
             std::vector<std::shared_ptr<Mir::Block>> entering;
             for (auto &predecessor: predecessors) {
-                if (block_dominators[predecessor].find(loop->get_header()) ==
-                    block_dominators[loop->get_header()].end())
+                if (!dom_graph.dominates(loop->get_header(), predecessor))
                     entering.push_back(predecessor);
             }
 
@@ -110,7 +113,7 @@ void LoopSimplyForm::transform(std::shared_ptr<Mir::Module> module) {
 
         for (auto &loop: loops) {
             for (auto &exit: loop->get_exits()) {
-                if (block_dominators[exit].find(loop->get_header()) == block_dominators[exit].end()) {
+                if (!dom_graph.dominates(loop->get_header(), exit)) {
                     auto new_exit_block = Mir::Block::create(Mir::Builder::gen_block_name(), func);
                     auto jump_instruction = Mir::Jump::create(exit, new_exit_block);
                     loop->add_block(new_exit_block);
@@ -120,7 +123,7 @@ void LoopSimplyForm::transform(std::shared_ptr<Mir::Module> module) {
 
                     std::vector<std::shared_ptr<Mir::Block>> tem_exitings;
                     for (auto &exiting: loop->get_exitings()) {
-                        if (block_predecessors[exit].find(exiting) != block_predecessors[exit].end()) {
+                        if (block_predecessors.lookup(exit).count(exiting)) {
                             exiting->modify_successor(exit, new_exit_block);
                             tem_exitings.push_back(exiting);
                         }
@@ -143,10 +146,12 @@ void LoopSimplyForm::transform(std::shared_ptr<Mir::Module> module) {
                 }
             }
         }
+        changed |= func->get_blocks().size() != block_count;
     }
+    return changed;
 }
 
-void LoopSimplyForm::transform(const std::shared_ptr<Mir::Function> &func) {
+bool LoopSimplyForm::transform(const std::shared_ptr<Mir::Function> &func) {
     auto module = Mir::Module::instance();
     const auto cfg_info = get_analysis_result<ControlFlowGraph>(module);
     const auto dom_info = get_analysis_result<DominanceGraph>(module);
@@ -155,18 +160,19 @@ void LoopSimplyForm::transform(const std::shared_ptr<Mir::Function> &func) {
     module->update_id(); // DEBUG
     loop_info->run_on(module);
 
+    const size_t block_count = func->get_blocks().size();
     auto loops = loop_info->loops(func);
     auto block_predecessors = cfg_info->graph(func).predecessors;
-    auto block_dominators = dom_info->graph(func).dominator_blocks;
+    const auto &dom_graph = dom_info->graph(func);
     ;
     // TODO:以下为了分割三种动作的逻辑，拆分出了三个循环，之后需要把这个架构重构一下
 
     for (auto &loop: loops) {
         // 首先进行 entering 单一化：对于 header, 如果存在多个 entering, 则新建一个 , 将所有 entering 的跳转都指向它
-        auto predecessors = block_predecessors[loop->get_header()];
+        auto predecessors = block_predecessors.lookup(loop->get_header());
         std::vector<std::shared_ptr<Mir::Block>> entering;
         for (auto &predecessor: predecessors) {
-            if (block_dominators[predecessor].find(loop->get_header()) == block_dominators[loop->get_header()].end())
+            if (!dom_graph.dominates(loop->get_header(), predecessor))
                 entering.push_back(predecessor);
         }
 
@@ -249,7 +255,7 @@ void LoopSimplyForm::transform(const std::shared_ptr<Mir::Function> &func) {
 
     for (auto &loop: loops) {
         for (auto &exit: loop->get_exits()) {
-            if (block_dominators[exit].find(loop->get_header()) == block_dominators[exit].end()) {
+            if (!dom_graph.dominates(loop->get_header(), exit)) {
                 auto new_exit_block = Mir::Block::create(Mir::Builder::gen_block_name(), func);
                 auto jump_instruction = Mir::Jump::create(exit, new_exit_block);
                 loop->add_block(new_exit_block);
@@ -259,7 +265,7 @@ void LoopSimplyForm::transform(const std::shared_ptr<Mir::Function> &func) {
 
                 std::vector<std::shared_ptr<Mir::Block>> tem_exitings;
                 for (auto &exiting: loop->get_exitings()) {
-                    if (block_predecessors[exit].find(exiting) != block_predecessors[exit].end()) {
+                    if (block_predecessors.lookup(exit).count(exiting)) {
                         exiting->modify_successor(exit, new_exit_block);
                         tem_exitings.push_back(exiting);
                     }
@@ -282,6 +288,7 @@ void LoopSimplyForm::transform(const std::shared_ptr<Mir::Function> &func) {
             }
         }
     }
+    return func->get_blocks().size() != block_count;
 }
 
 
@@ -7,27 +7,26 @@
 
 namespace Pass {
 
-void LoopUnSwitch::transform(std::shared_ptr<Mir::Module> module) {
-    const auto loop_info = get_analysis_result<LoopAnalysis>(module);
-    const auto cfg_info = get_analysis_result<ControlFlowGraph>(module);
-
+bool LoopUnSwitch::transform(std::shared_ptr<Mir::Module> module) {
+    // 各变换都自行报告或增量更新控制流的修改，每轮按需重新计算循环即可
+    bool changed = false;
     for (auto &fun: *module) {
         bool modified = true;
         while (modified) {
             modified = false;
-            cfg_info->set_dirty(fun);
-            loop_info->set_dirty(fun);
-            create<LoopSimplyForm>()->run_on(fun);
-            create<LCSSA>()->run_on(fun);
+            changed |= create<LoopSimplyForm>()->run_on(fun);
+            changed |= create<LCSSA>()->run_on(fun);
             auto new_loop_info = get_analysis_result<LoopAnalysis>(module);
             for (auto node: new_loop_info->loop_forest(fun)) {
                 modified |= un_switching(node);
             }
-            create<GlobalValueNumbering>()->run_on(fun);
-            create<GlobalCodeMotion>()->run_on(fun);
-            create<SimplifyControlFlow>()->run_on(fun);
+            changed |= modified;
+            changed |= create<GlobalValueNumbering>()->run_on(fun);
+            changed |= create<GlobalCodeMotion>()->run_on(fun);
+            changed |= create<SimplifyControlFlow>()->run_on(fun);
         }
     }
+    return changed;
 }
 
 bool LoopUnSwitch::un_switching(std::shared_ptr<LoopNodeTreeNode> &node) {
@@ -57,6 +56,7 @@ void LoopUnSwitch::handle_branch(std::shared_ptr<LoopNodeTreeNode> &node,
     auto branch = branch_vector[0];
     auto parent_function = branch->get_block()->get_function();
     auto last_preheader = node->get_loop()->get_preheader();
+    const auto cfg_info = get_analysis_result<ControlFlowGraph>(Mir::Module::instance());
 
     std::vector<std::shared_ptr<Mir::Block>> true_blocks;
     std::vector<std::shared_ptr<Mir::Block>> false_blocks;
@@ -104,6 +104,18 @@ void LoopUnSwitch::handle_branch(std::shared_ptr<LoopNodeTreeNode> &node,
     auto instr = last_preheader->get_instructions().back()->as<Mir::Terminator>();
     instr->modify_operand(node->get_loop()->get_header(), cond_blocks[0]);
 
+    // 复制出的循环与新建的判断块加入控制流图，再让 preheader 改为进入判断块，原循环随之不可达
+    for (const auto &clone_info: clone_infos) {
+        for (const auto &block: clone_info->node_cpy->get_loop()->get_blocks()) {
+            cfg_info->insert_block(parent_function, block);
+        }
+    }
+    for (int i = 1; i < (1 << branch_vector.size()); i++) {
+        cfg_info->insert_block(parent_function, cond_blocks.at(i - 1));
+    }
+    cfg_info->insert_edge(parent_function, last_preheader, cond_blocks[0]);
+    cfg_info->delete_edge(parent_function, last_preheader, node->get_loop()->get_header());
+
     for (const auto &exit_block: node->get_loop()->get_exits()) {
         for (const auto &phi_instr: *exit_block->get_phis()) {
             auto phi = phi_instr->is<Mir::Phi>();
@@ -133,9 +145,9 @@ void LoopUnSwitch::collect_branch(std::shared_ptr<LoopNodeTreeNode> &node,
     auto loop = node->get_loop();
     for (auto &block: loop->get_blocks()) {
 
-        if (block->get_instructions().back()->is<Mir::Branch>()) {
+        if (block->get_instructions().back()->is_ptr<Mir::Branch>()) {
             auto branch = block->get_instructions().back()->as<Mir::Branch>();
-            if (branch->get_cond()->is<Mir::Const>())
+            if (branch->get_cond()->is_ptr<Mir::Const>())
                 continue;
             if (node->def_value(branch->get_cond()))
                 continue;
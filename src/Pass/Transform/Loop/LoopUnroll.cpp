@@ -9,31 +9,35 @@
 #include "Pass/Util.h"
 
 namespace Pass {
-    void LoopUnroll::transform(std::shared_ptr<Mir::Module> module) {
+    bool LoopUnroll::transform(std::shared_ptr<Mir::Module> module) {
         this->cfg_info_ = get_analysis_result<ControlFlowGraph>(module);
         this->scev_info_ = get_analysis_result<SCEVAnalysis>(module);
         this->loop_info_ = get_analysis_result<LoopAnalysis>(module);
+        bool changed = false;
         for (auto &function : *module) {
-            run_on( function);
+            changed |= run_on(function);
         }
+        return changed;
     }
 
-    void LoopUnroll::transform(const std::shared_ptr<Mir::Function> &fun) {
-        bool modified = true;
+    bool LoopUnroll::transform(const std::shared_ptr<Mir::Function> &fun) {
+        bool modified = true, changed = false;
         while (modified) {
             modified = false;
             this->cfg_info_->set_dirty(fun);
             this->loop_info_->set_dirty(fun);
-            create<LoopSimplyForm>()->run_on(fun);
-            create<LCSSA>()->run_on(fun);
-            create<LoopInvariantCodeMotion>()->run_on(fun);
+            changed |= create<LoopSimplyForm>()->run_on(fun);
+            changed |= create<LCSSA>()->run_on(fun);
+            changed |= create<LoopInvariantCodeMotion>()->run_on(fun);
             auto new_loop_info = get_analysis_result<LoopAnalysis>(Mir::Module::instance());
             for (auto node: new_loop_info->loop_forest(fun)) {
                 modified |= try_unroll(node, fun);
             }
-            create<GlobalValueNumbering>()->run_on(fun);
-            create<SimplifyControlFlow>()->run_on(fun);
+            changed |= modified;
+            changed |= create<GlobalValueNumbering>()->run_on(fun);
+            changed |= create<SimplifyControlFlow>()->run_on(fun);
         }
+        return changed;
     }
 
     bool LoopUnroll::can_unroll(std::shared_ptr<LoopNodeTreeNode> loop_node, std::shared_ptr<Mir::Function> func) {
@@ -45,10 +49,10 @@ namespace Pass {
         if (block_predecessors.size() != 1 || *block_predecessors.begin() != loop_node->get_loop()->get_header()) return false;
 
         auto terminator = loop_node->get_loop()->get_header()->get_instructions().back();
-        if (!terminator->is<Mir::Branch>()) return false;
+        if (!terminator->is_ptr<Mir::Branch>()) return false;
         auto br = terminator->as<Mir::Branch>();
         auto cond = br->get_cond();
-        if(!cond->is<Mir::Icmp>()) return false;
+        if(!cond->is_ptr<Mir::Icmp>()) return false;
         auto icmp = cond->as<Mir::Icmp>();
         if (icmp->icmp_op() == Mir::Icmp::Op::EQ || icmp->icmp_op() == Mir::Icmp::Op::NE) return false;
 
@@ -158,7 +162,6 @@ namespace Pass {
         auto end_info = clone_infos[this->unroll_times - 1];
         auto termin = end_info->node_cpy->get_loop()->get_latch()->get_instructions().back();
         termin->clear_operands();
-        termin->cleanup_users();
         auto jump_instr = Mir::Jump::create(begin_info->node_cpy->get_loop()->get_header(), end_info->node_cpy->get_loop()->get_latch());
 
         for (auto phi : *loop_node->get_loop()->get_header()->get_phis()) {
@@ -191,7 +194,6 @@ namespace Pass {
             auto terminator = header_block->get_instructions().back();
             if (auto br = terminator->is<Mir::Branch>()) {
                 auto next_block = (br->get_true_block() == loop_node->get_loop()->get_exits()[0]) ? br->get_false_block() : br->get_true_block();
-                br->cleanup_users();
                 br->clear_operands();
                 auto new_jump_instruction = Mir::Jump::create(next_block, header_block);
             }
@@ -0,0 +1,15 @@
+#include <algorithm>
+
+#include "Utils/AST.h"
+
+namespace AST {
+std::byte *Arena::new_chunk(const size_t size, const size_t align) {
+    // 超过块大小的大数组独占一块
+    const size_t bytes = std::max(chunk_size, size);
+    chunks_.emplace_back(new std::byte[bytes]);
+    bytes_reserved_ += bytes;
+    cursor_ = chunks_.back().get();
+    limit_ = cursor_ + bytes;
+    return reinterpret_cast<std::byte *>((reinterpret_cast<uintptr_t>(cursor_) + align - 1) & ~(align - 1));
+}
+} // namespace AST
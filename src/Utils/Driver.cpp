@@ -1,3 +1,5 @@
+#include <thread>
+
 #include "Compiler.h"
 
 const compiler_options debug_compile_options = {
@@ -25,12 +27,38 @@ std::string opt_level_to_string(const Optimize_level level) {
     return "unknown";
 }
 
+RISCV::RegisterAllocator::AllocationType compiler_options::allocation_type() const {
+    if (register_allocator.has_value()) {
+        return register_allocator.value();
+    }
+    return opt_level == Optimize_level::O0 ? RISCV::RegisterAllocator::AllocationType::LINEAR_SCAN
+                                           : RISCV::RegisterAllocator::AllocationType::GRAPH_COLORING;
+}
+
+size_t compiler_options::worker_threads() const {
+    if (jobs.has_value()) {
+        return jobs.value();
+    }
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
 void compiler_options::print() const {
     std::stringstream ss;
     ss << "Options: "
             << "-input=" << input_file
             << ", -assembly=" << (_emit_options.emit_riscv ? "rsicv" : "arm");
     ss << ", opt=-" << opt_level_to_string(opt_level);
+    ss << ", regalloc="
+       << (allocation_type() == RISCV::RegisterAllocator::AllocationType::LINEAR_SCAN ? "linear-scan" : "graph-coloring");
+    if (!passes.empty()) {
+        ss << ", -passes=" << passes;
+    }
+    if (parallel_passes) {
+        ss << ", -fparallel-passes";
+    }
+    if (parallel_passes || jobs.has_value()) {
+        ss << ", jobs=" << worker_threads();
+    }
     if (_emit_options.emit_tokens) {
         ss << ", -emit-tokens=" << (_emit_options.tokens_file.empty() ? "stdout" : _emit_options.tokens_file);
     }
@@ -64,7 +92,20 @@ void usage(const char *prog_name) {
               << "  -emit-llvm [<file>]     Output LLVM IR to file or (default) .ll file\n"
               << "  -emit-lir [<file>]      Output LIR to file or (default) .lir file\n"
               << "  -emit-riscv [<file>]    Output RISC-V assembly to file or (default) .s file\n"
-              << "  -emit-arm [<file>]      Output ARM assembly to file or (default) .s file\n";
+              << "  -emit-arm [<file>]      Output ARM assembly to file or (default) .s file\n"
+              << "  -fno-ir-arena           Allocate IR nodes on the heap instead of the module arena\n"
+              << "  -fregalloc=<algorithm>  Register allocator: linear-scan (default at -O0) or graph-coloring\n"
+              << "  -fparallel-passes       Run function-local passes on a thread pool, one function per task\n"
+              << "  -j <N>                  Number of worker threads, also compiles functions in parallel in the backend\n"
+              << "  -passes=<pipeline>      Run the given pass pipeline instead of the one chosen by -O, e.g.\n"
+              << "                          -passes=mem2reg,fixpoint(lvn,simplify-cfg),dce,remove-phi\n"
+              << "                          algebraic-simplify,simplify-cfg run before every remove-phi,\n"
+              << "                          and all three are appended if the pipeline has no remove-phi\n"
+              << "  -stats                  Print compilation statistics to stderr\n"
+              << "  -ftime-report[=<file>]  Print the time spent in every pass and backend phase to stderr,\n"
+              << "                          and write every measurement as JSON to <file> if given\n"
+              << "  -ftrace=<file>          Write nested spans of phases, passes, functions and register allocation\n"
+              << "                          rounds to <file> as Chrome trace_event JSON\n";
 }
 
 compiler_options parse_args(const int argc, char *argv[]) {
@@ -144,6 +185,64 @@ compiler_options parse_args(const int argc, char *argv[]) {
                 } else {
                     i++;
                 }
+            } else if (arg == "-fno-ir-arena") {
+                options.ir_arena = false;
+                i++;
+            } else if (arg == "-stats") {
+                options.print_stats = true;
+                i++;
+            } else if (arg == "-ftime-report") {
+                options.time_report = true;
+                i++;
+            } else if (arg.rfind("-passes=", 0) == 0) {
+                options.passes = arg.substr(std::string("-passes=").size());
+                if (options.passes.empty()) {
+                    usage(argv[0]);
+                    log_fatal("Missing pipeline after -passes=");
+                }
+                // 尽早报告语法错误与未知的变换名
+                (void) Pass::Pipeline::parse(options.passes);
+                i++;
+            } else if (arg.rfind("-ftrace=", 0) == 0) {
+                options.trace_file = arg.substr(std::string("-ftrace=").size());
+                if (options.trace_file.empty()) {
+                    usage(argv[0]);
+                    log_fatal("Missing file after -ftrace=");
+                }
+                i++;
+            } else if (arg.rfind("-ftime-report=", 0) == 0) {
+                options.time_report = true;
+                options.time_report_file = arg.substr(std::string("-ftime-report=").size());
+                if (options.time_report_file.empty()) {
+                    usage(argv[0]);
+                    log_fatal("Missing file after -ftime-report=");
+                }
+                i++;
+            } else if (arg.rfind("-fregalloc=", 0) == 0) {
+                if (const std::string algorithm = arg.substr(std::string("-fregalloc=").size()); algorithm == "linear-scan") {
+                    options.register_allocator = RISCV::RegisterAllocator::AllocationType::LINEAR_SCAN;
+                } else if (algorithm == "graph-coloring") {
+                    options.register_allocator = RISCV::RegisterAllocator::AllocationType::GRAPH_COLORING;
+                } else {
+                    usage(argv[0]);
+                    log_fatal("Unknown register allocator: %s", algorithm.c_str());
+                }
+                i++;
+            } else if (arg == "-fparallel-passes") {
+                options.parallel_passes = true;
+                i++;
+            } else if (arg.rfind("-j", 0) == 0) {
+                // 同时接受 -j <N> 与 -j<N>
+                std::string count = arg.substr(2);
+                if (count.empty() && i + 1 < argc) {
+                    count = argv[++i];
+                }
+                if (count.empty() || count.find_first_not_of("0123456789") != std::string::npos || std::stoul(count) == 0) {
+                    usage(argv[0]);
+                    log_fatal("Invalid number of jobs: %s", count.c_str());
+                }
+                options.jobs = std::stoul(count);
+                i++;
             } else {
                 usage(argv[0]);
                 log_fatal("Unknown option: %s", arg.c_str());
@@ -179,6 +278,21 @@ compiler_options parse_args(const int argc, char *argv[], compiler_options optio
     if (options_.opt_level != default_opt_level) {
         options.opt_level = options_.opt_level;
     }
+    options.ir_arena = options_.ir_arena;
+    options.print_stats = options_.print_stats;
+    options.time_report = options_.time_report;
+    options.time_report_file = options_.time_report_file;
+    options.trace_file = options_.trace_file;
+    if (!options_.passes.empty()) {
+        options.passes = options_.passes;
+    }
+    if (options_.register_allocator.has_value()) {
+        options.register_allocator = options_.register_allocator;
+    }
+    options.parallel_passes = options_.parallel_passes;
+    if (options_.jobs.has_value()) {
+        options.jobs = options_.jobs;
+    }
     if (options_._emit_options.emit_tokens) {
         options._emit_options.emit_tokens = true;
         options._emit_options.tokens_file = options_._emit_options.tokens_file;
@@ -210,16 +324,14 @@ void emit_tokens(const std::vector<Token::Token> &tokens, const emit_options &op
     if (!options.emit_tokens)
         return;
     log_info("Emitting tokens...");
-    emit_output(options.tokens_file, [&tokens]() -> std::string {
-        std::stringstream ss;
+    emit_output(options.tokens_file, [&tokens](Utils::OutputSink &out) {
         for (const auto &token: tokens) {
-            ss << token.to_string() << std::endl;
+            out << token.to_string() << "\n";
         }
-        return ss.str();
-    }());
+    });
 }
 
-void emit_ast(const std::shared_ptr<AST::CompUnit> &ast, const emit_options &options) {
+void emit_ast(const AST::CompUnit *ast, const emit_options &options) {
     if (!options.emit_ast)
         return;
     log_info("Emitting AST...");
@@ -231,15 +343,53 @@ void emit_llvm(const std::shared_ptr<Mir::Module> &module, const emit_options &o
         return;
     log_info("Emitting LLVM IR...");
     module->update_id();
-    emit_output(options.llvm_file, module->to_string());
+    emit_output(options.llvm_file, [&module](Utils::OutputSink &out) { module->print(out); });
 }
 
 void emit_riscv(const RISCV::Assembler &assembler, const compiler_options &options) {
     if (!options._emit_options.emit_riscv) return;
     if (options._emit_options.emit_lir) {
         log_info("Emitting LIR...");
-        emit_output(options._emit_options.lir_file, assembler.lir_module->to_string());
+        emit_output(options._emit_options.lir_file,
+                    [&assembler](Utils::OutputSink &out) { assembler.lir_module->print(out); });
     }
     log_info("Emitting RISC-V assembly...");
-    emit_output(options._emit_options.riscv_file, assembler.to_string());
+    const Utils::ScopedTimer timer("backend", "emission");
+    emit_output(options._emit_options.riscv_file, [&assembler](Utils::OutputSink &out) { assembler.print(out); });
+}
+
+void emit_statistics(const std::shared_ptr<Mir::Module> &module, const compiler_options &options) {
+    if (!options.print_stats)
+        return;
+    log_info("Emitting statistics...");
+    std::cerr << "===== Statistics =====" << std::endl;
+    if (const auto arena = module->get_arena()) {
+        std::cerr << arena->statistics_string() << std::endl;
+    } else {
+        std::cerr << "arena disabled" << std::endl;
+    }
+    std::cerr << module->get_constant_pool().statistics_string() << std::endl;
+    const auto size = Pass::ir_size(module);
+    std::cerr << "ir.functions " << size.functions << "\n"
+              << "ir.blocks " << size.blocks << "\n"
+              << "ir.instructions " << size.instructions << std::endl;
+    std::cerr << Pass::analysis_statistics_string() << std::endl;
+}
+
+void emit_time_report(const compiler_options &options) {
+    if (!options.time_report)
+        return;
+    log_info("Emitting time report...");
+    std::cerr << "===== Time Report =====" << std::endl;
+    std::cerr << Utils::time_report_table() << std::endl;
+    if (!options.time_report_file.empty()) {
+        emit_output(options.time_report_file, Utils::time_report_json());
+    }
+}
+
+void emit_trace(const compiler_options &options) {
+    if (options.trace_file.empty())
+        return;
+    log_info("Emitting trace...");
+    Utils::write_trace(options.trace_file);
 }
@@ -22,12 +22,16 @@
 
 #include "Utils/Log.h"
 #include <chrono>
+#include <mutex>
 
 static std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
 
 static int current_level = LOG_INFO;
 static bool quiet_mode = false;
 
+// 并行执行变换时，多个线程的日志不应交错在同一行中
+static std::mutex log_mutex;
+
 static const char *level_strings[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
 
 #ifdef LOG_USE_COLOR
@@ -47,6 +51,7 @@ void log_log(const int level, const char *file, const int line, const char *fmt,
 
     const auto now = std::chrono::steady_clock::now();
     const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time).count();
+    std::lock_guard lock{log_mutex};
 
 #ifdef LOG_USE_COLOR
     fprintf(stdout, "[%5ldms] %s%-5s\x1b[0m \x1b[90m%s:%d:\x1b[0m ", static_cast<long>(elapsed_ms), level_colors[level],
@@ -0,0 +1,80 @@
+#include <cerrno>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+#include "Utils/Log.h"
+#include "Utils/OutputSink.h"
+
+namespace {
+// 写入全部 size 个字节，被信号打断时重试
+bool write_all(const int fd, const char *data, size_t size) noexcept {
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+} // namespace
+
+namespace Utils {
+OutputSink::OutputSink(const std::string &path) : buffer_{new char[buffer_size]} {
+    if (path.empty()) {
+        // 之前经 std::cout 输出的内容须先写出，保证顺序
+        std::cout.flush();
+        fd_ = STDOUT_FILENO;
+        return;
+    }
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        log_error("Failed to open file: %s", path.c_str());
+    }
+    owns_fd_ = true;
+}
+
+OutputSink::~OutputSink() {
+    if (fd_ >= 0) {
+        drain();
+        if (owns_fd_) {
+            ::close(fd_);
+        }
+    }
+}
+
+bool OutputSink::drain() noexcept {
+    const bool ok = write_all(fd_, buffer_.get(), used_);
+    used_ = 0;
+    return ok;
+}
+
+void OutputSink::flush() {
+    if (target_ != nullptr || used_ == 0)
+        return;
+    if (!drain()) {
+        log_error("Failed to write output");
+    }
+}
+
+void OutputSink::write_through(const char *data, const size_t size) {
+    if (!write_all(fd_, data, size)) {
+        log_error("Failed to write output");
+    }
+}
+
+void OutputSink::close() {
+    if (target_ != nullptr || fd_ < 0)
+        return;
+    flush();
+    if (owns_fd_ && ::close(fd_) != 0) {
+        fd_ = -1;
+        log_error("Failed to close output");
+    }
+    fd_ = -1;
+}
+} // namespace Utils
@@ -4,17 +4,6 @@
 #include "Utils/AST.h"
 #include "Utils/Token.h"
 
-template<typename T>
-void join_and_append(std::ostringstream &oss, const std::vector<std::shared_ptr<T>> &items,
-                     const std::string &separator) {
-    for (size_t i = 0; i < items.size(); ++i) {
-        oss << items[i]->to_string();
-        if (i != items.size() - 1) {
-            oss << separator;
-        }
-    }
-}
-
 std::string Token::type_to_string(const Type type) {
     switch (type) {
         // 关键词
@@ -153,10 +142,10 @@ namespace AST {
 [[nodiscard]] std::string ConstInitVal::to_string() const {
     std::ostringstream oss;
     if (is_constExp()) {
-        const auto &constExp = std::get<std::shared_ptr<ConstExp>>(value_);
+        const auto &constExp = std::get<const ConstExp *>(value_);
         oss << constExp->to_string() << "\n";
     } else if (is_constInitVals()) {
-        const auto &constInitVals = std::get<std::vector<std::shared_ptr<ConstInitVal>>>(value_);
+        const auto &constInitVals = std::get<List<const ConstInitVal *>>(value_);
         oss << "{\n";
         for (size_t i = 0u; i < constInitVals.size(); ++i) {
             oss << constInitVals[i]->to_string();
@@ -201,10 +190,10 @@ namespace AST {
 [[nodiscard]] std::string InitVal::to_string() const {
     std::ostringstream oss;
     if (is_exp()) {
-        const auto &exp = std::get<std::shared_ptr<Exp>>(value_);
+        const auto &exp = std::get<const Exp *>(value_);
         oss << exp->to_string() << "\n";
     } else if (is_initVals()) {
-        const auto &initVals = std::get<std::vector<std::shared_ptr<InitVal>>>(value_);
+        const auto &initVals = std::get<List<const InitVal *>>(value_);
         oss << "{\n";
         for (size_t i = 0u; i < initVals.size(); ++i) {
             oss << initVals[i]->to_string();
@@ -324,10 +313,10 @@ namespace AST {
 
 [[nodiscard]] std::string Exp::to_string() const {
     std::ostringstream oss;
-    if (std::holds_alternative<std::shared_ptr<AddExp>>(addExp_)) {
-        oss << std::get<std::shared_ptr<AddExp>>(addExp_)->to_string() << "\n<Exp>";
+    if (std::holds_alternative<const AddExp *>(addExp_)) {
+        oss << std::get<const AddExp *>(addExp_)->to_string() << "\n<Exp>";
     } else {
-        oss << std::get<std::string>(addExp_) << "\n<ConstString>";
+        oss << std::get<std::string_view>(addExp_) << "\n<ConstString>";
     }
     return oss.str();
 }
@@ -353,13 +342,13 @@ namespace AST {
 [[nodiscard]] std::string PrimaryExp::to_string() const {
     std::ostringstream oss;
     if (is_exp()) {
-        const auto &exp = std::get<std::shared_ptr<Exp>>(value_);
+        const auto &exp = std::get<const Exp *>(value_);
         oss << "(\n" + exp->to_string() << "\n)\n";
     } else if (is_lVal()) {
-        const auto &lVal = std::get<std::shared_ptr<LVal>>(value_);
+        const auto &lVal = std::get<const LVal *>(value_);
         oss << lVal->to_string() << "\n";
     } else if (is_number()) {
-        const auto &number = std::get<std::shared_ptr<Number>>(value_);
+        const auto &number = std::get<const Number *>(value_);
         oss << number->to_string() << "\n";
     } else {
         throw std::runtime_error("Invalid PrimaryExp");
@@ -375,7 +364,7 @@ namespace AST {
 [[nodiscard]] std::string UnaryExp::to_string() const {
     std::ostringstream oss;
     if (is_primaryExp()) {
-        const auto &primaryExp = std::get<std::shared_ptr<PrimaryExp>>(value_);
+        const auto &primaryExp = std::get<const PrimaryExp *>(value_);
         oss << primaryExp->to_string() << "\n";
     } else if (is_call()) {
         const auto &[ident, params] = std::get<call>(value_);
@@ -492,237 +481,226 @@ std::string str_to_llvm_ir(const std::string &str) {
 
 namespace Mir {
 [[nodiscard]] std::string Module::to_string() const {
-    std::ostringstream oss;
+    return Utils::print_to_string([this](Utils::OutputSink &out) { print(out); });
+}
+
+void Module::print(Utils::OutputSink &out) const {
     for (size_t i = 0; i < const_strings.size(); ++i) {
-        oss << "@.str_" << i + 1 << " = private unnamed_addr constant [" << str_to_llvm_ir(const_strings[i]) << "\n";
+        out << "@.str_" << i + 1 << " = private unnamed_addr constant [" << str_to_llvm_ir(const_strings[i]) << "\n";
     }
     if (!const_strings.empty()) {
-        oss << "\n";
+        out << "\n";
     }
-    join_and_append(oss, used_runtime_functions, "\n");
-    if (!used_runtime_functions.empty()) {
-        oss << "\n";
+    for (const auto &function: used_runtime_functions) {
+        function->print(out);
+        out << "\n";
     }
-    // 拼接全局变量
-    join_and_append(oss, global_variables, "\n");
-    if (!global_variables.empty()) {
-        oss << "\n";
+    // 全局变量
+    for (const auto &global_variable: global_variables) {
+        global_variable->print(out);
+        out << "\n";
     }
-    // 拼接函数
-    join_and_append(oss, functions, "\n");
-    if (!functions.empty()) {
-        oss << "\n";
+    // 函数
+    for (const auto &function: functions) {
+        function->print(out);
+        out << "\n";
     }
-    oss << "\ndeclare void @llvm.memset.p0i8.i32(i8* nocapture writeonly, i8, i32, i1 immarg)\n";
-    return oss.str();
+    out << "\ndeclare void @llvm.memset.p0i8.i32(i8* nocapture writeonly, i8, i32, i1 immarg)\n";
 }
 
-
 [[nodiscard]] std::string GlobalVariable::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = dso_local " << (is_constant ? "constant " : "global ") << init_value->to_string();
-    return oss.str();
+    return Utils::print_to_string([this](Utils::OutputSink &out) { print(out); });
+}
+
+void GlobalVariable::print(Utils::OutputSink &out) const {
+    out << name_ << " = dso_local " << (is_constant ? "constant " : "global ");
+    init_value->print(out);
 }
 
 [[nodiscard]] std::string Function::to_string() const {
+    return Utils::print_to_string([this](Utils::OutputSink &out) { print(out); });
+}
+
+void Function::print(Utils::OutputSink &out) const {
     if (is_runtime_function) {
-        if (name_ == "putf")
-            return "declare void @putf(i8*, ...)";
-        std::ostringstream oss;
-        oss << "declare " << type_->to_string() << " @" << name_ << "(";
+        if (name_ == "putf") {
+            out << "declare void @putf(i8*, ...)";
+            return;
+        }
+        out << "declare " << type_->to_string() << " @" << name_ << "(";
         for (size_t i = 0; i < arguments.size(); ++i) {
-            oss << arguments[i]->get_type()->to_string();
+            out << arguments[i]->get_type()->to_string();
             if (i != arguments.size() - 1) {
-                oss << ", ";
+                out << ", ";
             }
         }
-        oss << ")";
-        return oss.str();
+        out << ")";
+        return;
     }
-    std::ostringstream param_info;
+    out << "define dso_local " << type_->to_string() << " @" << name_ << "(";
     for (size_t i = 0; i < arguments.size(); ++i) {
-        param_info << arguments[i]->to_string();
+        out << arguments[i]->to_string();
         if (i != arguments.size() - 1) {
-            param_info << ", ";
+            out << ", ";
         }
     }
-    std::ostringstream block_info;
+    out << ") {\n";
     for (size_t i = 0; i < blocks.size(); ++i) {
-        block_info << blocks[i]->to_string();
+        blocks[i]->print(out);
         if (i != blocks.size() - 1) {
-            block_info << "\n";
+            out << "\n";
         }
     }
-    std::ostringstream function_info;
-    function_info << "define dso_local " << type_->to_string() << " @" << name_ << "(" << param_info.str() << ") {\n"
-            << block_info.str() << "\n}";
-    return function_info.str();
+    out << "\n}";
 }
 
 [[nodiscard]] std::string Block::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << ":\n\t";
+    return Utils::print_to_string([this](Utils::OutputSink &out) { print(out); });
+}
+
+void Block::print(Utils::OutputSink &out) const {
+    out << name_ << ":\n\t";
     for (size_t i = 0; i < instructions.size(); ++i) {
-        oss << instructions[i]->to_string();
+        instructions[i]->print(out);
         if (i != instructions.size() - 1) {
-            oss << "\n\t";
+            out << "\n\t";
         }
     }
-    return oss.str();
 }
 
-[[nodiscard]] std::string Alloc::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = ";
+#define TO_STRING_BY_PRINT(Class)                                                                                      \
+    [[nodiscard]] std::string Class::to_string() const {                                                               \
+        return Utils::print_to_string([this](Utils::OutputSink &out) { print(out); });                                 \
+    }
+
+TO_STRING_BY_PRINT(Alloc)
+TO_STRING_BY_PRINT(Load)
+TO_STRING_BY_PRINT(Store)
+TO_STRING_BY_PRINT(GetElementPtr)
+TO_STRING_BY_PRINT(BitCast)
+TO_STRING_BY_PRINT(Fptosi)
+TO_STRING_BY_PRINT(Sitofp)
+TO_STRING_BY_PRINT(Fcmp)
+TO_STRING_BY_PRINT(Icmp)
+TO_STRING_BY_PRINT(Zext)
+TO_STRING_BY_PRINT(Branch)
+TO_STRING_BY_PRINT(Jump)
+TO_STRING_BY_PRINT(Ret)
+TO_STRING_BY_PRINT(Call)
+TO_STRING_BY_PRINT(Phi)
+
+#undef TO_STRING_BY_PRINT
+
+namespace {
+// 输出 "<类型> <名字>"
+void print_typed(Utils::OutputSink &out, const std::shared_ptr<Value> &value) {
+    out << value->get_type()->to_string() << " " << value->get_name();
+}
+
+// 输出 "<名字> = <指令> <原类型> <原值> to <目标类型>"
+void print_cast(Utils::OutputSink &out, const std::string &name, const char *instr_name,
+                const std::shared_ptr<Value> &origin_value, const std::shared_ptr<Type::Type> &type) {
+    out << name << " = " << instr_name << " ";
+    print_typed(out, origin_value);
+    out << " to " << type->to_string();
+}
+} // namespace
+
+void Alloc::print(Utils::OutputSink &out) const {
     const auto &type = std::static_pointer_cast<Type::Pointer>(type_);
-    oss << "alloca " << type->get_contain_type()->to_string();
-    return oss.str();
+    out << name_ << " = alloca " << type->get_contain_type()->to_string();
 }
 
-[[nodiscard]] std::string Load::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = ";
-    oss << "load " << type_->to_string() << ", ";
-    const auto &addr = get_addr();
-    oss << addr->get_type()->to_string() << " " << addr->get_name();
-    return oss.str();
+void Load::print(Utils::OutputSink &out) const {
+    out << name_ << " = load " << type_->to_string() << ", ";
+    print_typed(out, get_addr());
 }
 
-[[nodiscard]] std::string Store::to_string() const {
-    std::ostringstream oss;
-    oss << "store ";
-    const auto &addr = get_addr(), &value = get_value();
-    oss << value->get_type()->to_string() << " " << value->get_name() << ", ";
-    oss << addr->get_type()->to_string() << " " << addr->get_name();
-    return oss.str();
+void Store::print(Utils::OutputSink &out) const {
+    out << "store ";
+    print_typed(out, get_value());
+    out << ", ";
+    print_typed(out, get_addr());
 }
 
-[[nodiscard]] std::string GetElementPtr::to_string() const {
+void GetElementPtr::print(Utils::OutputSink &out) const {
     const auto addr = get_addr();
     const auto ptr_type = std::static_pointer_cast<Type::Pointer>(addr->get_type());
-    const auto target_type = ptr_type->get_contain_type();
-    std::ostringstream oss;
-    oss << name_ << " = getelementptr inbounds " << target_type->to_string() << ", " << ptr_type->to_string() << " "
-            << addr->get_name();
+    out << name_ << " = getelementptr inbounds " << ptr_type->get_contain_type()->to_string() << ", "
+            << ptr_type->to_string() << " " << addr->get_name();
     for (size_t i = 1; i < operands_.size(); ++i) {
-        oss << ", " << operands_[i]->get_type()->to_string() << " " << operands_[i]->get_name();
+        out << ", ";
+        print_typed(out, get_operand(i));
     }
-    return oss.str();
 }
 
-[[nodiscard]] std::string BitCast::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = bitcast ";
-    const auto &origin_value = get_value();
-    oss << origin_value->get_type()->to_string() << " " << origin_value->get_name();
-    oss << " to " << type_->to_string();
-    return oss.str();
-}
+void BitCast::print(Utils::OutputSink &out) const { print_cast(out, name_, "bitcast", get_value(), type_); }
 
+void Fptosi::print(Utils::OutputSink &out) const { print_cast(out, name_, "fptosi", get_value(), type_); }
 
-[[nodiscard]] std::string Fptosi::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = fptosi ";
-    const auto &origin_value = get_value();
-    oss << origin_value->get_type()->to_string() << " " << origin_value->get_name();
-    oss << " to " << type_->to_string();
-    return oss.str();
-}
-
-[[nodiscard]] std::string Sitofp::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = sitofp ";
-    const auto &origin_value = get_value();
-    oss << origin_value->get_type()->to_string() << " " << origin_value->get_name();
-    oss << " to " << type_->to_string();
-    return oss.str();
-}
+void Sitofp::print(Utils::OutputSink &out) const { print_cast(out, name_, "sitofp", get_value(), type_); }
 
-[[nodiscard]] std::string Fcmp::to_string() const {
+void Fcmp::print(Utils::OutputSink &out) const {
     const auto op_str = [&] {
-        const std::string id = "fcmp";
         switch (op) {
             case Op::EQ:
-                return id + " oeq";
+                return "oeq";
             case Op::NE:
-                return id + " one";
+                return "one";
             case Op::LT:
-                return id + " olt";
+                return "olt";
             case Op::LE:
-                return id + " ole";
+                return "ole";
             case Op::GT:
-                return id + " ogt";
+                return "ogt";
             case Op::GE:
-                return id + " oge";
+                return "oge";
             default:
                 log_error("Unknown op");
         }
     }();
-    std::ostringstream oss;
-    oss << name_ << " = " << op_str << " float ";
-    oss << get_lhs()->get_name() << ", " << get_rhs()->get_name();
-    return oss.str();
+    out << name_ << " = fcmp " << op_str << " float " << get_lhs()->get_name() << ", " << get_rhs()->get_name();
 }
 
-[[nodiscard]] std::string Icmp::to_string() const {
+void Icmp::print(Utils::OutputSink &out) const {
     const auto op_str = [&] {
-        const std::string id = "icmp";
         switch (op) {
             case Op::EQ:
-                return id + " eq";
+                return "eq";
             case Op::NE:
-                return id + " ne";
+                return "ne";
             case Op::LT:
-                return id + " slt";
+                return "slt";
             case Op::LE:
-                return id + " sle";
+                return "sle";
             case Op::GT:
-                return id + " sgt";
+                return "sgt";
             case Op::GE:
-                return id + " sge";
+                return "sge";
             default:
                 log_error("Unknown op");
         }
     }();
-    std::ostringstream oss;
-    oss << name_ << " = " << op_str << " i32 ";
-    oss << get_lhs()->get_name() << ", " << get_rhs()->get_name();
-    return oss.str();
+    out << name_ << " = icmp " << op_str << " i32 " << get_lhs()->get_name() << ", " << get_rhs()->get_name();
 }
 
-[[nodiscard]] std::string Zext::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = zext ";
-    const auto &origin_value = get_value();
-    oss << origin_value->get_type()->to_string() << " " << origin_value->get_name();
-    oss << " to " << type_->to_string();
-    return oss.str();
-}
+void Zext::print(Utils::OutputSink &out) const { print_cast(out, name_, "zext", get_value(), type_); }
 
-[[nodiscard]] std::string Branch::to_string() const {
-    std::ostringstream oss;
-    oss << "br ";
-    const auto &cond = get_cond();
-    oss << cond->get_type()->to_string() << " " << cond->get_name() << ", ";
-    oss << "label %" << get_true_block()->get_name() << ", label %" << get_false_block()->get_name();
-    return oss.str();
+void Branch::print(Utils::OutputSink &out) const {
+    out << "br ";
+    print_typed(out, get_cond());
+    out << ", label %" << get_true_block()->get_name() << ", label %" << get_false_block()->get_name();
 }
 
-[[nodiscard]] std::string Jump::to_string() const {
-    std::ostringstream oss;
-    oss << "br label %" << get_target_block()->get_name();
-    return oss.str();
-}
+void Jump::print(Utils::OutputSink &out) const { out << "br label %" << get_target_block()->get_name(); }
 
-[[nodiscard]] std::string Ret::to_string() const {
-    std::ostringstream oss;
-    oss << "ret ";
+void Ret::print(Utils::OutputSink &out) const {
+    out << "ret ";
     if (operands_.empty()) {
-        oss << "void";
+        out << "void";
     } else {
-        oss << get_value()->get_type()->to_string() << " " << get_value()->get_name();
+        print_typed(out, get_value());
     }
-    return oss.str();
 }
 
 [[nodiscard]] std::string Switch::to_string() const {
@@ -737,95 +715,80 @@ namespace Mir {
     return oss.str();
 }
 
-[[nodiscard]] std::string Call::to_string() const {
-    auto params_to_string = [&] {
-        std::ostringstream oss;
+void Call::print(Utils::OutputSink &out) const {
+    const auto print_params = [&] {
         for (size_t i = 0; i < get_params().size(); ++i) {
-            const auto param = get_params()[i];
-            oss << param->get_type()->to_string() << " " << param->get_name();
+            print_typed(out, get_params()[i]);
             if (i != get_params().size() - 1)
-                oss << ", ";
+                out << ", ";
         }
-        return oss.str();
     };
-    std::ostringstream oss;
     if (const_string_index != -1) {
         if (get_function()->get_name() != "putf") {
             log_error("Unknown const string index");
         }
-        if (get_params().empty()) {
-            oss << "call void @putf(i8* @.str_" << const_string_index << ")";
-        } else {
-            oss << "call void @putf(i8* @.str_" << const_string_index << ", " << params_to_string() << ")";
-        }
-    } else {
-        constexpr auto tail = std::string_view{"tail "};
-        if (get_function()->get_type()->is_void()) {
-            oss << (is_tail_call() ? tail : "") << "call " << get_function()->get_type()->to_string() << " @"
-                    << get_function()->get_name() << "(";
-            oss << params_to_string() << ")";
-        } else {
-            oss << name_ << " = " << (is_tail_call() ? tail : "") << "call " << get_function()->get_type()->to_string()
-                    << " @" << get_function()->get_name() << "(";
-            oss << params_to_string() << ")";
+        out << "call void @putf(i8* @.str_" << const_string_index;
+        if (!get_params().empty()) {
+            out << ", ";
+            print_params();
         }
+        out << ")";
+        return;
     }
-    return oss.str();
+    if (!get_function()->get_type()->is_void()) {
+        out << name_ << " = ";
+    }
+    if (is_tail_call()) {
+        out << "tail ";
+    }
+    out << "call " << get_function()->get_type()->to_string() << " @" << get_function()->get_name() << "(";
+    print_params();
+    out << ")";
 }
 
 
-#define BINARY_TO_STRING(op_name, instr_name)                                                                          \
+#define BINARY_PRINT(op_name, instr_name)                                                                              \
     [[nodiscard]] std::string op_name::to_string() const {                                                             \
-        std::ostringstream oss;                                                                                        \
-        oss << name_ << " = ";                                                                                         \
-        oss << #instr_name << " " << get_lhs()->get_type()->to_string() << " " << get_lhs()->get_name() << ", "        \
-            << get_rhs()->get_name();                                                                                  \
-        return oss.str();                                                                                              \
+        return Utils::print_to_string([this](Utils::OutputSink &out) { print(out); });                                 \
+    }                                                                                                                  \
+    void op_name::print(Utils::OutputSink &out) const {                                                                \
+        out << name_ << " = " << #instr_name << " ";                                                                   \
+        print_typed(out, get_lhs());                                                                                   \
+        out << ", " << get_rhs()->get_name();                                                                          \
+    }
+
+BINARY_PRINT(Add, add)
+BINARY_PRINT(Sub, sub)
+BINARY_PRINT(Mul, mul)
+BINARY_PRINT(Div, sdiv)
+BINARY_PRINT(Mod, srem)
+BINARY_PRINT(And, and)
+BINARY_PRINT(Or, or)
+BINARY_PRINT(Xor, xor)
+BINARY_PRINT(FAdd, fadd)
+BINARY_PRINT(FSub, fsub)
+BINARY_PRINT(FMul, fmul)
+BINARY_PRINT(FDiv, fdiv)
+BINARY_PRINT(FMod, frem)
+
+#define MIN_MAX_PRINT(op_name, callee)                                                                                 \
+    [[nodiscard]] std::string op_name::to_string() const {                                                             \
+        return Utils::print_to_string([this](Utils::OutputSink &out) { print(out); });                                 \
+    }                                                                                                                  \
+    void op_name::print(Utils::OutputSink &out) const {                                                                \
+        out << name_ << " = call " << type_->to_string() << " @" << #callee << "(";                                    \
+        print_typed(out, get_lhs());                                                                                   \
+        out << ", ";                                                                                                   \
+        print_typed(out, get_rhs());                                                                                   \
+        out << ")";                                                                                                    \
     }
 
-BINARY_TO_STRING(Add, add)
-BINARY_TO_STRING(Sub, sub)
-BINARY_TO_STRING(Mul, mul)
-BINARY_TO_STRING(Div, sdiv)
-BINARY_TO_STRING(Mod, srem)
-BINARY_TO_STRING(And, and)
-BINARY_TO_STRING(Or, or)
-BINARY_TO_STRING(Xor, xor)
-BINARY_TO_STRING(FAdd, fadd)
-BINARY_TO_STRING(FSub, fsub)
-BINARY_TO_STRING(FMul, fmul)
-BINARY_TO_STRING(FDiv, fdiv)
-BINARY_TO_STRING(FMod, frem)
-
-std::string Smax::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = call i32 @llvm.smax.i32(" << get_lhs()->get_type()->to_string() << " " << get_lhs()->get_name()
-            << ", " << get_rhs()->get_type()->to_string() << " " << get_rhs()->get_name() << ")";
-    return oss.str();
-}
-
-std::string Smin::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = call i32 @llvm.smin.i32(" << get_lhs()->get_type()->to_string() << " " << get_lhs()->get_name()
-            << ", " << get_rhs()->get_type()->to_string() << " " << get_rhs()->get_name() << ")";
-    return oss.str();
-}
-
-std::string FSmax::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = call float @llvm.smax.float(" << get_lhs()->get_type()->to_string() << " "
-            << get_lhs()->get_name() << ", " << get_rhs()->get_type()->to_string() << " " << get_rhs()->get_name() <<
-            ")";
-    return oss.str();
-}
+MIN_MAX_PRINT(Smax, llvm.smax.i32)
+MIN_MAX_PRINT(Smin, llvm.smin.i32)
+MIN_MAX_PRINT(FSmax, llvm.smax.float)
+MIN_MAX_PRINT(FSmin, llvm.smin.float)
 
-std::string FSmin::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = call float @llvm.smin.float(" << get_lhs()->get_type()->to_string() << " "
-            << get_lhs()->get_name() << ", " << get_rhs()->get_type()->to_string() << " " << get_rhs()->get_name() <<
-            ")";
-    return oss.str();
-}
+#undef MIN_MAX_PRINT
 
 std::string FMadd::to_string() const {
     std::ostringstream oss;
@@ -866,22 +829,20 @@ std::string FNeg::to_string() const {
     return oss.str();
 }
 
-#undef BINARY_TO_STRING
+#undef BINARY_PRINT
 
-[[nodiscard]] std::string Phi::to_string() const {
-    std::ostringstream oss;
-    oss << name_ << " = phi " << type_->to_string();
+void Phi::print(Utils::OutputSink &out) const {
+    out << name_ << " = phi " << type_->to_string();
     size_t i{0};
     for (const auto &[value, block]: optional_values) {
-        oss << " [ " << block->get_name() << ", %" << value->get_name();
+        out << " [ " << block->get_name() << ", %" << value->get_name();
         if (i != optional_values.size() - 1) {
-            oss << " ], ";
+            out << " ], ";
         } else {
-            oss << " ]";
+            out << " ]";
         }
         ++i;
     }
-    return oss.str();
 }
 
 std::string Select::to_string() const {
@@ -903,20 +864,35 @@ namespace Init {
     [[nodiscard]] std::string Constant::to_string() const { return type->to_string() + " " + const_value->to_string(); }
 
     [[nodiscard]] std::string Array::to_string() const {
-        std::ostringstream oss;
-        if (is_zero_initialized) {
-            oss << type->to_string() << " zeroinitializer";
-            return oss.str();
+        return Utils::print_to_string([this](Utils::OutputSink &out) { print(out); });
+    }
+
+    void Array::print(Utils::OutputSink &out) const { print(out, type, 0); }
+
+    void Array::print(Utils::OutputSink &out, const std::shared_ptr<Type::Type> &sub_type, const size_t offset) const {
+        const auto array_type = std::static_pointer_cast<Type::Array>(sub_type);
+        if (!has_value_in(offset, offset + array_type->get_flattened_size())) {
+            out << sub_type->to_string() << " zeroinitializer";
+            return;
         }
-        oss << type->to_string() << " [";
-        for (size_t i = 0; i < init_values.size(); ++i) {
-            oss << init_values[i]->to_string();
-            if (i != init_values.size() - 1) {
-                oss << ", ";
+        const auto &element_type = array_type->get_element_type();
+        const size_t element_size =
+                element_type->is_array() ? std::static_pointer_cast<Type::Array>(element_type)->get_flattened_size() : 1;
+        const auto element_type_name = element_type->to_string();
+        out << sub_type->to_string() << " [";
+        for (size_t i = 0; i < array_type->get_size(); ++i) {
+            if (i != 0) {
+                out << ", ";
+            }
+            if (element_type->is_array()) {
+                print(out, element_type, offset + i * element_size);
+            } else if (const auto value = get_value(offset + i); value->is_constant()) {
+                out << element_type_name << " " << value->get_name();
+            } else {
+                log_error("ExpInit cannot be output as a string");
             }
         }
-        oss << "]";
-        return oss.str();
+        out << "]";
     }
 } // namespace Init
 } // namespace Mir
@@ -0,0 +1,128 @@
+#include "Utils/ThreadPool.h"
+#include "Utils/Parallel.h"
+
+namespace Utils {
+ThreadPool::ThreadPool(const size_t threads) {
+    const size_t count = threads == 0 ? 1 : threads;
+    for (size_t i = 0; i < count; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 1; i < count; ++i) {
+        workers_.emplace_back([this, i] { work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker: workers_) {
+        worker.join();
+    }
+}
+
+bool ThreadPool::pop(const size_t self, Task &task) {
+    {
+        auto &own = *queues_[self];
+        std::lock_guard lock{own.mutex};
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        auto &victim = *queues_[(self + offset) % queues_.size()];
+        std::lock_guard lock{victim.mutex};
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(Task &task) {
+    if (!failed_.load(std::memory_order_relaxed)) {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard lock{mutex_};
+            if (!failed_.exchange(true)) {
+                error_ = std::current_exception();
+            }
+        }
+    }
+    task = nullptr;
+    if (pending_.fetch_sub(1) == 1) {
+        std::lock_guard lock{mutex_};
+        done_.notify_all();
+    }
+}
+
+void ThreadPool::work(const size_t self) {
+    size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock lock{mutex_};
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+        Task task;
+        while (pop(self, task)) {
+            execute(task);
+        }
+    }
+}
+
+void ThreadPool::run(std::vector<Task> tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+    {
+        // 上一批的工作线程可能仍在窃取循环中，任务一入队就会被取走，因此须在入队前切换标记并重置状态
+        std::lock_guard lock{mutex_};
+        parallel_running() = true;
+        failed_ = false;
+        error_ = nullptr;
+        pending_ = tasks.size();
+        ++generation_;
+    }
+    // 按顺序轮流分配，相邻的任务落在不同的线程上
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        auto &queue = *queues_[i % queues_.size()];
+        std::lock_guard lock{queue.mutex};
+        queue.tasks.push_back(std::move(tasks[i]));
+    }
+    wake_.notify_all();
+    Task task;
+    while (pop(0, task)) {
+        execute(task);
+    }
+    {
+        std::unique_lock lock{mutex_};
+        done_.wait(lock, [&] { return pending_.load() == 0; });
+    }
+    parallel_running() = false;
+    if (error_ != nullptr) {
+        std::rethrow_exception(error_);
+    }
+}
+
+namespace {
+size_t worker_threads_{1};
+} // namespace
+
+void set_worker_threads(const size_t threads) { worker_threads_ = threads == 0 ? 1 : threads; }
+
+ThreadPool &worker_pool() {
+    static ThreadPool pool{worker_threads_};
+    return pool;
+}
+} // namespace Utils
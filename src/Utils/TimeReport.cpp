@@ -0,0 +1,154 @@
+#include "Utils/TimeReport.h"
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "Utils/Parallel.h"
+#include "Utils/Trace.h"
+
+namespace Utils {
+namespace {
+bool enabled_{false};
+std::chrono::steady_clock::time_point start_;
+std::mutex records_mutex_;
+std::vector<TimeRecord> records_;
+
+double cpu_clock_ms(const bool thread_clock) {
+    timespec ts{};
+    clock_gettime(thread_clock ? CLOCK_THREAD_CPUTIME_ID : CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) * 1e3 + static_cast<double>(ts.tv_nsec) / 1e6;
+}
+
+double total_wall_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+}
+
+void size_to_json(std::ostringstream &oss, const IRSize &size) {
+    oss << "{\"functions\": " << size.functions << ", \"blocks\": " << size.blocks
+        << ", \"instructions\": " << size.instructions << "}";
+}
+} // namespace
+
+void set_time_report_enabled(const bool enabled) {
+    enabled_ = enabled;
+    start_ = std::chrono::steady_clock::now();
+}
+
+bool time_report_enabled() { return enabled_; }
+
+void record_time(TimeRecord record) {
+    const ParallelLock lock{records_mutex_};
+    records_.push_back(std::move(record));
+}
+
+std::string time_report_table() {
+    struct Summary {
+        std::string group;
+        std::string name;
+        size_t calls{0};
+        double wall_ms{0};
+        double cpu_ms{0};
+        long long instructions_delta{0};
+        bool has_size{false};
+        size_t analyses{0};
+    };
+    std::map<std::pair<std::string, std::string>, Summary> summaries;
+    for (const auto &record: records_) {
+        auto &summary = summaries[{record.group, record.name}];
+        summary.group = record.group;
+        summary.name = record.name;
+        ++summary.calls;
+        summary.wall_ms += record.wall_ms;
+        summary.cpu_ms += record.cpu_ms;
+        summary.analyses += record.analyses;
+        if (record.before.has_value() && record.after.has_value()) {
+            summary.has_size = true;
+            summary.instructions_delta += static_cast<long long>(record.after->instructions) -
+                                          static_cast<long long>(record.before->instructions);
+        }
+    }
+    std::vector<Summary> sorted;
+    sorted.reserve(summaries.size());
+    for (auto &[key, summary]: summaries) {
+        sorted.push_back(std::move(summary));
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Summary &lhs, const Summary &rhs) { return lhs.wall_ms > rhs.wall_ms; });
+
+    const double total = total_wall_ms();
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    oss << "total wall " << total << " ms\n";
+    oss << std::left << std::setw(10) << "group" << std::setw(32) << "name" << std::right << std::setw(7) << "calls"
+        << std::setw(12) << "wall(ms)" << std::setw(8) << "wall%" << std::setw(12) << "cpu(ms)" << std::setw(10)
+        << "instrs+-" << std::setw(10) << "analyses";
+    for (const auto &summary: sorted) {
+        oss << "\n" << std::left << std::setw(10) << summary.group << std::setw(32) << summary.name << std::right
+            << std::setw(7) << summary.calls << std::setw(12) << summary.wall_ms << std::setw(7)
+            << std::setprecision(1) << (total > 0 ? summary.wall_ms / total * 100 : 0) << "%" << std::setprecision(3)
+            << std::setw(12) << summary.cpu_ms << std::setw(10);
+        if (summary.has_size) {
+            oss << summary.instructions_delta << std::setw(10) << summary.analyses;
+        } else {
+            oss << "-" << std::setw(10) << "-";
+        }
+    }
+    return oss.str();
+}
+
+std::string time_report_json() {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    oss << "{\n  \"total_wall_ms\": " << total_wall_ms() << ",\n  \"records\": [";
+    for (size_t i = 0; i < records_.size(); ++i) {
+        const auto &record = records_[i];
+        oss << (i == 0 ? "\n" : ",\n") << "    {\"group\": \"" << escape_json(record.group) << "\", \"name\": \""
+            << escape_json(record.name) << "\", \"wall_ms\": " << record.wall_ms << ", \"cpu_ms\": " << record.cpu_ms;
+        if (record.before.has_value() && record.after.has_value()) {
+            oss << ", \"before\": ";
+            size_to_json(oss, *record.before);
+            oss << ", \"after\": ";
+            size_to_json(oss, *record.after);
+            oss << ", \"analyses_recomputed\": " << record.analyses;
+        }
+        oss << "}";
+    }
+    oss << "\n  ]\n}";
+    return oss.str();
+}
+
+Stopwatch::Stopwatch() :
+    wall_start_{std::chrono::steady_clock::now()},
+    thread_clock_{parallel_running().load(std::memory_order_relaxed)}, cpu_start_{cpu_clock_ms(thread_clock_)} {}
+
+double Stopwatch::wall_ms() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start_).count();
+}
+
+double Stopwatch::cpu_ms() const { return cpu_clock_ms(thread_clock_) - cpu_start_; }
+
+ScopedTimer::ScopedTimer(std::string group, std::string name) :
+    span_{group.c_str(), name}, group_{std::move(group)}, name_{std::move(name)} {
+    if (enabled_) {
+        stopwatch_.emplace();
+    }
+}
+
+ScopedTimer::~ScopedTimer() {
+    if (!stopwatch_.has_value()) {
+        return;
+    }
+    TimeRecord record;
+    record.group = std::move(group_);
+    record.name = std::move(name_);
+    record.wall_ms = stopwatch_->wall_ms();
+    record.cpu_ms = stopwatch_->cpu_ms();
+    record_time(std::move(record));
+}
+} // namespace Utils
@@ -0,0 +1,119 @@
+#include "Utils/Trace.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+
+#include "Utils/Log.h"
+#include "Utils/Parallel.h"
+
+namespace Utils {
+namespace {
+struct Event {
+    std::string category;
+    std::string name;
+    size_t thread;
+    double start_us;
+    double duration_us;
+    std::vector<std::pair<const char *, long long>> args;
+};
+
+bool enabled_{false};
+std::chrono::steady_clock::time_point start_;
+std::mutex events_mutex_;
+std::vector<Event> events_;
+std::atomic<size_t> thread_count_{0};
+
+// 线程首次记录区间时分配编号，开启 -ftrace 的主线程为 0
+size_t thread_id() {
+    static thread_local const size_t id = thread_count_++;
+    return id;
+}
+
+double since_start_us(const std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration<double, std::micro>(time - start_).count();
+}
+} // namespace
+
+void set_trace_enabled(const bool enabled) {
+    enabled_ = enabled;
+    start_ = std::chrono::steady_clock::now();
+    (void) thread_id();
+}
+
+bool trace_enabled() { return enabled_; }
+
+std::string escape_json(const std::string &str) {
+    std::string result;
+    result.reserve(str.size());
+    for (const char c: str) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            result += buffer;
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
+void write_trace(const std::string &filename) {
+    std::ofstream out{filename};
+    if (!out) {
+        log_error("Failed to open file: %s", filename.c_str());
+    }
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    const size_t threads = thread_count_.load();
+    for (size_t thread = 0; thread < threads; ++thread) {
+        out << (thread == 0 ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+            << thread << ", \"args\": {\"name\": \"" << (thread == 0 ? "main" : "worker " + std::to_string(thread))
+            << "\"}}";
+    }
+    for (const auto &event: events_) {
+        out << ",\n{\"name\": \"" << escape_json(event.name) << "\", \"cat\": \"" << escape_json(event.category)
+            << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.thread << ", \"ts\": " << event.start_us
+            << ", \"dur\": " << event.duration_us;
+        if (!event.args.empty()) {
+            out << ", \"args\": {";
+            for (size_t i = 0; i < event.args.size(); ++i) {
+                out << (i == 0 ? "\"" : ", \"") << event.args[i].first << "\": " << event.args[i].second;
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n]}" << std::endl;
+}
+
+TraceSpan::TraceSpan(const char *category, std::string name) : active_{enabled_} {
+    if (active_) {
+        category_ = category;
+        name_ = std::move(name);
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (!active_) {
+        return;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    Event event{std::move(category_), std::move(name_), thread_id(), since_start_us(start_),
+                std::chrono::duration<double, std::micro>(end - start_).count(), std::move(args_)};
+    const ParallelLock lock{events_mutex_};
+    events_.push_back(std::move(event));
+}
+
+void TraceSpan::add_arg(const char *key, const long long value) {
+    if (active_) {
+        args_.emplace_back(key, value);
+    }
+}
+} // namespace Utils
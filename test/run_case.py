@@ -0,0 +1,105 @@
+"""
+编译一个 SysY 测试用例，并按用例中的注释检查编译器的输出。
+
+用例开头的注释支持以下指令：
+    // ARGS: <参数>        追加到编译命令后的参数，可以出现多次
+    // CHECK: <文本>       输出中必须出现该文本，且位于上一条 CHECK 的匹配之后
+    // CHECK-NOT: <文本>   在上一条与下一条 CHECK 的匹配之间不能出现该文本
+    // SAME-OUTPUT: <参数> 追加这些参数再编译一次，LLVM IR 与 RISC-V 汇编必须与不加时完全相同，可以出现多次
+    // FAIL                编译器应当以非零状态退出
+
+被检查的输出依次为编译器的日志（stdout 与 stderr）、LLVM IR 与 RISC-V 汇编。
+
+用法: run_case.py <compiler> <case.sy> <output-prefix>
+"""
+import os
+import subprocess
+import sys
+
+
+def parse_directives(case_path):
+    args, checks, same_output, expect_fail = [], [], [], False
+    with open(case_path, encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("//"):
+                continue
+            body = line[2:].strip()
+            if body.startswith("ARGS:"):
+                args += body[len("ARGS:"):].split()
+            elif body.startswith("SAME-OUTPUT:"):
+                same_output.append(body[len("SAME-OUTPUT:"):].split())
+            elif body.startswith("CHECK-NOT:"):
+                checks.append((False, body[len("CHECK-NOT:"):].strip()))
+            elif body.startswith("CHECK:"):
+                checks.append((True, body[len("CHECK:"):].strip()))
+            elif body == "FAIL":
+                expect_fail = True
+    return args, checks, same_output, expect_fail
+
+
+def read_if_exists(path):
+    if not os.path.exists(path):
+        return ""
+    with open(path, encoding="utf-8", errors="replace") as f:
+        return f.read()
+
+
+def verify(output, checks):
+    pos, pending_not = 0, []
+    for positive, text in checks + [(True, None)]:
+        if not positive:
+            pending_not.append(text)
+            continue
+        if text is None:
+            end = len(output)
+        else:
+            end = output.find(text, pos)
+            if end < 0:
+                return f"CHECK not found: {text}"
+        for forbidden in pending_not:
+            if output.find(forbidden, pos, end) >= 0:
+                return f"CHECK-NOT found: {forbidden}"
+        pending_not = []
+        if text is not None:
+            pos = end + len(text)
+    return None
+
+
+def compile_case(compiler, case_path, prefix, args):
+    llvm_path, riscv_path = prefix + ".ll", prefix + ".s"
+    for path in (llvm_path, riscv_path):
+        if os.path.exists(path):
+            os.remove(path)
+
+    cmd = [compiler, case_path, "-emit-llvm", llvm_path, "-emit-riscv", riscv_path] + args
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True, errors="replace")
+    return cmd, result, read_if_exists(llvm_path) + read_if_exists(riscv_path)
+
+
+def main():
+    compiler, case_path, prefix = sys.argv[1:4]
+    args, checks, same_output, expect_fail = parse_directives(case_path)
+    cmd, result, emitted = compile_case(compiler, case_path, prefix, args)
+    output = result.stdout + emitted
+
+    if (result.returncode != 0) != expect_fail:
+        print(output)
+        print(f"Unexpected exit code {result.returncode}: {' '.join(cmd)}")
+        return 1
+    error = verify(output, checks)
+    if error is not None:
+        print(output)
+        print(error)
+        return 1
+    for i, extra in enumerate(same_output):
+        other_cmd, other_result, other_emitted = compile_case(compiler, case_path, f"{prefix}.same{i}", args + extra)
+        if other_result.returncode != result.returncode or other_emitted != emitted:
+            print(other_result.stdout)
+            print(f"Output differs from {' '.join(cmd)}: {' '.join(other_cmd)}")
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())